@@ -0,0 +1,40 @@
+#include "delta_stepping_benchmarks.hpp"
+#include <iostream>
+#include <thread>
+#include <algorithms/delta_stepping.cpp>
+#include "benchmark_graphs.hpp"
+
+void deltaSteppingBenchmarkRun(
+        BenchmarkManager* manager,
+        std::string filepath) {
+    int max_threads = static_cast<int>(std::thread::hardware_concurrency());
+    if (max_threads < 1) {max_threads = 1;}
+    std::vector<std::string> names;
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        names.push_back(std::to_string(threads) + " threads");
+    }
+    if (!benchmarkManagerSelectedAny(*manager, "delta stepping", names)) {
+        return;
+    }
+    CsrGraph<int> graph = benchmarkLoadGraph(filepath);
+    double delta = deltaSteppingChooseDelta(graph);
+    ShortestPathResult expected = dijkstra<RadixHeap>(graph, 0);
+
+    for (int threads = 1, i = 0; threads <= max_threads; threads *= 2, i++) {
+        ThreadPool pool(threads);
+        bool matches = true;
+        benchmarkManagerMeasure(manager, "delta stepping", names[i],
+                graph.num_nodes, static_cast<long long>(graph.num_edges),
+                [&](BenchmarkTimer* timer) {
+            benchmarkTimerStart(timer);
+            ShortestPathResult result =
+                deltaStepping(graph, 0, delta, threads, pool);
+            benchmarkTimerStop(timer);
+            matches &= result.distances == expected.distances;
+        });
+        if (!matches) {
+            std::cerr << "delta stepping with " << threads
+                << " threads doesn't match dijkstra" << std::endl;
+        }
+    }
+}
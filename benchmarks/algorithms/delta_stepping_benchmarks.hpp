@@ -0,0 +1,19 @@
+#ifndef DELTA_STEPPING_BENCHMARKS_HPP
+#define DELTA_STEPPING_BENCHMARKS_HPP
+
+#include <string>
+#include "bench_utils/benchmark_manager.hpp"
+
+/**
+ * @brief Times delta-stepping at each power of two thread count up to the
+ * number of cores
+ *
+ * @param manager The manager to record the results in
+ * @param filepath A graph file to load, or an empty string to generate a
+ * random graph
+ */
+void deltaSteppingBenchmarkRun(
+    BenchmarkManager* manager,
+    std::string filepath);
+
+#endif
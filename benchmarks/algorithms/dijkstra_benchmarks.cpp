@@ -0,0 +1,43 @@
+#include "dijkstra_benchmarks.hpp"
+#include <algorithms/dijkstra.cpp>
+#include "benchmark_graphs.hpp"
+
+/**
+ * @brief Times Dijkstra with one queue. Each repetition searches from a
+ * different source, and every queue sees the same sources.
+ *
+ * @tparam Queue The priority queue template to time
+ * @param manager The manager to record the result in
+ * @param graph The graph to search
+ * @param name The queue's name
+ */
+template <template <typename> class Queue>
+void dijkstraBenchmarkQueue(
+        BenchmarkManager* manager,
+        const CsrGraph<int>& graph,
+        std::string name) {
+    int run = 0;
+    benchmarkManagerMeasure(manager, "dijkstra", name, graph.num_nodes,
+            static_cast<long long>(graph.num_edges),
+            [&](BenchmarkTimer* timer) {
+        int source = static_cast<int>(
+            static_cast<long long>(run++) * 7919 % graph.num_nodes);
+        benchmarkTimerStart(timer);
+        ShortestPathResult result = dijkstra<Queue>(graph, source);
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(result.distances[0]);
+    });
+}
+
+void dijkstraBenchmarkRun(BenchmarkManager* manager, std::string filepath) {
+    const std::vector<std::string> names = {
+        "binary heap", "4-ary heap", "pairing heap", "radix heap"
+    };
+    if (!benchmarkManagerSelectedAny(*manager, "dijkstra", names)) {return;}
+    CsrGraph<int> graph = benchmarkLoadGraph(filepath);
+
+    dijkstraBenchmarkQueue<BinaryHeap>(manager, graph, names[0]);
+    dijkstraBenchmarkQueue<QuaternaryHeap>(manager, graph, names[1]);
+    dijkstraBenchmarkQueue<PairingHeap>(manager, graph, names[2]);
+    dijkstraBenchmarkQueue<RadixHeap>(manager, graph, names[3]);
+}
@@ -0,0 +1,16 @@
+#ifndef DIJKSTRA_BENCHMARKS_HPP
+#define DIJKSTRA_BENCHMARKS_HPP
+
+#include <string>
+#include "bench_utils/benchmark_manager.hpp"
+
+/**
+ * @brief Times Dijkstra with every priority queue on the same graph
+ *
+ * @param manager The manager to record the results in
+ * @param filepath A graph file to load, or an empty string to generate a
+ * random graph
+ */
+void dijkstraBenchmarkRun(BenchmarkManager* manager, std::string filepath);
+
+#endif
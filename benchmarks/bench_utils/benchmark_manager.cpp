@@ -0,0 +1,85 @@
+#include "benchmark_manager.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+bool benchmarkManagerSelected(
+        const BenchmarkManager& manager,
+        const std::string& group,
+        const std::string& name) {
+    return (group + "/" + name).find(manager.filter) != std::string::npos;
+}
+
+bool benchmarkManagerSelectedAny(
+        const BenchmarkManager& manager,
+        const std::string& group,
+        const std::vector<std::string>& names) {
+    for (const std::string& name : names) {
+        if (benchmarkManagerSelected(manager, group, name)) {return true;}
+    }
+    return false;
+}
+
+void benchmarkManagerAddResult(
+        BenchmarkManager* manager,
+        const std::string& group,
+        const std::string& name,
+        int size,
+        long long operations,
+        std::vector<double> samples) {
+    BenchmarkResult result;
+    result.group = group;
+    result.name = name;
+    result.size = size;
+    result.operations = operations;
+    result.repetitions = static_cast<int>(samples.size());
+    if (!samples.empty()) {
+        std::sort(samples.begin(), samples.end());
+        size_t count = samples.size();
+        result.median_ns = count % 2
+            ? samples[count / 2]
+            : (samples[count / 2 - 1] + samples[count / 2]) / 2;
+        // Nearest rank, so with few repetitions it's the slowest one
+        size_t rank = (99 * count + 99) / 100;
+        result.p99_ns = samples[rank - 1];
+    }
+    result.ns_per_op = operations > 0 ? result.median_ns / operations : 0;
+    manager->results.push_back(result);
+
+    std::cout << "  " << group << " " << name << " [" << size << "]: "
+        << std::fixed << std::setprecision(2) << result.ns_per_op
+        << " ns/op (median " << result.median_ns / 1e6 << " ms, p99 "
+        << result.p99_ns / 1e6 << " ms)" << std::defaultfloat << '\n';
+}
+
+void benchmarkWriteJsonString(std::ostream& out, const std::string& text) {
+    out << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {out << '\\';}
+        out << c;
+    }
+    out << '"';
+}
+
+void benchmarkManagerWriteJson(
+        const BenchmarkManager& manager,
+        std::ostream& out) {
+    out << "{\n  \"warmups\": " << manager.warmups
+        << ",\n  \"repetitions\": " << manager.repetitions
+        << ",\n  \"benchmarks\": [";
+    out << std::setprecision(17);
+    for (size_t i = 0; i < manager.results.size(); i++) {
+        const BenchmarkResult& result = manager.results[i];
+        out << (i ? "," : "") << "\n    {\"group\": ";
+        benchmarkWriteJsonString(out, result.group);
+        out << ", \"name\": ";
+        benchmarkWriteJsonString(out, result.name);
+        out << ", \"size\": " << result.size
+            << ", \"operations\": " << result.operations
+            << ", \"repetitions\": " << result.repetitions
+            << ", \"median_ns\": " << result.median_ns
+            << ", \"p99_ns\": " << result.p99_ns
+            << ", \"ns_per_op\": " << result.ns_per_op << "}";
+    }
+    out << "\n  ]\n}\n";
+}
@@ -0,0 +1,155 @@
+#ifndef BENCHMARKS_BENCH_UTILS_BENCHMARK_MANAGER_HPP_
+#define BENCHMARKS_BENCH_UTILS_BENCHMARK_MANAGER_HPP_
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Times the part of a repetition that's being measured, so setup
+ * and teardown can happen around it
+ */
+struct BenchmarkTimer {
+ public:
+    // Fields
+    std::chrono::steady_clock::time_point start;
+    double elapsed_ns;
+
+    // Constructors
+    BenchmarkTimer(): elapsed_ns(0) {}
+};
+
+/**
+ * @brief The summary of one benchmark at one input size
+ */
+struct BenchmarkResult {
+ public:
+    // Fields
+    std::string group;
+    std::string name;
+    int size;
+    long long operations;
+    int repetitions;
+    double median_ns;
+    double p99_ns;
+    double ns_per_op;
+
+    // Constructors
+    BenchmarkResult(): size(0), operations(0), repetitions(0), median_ns(0),
+        p99_ns(0), ns_per_op(0) {}
+};
+
+/**
+ * @brief Runs benchmarks and collects their results. Every benchmark is
+ * run a few times untimed to warm the caches and allocator, then timed
+ * over several repetitions.
+ */
+struct BenchmarkManager {
+ public:
+    // Fields
+    int warmups;
+    int repetitions;
+    // Only benchmarks whose "group/name" contains this are run
+    std::string filter;
+    std::vector<BenchmarkResult> results;
+
+    // Constructors
+    BenchmarkManager(): warmups(1), repetitions(11) {}
+};
+
+/**
+ * @brief Starts timing the measured part of a repetition
+ *
+ * @param timer The repetition's timer
+ */
+inline void benchmarkTimerStart(BenchmarkTimer* timer) {
+    timer->start = std::chrono::steady_clock::now();
+}
+
+/**
+ * @brief Stops timing, adding the time since the last start
+ *
+ * @param timer The repetition's timer
+ */
+inline void benchmarkTimerStop(BenchmarkTimer* timer) {
+    std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - timer->start;
+    timer->elapsed_ns += elapsed.count();
+}
+
+/**
+ * @brief Keeps the compiler from optimizing away a value that's computed
+ * only to be timed
+ *
+ * @tparam T The type of the value
+ * @param value The value
+ */
+template <typename T>
+void benchmarkDoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    // The address escapes and memory is clobbered, so the value must exist
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static const T* volatile sink;
+    sink = &value;
+#endif
+}
+
+bool benchmarkManagerSelected(
+    const BenchmarkManager& manager,
+    const std::string& group,
+    const std::string& name);
+bool benchmarkManagerSelectedAny(
+    const BenchmarkManager& manager,
+    const std::string& group,
+    const std::vector<std::string>& names);
+void benchmarkManagerAddResult(
+    BenchmarkManager* manager,
+    const std::string& group,
+    const std::string& name,
+    int size,
+    long long operations,
+    std::vector<double> samples);
+void benchmarkManagerWriteJson(
+    const BenchmarkManager& manager,
+    std::ostream& out);
+void benchmarkWriteJsonString(std::ostream& out, const std::string& text);
+
+/**
+ * @brief Times body over the manager's warmups and repetitions and records
+ * the result. Each call of body is one repetition, which calls
+ * benchmarkTimerStart and benchmarkTimerStop around the work to measure.
+ *
+ * @tparam Body Called as body(timer)
+ * @param manager The manager to record the result in
+ * @param group The data structure or kernel being measured
+ * @param name The operation being measured
+ * @param size The input size
+ * @param operations How many operations one repetition times, for ns/op
+ * @param body Runs one repetition
+ */
+template <typename Body>
+void benchmarkManagerMeasure(
+        BenchmarkManager* manager,
+        const std::string& group,
+        const std::string& name,
+        int size,
+        long long operations,
+        Body body) {
+    if (!benchmarkManagerSelected(*manager, group, name)) {return;}
+    for (int i = 0; i < manager->warmups; i++) {
+        BenchmarkTimer timer;
+        body(&timer);
+    }
+    std::vector<double> samples;
+    for (int i = 0; i < manager->repetitions; i++) {
+        BenchmarkTimer timer;
+        body(&timer);
+        samples.push_back(timer.elapsed_ns);
+    }
+    benchmarkManagerAddResult(
+        manager, group, name, size, operations, samples);
+}
+
+#endif  // BENCHMARKS_BENCH_UTILS_BENCHMARK_MANAGER_HPP_
@@ -0,0 +1,32 @@
+#ifndef BENCHMARK_GRAPHS_HPP
+#define BENCHMARK_GRAPHS_HPP
+
+#include <string>
+#include <data_structures/csr_graph.cpp>
+#include <io/graph_generator.cpp>
+
+/**
+ * @brief Builds a uniform random directed graph with weights from 1 to 100
+ *
+ * @param num_nodes The number of nodes
+ * @param num_edges The number of edges
+ * @return CsrGraph<int> The graph
+ */
+inline CsrGraph<int> benchmarkRandomGraph(int num_nodes, size_t num_edges) {
+    return graphGeneratorGenerateCsr(
+        graphGeneratorUniform(num_nodes, num_edges, 88172645463325252ULL));
+}
+
+/**
+ * @brief Loads the graph file for the graph benchmarks, or generates a
+ * random graph with 1M nodes and 8M edges if there isn't one
+ *
+ * @param filepath A graph file, or an empty string
+ * @return CsrGraph<int> The graph
+ */
+inline CsrGraph<int> benchmarkLoadGraph(std::string filepath) {
+    if (filepath.empty()) {return benchmarkRandomGraph(1 << 20, 8 << 20);}
+    return CsrGraph<int>(filepath, GRAPH_DIRECTED);
+}
+
+#endif
@@ -0,0 +1,120 @@
+#include "mpmc_queue_benchmarks.hpp"
+#include <mutex>
+#include <thread>
+#include <concurrency/mpmc_queue.cpp>
+#include <data_structures/dynamic_array.cpp>
+#include <data_structures/queue.cpp>
+
+// How many elements the batched workers push and pop at once
+const size_t MPMC_QUEUE_BENCHMARK_BATCH = 16;
+
+/**
+ * @brief Pushes then pops one element at a time behind a mutex
+ */
+void mpmcQueueBenchmarkLockedWorker(
+        Queue<int>* queue,
+        std::mutex* mutex,
+        int operations) {
+    for (int i = 0; i < operations; i++) {
+        {
+            std::lock_guard<std::mutex> lock(*mutex);
+            queuePush(*queue, i);
+        }
+        std::lock_guard<std::mutex> lock(*mutex);
+        queuePop(*queue);
+    }
+}
+
+/**
+ * @brief Pushes then pops one element at a time, retrying while the queue
+ * is full or another thread got there first
+ */
+void mpmcQueueBenchmarkWorker(MpmcQueue<int>* queue, int operations) {
+    int popped;
+    for (int i = 0; i < operations; i++) {
+        while (!mpmcQueueTryPush(*queue, i)) {std::this_thread::yield();}
+        while (!mpmcQueueTryPop(*queue, popped)) {std::this_thread::yield();}
+    }
+}
+
+/**
+ * @brief Pushes then pops a batch at a time, retrying the rest of a batch
+ * that didn't fit
+ */
+void mpmcQueueBenchmarkBatchWorker(MpmcQueue<int>* queue, int operations) {
+    int batch[MPMC_QUEUE_BENCHMARK_BATCH];
+    for (size_t i = 0; i < MPMC_QUEUE_BENCHMARK_BATCH; i++) {
+        batch[i] = static_cast<int>(i);
+    }
+    int batches = operations / static_cast<int>(MPMC_QUEUE_BENCHMARK_BATCH);
+    for (int i = 0; i < batches; i++) {
+        size_t done = 0;
+        while (done < MPMC_QUEUE_BENCHMARK_BATCH) {
+            size_t pushed = mpmcQueueTryPushN(*queue, batch + done,
+                MPMC_QUEUE_BENCHMARK_BATCH - done);
+            if (!pushed) {std::this_thread::yield();}
+            done += pushed;
+        }
+        done = 0;
+        while (done < MPMC_QUEUE_BENCHMARK_BATCH) {
+            size_t popped = mpmcQueueTryPopN(*queue, batch + done,
+                MPMC_QUEUE_BENCHMARK_BATCH - done);
+            if (!popped) {std::this_thread::yield();}
+            done += popped;
+        }
+    }
+}
+
+/**
+ * @brief Times starting the threads on a worker and waiting for them
+ *
+ * @param manager The manager to record the result in
+ * @param name What the workers are timing
+ * @param threads The number of threads
+ * @param operations The number of elements all threads push between them
+ * @param worker Runs one thread's share of the operations
+ */
+template <typename Worker>
+void mpmcQueueBenchmarkThreads(
+        BenchmarkManager* manager,
+        const char* name,
+        int threads,
+        int operations,
+        Worker worker) {
+    benchmarkManagerMeasure(manager, "shared queue", name, threads,
+            operations, [&](BenchmarkTimer* timer) {
+        benchmarkTimerStart(timer);
+        DynamicArray<std::thread> workers;
+        for (int i = 0; i < threads; i++) {
+            dynamicArrayEmplaceBack(workers, worker, operations / threads);
+        }
+        for (int i = 0; i < threads; i++) {workers[i].join();}
+        benchmarkTimerStop(timer);
+    });
+}
+
+void mpmcQueueBenchmarkRun(BenchmarkManager* manager) {
+    const int OPERATIONS = 1 << 21;
+    const int MAX_THREADS = 64;
+
+    for (int threads = 1; threads <= MAX_THREADS; threads *= 2) {
+        Queue<int> locked;
+        queueReserve(locked, threads);
+        std::mutex mutex;
+        mpmcQueueBenchmarkThreads(manager, "mutex queue", threads,
+            OPERATIONS, [&](int operations) {
+                mpmcQueueBenchmarkLockedWorker(&locked, &mutex, operations);
+            });
+
+        // Room for every thread's batch, so nobody waits on a full ring
+        MpmcQueue<int> queue(threads * MPMC_QUEUE_BENCHMARK_BATCH);
+        mpmcQueueBenchmarkThreads(manager, "mpmc queue", threads,
+            OPERATIONS, [&](int operations) {
+                mpmcQueueBenchmarkWorker(&queue, operations);
+            });
+        mpmcQueueBenchmarkThreads(manager, "mpmc queue batched", threads,
+            OPERATIONS, [&](int operations) {
+                mpmcQueueBenchmarkBatchWorker(&queue, operations);
+            });
+    }
+}
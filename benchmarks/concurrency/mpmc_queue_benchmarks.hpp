@@ -0,0 +1,16 @@
+#ifndef MPMC_QUEUE_BENCHMARKS_HPP
+#define MPMC_QUEUE_BENCHMARKS_HPP
+
+#include "bench_utils/benchmark_manager.hpp"
+
+/**
+ * @brief Times threads hammering one shared queue, from 1 to 64 threads,
+ * comparing a mutex around a Queue with the lock-free MpmcQueue, one
+ * element and a batch at a time. The size of each result is the number
+ * of threads.
+ *
+ * @param manager The manager to record the results in
+ */
+void mpmcQueueBenchmarkRun(BenchmarkManager* manager);
+
+#endif
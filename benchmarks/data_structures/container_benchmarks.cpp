@@ -0,0 +1,226 @@
+#include "container_benchmarks.hpp"
+#include <data_structures/binary_tree.cpp>
+#include <data_structures/double_linked_list.cpp>
+#include <data_structures/dynamic_array.cpp>
+#include <data_structures/linked_list.cpp>
+#include <data_structures/queue.cpp>
+#include <data_structures/stack.cpp>
+
+const int CONTAINER_BENCHMARK_SIZES[3] = {1000, 10000, 100000};
+// Lists search linearly, so they're only asked for this many keys. The
+// keys are spread over 0 to size - 1, so they land all over the list.
+const int CONTAINER_BENCHMARK_LIST_LOOKUPS = 100;
+
+/**
+ * @brief Makes the keys 0 to size - 1 in a random order
+ *
+ * @param size The number of keys
+ * @return DynamicArray<int> The shuffled keys
+ */
+DynamicArray<int> containerBenchmarkKeys(int size) {
+    DynamicArray<int> keys(size);
+    for (int i = 0; i < size; i++) {dynamicArrayPushBack(keys, i);}
+    unsigned long long state = 88172645463325252ULL;
+    for (int i = size - 1; i > 0; i--) {
+        // xorshift64
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        int j = static_cast<int>(state % (i + 1));
+        int temp = keys[i];
+        keys[i] = keys[j];
+        keys[j] = temp;
+    }
+    return keys;
+}
+
+void containerBenchmarkLinkedList(BenchmarkManager* manager, int size) {
+    DynamicArray<int> keys = containerBenchmarkKeys(size);
+    benchmarkManagerMeasure(manager, "linked list", "insert at head", size,
+            size, [&](BenchmarkTimer* timer) {
+        LinkedList<int>* list = nullptr;
+        benchmarkTimerStart(timer);
+        for (int i = 0; i < size; i++) {linkedListInsertAtHead(&list, keys[i]);}
+        benchmarkTimerStop(timer);
+        delete list;
+    });
+
+    LinkedList<int>* list = nullptr;
+    for (int i = 0; i < size; i++) {linkedListInsertAtHead(&list, keys[i]);}
+    benchmarkManagerMeasure(manager, "linked list", "lookup", size,
+            CONTAINER_BENCHMARK_LIST_LOOKUPS, [&](BenchmarkTimer* timer) {
+        benchmarkTimerStart(timer);
+        for (int i = 0; i < CONTAINER_BENCHMARK_LIST_LOOKUPS; i++) {
+            benchmarkDoNotOptimize(linkedListGetNthOccurrence(
+                list, i * (size / CONTAINER_BENCHMARK_LIST_LOOKUPS), 1));
+        }
+        benchmarkTimerStop(timer);
+    });
+    benchmarkManagerMeasure(manager, "linked list", "traversal", size, size,
+            [&](BenchmarkTimer* timer) {
+        benchmarkTimerStart(timer);
+        long long sum = 0;
+        for (LinkedList<int>* node = list; node; node = node->next) {
+            sum += node->data;
+        }
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(sum);
+    });
+    delete list;
+}
+
+void containerBenchmarkDoubleLinkedList(BenchmarkManager* manager, int size) {
+    DynamicArray<int> keys = containerBenchmarkKeys(size);
+    benchmarkManagerMeasure(manager, "double linked list", "insert at tail",
+            size, size, [&](BenchmarkTimer* timer) {
+        DoubleLinkedList<int>* head = nullptr;
+        benchmarkTimerStart(timer);
+        doubleLinkedListInsertAtTail(&head, keys[0]);
+        DoubleLinkedList<int>* tail = head;
+        for (int i = 1; i < size; i++) {
+            doubleLinkedListInsertAtTail(&tail, keys[i]);
+            tail = tail->next;
+        }
+        benchmarkTimerStop(timer);
+        delete head;
+    });
+
+    DoubleLinkedList<int>* head = nullptr;
+    doubleLinkedListInsertAtTail(&head, keys[0]);
+    DoubleLinkedList<int>* tail = head;
+    for (int i = 1; i < size; i++) {
+        doubleLinkedListInsertAtTail(&tail, keys[i]);
+        tail = tail->next;
+    }
+    benchmarkManagerMeasure(manager, "double linked list", "lookup", size,
+            CONTAINER_BENCHMARK_LIST_LOOKUPS, [&](BenchmarkTimer* timer) {
+        benchmarkTimerStart(timer);
+        for (int i = 0; i < CONTAINER_BENCHMARK_LIST_LOOKUPS; i++) {
+            benchmarkDoNotOptimize(doubleLinkedListGetForwardNthOccurrence(
+                &head, i * (size / CONTAINER_BENCHMARK_LIST_LOOKUPS), 1));
+        }
+        benchmarkTimerStop(timer);
+    });
+    benchmarkManagerMeasure(manager, "double linked list", "traversal", size,
+            size, [&](BenchmarkTimer* timer) {
+        benchmarkTimerStart(timer);
+        long long sum = 0;
+        for (DoubleLinkedList<int>* node = tail; node; node = node->prev) {
+            sum += node->data;
+        }
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(sum);
+    });
+    delete head;
+}
+
+void containerBenchmarkBinaryTree(BenchmarkManager* manager, int size) {
+    DynamicArray<int> keys = containerBenchmarkKeys(size);
+    benchmarkManagerMeasure(manager, "binary tree", "insert", size, size,
+            [&](BenchmarkTimer* timer) {
+        BinaryTree<int>* tree = nullptr;
+        benchmarkTimerStart(timer);
+        for (int i = 0; i < size; i++) {binaryTreeInsertNode(&tree, keys[i]);}
+        benchmarkTimerStop(timer);
+        delete tree;
+    });
+    benchmarkManagerMeasure(manager, "binary tree", "avl insert", size, size,
+            [&](BenchmarkTimer* timer) {
+        BinaryTree<int>* tree = nullptr;
+        benchmarkTimerStart(timer);
+        for (int i = 0; i < size; i++) {
+            binaryTreeAvlInsertNode(&tree, keys[i]);
+        }
+        benchmarkTimerStop(timer);
+        delete tree;
+    });
+
+    BinaryTree<int>* tree = nullptr;
+    for (int i = 0; i < size; i++) {binaryTreeAvlInsertNode(&tree, keys[i]);}
+    benchmarkManagerMeasure(manager, "binary tree", "lookup", size, size,
+            [&](BenchmarkTimer* timer) {
+        benchmarkTimerStart(timer);
+        for (int i = 0; i < size; i++) {
+            benchmarkDoNotOptimize(binaryTreeGetNode(tree, keys[i]));
+        }
+        benchmarkTimerStop(timer);
+    });
+    benchmarkManagerMeasure(manager, "binary tree", "inorder traversal", size,
+            size, [&](BenchmarkTimer* timer) {
+        benchmarkTimerStart(timer);
+        long long sum = 0;
+        for (BinaryTree<int>& node : binaryTreeInorder(tree)) {
+            sum += node.data;
+        }
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(sum);
+    });
+    delete tree;
+}
+
+void containerBenchmarkStack(BenchmarkManager* manager, int size) {
+    benchmarkManagerMeasure(manager, "stack", "push", size, size,
+            [&](BenchmarkTimer* timer) {
+        Stack<int> stack;
+        benchmarkTimerStart(timer);
+        for (int i = 0; i < size; i++) {stackPush(stack, i);}
+        benchmarkTimerStop(timer);
+    });
+    benchmarkManagerMeasure(manager, "stack", "pop", size, size,
+            [&](BenchmarkTimer* timer) {
+        Stack<int> stack;
+        for (int i = 0; i < size; i++) {stackPush(stack, i);}
+        benchmarkTimerStart(timer);
+        long long sum = 0;
+        while (!stackEmpty(stack)) {
+            sum += stackTop(stack);
+            stackPop(stack);
+        }
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(sum);
+    });
+}
+
+void containerBenchmarkQueue(BenchmarkManager* manager, int size) {
+    DynamicArray<int> keys = containerBenchmarkKeys(size);
+    benchmarkManagerMeasure(manager, "queue", "push", size, size,
+            [&](BenchmarkTimer* timer) {
+        Queue<int> queue;
+        benchmarkTimerStart(timer);
+        for (int i = 0; i < size; i++) {queuePush(queue, i);}
+        benchmarkTimerStop(timer);
+    });
+
+    Queue<int> queue;
+    for (int i = 0; i < size; i++) {queuePush(queue, i);}
+    benchmarkManagerMeasure(manager, "queue", "lookup", size, size,
+            [&](BenchmarkTimer* timer) {
+        benchmarkTimerStart(timer);
+        long long sum = 0;
+        for (int i = 0; i < size; i++) {sum += queueGet(queue, keys[i]);}
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(sum);
+    });
+    benchmarkManagerMeasure(manager, "queue", "pop", size, size,
+            [&](BenchmarkTimer* timer) {
+        Queue<int> copy(queue);
+        benchmarkTimerStart(timer);
+        long long sum = 0;
+        while (!queueEmpty(copy)) {
+            sum += queueFront(copy);
+            queuePop(copy);
+        }
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(sum);
+    });
+}
+
+void containerBenchmarkRun(BenchmarkManager* manager) {
+    for (int size : CONTAINER_BENCHMARK_SIZES) {
+        containerBenchmarkLinkedList(manager, size);
+        containerBenchmarkDoubleLinkedList(manager, size);
+        containerBenchmarkBinaryTree(manager, size);
+        containerBenchmarkStack(manager, size);
+        containerBenchmarkQueue(manager, size);
+    }
+}
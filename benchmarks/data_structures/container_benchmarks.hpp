@@ -0,0 +1,14 @@
+#ifndef CONTAINER_BENCHMARKS_HPP
+#define CONTAINER_BENCHMARKS_HPP
+
+#include "bench_utils/benchmark_manager.hpp"
+
+/**
+ * @brief Times inserts, lookups and traversals of LinkedList,
+ * DoubleLinkedList, BinaryTree, Stack and Queue across input sizes
+ *
+ * @param manager The manager to record the results in
+ */
+void containerBenchmarkRun(BenchmarkManager* manager);
+
+#endif
@@ -0,0 +1,83 @@
+#include "eytzinger_tree_benchmarks.hpp"
+#include <data_structures/eytzinger_tree.cpp>
+
+void eytzingerTreeBenchmarkRun(BenchmarkManager* manager) {
+    // Big enough that neither tree fits in cache
+    const int SIZE = 1 << 22;
+    const int LOOKUPS = 1 << 22;
+    if (!benchmarkManagerSelected(*manager, "binary tree", "random lookup")
+        && !benchmarkManagerSelectedAny(*manager, "eytzinger tree",
+            {"random lookup", "random lookup batched"})) {
+        return;
+    }
+
+    int* sorted = new int[SIZE];
+    for (int i = 0; i < SIZE; i++) {sorted[i] = 2 * i;}
+    BinaryTree<int>* tree = binaryTreeBuildFromSorted(sorted, SIZE);
+    delete[] sorted;
+
+    // Building from sorted data puts nodes in address order, so shuffle
+    // them the way a tree built over time would be
+    EytzingerTree<int> frozen(tree);
+    BinaryTree<int>* scattered = nullptr;
+    unsigned long long state = 88172645463325252ULL;
+    int* shuffled = new int[SIZE];
+    for (int i = 0; i < SIZE; i++) {shuffled[i] = frozen.keys[i + 1];}
+    for (int i = SIZE - 1; i > 0; i--) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        int j = static_cast<int>(state % (i + 1));
+        int temp = shuffled[i];
+        shuffled[i] = shuffled[j];
+        shuffled[j] = temp;
+    }
+    for (int i = 0; i < SIZE; i++) {
+        binaryTreeAvlInsertNode(&scattered, shuffled[i]);
+    }
+    delete tree;
+
+    int* keys = new int[LOOKUPS];
+    for (int i = 0; i < LOOKUPS; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        keys[i] = static_cast<int>(state % (2 * SIZE));
+    }
+    const int** results = new const int*[LOOKUPS];
+
+    benchmarkManagerMeasure(manager, "binary tree", "random lookup", SIZE,
+            LOOKUPS, [&](BenchmarkTimer* timer) {
+        benchmarkTimerStart(timer);
+        long long found = 0;
+        for (int i = 0; i < LOOKUPS; i++) {
+            found += binaryTreeGetNode(scattered, keys[i]) != nullptr;
+        }
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(found);
+    });
+    benchmarkManagerMeasure(manager, "eytzinger tree", "random lookup", SIZE,
+            LOOKUPS, [&](BenchmarkTimer* timer) {
+        benchmarkTimerStart(timer);
+        long long found = 0;
+        for (int i = 0; i < LOOKUPS; i++) {
+            found += eytzingerTreeGet(frozen, keys[i]) != nullptr;
+        }
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(found);
+    });
+    benchmarkManagerMeasure(manager, "eytzinger tree", "random lookup batched",
+            SIZE, LOOKUPS, [&](BenchmarkTimer* timer) {
+        benchmarkTimerStart(timer);
+        eytzingerTreeGetBatch(frozen, keys, LOOKUPS, results);
+        long long found = 0;
+        for (int i = 0; i < LOOKUPS; i++) {found += results[i] != nullptr;}
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(found);
+    });
+
+    delete[] shuffled;
+    delete[] keys;
+    delete[] results;
+    delete scattered;
+}
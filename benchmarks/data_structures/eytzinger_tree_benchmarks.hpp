@@ -0,0 +1,14 @@
+#ifndef EYTZINGER_TREE_BENCHMARKS_HPP
+#define EYTZINGER_TREE_BENCHMARKS_HPP
+
+#include "bench_utils/benchmark_manager.hpp"
+
+/**
+ * @brief Times random lookups in a BinaryTree against the same keys frozen
+ * into an EytzingerTree, one at a time and batched
+ *
+ * @param manager The manager to record the results in
+ */
+void eytzingerTreeBenchmarkRun(BenchmarkManager* manager);
+
+#endif
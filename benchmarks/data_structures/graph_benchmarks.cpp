@@ -0,0 +1,259 @@
+#include "graph_benchmarks.hpp"
+#include <cstdio>
+#include <fstream>
+#include <algorithms/breadth_first_search.cpp>
+#include <data_structures/csr_graph.cpp>
+#include <data_structures/dynamic_graph.cpp>
+#include <data_structures/graph.cpp>
+
+const int GRAPH_BENCHMARK_SIZES[3] = {1000, 10000, 100000};
+const int GRAPH_BENCHMARK_DEGREE = 8;
+
+/**
+ * @brief Makes GRAPH_BENCHMARK_DEGREE distinct random-looking edges out of
+ * every node
+ *
+ * @param num_nodes The number of nodes
+ * @return DynamicArray<Edge<int>> The edges, grouped by source node
+ */
+DynamicArray<Edge<int>> graphBenchmarkEdges(int num_nodes) {
+    DynamicArray<Edge<int>> edges(
+        static_cast<size_t>(num_nodes) * GRAPH_BENCHMARK_DEGREE);
+    unsigned long long state = 88172645463325252ULL;
+    for (int from = 0; from < num_nodes; from++) {
+        // xorshift64
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        // Strides below num_nodes / degree keep the targets distinct
+        int stride = static_cast<int>(
+            state % (num_nodes / GRAPH_BENCHMARK_DEGREE)) + 1;
+        for (int k = 1; k <= GRAPH_BENCHMARK_DEGREE; k++) {
+            int to = static_cast<int>(
+                (from + static_cast<long long>(k) * stride) % num_nodes);
+            dynamicArrayPushBack(edges, Edge<int>(from, to, k));
+        }
+    }
+    return edges;
+}
+
+/**
+ * @brief Makes a graph with every node and no edges
+ *
+ * @param graph The graph to add the nodes to
+ * @param num_nodes The number of nodes
+ */
+void graphBenchmarkAddNodes(Graph<int>& graph, int num_nodes) {
+    for (int i = 0; i < num_nodes; i++) {graphAddNode(graph, i);}
+}
+
+/**
+ * @brief Measures building a CSR graph with the given weight type and
+ * searching it breadth-first, which never reads the weights
+ *
+ * @tparam W The type of the graph's weights
+ * @param manager The manager to record the results in
+ * @param edges The graph's edges
+ * @param size The number of nodes
+ * @param weights The name of the weight type
+ */
+template <typename W>
+void graphBenchmarkCsr(
+        BenchmarkManager* manager,
+        const DynamicArray<Edge<int>>& edges,
+        int size,
+        std::string weights) {
+    long long num_edges = static_cast<long long>(edges.size);
+    benchmarkManagerMeasure(manager, "graph", "csr build " + weights, size,
+            num_edges, [&](BenchmarkTimer* timer) {
+        CsrGraph<int, W> graph;
+        benchmarkTimerStart(timer);
+        csrGraphAllocate(graph, size, edges.size);
+        for (int i = 0; i < size; i++) {graph.nodes[i] = i;}
+        csrGraphFillEdges(graph, edges);
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(graph.targets);
+    });
+
+    CsrGraph<int, W> graph;
+    csrGraphAllocate(graph, size, edges.size);
+    for (int i = 0; i < size; i++) {graph.nodes[i] = i;}
+    csrGraphFillEdges(graph, edges);
+    CsrGraph<int, W> transpose = csrGraphTranspose(graph);
+    benchmarkManagerMeasure(manager, "graph", "csr search " + weights, size,
+            num_edges, [&](BenchmarkTimer* timer) {
+        benchmarkTimerStart(timer);
+        BreadthFirstSearchResult search = breadthFirstSearch(
+            graph, transpose, 0);
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(search.distances[size - 1]);
+    });
+}
+
+/**
+ * @brief Measures building a DynamicGraph from one batch, deleting and
+ * reinserting an eighth of its edges in two batches, and reading every
+ * edge, against reading the same CsrGraph
+ *
+ * @param manager The manager to record the results in
+ * @param edges The graph's edges
+ * @param size The number of nodes
+ */
+void graphBenchmarkDynamic(
+        BenchmarkManager* manager,
+        const DynamicArray<Edge<int>>& edges,
+        int size) {
+    long long num_edges = static_cast<long long>(edges.size);
+    DynamicArray<DynamicGraphUpdate> inserts(edges.size);
+    DynamicArray<DynamicGraphUpdate> deletes, reinserts;
+    for (size_t i = 0; i < edges.size; i++) {
+        dynamicArrayPushBack(inserts,
+            DynamicGraphUpdate(DYNAMIC_GRAPH_INSERT, edges[i]));
+        if (i % 8) {continue;}
+        dynamicArrayPushBack(deletes,
+            DynamicGraphUpdate(DYNAMIC_GRAPH_DELETE, edges[i]));
+        dynamicArrayPushBack(reinserts,
+            DynamicGraphUpdate(DYNAMIC_GRAPH_INSERT, edges[i]));
+    }
+    dynamicGraphSortUpdates(inserts);
+    dynamicGraphSortUpdates(deletes);
+    dynamicGraphSortUpdates(reinserts);
+
+    benchmarkManagerMeasure(manager, "graph", "dynamic build", size,
+            num_edges, [&](BenchmarkTimer* timer) {
+        DynamicGraph<> graph(size);
+        benchmarkTimerStart(timer);
+        dynamicGraphApplyUpdates(graph, inserts);
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(graph.targets);
+    });
+
+    DynamicGraph<> graph(size);
+    dynamicGraphApplyUpdates(graph, inserts);
+    long long num_updates = static_cast<long long>(2 * deletes.size);
+    benchmarkManagerMeasure(manager, "graph", "dynamic update batch", size,
+            num_updates, [&](BenchmarkTimer* timer) {
+        benchmarkTimerStart(timer);
+        dynamicGraphApplyUpdates(graph, deletes);
+        dynamicGraphApplyUpdates(graph, reinserts);
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(graph.num_edges);
+    });
+
+    CsrGraph<int> csr = dynamicGraphToCsr(graph);
+    benchmarkManagerMeasure(manager, "graph", "dynamic traversal", size,
+            num_edges, [&](BenchmarkTimer* timer) {
+        benchmarkTimerStart(timer);
+        double sum = 0;
+        for (int node = 0; node < size; node++) {
+            CsrNeighbors<double> neighbors =
+                dynamicGraphGetNeighbors(graph, node);
+            for (size_t i = 0; i < neighbors.length; i++) {
+                sum += neighbors.weights[i];
+            }
+        }
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(sum);
+    });
+    benchmarkManagerMeasure(manager, "graph", "csr traversal", size,
+            num_edges, [&](BenchmarkTimer* timer) {
+        benchmarkTimerStart(timer);
+        double sum = 0;
+        for (int node = 0; node < size; node++) {
+            CsrNeighbors<double> neighbors = csrGraphGetNeighbors(csr, node);
+            for (size_t i = 0; i < neighbors.length; i++) {
+                sum += neighbors.weights[i];
+            }
+        }
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(sum);
+    });
+}
+
+void graphBenchmarkSize(BenchmarkManager* manager, int size) {
+    DynamicArray<Edge<int>> edges = graphBenchmarkEdges(size);
+    long long num_edges = static_cast<long long>(edges.size);
+
+    benchmarkManagerMeasure(manager, "graph", "insert node", size, size,
+            [&](BenchmarkTimer* timer) {
+        Graph<int> graph;
+        benchmarkTimerStart(timer);
+        graphBenchmarkAddNodes(graph, size);
+        benchmarkTimerStop(timer);
+    });
+    benchmarkManagerMeasure(manager, "graph", "insert edge", size, num_edges,
+            [&](BenchmarkTimer* timer) {
+        Graph<int> graph;
+        graphBenchmarkAddNodes(graph, size);
+        benchmarkTimerStart(timer);
+        for (size_t i = 0; i < edges.size; i++) {
+            graphAddEdge(graph, edges[i]);
+        }
+        benchmarkTimerStop(timer);
+    });
+    benchmarkManagerMeasure(manager, "graph", "insert edges batched", size,
+            num_edges, [&](BenchmarkTimer* timer) {
+        Graph<int> graph;
+        graphBenchmarkAddNodes(graph, size);
+        benchmarkTimerStart(timer);
+        graphAddEdges(graph, edges);
+        benchmarkTimerStop(timer);
+    });
+
+    Graph<int> graph;
+    graphBenchmarkAddNodes(graph, size);
+    graphAddEdges(graph, edges);
+    benchmarkManagerMeasure(manager, "graph", "edge lookup", size, num_edges,
+            [&](BenchmarkTimer* timer) {
+        benchmarkTimerStart(timer);
+        int found = 0;
+        for (size_t i = 0; i < edges.size; i++) {
+            found += graphHasEdge(graph, edges[i]);
+        }
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(found);
+    });
+    benchmarkManagerMeasure(manager, "graph", "traversal", size, num_edges,
+            [&](BenchmarkTimer* timer) {
+        benchmarkTimerStart(timer);
+        double sum = 0;
+        for (LinkedList<AdjacencyList<int>>* node = graph.adjacency_matrix;
+                node;
+                node = node->next) {
+            for (LinkedList<Edge<int>>* edge = node->data.edges;
+                    edge;
+                    edge = edge->next) {
+                sum += edge->data.weight;
+            }
+        }
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(sum);
+    });
+
+    graphBenchmarkCsr<double>(manager, edges, size, "double");
+    graphBenchmarkCsr<float>(manager, edges, size, "float");
+    graphBenchmarkCsr<void>(manager, edges, size, "unweighted");
+    graphBenchmarkDynamic(manager, edges, size);
+
+    std::string path = "graph_benchmark.txt";
+    {
+        std::ofstream file(path);
+        file << size - 1 << '\n';
+        for (size_t i = 0; i < edges.size; i++) {
+            file << edges[i].from << ' ' << edges[i].to << ' '
+                << edges[i].weight << '\n';
+        }
+    }
+    benchmarkManagerMeasure(manager, "graph", "load", size, num_edges,
+            [&](BenchmarkTimer* timer) {
+        benchmarkTimerStart(timer);
+        Graph<int> loaded(path, GRAPH_DIRECTED);
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(loaded.adjacency_matrix);
+    });
+    std::remove(path.c_str());
+}
+
+void graphBenchmarkRun(BenchmarkManager* manager) {
+    for (int size : GRAPH_BENCHMARK_SIZES) {graphBenchmarkSize(manager, size);}
+}
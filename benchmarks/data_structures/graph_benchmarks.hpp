@@ -0,0 +1,14 @@
+#ifndef GRAPH_BENCHMARKS_HPP
+#define GRAPH_BENCHMARKS_HPP
+
+#include "bench_utils/benchmark_manager.hpp"
+
+/**
+ * @brief Times building, loading, edge lookups and traversals of Graph
+ * across input sizes
+ *
+ * @param manager The manager to record the results in
+ */
+void graphBenchmarkRun(BenchmarkManager* manager);
+
+#endif
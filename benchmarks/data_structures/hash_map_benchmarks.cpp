@@ -0,0 +1,223 @@
+#include "hash_map_benchmarks.hpp"
+#include <unordered_map>
+#include <concurrency/concurrent_hash_map.cpp>
+#include <data_structures/dynamic_array.cpp>
+#include <data_structures/flat_hash_map.cpp>
+#include <data_structures/hash_map.cpp>
+
+const int HASH_MAP_BENCHMARK_SIZES[4] = {1000, 10000, 100000, 1000000};
+
+/**
+ * @brief Makes size distinct keys spread over the whole int range in a
+ * random order, so neither the order nor the values favor a layout
+ *
+ * @param size The number of keys
+ * @return DynamicArray<int> The keys
+ */
+DynamicArray<int> hashMapBenchmarkKeys(int size) {
+    DynamicArray<int> keys(size);
+    for (int i = 0; i < size; i++) {
+        // Multiplying by an odd constant is a bijection, so the keys stay
+        // distinct
+        unsigned int key = static_cast<unsigned int>(i) * 2654435761u;
+        dynamicArrayPushBack(keys, static_cast<int>(key));
+    }
+    unsigned long long state = 88172645463325252ULL;
+    for (int i = size - 1; i > 0; i--) {
+        // xorshift64
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        int j = static_cast<int>(state % (i + 1));
+        int temp = keys[i];
+        keys[i] = keys[j];
+        keys[j] = temp;
+    }
+    return keys;
+}
+
+void hashMapBenchmarkUnorderedMap(
+        BenchmarkManager* manager,
+        const DynamicArray<int>& keys,
+        const DynamicArray<int>& misses) {
+    int size = keys.size;
+    benchmarkManagerMeasure(manager, "unordered map", "insert", size, size,
+            [&](BenchmarkTimer* timer) {
+        std::unordered_map<int, int> map;
+        benchmarkTimerStart(timer);
+        for (int i = 0; i < size; i++) {map[keys[i]] = i;}
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(map.size());
+    });
+
+    std::unordered_map<int, int> map;
+    for (int i = 0; i < size; i++) {map[keys[i]] = i;}
+    benchmarkManagerMeasure(manager, "unordered map", "lookup hit", size, size,
+            [&](BenchmarkTimer* timer) {
+        benchmarkTimerStart(timer);
+        long long sum = 0;
+        for (int i = 0; i < size; i++) {sum += map.find(keys[i])->second;}
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(sum);
+    });
+    benchmarkManagerMeasure(manager, "unordered map", "lookup miss", size,
+            size, [&](BenchmarkTimer* timer) {
+        benchmarkTimerStart(timer);
+        int found = 0;
+        for (int i = 0; i < size; i++) {found += map.count(misses[i]);}
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(found);
+    });
+    benchmarkManagerMeasure(manager, "unordered map", "delete", size, size,
+            [&](BenchmarkTimer* timer) {
+        std::unordered_map<int, int> copy(map);
+        benchmarkTimerStart(timer);
+        for (int i = 0; i < size; i++) {copy.erase(keys[i]);}
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(copy.size());
+    });
+}
+
+void hashMapBenchmarkHashMap(
+        BenchmarkManager* manager,
+        const DynamicArray<int>& keys,
+        const DynamicArray<int>& misses) {
+    int size = keys.size;
+    benchmarkManagerMeasure(manager, "hash map", "insert", size, size,
+            [&](BenchmarkTimer* timer) {
+        HashMap<int, int> map;
+        benchmarkTimerStart(timer);
+        for (int i = 0; i < size; i++) {hashMapInsert(map, keys[i], i);}
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(map.size);
+    });
+
+    HashMap<int, int> map;
+    for (int i = 0; i < size; i++) {hashMapInsert(map, keys[i], i);}
+    benchmarkManagerMeasure(manager, "hash map", "lookup hit", size, size,
+            [&](BenchmarkTimer* timer) {
+        benchmarkTimerStart(timer);
+        long long sum = 0;
+        for (int i = 0; i < size; i++) {sum += *hashMapGet(map, keys[i]);}
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(sum);
+    });
+    benchmarkManagerMeasure(manager, "hash map", "lookup miss", size, size,
+            [&](BenchmarkTimer* timer) {
+        benchmarkTimerStart(timer);
+        int found = 0;
+        for (int i = 0; i < size; i++) {found += hashMapHas(map, misses[i]);}
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(found);
+    });
+    benchmarkManagerMeasure(manager, "hash map", "delete", size, size,
+            [&](BenchmarkTimer* timer) {
+        HashMap<int, int> copy(map);
+        benchmarkTimerStart(timer);
+        for (int i = 0; i < size; i++) {hashMapDelete(copy, keys[i]);}
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(copy.size);
+    });
+}
+
+void hashMapBenchmarkFlatHashMap(
+        BenchmarkManager* manager,
+        const DynamicArray<int>& keys,
+        const DynamicArray<int>& misses) {
+    int size = keys.size;
+    benchmarkManagerMeasure(manager, "flat hash map", "insert", size, size,
+            [&](BenchmarkTimer* timer) {
+        FlatHashMap<int, int> map;
+        benchmarkTimerStart(timer);
+        for (int i = 0; i < size; i++) {flatHashMapInsert(map, keys[i], i);}
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(map.size);
+    });
+
+    FlatHashMap<int, int> map;
+    for (int i = 0; i < size; i++) {flatHashMapInsert(map, keys[i], i);}
+    benchmarkManagerMeasure(manager, "flat hash map", "lookup hit", size, size,
+            [&](BenchmarkTimer* timer) {
+        benchmarkTimerStart(timer);
+        long long sum = 0;
+        for (int i = 0; i < size; i++) {sum += *flatHashMapGet(map, keys[i]);}
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(sum);
+    });
+    benchmarkManagerMeasure(manager, "flat hash map", "lookup miss", size,
+            size, [&](BenchmarkTimer* timer) {
+        benchmarkTimerStart(timer);
+        int found = 0;
+        for (int i = 0; i < size; i++) {
+            found += flatHashMapHas(map, misses[i]);
+        }
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(found);
+    });
+    benchmarkManagerMeasure(manager, "flat hash map", "delete", size, size,
+            [&](BenchmarkTimer* timer) {
+        FlatHashMap<int, int> copy(map);
+        benchmarkTimerStart(timer);
+        for (int i = 0; i < size; i++) {flatHashMapDelete(copy, keys[i]);}
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(copy.size);
+    });
+}
+
+/**
+ * @brief Times giving every key a dense id the way graph loading does,
+ * where each key shows up more than once: one at a time in a FlatHashMap,
+ * then in bulk in a ConcurrentHashMap on the default pool
+ *
+ * @param manager The manager to record the results in
+ * @param keys The distinct keys. Each one is looked up twice
+ */
+void hashMapBenchmarkAssignIds(
+        BenchmarkManager* manager,
+        const DynamicArray<int>& keys) {
+    int size = keys.size;
+    benchmarkManagerMeasure(manager, "flat hash map", "assign ids", size,
+            2 * size, [&](BenchmarkTimer* timer) {
+        FlatHashMap<int, int> map;
+        DynamicArray<int> ids(2 * size);
+        benchmarkTimerStart(timer);
+        for (int i = 0; i < 2 * size; i++) {
+            int* id = flatHashMapGet(map, keys[i % size]);
+            if (!id) {
+                flatHashMapInsert(map, keys[i % size],
+                    static_cast<int>(map.size));
+                id = flatHashMapGet(map, keys[i % size]);
+            }
+            dynamicArrayPushBack(ids, *id);
+        }
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(ids[size]);
+    });
+    benchmarkManagerMeasure(manager, "concurrent hash map", "assign ids",
+            size, 2 * size, [&](BenchmarkTimer* timer) {
+        ConcurrentHashMap<int, int> map;
+        DynamicArray<int> ids;
+        benchmarkTimerStart(timer);
+        concurrentHashMapAssignIds(map, 2 * size,
+            [&](size_t i) -> const int& {return keys[i % size];}, ids);
+        benchmarkTimerStop(timer);
+        benchmarkDoNotOptimize(ids[size]);
+    });
+}
+
+void hashMapBenchmarkRun(BenchmarkManager* manager) {
+    for (int size : HASH_MAP_BENCHMARK_SIZES) {
+        // Half the keys go in the maps and the other half are the misses,
+        // so the misses look just like the keys
+        DynamicArray<int> all = hashMapBenchmarkKeys(2 * size);
+        DynamicArray<int> keys(size), misses(size);
+        for (int i = 0; i < size; i++) {
+            dynamicArrayPushBack(keys, all[i]);
+            dynamicArrayPushBack(misses, all[size + i]);
+        }
+        hashMapBenchmarkUnorderedMap(manager, keys, misses);
+        hashMapBenchmarkHashMap(manager, keys, misses);
+        hashMapBenchmarkFlatHashMap(manager, keys, misses);
+        hashMapBenchmarkAssignIds(manager, keys);
+    }
+}
@@ -0,0 +1,15 @@
+#ifndef HASH_MAP_BENCHMARKS_HPP
+#define HASH_MAP_BENCHMARKS_HPP
+
+#include "bench_utils/benchmark_manager.hpp"
+
+/**
+ * @brief Times inserts, lookups that hit and miss, and deletes of
+ * std::unordered_map, HashMap and FlatHashMap across input sizes, and
+ * dense id assignment with FlatHashMap and ConcurrentHashMap
+ *
+ * @param manager The manager to record the results in
+ */
+void hashMapBenchmarkRun(BenchmarkManager* manager);
+
+#endif
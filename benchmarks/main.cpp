@@ -0,0 +1,63 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "bench_utils/benchmark_manager.hpp"
+#include "algorithms/dijkstra_benchmarks.hpp"
+#include "algorithms/delta_stepping_benchmarks.hpp"
+#include "data_structures/container_benchmarks.hpp"
+#include "data_structures/eytzinger_tree_benchmarks.hpp"
+#include "data_structures/graph_benchmarks.hpp"
+#include "data_structures/hash_map_benchmarks.hpp"
+#include "concurrency/mpmc_queue_benchmarks.hpp"
+
+/**
+ * @brief Runs every benchmark. Takes these arguments, in any order:
+ *
+ * --json <path>: also writes the results to path as JSON, to compare
+ * against another commit's run
+ * --repetitions <n>: how many timed repetitions each benchmark gets
+ * --filter <text>: only runs the benchmarks whose "group/name" contains
+ * text
+ * <path>: a graph file to run the algorithm benchmarks on instead of a
+ * generated graph
+ */
+int main(int argc, char** argv) {
+    BenchmarkManager manager;
+    std::string filepath = "";
+    std::string json_path = "";
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        bool has_value = i + 1 < argc;
+        if (argument == "--json" && has_value) {
+            json_path = argv[++i];
+        } else if (argument == "--repetitions" && has_value) {
+            manager.repetitions = std::atoi(argv[++i]);
+        } else if (argument == "--filter" && has_value) {
+            manager.filter = argv[++i];
+        } else {
+            filepath = argument;
+        }
+    }
+    if (manager.repetitions < 1) {
+        std::cerr << "--repetitions must be at least 1" << std::endl;
+        return 1;
+    }
+
+    containerBenchmarkRun(&manager);
+    hashMapBenchmarkRun(&manager);
+    graphBenchmarkRun(&manager);
+    eytzingerTreeBenchmarkRun(&manager);
+    dijkstraBenchmarkRun(&manager, filepath);
+    deltaSteppingBenchmarkRun(&manager, filepath);
+    mpmcQueueBenchmarkRun(&manager);
+    if (json_path != "") {
+        std::ofstream json(json_path);
+        if (!json) {
+            std::cerr << "Can't write to " << json_path << std::endl;
+            return 1;
+        }
+        benchmarkManagerWriteJson(manager, json);
+    }
+    return 0;
+}
@@ -11,4 +11,8 @@ REM Testbed
 make -f ".\build\Makefile.tests.mak" clean
 IF %ERRORLEVEL% NEQ 0 (echo ERROR: %ERRORLEVEL% %% exit)
 
+REM Benchmarks
+make -f ".\build\Makefile.benchmarks.mak" clean
+IF %ERRORLEVEL% NEQ 0 (echo ERROR: %ERRORLEVEL% %% exit)
+
 ECHO "All assemblies cleaned successfully."
\ No newline at end of file
@@ -0,0 +1,281 @@
+#ifndef BREADTH_FIRST_SEARCH_CPP
+#define BREADTH_FIRST_SEARCH_CPP
+
+#include <cstdint>
+#include <stdexcept>
+
+#include "../concurrency/thread_pool.cpp"
+#include "../data_structures/csr_graph.cpp"
+#include "../data_structures/dynamic_array.cpp"
+
+// Defaults from Beamer et al., "Direction-Optimizing Breadth-First Search"
+const int BREADTH_FIRST_SEARCH_ALPHA = 15;
+const int BREADTH_FIRST_SEARCH_BETA = 18;
+
+/**
+ * @brief The result of a breadth-first search. Both arrays are indexed by
+ * node index.
+ */
+struct BreadthFirstSearchResult {
+    // Fields
+
+    // Number of edges on the shortest path from the source, or -1
+    DynamicArray<int> distances;
+    // Node each node was reached from, or -1. The source is its own parent
+    DynamicArray<int> parents;
+    int top_down_steps;
+    int bottom_up_steps;
+
+    // Constructors
+    BreadthFirstSearchResult(): top_down_steps(0), bottom_up_steps(0) {}
+};
+
+/**
+ * @brief Checks whether a node is in a bitmap frontier
+ *
+ * @param bitmap The frontier, one bit per node
+ * @param node The index of the node
+ * @return true if the node's bit is set, otherwise false
+ */
+inline bool breadthFirstSearchTestBit(
+        const DynamicArray<uint64_t>& bitmap,
+        int node) {
+    return (bitmap[node >> 6] >> (node & 63)) & 1;
+}
+
+/**
+ * @brief Adds a node to a bitmap frontier
+ *
+ * @param bitmap The frontier, one bit per node
+ * @param node The index of the node
+ */
+inline void breadthFirstSearchSetBit(DynamicArray<uint64_t>& bitmap, int node) {
+    bitmap[node >> 6] |= uint64_t(1) << (node & 63);
+}
+
+/**
+ * @brief Expands the frontier by scanning every frontier node's outgoing
+ * edges. Cheap while the frontier is small.
+ *
+ * @tparam T The type of the graph's data
+ * @tparam W The type of the graph's weights, which are never read
+ * @param graph The graph to search
+ * @param frontier The nodes found in the last step
+ * @param next Where to put the nodes found in this step
+ * @param result The distances and parents found so far
+ * @param distance The distance of the nodes found in this step
+ * @return size_t The total out-degree of the nodes found
+ */
+template <typename T, typename W>
+size_t breadthFirstSearchTopDownStep(
+        const CsrGraph<T, W>& graph,
+        const DynamicArray<int>& frontier,
+        DynamicArray<int>& next,
+        BreadthFirstSearchResult& result,
+        int distance) {
+    size_t next_edges = 0;
+    for (size_t i = 0; i < frontier.size; i++) {
+        int from = frontier[i];
+        for (int to : csrGraphGetNeighbors(graph, from)) {
+            if (result.parents[to] != -1) {continue;}
+            result.parents[to] = from;
+            result.distances[to] = distance;
+            dynamicArrayPushBack(next, to);
+            next_edges += csrGraphGetDegree(graph, to);
+        }
+    }
+    return next_edges;
+}
+
+/**
+ * @brief One worker's tally of the nodes found in a bottom-up step
+ */
+struct BreadthFirstSearchCounts {
+    // Fields
+    size_t nodes;
+    size_t edges;
+
+    // Constructors
+    BreadthFirstSearchCounts(): nodes(0), edges(0) {}
+};
+
+/**
+ * @brief Expands the frontier by having every unvisited node look for a
+ * parent in the frontier, stopping at the first one. Cheap once the
+ * frontier is large, since most edges into the frontier are never checked.
+ *
+ * Every node is checked independently, so the nodes are split between the
+ * pool's workers in runs of 64, one bitmap word each, and no two workers
+ * write the same word.
+ *
+ * @tparam T The type of the graph's data
+ * @tparam W The type of the graph's weights, which are never read
+ * @param graph The graph to search
+ * @param transpose The graph's transpose, for incoming edges
+ * @param frontier The nodes found in the last step
+ * @param next Where to put the nodes found in this step. Must be cleared
+ * @param result The distances and parents found so far
+ * @param distance The distance of the nodes found in this step
+ * @param next_edges Where to store the total out-degree of the nodes found
+ * @param pool The pool to search on
+ * @return size_t The number of nodes found
+ */
+template <typename T, typename W>
+size_t breadthFirstSearchBottomUpStep(
+        const CsrGraph<T, W>& graph,
+        const CsrGraph<T, W>& transpose,
+        const DynamicArray<uint64_t>& frontier,
+        DynamicArray<uint64_t>& next,
+        BreadthFirstSearchResult& result,
+        int distance,
+        size_t* next_edges,
+        ThreadPool& pool) {
+    ThreadPoolScratch<BreadthFirstSearchCounts> counts(pool);
+    int words = static_cast<int>(next.size);
+    threadPoolParallelFor(pool, 0, words, [&](int begin, int end, int worker) {
+        BreadthFirstSearchCounts& found = threadPoolScratchGet(counts, worker);
+        int last = end * 64 < graph.num_nodes ? end * 64 : graph.num_nodes;
+        for (int to = begin * 64; to < last; to++) {
+            if (result.parents[to] != -1) {continue;}
+            for (int from : csrGraphGetNeighbors(transpose, to)) {
+                if (!breadthFirstSearchTestBit(frontier, from)) {continue;}
+                result.parents[to] = from;
+                result.distances[to] = distance;
+                breadthFirstSearchSetBit(next, to);
+                found.edges += csrGraphGetDegree(graph, to);
+                found.nodes++;
+                break;
+            }
+        }
+    });
+
+    size_t found = 0;
+    *next_edges = 0;
+    for (int i = 0; i < threadPoolGetNumWorkers(pool); i++) {
+        found += threadPoolScratchGet(counts, i).nodes;
+        *next_edges += threadPoolScratchGet(counts, i).edges;
+    }
+    return found;
+}
+
+/**
+ * @brief Direction-optimizing breadth-first search. Small frontiers are
+ * expanded top-down from a dense array of nodes. Once the frontier's
+ * edges outnumber the unexplored edges by a factor of alpha, it switches
+ * to bottom-up steps over a bitmap frontier. It switches back once the
+ * frontier shrinks below 1 / beta of the nodes.
+ *
+ * @tparam T The type of the graph's data
+ * @tparam W The type of the graph's weights, which are never read
+ * @param graph The graph to search
+ * @param transpose The graph's transpose. An undirected graph can be
+ * passed as its own transpose
+ * @param source The index of the node to start from
+ * @param alpha How eagerly to switch to bottom-up. 0 never switches
+ * @param beta How eagerly to switch back to top-down
+ * @param pool The pool to run bottom-up steps on
+ * @return BreadthFirstSearchResult The distances and parents of every node
+ */
+template <typename T, typename W>
+BreadthFirstSearchResult breadthFirstSearch(
+        const CsrGraph<T, W>& graph,
+        const CsrGraph<T, W>& transpose,
+        int source,
+        int alpha = BREADTH_FIRST_SEARCH_ALPHA,
+        int beta = BREADTH_FIRST_SEARCH_BETA,
+        ThreadPool& pool = threadPoolGetDefault()) {
+    if (source < 0 || source >= graph.num_nodes) {
+        throw std::logic_error("Can't search from a node not in the graph.");
+    }
+    if (transpose.num_nodes != graph.num_nodes
+        || transpose.num_edges != graph.num_edges) {
+        throw std::logic_error("Can't search with a mismatched transpose.");
+    }
+
+    BreadthFirstSearchResult result;
+    dynamicArrayResize(result.distances, graph.num_nodes);
+    dynamicArrayResize(result.parents, graph.num_nodes);
+    for (int i = 0; i < graph.num_nodes; i++) {
+        result.distances[i] = -1;
+        result.parents[i] = -1;
+    }
+    result.distances[source] = 0;
+    result.parents[source] = source;
+
+    size_t words = (static_cast<size_t>(graph.num_nodes) + 63) / 64;
+    DynamicArray<int> queue, next_queue;
+    DynamicArray<uint64_t> bitmap, next_bitmap;
+    dynamicArrayResize(bitmap, words);
+    dynamicArrayResize(next_bitmap, words);
+    dynamicArrayPushBack(queue, source);
+
+    // Edges out of the frontier versus edges out of unvisited nodes
+    size_t frontier_edges = csrGraphGetDegree(graph, source);
+    size_t unexplored_edges = graph.num_edges - frontier_edges;
+    size_t frontier_nodes = 1;
+    bool bottom_up = false;
+    for (int distance = 1; frontier_nodes; distance++) {
+        if (!bottom_up && frontier_edges * alpha > unexplored_edges) {
+            bottom_up = true;
+            for (size_t i = 0; i < words; i++) {bitmap[i] = 0;}
+            for (size_t i = 0; i < queue.size; i++) {
+                breadthFirstSearchSetBit(bitmap, queue[i]);
+            }
+        }
+
+        if (bottom_up) {
+            for (size_t i = 0; i < words; i++) {next_bitmap[i] = 0;}
+            size_t found = breadthFirstSearchBottomUpStep(graph, transpose,
+                bitmap, next_bitmap, result, distance, &frontier_edges, pool);
+            swap(bitmap, next_bitmap);
+            result.bottom_up_steps++;
+            unexplored_edges -= frontier_edges;
+
+            bool shrinking = found < frontier_nodes;
+            frontier_nodes = found;
+            size_t num_nodes = static_cast<size_t>(graph.num_nodes);
+            if (shrinking && frontier_nodes * beta < num_nodes) {
+                bottom_up = false;
+                dynamicArrayClear(queue);
+                for (int i = 0; i < graph.num_nodes; i++) {
+                    if (breadthFirstSearchTestBit(bitmap, i)) {
+                        dynamicArrayPushBack(queue, i);
+                    }
+                }
+            }
+        } else {
+            dynamicArrayClear(next_queue);
+            frontier_edges = breadthFirstSearchTopDownStep(
+                graph, queue, next_queue, result, distance);
+            swap(queue, next_queue);
+            result.top_down_steps++;
+
+            frontier_nodes = queue.size;
+            unexplored_edges -= frontier_edges;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Direction-optimizing breadth-first search that builds the
+ * graph's transpose first. Pass the transpose yourself when searching the
+ * same graph more than once.
+ *
+ * @tparam T The type of the graph's data
+ * @tparam W The type of the graph's weights, which are never read
+ * @param graph The graph to search
+ * @param source The index of the node to start from
+ * @param pool The pool to run bottom-up steps on
+ * @return BreadthFirstSearchResult The distances and parents of every node
+ */
+template <typename T, typename W>
+BreadthFirstSearchResult breadthFirstSearch(
+        const CsrGraph<T, W>& graph,
+        int source,
+        ThreadPool& pool = threadPoolGetDefault()) {
+    return breadthFirstSearch(graph, csrGraphTranspose(graph), source,
+        BREADTH_FIRST_SEARCH_ALPHA, BREADTH_FIRST_SEARCH_BETA, pool);
+}
+
+#endif
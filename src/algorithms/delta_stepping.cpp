@@ -0,0 +1,488 @@
+#ifndef DELTA_STEPPING_CPP
+#define DELTA_STEPPING_CPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#include "../concurrency/thread_pool.cpp"
+#include "../data_structures/csr_graph.cpp"
+#include "../data_structures/dynamic_array.cpp"
+#include "dijkstra.cpp"
+
+// Buckets further ahead than this wait in an overflow list
+const size_t DELTA_STEPPING_WINDOW = 1024;
+// Below this many nodes per part, extra parts only add overhead
+const int DELTA_STEPPING_MIN_NODES_PER_PART = 4096;
+const size_t DELTA_STEPPING_NONE = std::numeric_limits<size_t>::max();
+
+/**
+ * @brief A proposed new distance for a node, sent to the part that owns
+ * the node
+ */
+struct DeltaSteppingRequest {
+    // Fields
+    int node;
+    int parent;
+    double distance;
+
+    // Constructors
+    DeltaSteppingRequest(): node(0), parent(0), distance(0) {}
+    DeltaSteppingRequest(int node, int parent, double distance):
+        node(node), parent(parent), distance(distance) {}
+};
+
+/**
+ * @brief One part's buckets. Bucket b holds nodes whose tentative
+ * distance is in [b * delta, (b + 1) * delta). The next
+ * DELTA_STEPPING_WINDOW buckets are kept in a ring, and anything further
+ * ahead waits in an overflow list, so huge weights don't need huge arrays.
+ * Entries go stale when a node moves to a lower bucket; they're skipped.
+ */
+struct DeltaSteppingBuckets {
+    // Fields
+    DynamicArray<DynamicArray<int>> window;
+    DynamicArray<int> overflow;
+    size_t overflow_min;
+
+    // Constructors
+    DeltaSteppingBuckets(): overflow_min(DELTA_STEPPING_NONE) {
+        dynamicArrayResize(window, DELTA_STEPPING_WINDOW);
+    }
+};
+
+/**
+ * @brief Everything the delta-stepping parts share. The nodes are split
+ * into parts, with node owned by part node % num_parts, and only work on
+ * its owner touches its distance, parent and bucket, so the parts don't
+ * need locks or atomics. Other parts send the owner requests instead.
+ *
+ * Each step runs every part as a task on the thread pool, and the end of
+ * the step is the only synchronization between them.
+ *
+ * @tparam T The type of the graph's data
+ * @tparam W The type of the graph's weights
+ */
+template <typename T, typename W>
+struct DeltaSteppingState {
+    // Fields
+    const CsrGraph<T, W>& graph;
+    ShortestPathResult& result;
+    double delta;
+    int num_parts;
+    // Bucket each node is queued in, or DELTA_STEPPING_NONE
+    DynamicArray<size_t> queued;
+    DynamicArray<char> settled;
+    DynamicArray<DeltaSteppingBuckets> buckets;
+    // Each part's nodes being relaxed, and those settled in this bucket
+    DynamicArray<DynamicArray<int>> frontiers;
+    DynamicArray<DynamicArray<int>> newly_settled;
+    // Requests from part i to part j are at i * num_parts + j
+    DynamicArray<DynamicArray<DeltaSteppingRequest>> requests;
+    // Each part's answer to the last question asked of every part
+    DynamicArray<size_t> votes;
+
+    // Constructors
+    DeltaSteppingState(
+            const CsrGraph<T, W>& graph,
+            ShortestPathResult& result,
+            double delta,
+            int num_parts):
+            graph(graph), result(result), delta(delta),
+            num_parts(num_parts) {
+        dynamicArrayResize(queued, graph.num_nodes);
+        for (int i = 0; i < graph.num_nodes; i++) {
+            queued[i] = DELTA_STEPPING_NONE;
+        }
+        dynamicArrayResize(settled, graph.num_nodes);
+        dynamicArrayResize(buckets, num_parts);
+        dynamicArrayResize(frontiers, num_parts);
+        dynamicArrayResize(newly_settled, num_parts);
+        dynamicArrayResize(requests, num_parts * num_parts);
+        dynamicArrayResize(votes, num_parts);
+    }
+};
+
+/**
+ * @brief Picks delta from the weights as the largest weight divided by the
+ * average out-degree, the choice Meyer and Sanders analyze for random
+ * weights. Smaller deltas waste less work on nodes that aren't settled
+ * yet, and larger deltas give each step more parallel work.
+ *
+ * @tparam T The type of the graph's data
+ * @tparam W The type of the graph's weights
+ * @param graph The graph to search
+ * @return double The bucket width
+ */
+template <typename T, typename W>
+double deltaSteppingChooseDelta(const CsrGraph<T, W>& graph) {
+    double max_weight = 0;
+    double min_positive = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < graph.num_edges; i++) {
+        double weight = csrGraphGetWeight(graph.weights, i);
+        if (weight > max_weight) {max_weight = weight;}
+        if (weight > 0 && weight < min_positive) {min_positive = weight;}
+    }
+    if (max_weight == 0) {return 1;}
+
+    double average_degree = graph.num_nodes
+        ? static_cast<double>(graph.num_edges) / graph.num_nodes
+        : 1;
+    double delta = max_weight / (average_degree > 1 ? average_degree : 1);
+    return delta > min_positive ? delta : min_positive;
+}
+
+/**
+ * @brief Gets the bucket a distance falls in
+ *
+ * @param distance The distance
+ * @param delta The bucket width
+ * @return size_t The bucket number
+ */
+inline size_t deltaSteppingGetBucket(double distance, double delta) {
+    double bucket = distance / delta;
+    if (bucket >= static_cast<double>(DELTA_STEPPING_NONE / 2)) {
+        return DELTA_STEPPING_NONE / 2;
+    }
+    return static_cast<size_t>(bucket);
+}
+
+/**
+ * @brief Queues a node in one of its owner's buckets
+ *
+ * @param buckets The owner's buckets
+ * @param node The node
+ * @param bucket The bucket to queue the node in
+ * @param current The bucket being processed
+ */
+inline void deltaSteppingQueue(
+        DeltaSteppingBuckets& buckets,
+        int node,
+        size_t bucket,
+        size_t current) {
+    if (bucket < current + DELTA_STEPPING_WINDOW) {
+        dynamicArrayPushBack(
+            buckets.window[bucket % DELTA_STEPPING_WINDOW],
+            node);
+        return;
+    }
+    dynamicArrayPushBack(buckets.overflow, node);
+    if (bucket < buckets.overflow_min) {buckets.overflow_min = bucket;}
+}
+
+/**
+ * @brief Gets the first bucket at or after current that may have nodes.
+ * Overflow entries may be stale, so the answer can be an empty bucket.
+ *
+ * @param buckets The part's buckets
+ * @param current The bucket to start from
+ * @return size_t The bucket, or DELTA_STEPPING_NONE if there are none
+ */
+inline size_t deltaSteppingNextBucket(
+        const DeltaSteppingBuckets& buckets,
+        size_t current) {
+    for (size_t i = current; i < current + DELTA_STEPPING_WINDOW; i++) {
+        if (buckets.window[i % DELTA_STEPPING_WINDOW].size) {return i;}
+    }
+    return buckets.overflow_min;
+}
+
+/**
+ * @brief Moves overflow nodes that fit in the window once it starts at
+ * current, and drops stale ones
+ *
+ * @tparam T The type of the graph's data
+ * @tparam W The type of the graph's weights
+ * @param state The shared state
+ * @param buckets The part's buckets
+ * @param current The bucket about to be processed
+ */
+template <typename T, typename W>
+void deltaSteppingAdvance(
+        DeltaSteppingState<T, W>& state,
+        DeltaSteppingBuckets& buckets,
+        size_t current) {
+    if (buckets.overflow_min >= current + DELTA_STEPPING_WINDOW) {return;}
+    DynamicArray<int> remaining;
+    buckets.overflow_min = DELTA_STEPPING_NONE;
+    for (size_t i = 0; i < buckets.overflow.size; i++) {
+        int node = buckets.overflow[i];
+        size_t bucket = state.queued[node];
+        if (bucket == DELTA_STEPPING_NONE || bucket < current) {continue;}
+        if (bucket < current + DELTA_STEPPING_WINDOW) {
+            dynamicArrayPushBack(
+                buckets.window[bucket % DELTA_STEPPING_WINDOW],
+                node);
+            continue;
+        }
+        dynamicArrayPushBack(remaining, node);
+        if (bucket < buckets.overflow_min) {buckets.overflow_min = bucket;}
+    }
+    swap(buckets.overflow, remaining);
+}
+
+/**
+ * @brief Sends a request for every light or heavy edge out of the nodes
+ *
+ * @tparam T The type of the graph's data
+ * @tparam W The type of the graph's weights
+ * @param state The shared state
+ * @param part The sending part
+ * @param nodes The nodes to relax, all owned by the sending part
+ * @param heavy Whether to relax edges heavier than delta, or the others
+ */
+template <typename T, typename W>
+void deltaSteppingRelax(
+        DeltaSteppingState<T, W>& state,
+        int part,
+        const DynamicArray<int>& nodes,
+        bool heavy) {
+    for (size_t i = 0; i < nodes.size; i++) {
+        int from = nodes[i];
+        double distance = state.result.distances[from];
+        CsrNeighbors<W> neighbors = csrGraphGetNeighbors(state.graph, from);
+        for (size_t j = 0; j < neighbors.length; j++) {
+            double weight = csrGraphGetWeight(neighbors.weights, j);
+            if ((weight > state.delta) != heavy) {continue;}
+            int to = neighbors.targets[j];
+            dynamicArrayPushBack(
+                state.requests[part * state.num_parts
+                    + to % state.num_parts],
+                DeltaSteppingRequest(to, from, distance + weight));
+        }
+    }
+}
+
+/**
+ * @brief Applies every request sent to a part, queueing nodes whose
+ * distance improved
+ *
+ * @tparam T The type of the graph's data
+ * @tparam W The type of the graph's weights
+ * @param state The shared state
+ * @param part The receiving part
+ * @param current The bucket being processed
+ */
+template <typename T, typename W>
+void deltaSteppingApply(
+        DeltaSteppingState<T, W>& state,
+        int part,
+        size_t current) {
+    for (int sender = 0; sender < state.num_parts; sender++) {
+        DynamicArray<DeltaSteppingRequest>& requests =
+            state.requests[sender * state.num_parts + part];
+        for (size_t i = 0; i < requests.size; i++) {
+            DeltaSteppingRequest request = requests[i];
+            if (!(request.distance < state.result.distances[request.node])) {
+                continue;
+            }
+            state.result.distances[request.node] = request.distance;
+            state.result.parents[request.node] = request.parent;
+            // Rounding can't be allowed to reopen a finished bucket
+            size_t bucket =
+                deltaSteppingGetBucket(request.distance, state.delta);
+            if (bucket < current) {bucket = current;}
+            if (state.queued[request.node] != bucket) {
+                state.queued[request.node] = bucket;
+                deltaSteppingQueue(
+                    state.buckets[part],
+                    request.node,
+                    bucket,
+                    current);
+            }
+        }
+        dynamicArrayClear(requests);
+    }
+}
+
+/**
+ * @brief Asks every part a question in parallel and gets the smallest
+ * answer
+ *
+ * @tparam T The type of the graph's data
+ * @tparam W The type of the graph's weights
+ * @tparam Question Called as question(part), returning the part's answer
+ * @param state The shared state
+ * @param pool The pool to run the parts on
+ * @param question The question
+ * @return size_t The smallest answer
+ */
+template <typename T, typename W, typename Question>
+size_t deltaSteppingVote(
+        DeltaSteppingState<T, W>& state,
+        ThreadPool& pool,
+        Question question) {
+    threadPoolParallelFor(pool, 0, state.num_parts,
+        [&](int begin, int end, int) {
+            for (int part = begin; part < end; part++) {
+                state.votes[part] = question(part);
+            }
+        }, 1);
+    size_t smallest = DELTA_STEPPING_NONE;
+    for (int i = 0; i < state.num_parts; i++) {
+        if (state.votes[i] < smallest) {smallest = state.votes[i];}
+    }
+    return smallest;
+}
+
+/**
+ * @brief Runs a step on every part in parallel
+ *
+ * @tparam Step Called as step(part)
+ * @param num_parts The number of parts
+ * @param pool The pool to run the parts on
+ * @param step The step
+ */
+template <typename Step>
+void deltaSteppingEachPart(int num_parts, ThreadPool& pool, Step step) {
+    threadPoolParallelFor(pool, 0, num_parts, [&](int begin, int end, int) {
+        for (int part = begin; part < end; part++) {step(part);}
+    }, 1);
+}
+
+/**
+ * @brief Moves a part's live nodes out of the current bucket into its
+ * frontier, and remembers the ones settled for the first time
+ *
+ * @tparam T The type of the graph's data
+ * @tparam W The type of the graph's weights
+ * @param state The shared state
+ * @param part The part
+ * @param current The bucket being processed
+ */
+template <typename T, typename W>
+void deltaSteppingTakeBucket(
+        DeltaSteppingState<T, W>& state,
+        int part,
+        size_t current) {
+    DynamicArray<int>& bucket =
+        state.buckets[part].window[current % DELTA_STEPPING_WINDOW];
+    DynamicArray<int>& frontier = state.frontiers[part];
+    dynamicArrayClear(frontier);
+    for (size_t i = 0; i < bucket.size; i++) {
+        int node = bucket[i];
+        if (state.queued[node] != current) {continue;}
+        state.queued[node] = DELTA_STEPPING_NONE;
+        dynamicArrayPushBack(frontier, node);
+        if (!state.settled[node]) {
+            state.settled[node] = 1;
+            dynamicArrayPushBack(state.newly_settled[part], node);
+        }
+    }
+    dynamicArrayClear(bucket);
+}
+
+/**
+ * @brief Gets whether a part has anything left in the current bucket
+ *
+ * @tparam T The type of the graph's data
+ * @tparam W The type of the graph's weights
+ * @param state The shared state
+ * @param part The part
+ * @param current The bucket being processed
+ * @return size_t current if the bucket has nodes, else DELTA_STEPPING_NONE
+ */
+template <typename T, typename W>
+size_t deltaSteppingRemaining(
+        DeltaSteppingState<T, W>& state,
+        int part,
+        size_t current) {
+    return state.buckets[part].window[current % DELTA_STEPPING_WINDOW].size
+        ? current : DELTA_STEPPING_NONE;
+}
+
+/**
+ * @brief Parallel single-source shortest paths by delta-stepping. Nodes
+ * are grouped into buckets of width delta by tentative distance, and all
+ * the nodes in the lowest bucket are relaxed in parallel. Edges no heavier
+ * than delta may land back in the same bucket, so they're relaxed until
+ * it empties; heavier edges are relaxed once per bucket.
+ *
+ * Gives the same distances as dijkstra. Parents may differ where there
+ * are ties.
+ *
+ * The nodes are split into parts that step through the buckets together,
+ * each step running every part on the thread pool. Parts outnumbering the
+ * workers just queue up, so the answer doesn't depend on the pool.
+ *
+ * @tparam T The type of the graph's data
+ * @tparam W The type of the graph's weights
+ * @param graph The graph to search. Weights must be non-negative
+ * @param source The index of the node to start from
+ * @param delta The bucket width, or 0 to pick one from the weights
+ * @param num_parts The number of parts to split the nodes into, or 0 for
+ * one per worker in the pool, fewer on small graphs
+ * @param pool The pool to run on
+ * @return ShortestPathResult The distances and parents of every node
+ */
+template <typename T, typename W>
+ShortestPathResult deltaStepping(
+        const CsrGraph<T, W>& graph,
+        int source,
+        double delta = 0,
+        int num_parts = 0,
+        ThreadPool& pool = threadPoolGetDefault()) {
+    if (source < 0 || source >= graph.num_nodes) {
+        throw std::logic_error("Can't search from a node not in the graph.");
+    }
+    for (size_t i = 0; i < graph.num_edges; i++) {
+        if (csrGraphGetWeight(graph.weights, i) < 0) {
+            throw std::logic_error(
+                "Can't find shortest paths with negative weights.");
+        }
+    }
+    if (delta < 0) {throw std::logic_error("Can't use a negative delta.");}
+    if (delta == 0) {delta = deltaSteppingChooseDelta(graph);}
+
+    if (num_parts <= 0) {
+        num_parts = threadPoolGetNumWorkers(pool);
+        int max_parts = graph.num_nodes / DELTA_STEPPING_MIN_NODES_PER_PART;
+        if (num_parts > max_parts) {num_parts = max_parts;}
+    }
+    if (num_parts > graph.num_nodes) {num_parts = graph.num_nodes;}
+    if (num_parts < 1) {num_parts = 1;}
+
+    ShortestPathResult result;
+    shortestPathInitialize(result, graph.num_nodes, source);
+    DeltaSteppingState<T, W> state(graph, result, delta, num_parts);
+    state.queued[source] = 0;
+    deltaSteppingQueue(state.buckets[source % num_parts], source, 0, 0);
+
+    // For each bucket in order, light edges are relaxed until the bucket
+    // stays empty, then the heavy edges of every node settled in it are
+    // relaxed once. Requests are sent in one step and applied in the next
+    size_t current = 0;
+    while (true) {
+        current = deltaSteppingVote(state, pool, [&](int part) {
+            return deltaSteppingNextBucket(state.buckets[part], current);
+        });
+        if (current == DELTA_STEPPING_NONE) {break;}
+
+        size_t remaining = deltaSteppingVote(state, pool, [&](int part) {
+            deltaSteppingAdvance(state, state.buckets[part], current);
+            return deltaSteppingRemaining(state, part, current);
+        });
+        while (remaining != DELTA_STEPPING_NONE) {
+            deltaSteppingEachPart(num_parts, pool, [&](int part) {
+                deltaSteppingTakeBucket(state, part, current);
+                deltaSteppingRelax(state, part, state.frontiers[part], false);
+            });
+            remaining = deltaSteppingVote(state, pool, [&](int part) {
+                deltaSteppingApply(state, part, current);
+                return deltaSteppingRemaining(state, part, current);
+            });
+        }
+
+        deltaSteppingEachPart(num_parts, pool, [&](int part) {
+            deltaSteppingRelax(state, part, state.newly_settled[part], true);
+            dynamicArrayClear(state.newly_settled[part]);
+        });
+        deltaSteppingEachPart(num_parts, pool, [&](int part) {
+            deltaSteppingApply(state, part, current);
+        });
+    }
+    return result;
+}
+
+#endif
@@ -0,0 +1,176 @@
+#ifndef DIJKSTRA_CPP
+#define DIJKSTRA_CPP
+
+#include <limits>
+#include <stdexcept>
+
+#include "../data_structures/csr_graph.cpp"
+#include "../data_structures/dynamic_array.cpp"
+#include "../data_structures/graph.cpp"
+#include "../data_structures/linked_list.cpp"
+#include "../data_structures/pairing_heap.cpp"
+#include "../data_structures/priority_queue.cpp"
+#include "../data_structures/radix_heap.cpp"
+
+/**
+ * @brief The result of a single-source shortest path search. Both arrays
+ * are indexed by node index.
+ */
+struct ShortestPathResult {
+    // Fields
+
+    // Length of the shortest path from the source, or infinity
+    DynamicArray<double> distances;
+    // Node before each node on its shortest path, or -1. The source is its
+    // own parent
+    DynamicArray<int> parents;
+};
+
+/**
+ * @brief Sets up a result where only the source has been reached
+ *
+ * @param result The result to set up
+ * @param num_nodes The number of nodes in the graph
+ * @param source The index of the source node
+ */
+inline void shortestPathInitialize(
+        ShortestPathResult& result,
+        int num_nodes,
+        int source) {
+    dynamicArrayResize(result.distances, num_nodes);
+    dynamicArrayResize(result.parents, num_nodes);
+    for (int i = 0; i < num_nodes; i++) {
+        result.distances[i] = std::numeric_limits<double>::infinity();
+        result.parents[i] = -1;
+    }
+    result.distances[source] = 0;
+    result.parents[source] = source;
+}
+
+/**
+ * @brief Follows the parents back from a node to build its shortest path
+ *
+ * @param result The result of a shortest path search
+ * @param target The index of the node to find the path to
+ * @return DynamicArray<int> The node indices from the source to the target,
+ * or an empty array if the target wasn't reached
+ */
+inline DynamicArray<int> shortestPathGetPath(
+        const ShortestPathResult& result,
+        int target) {
+    DynamicArray<int> path;
+    if (result.parents[target] == -1) {return path;}
+    for (int node = target; ; node = result.parents[node]) {
+        dynamicArrayPushBack(path, node);
+        if (result.parents[node] == node) {break;}
+    }
+    for (size_t i = 0; i < path.size / 2; i++) {
+        int temp = path[i];
+        path[i] = path[path.size - 1 - i];
+        path[path.size - 1 - i] = temp;
+    }
+    return path;
+}
+
+/**
+ * @brief Dijkstra's single-source shortest paths. Instead of decreasing
+ * keys, a node is pushed again whenever its distance improves and stale
+ * entries are skipped when popped, so any priority queue with the
+ * priorityQueue API can be used.
+ *
+ * With a target, the search stops as soon as the target is settled. Only
+ * the target's distance and path are final then; other nodes may keep
+ * longer tentative distances.
+ *
+ * @tparam Queue The priority queue template: BinaryHeap, QuaternaryHeap,
+ * PairingHeap or RadixHeap
+ * @tparam T The type of the graph's data
+ * @tparam W The type of the graph's weights
+ * @param graph The graph to search. Weights must be non-negative
+ * @param source The index of the node to start from
+ * @param target The index of the node to stop at, or -1 to search them all
+ * @return ShortestPathResult The distances and parents of every node
+ */
+template <
+    template <typename> class Queue = BinaryHeap,
+    typename T,
+    typename W>
+ShortestPathResult dijkstra(
+        const CsrGraph<T, W>& graph,
+        int source,
+        int target = -1) {
+    if (source < 0 || source >= graph.num_nodes
+        || target < -1 || target >= graph.num_nodes) {
+        throw std::logic_error("Can't search from a node not in the graph.");
+    }
+
+    ShortestPathResult result;
+    shortestPathInitialize(result, graph.num_nodes, source);
+    Queue<int> queue;
+    priorityQueuePush(queue, 0.0, source);
+    while (!priorityQueueEmpty(queue)) {
+        PriorityQueueEntry<int> top = priorityQueueTop(queue);
+        priorityQueuePop(queue);
+        int from = top.value;
+        if (top.key > result.distances[from]) {continue;}
+        if (from == target) {break;}
+
+        CsrNeighbors<W> neighbors = csrGraphGetNeighbors(graph, from);
+        for (size_t i = 0; i < neighbors.length; i++) {
+            double weight = csrGraphGetWeight(neighbors.weights, i);
+            if (weight < 0) {
+                throw std::logic_error(
+                    "Can't find shortest paths with negative weights.");
+            }
+            int to = neighbors.targets[i];
+            double distance = top.key + weight;
+            if (distance < result.distances[to]) {
+                result.distances[to] = distance;
+                result.parents[to] = from;
+                priorityQueuePush(queue, distance, to);
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Finds the shortest path between two nodes of a Graph. The graph
+ * is frozen into a CsrGraph first, so prefer building the CsrGraph once
+ * when running many queries.
+ *
+ * @tparam Queue The priority queue template
+ * @tparam T The type of the graph's data
+ * @param graph The graph to search. Weights must be non-negative
+ * @param source The node to start from
+ * @param target The node to find a path to
+ * @param distance Where to store the length of the path, if not null.
+ * Infinity if there's no path
+ * @return LinkedList<T>* The nodes from source to target, or nullptr if
+ * there's no path
+ */
+template <template <typename> class Queue = BinaryHeap, typename T>
+LinkedList<T>* dijkstraGetPath(
+        const Graph<T>& graph,
+        T source,
+        T target,
+        double* distance = nullptr) {
+    CsrGraph<T> csr(graph);
+    int source_index = csrGraphGetIndex(csr, source);
+    int target_index = csrGraphGetIndex(csr, target);
+    if (source_index == -1 || target_index == -1) {
+        throw std::logic_error("Can't search from a node not in the graph.");
+    }
+
+    ShortestPathResult result =
+        dijkstra<Queue>(csr, source_index, target_index);
+    if (distance) {*distance = result.distances[target_index];}
+    DynamicArray<int> path = shortestPathGetPath(result, target_index);
+    LinkedList<T>* nodes = nullptr;
+    for (size_t i = path.size; i > 0; i--) {
+        linkedListInsertAtHead(&nodes, csr.nodes[path[i - 1]]);
+    }
+    return nodes;
+}
+
+#endif
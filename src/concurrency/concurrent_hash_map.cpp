@@ -0,0 +1,485 @@
+#ifndef CONCURRENT_HASH_MAP_CPP
+#define CONCURRENT_HASH_MAP_CPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include "../data_structures/dynamic_array.cpp"
+#include "../data_structures/flat_hash_map.cpp"
+#include "thread_pool.cpp"
+
+// Enough shards that threads rarely want the same one at once
+const int CONCURRENT_HASH_MAP_DEFAULT_SHARDS = 64;
+// Bulk id assignment hands out keys in blocks this big
+const size_t CONCURRENT_HASH_MAP_ID_BLOCK = 4096;
+
+/**
+ * @brief One shard of a ConcurrentHashMap: a lock and the part of the map
+ * it guards, padded so neighbouring shards' locks don't share a cache line
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the value
+ * @tparam Hash The hash functor for the key
+ * @tparam Equal The equality functor for the key
+ */
+template <typename K, typename V, typename Hash, typename Equal>
+struct ConcurrentHashMapShard {
+public:
+    // Fields
+    std::mutex mutex;
+    FlatHashMap<K, V, Hash, Equal> map;
+    char padding[64];
+};
+
+/**
+ * @brief Hash map that any number of threads can use at once. Keys are
+ * split over a power-of-two number of shards by the top bits of their
+ * hash, and each shard is a FlatHashMap behind its own lock, so threads
+ * working on different shards never wait on each other.
+ *
+ * Values are copied out rather than handed out by pointer, since another
+ * thread may grow the shard and move them at any time.
+ *
+ * The map can also give keys dense ids, for turning external vertex ids
+ * into array indices: see concurrentHashMapGetOrAssignId and
+ * concurrentHashMapAssignIds. The ids are only dense if the map is filled
+ * by those two functions alone.
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the value
+ * @tparam Hash The hash functor for the key
+ * @tparam Equal The equality functor for the key
+ */
+template <
+    typename K,
+    typename V,
+    typename Hash = std::hash<K>,
+    typename Equal = std::equal_to<K>>
+struct ConcurrentHashMap {
+public:
+    // Fields
+    ConcurrentHashMapShard<K, V, Hash, Equal>* shards;
+    int num_shards;
+    int shard_shift;
+    std::atomic<size_t> size;
+
+    // Constructors
+
+    /**
+     * @brief Constructs an empty map
+     *
+     * @param num_shards The number of shards, rounded up to a power of two
+     */
+    ConcurrentHashMap(int num_shards = CONCURRENT_HASH_MAP_DEFAULT_SHARDS):
+            shards(nullptr), num_shards(1), shard_shift(64), size(0) {
+        while (this->num_shards < num_shards) {
+            this->num_shards *= 2;
+            shard_shift--;
+        }
+        shards = new ConcurrentHashMapShard<K, V, Hash, Equal>[
+            this->num_shards];
+    }
+    ConcurrentHashMap(const ConcurrentHashMap<K, V, Hash, Equal>& other) =
+        delete;
+
+    // Destructor
+    ~ConcurrentHashMap() {delete[] shards;}
+
+    // Operators
+    ConcurrentHashMap<K, V, Hash, Equal>& operator = (
+        const ConcurrentHashMap<K, V, Hash, Equal>& rhs) = delete;
+};
+
+/**
+ * @brief Finds the shard that holds the key
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the value
+ * @tparam Hash The hash functor for the key
+ * @tparam Equal The equality functor for the key
+ * @tparam Key The type of the key to search for
+ * @param map The hash map
+ * @param key The key
+ * @return ConcurrentHashMapShard<K, V, Hash, Equal>& The key's shard
+ */
+template <
+    typename K,
+    typename V,
+    typename Hash,
+    typename Equal,
+    typename Key>
+ConcurrentHashMapShard<K, V, Hash, Equal>& concurrentHashMapGetShard(
+        ConcurrentHashMap<K, V, Hash, Equal>& map,
+        const Key& key) {
+    // The shards' own tables place keys by the low bits, so the top bits
+    // pick the shard without crowding any one table
+    if (map.num_shards == 1) {return map.shards[0];}
+    uint64_t hash = flatHashMapMix(Hash()(key));
+    return map.shards[hash >> map.shard_shift];
+}
+
+/**
+ * @brief Gets a copy of the value associated with the key
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the value
+ * @tparam Hash The hash functor for the key
+ * @tparam Equal The equality functor for the key
+ * @tparam Key The type of the key to search for
+ * @param map The hash map to search
+ * @param key The key to search for
+ * @param value Where to copy the value, if found
+ * @return true if the key was found, otherwise false
+ */
+template <
+    typename K,
+    typename V,
+    typename Hash,
+    typename Equal,
+    typename Key>
+bool concurrentHashMapGet(
+        ConcurrentHashMap<K, V, Hash, Equal>& map,
+        const Key& key,
+        V* value) {
+    ConcurrentHashMapShard<K, V, Hash, Equal>& shard =
+        concurrentHashMapGetShard(map, key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    V* found = flatHashMapGet(shard.map, key);
+    if (!found) {return false;}
+    *value = *found;
+    return true;
+}
+
+/**
+ * @brief Checks if the map has the given key
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the value
+ * @tparam Hash The hash functor for the key
+ * @tparam Equal The equality functor for the key
+ * @tparam Key The type of the key to search for
+ * @param map The hash map to search
+ * @param key The key to search for
+ * @return true if the key is found, otherwise false
+ */
+template <
+    typename K,
+    typename V,
+    typename Hash,
+    typename Equal,
+    typename Key>
+bool concurrentHashMapHas(
+        ConcurrentHashMap<K, V, Hash, Equal>& map,
+        const Key& key) {
+    ConcurrentHashMapShard<K, V, Hash, Equal>& shard =
+        concurrentHashMapGetShard(map, key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return flatHashMapHas(shard.map, key);
+}
+
+/**
+ * @brief Inserts a key-value pair into the map. If the key exists, its
+ * value is overwritten
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the value
+ * @tparam Hash The hash functor for the key
+ * @tparam Equal The equality functor for the key
+ * @param map The hash map to insert into
+ * @param key The key to insert
+ * @param value The value to associate with the key
+ */
+template <typename K, typename V, typename Hash, typename Equal>
+void concurrentHashMapInsert(
+        ConcurrentHashMap<K, V, Hash, Equal>& map,
+        K key,
+        V value) {
+    ConcurrentHashMapShard<K, V, Hash, Equal>& shard =
+        concurrentHashMapGetShard(map, key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    size_t before = shard.map.size;
+    flatHashMapInsert(shard.map, std::move(key), std::move(value));
+    if (shard.map.size != before) {map.size.fetch_add(1);}
+}
+
+/**
+ * @brief Inserts a key-value pair only if the key isn't in the map yet, as
+ * one step, so racing threads agree on which value won
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the value
+ * @tparam Hash The hash functor for the key
+ * @tparam Equal The equality functor for the key
+ * @param map The hash map to insert into
+ * @param key The key to insert
+ * @param value The value to associate with the key
+ * @param stored Where to copy the value the key ends up with, if not null
+ * @return true if the pair was inserted, false if the key already existed
+ */
+template <typename K, typename V, typename Hash, typename Equal>
+bool concurrentHashMapInsertIfAbsent(
+        ConcurrentHashMap<K, V, Hash, Equal>& map,
+        K key,
+        V value,
+        V* stored = nullptr) {
+    ConcurrentHashMapShard<K, V, Hash, Equal>& shard =
+        concurrentHashMapGetShard(map, key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    V* found = flatHashMapGet(shard.map, key);
+    if (found) {
+        if (stored) {*stored = *found;}
+        return false;
+    }
+    if (stored) {*stored = value;}
+    flatHashMapInsert(shard.map, std::move(key), std::move(value));
+    map.size.fetch_add(1);
+    return true;
+}
+
+/**
+ * @brief Removes the key from the map, if it exists
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the value
+ * @tparam Hash The hash functor for the key
+ * @tparam Equal The equality functor for the key
+ * @tparam Key The type of the key to delete
+ * @param map The hash map to delete from
+ * @param key The key to delete
+ */
+template <
+    typename K,
+    typename V,
+    typename Hash,
+    typename Equal,
+    typename Key>
+void concurrentHashMapDelete(
+        ConcurrentHashMap<K, V, Hash, Equal>& map,
+        const Key& key) {
+    ConcurrentHashMapShard<K, V, Hash, Equal>& shard =
+        concurrentHashMapGetShard(map, key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    size_t before = shard.map.size;
+    flatHashMapDelete(shard.map, key);
+    if (shard.map.size != before) {map.size.fetch_sub(1);}
+}
+
+/**
+ * @brief Calls visit(key, value) on every entry, one shard at a time with
+ * that shard locked. Entries other threads add or remove meanwhile may or
+ * may not be visited, and visit mustn't call back into the map.
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the value
+ * @tparam Hash The hash functor for the key
+ * @tparam Equal The equality functor for the key
+ * @tparam Visit Called as visit(const K& key, V& value)
+ * @param map The hash map to visit
+ * @param visit The function to call on each entry
+ */
+template <
+    typename K,
+    typename V,
+    typename Hash,
+    typename Equal,
+    typename Visit>
+void concurrentHashMapForEach(
+        ConcurrentHashMap<K, V, Hash, Equal>& map,
+        Visit visit) {
+    for (int i = 0; i < map.num_shards; i++) {
+        std::lock_guard<std::mutex> lock(map.shards[i].mutex);
+        flatHashMapForEach(map.shards[i].map, visit);
+    }
+}
+
+/**
+ * @brief Gets the key's id, giving it the next unused one if it doesn't
+ * have one yet. Safe to call from many threads at once, in which case the
+ * ids stay dense but which key gets which depends on the timing.
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the id. Must be an integer type
+ * @tparam Hash The hash functor for the key
+ * @tparam Equal The equality functor for the key
+ * @param map The map from keys to ids
+ * @param key The key
+ * @return V The key's id
+ */
+template <typename K, typename V, typename Hash, typename Equal>
+V concurrentHashMapGetOrAssignId(
+        ConcurrentHashMap<K, V, Hash, Equal>& map,
+        const K& key) {
+    ConcurrentHashMapShard<K, V, Hash, Equal>& shard =
+        concurrentHashMapGetShard(map, key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    V* found = flatHashMapGet(shard.map, key);
+    if (found) {return *found;}
+    size_t id = map.size.fetch_add(1);
+    if (id > static_cast<size_t>(std::numeric_limits<V>::max())) {
+        map.size.fetch_sub(1);
+        throw std::logic_error("Can't assign more ids than the id type holds.");
+    }
+    flatHashMapInsert(shard.map, key, static_cast<V>(id));
+    return static_cast<V>(id);
+}
+
+/**
+ * @brief Gets the ids of a batch of keys, in parallel, giving new keys the
+ * next unused ids in the order they first appear in the batch. Keys that
+ * already have ids keep them. The result is the same as calling
+ * concurrentHashMapGetOrAssignId on each key in turn, whatever the number
+ * of threads.
+ *
+ * Runs in passes over blocks of keys: every new key first claims the
+ * position it first appears at, then a prefix sum over the claimed
+ * positions turns them into dense ids. Other threads mustn't use the map
+ * while this runs, since it holds claimed positions in between. The passes
+ * split the work by block, so the number of keys can pass what an int
+ * holds as long as the number of blocks doesn't.
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the id. Must be an integer type
+ * @tparam Hash The hash functor for the key
+ * @tparam Equal The equality functor for the key
+ * @tparam GetKey Called as get_key(i) for i in [0, num_keys), and returns
+ * the ith key. Called from many threads at once
+ * @param map The map from keys to ids
+ * @param num_keys The number of keys in the batch
+ * @param get_key Gets a key of the batch
+ * @param ids Where to store the ids. Resized to num_keys
+ * @param pool The pool to run on
+ */
+template <
+    typename K,
+    typename V,
+    typename Hash,
+    typename Equal,
+    typename GetKey>
+void concurrentHashMapAssignIds(
+        ConcurrentHashMap<K, V, Hash, Equal>& map,
+        size_t num_keys,
+        GetKey get_key,
+        DynamicArray<V>& ids,
+        ThreadPool& pool = threadPoolGetDefault()) {
+    size_t base = map.size.load();
+    if (num_keys > static_cast<size_t>(std::numeric_limits<V>::max()) - base) {
+        throw std::logic_error("Can't assign more ids than the id type holds.");
+    }
+    size_t num_blocks = (num_keys + CONCURRENT_HASH_MAP_ID_BLOCK - 1)
+        / CONCURRENT_HASH_MAP_ID_BLOCK;
+    if (num_blocks > static_cast<size_t>(std::numeric_limits<int>::max())) {
+        throw std::logic_error("Can't split that many keys into blocks.");
+    }
+    dynamicArrayResize(ids, num_keys);
+    // Nothing else touches the map meanwhile, so only the pass that
+    // inserts in parallel has to lock
+    if (num_blocks <= 1 || threadPoolGetNumWorkers(pool) == 1) {
+        size_t next = base;
+        for (size_t i = 0; i < num_keys; i++) {
+            const K& key = get_key(i);
+            FlatHashMap<K, V, Hash, Equal>& shard =
+                concurrentHashMapGetShard(map, key).map;
+            V* found = flatHashMapGet(shard, key);
+            if (found) {
+                ids[i] = *found;
+            } else {
+                ids[i] = static_cast<V>(next++);
+                flatHashMapInsert(shard, key, ids[i]);
+            }
+        }
+        map.size.store(next);
+        return;
+    }
+
+    // Each new key claims base + the first position it appears at. Ids
+    // below base are ids that were assigned before, so they're kept
+    threadPoolParallelFor(pool, 0, static_cast<int>(num_blocks),
+            [&](int begin, int end, int) {
+        for (int block = begin; block < end; block++) {
+            size_t first = block * CONCURRENT_HASH_MAP_ID_BLOCK;
+            size_t last = first + CONCURRENT_HASH_MAP_ID_BLOCK;
+            if (last > num_keys) {last = num_keys;}
+            for (size_t i = first; i < last; i++) {
+                const K& key = get_key(i);
+                V position = static_cast<V>(base + i);
+                ConcurrentHashMapShard<K, V, Hash, Equal>& shard =
+                    concurrentHashMapGetShard(map, key);
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                V* found = flatHashMapGet(shard.map, key);
+                if (!found) {
+                    flatHashMapInsert(shard.map, key, position);
+                } else if (static_cast<size_t>(*found) >= base
+                        && position < *found) {
+                    *found = position;
+                }
+            }
+        }
+    }, 1);
+
+    // Read back every key's claim, and count the keys that appear first in
+    // each block. ids holds the claims until the last pass. Nothing
+    // inserts from here on, so reads don't need the locks
+    DynamicArray<size_t> block_starts;
+    dynamicArrayResize(block_starts, num_blocks + 1);
+    threadPoolParallelFor(pool, 0, static_cast<int>(num_blocks),
+            [&](int begin, int end, int) {
+        for (int block = begin; block < end; block++) {
+            size_t first = block * CONCURRENT_HASH_MAP_ID_BLOCK;
+            size_t last = first + CONCURRENT_HASH_MAP_ID_BLOCK;
+            if (last > num_keys) {last = num_keys;}
+            size_t count = 0;
+            for (size_t i = first; i < last; i++) {
+                const K& key = get_key(i);
+                ids[i] = *flatHashMapGet(
+                    concurrentHashMapGetShard(map, key).map, key);
+                count += static_cast<size_t>(ids[i]) == base + i;
+            }
+            block_starts[block + 1] = count;
+        }
+    }, 1);
+    for (size_t block = 0; block < num_blocks; block++) {
+        block_starts[block + 1] += block_starts[block];
+    }
+
+    // Number the first appearances in order, and swap claims for ids.
+    // Each key is written by one thread, in place, so this needs no locks
+    DynamicArray<V> ranks;
+    dynamicArrayResize(ranks, num_keys);
+    threadPoolParallelFor(pool, 0, static_cast<int>(num_blocks),
+            [&](int begin, int end, int) {
+        for (int block = begin; block < end; block++) {
+            size_t first = block * CONCURRENT_HASH_MAP_ID_BLOCK;
+            size_t last = first + CONCURRENT_HASH_MAP_ID_BLOCK;
+            if (last > num_keys) {last = num_keys;}
+            size_t next = base + block_starts[block];
+            for (size_t i = first; i < last; i++) {
+                if (static_cast<size_t>(ids[i]) != base + i) {continue;}
+                ranks[i] = static_cast<V>(next++);
+                const K& key = get_key(i);
+                *flatHashMapGet(concurrentHashMapGetShard(map, key).map, key) =
+                    ranks[i];
+            }
+        }
+    }, 1);
+    threadPoolParallelFor(pool, 0, static_cast<int>(num_blocks),
+            [&](int begin, int end, int) {
+        for (int block = begin; block < end; block++) {
+            size_t first = block * CONCURRENT_HASH_MAP_ID_BLOCK;
+            size_t last = first + CONCURRENT_HASH_MAP_ID_BLOCK;
+            if (last > num_keys) {last = num_keys;}
+            for (size_t i = first; i < last; i++) {
+                size_t claim = static_cast<size_t>(ids[i]);
+                if (claim >= base) {ids[i] = ranks[claim - base];}
+            }
+        }
+    }, 1);
+    map.size.fetch_add(block_starts[num_blocks]);
+}
+
+#endif
@@ -0,0 +1,239 @@
+#ifndef MPMC_QUEUE_CPP
+#define MPMC_QUEUE_CPP
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+// Keeps the producer and consumer positions on separate cache lines
+const size_t MPMC_QUEUE_CACHE_LINE = 64;
+
+/**
+ * @brief One slot of an MpmcQueue. The sequence number says whose turn it
+ * is: a producer may fill the cell when it equals the position being
+ * pushed, and a consumer may empty it when it equals that position plus
+ * one.
+ *
+ * @tparam T The type of the queue's data
+ */
+template <typename T>
+struct MpmcQueueCell {
+    // Fields
+    std::atomic<size_t> sequence;
+    T data;
+};
+
+/**
+ * @brief Bounded lock-free queue for any number of producer and consumer
+ * threads, after Dmitry Vyukov's design. The cells form a ring with a
+ * power-of-two capacity. A thread claims a position with one compare and
+ * swap on the shared counter, then hands the cell over through its
+ * sequence number, so threads working on different cells never wait on
+ * each other.
+ *
+ * Pushes fail instead of blocking when the queue is full, and pops fail
+ * when it's empty.
+ *
+ * @tparam T The type of the queue's data. Must be default constructible and
+ * move assignable
+ */
+template <typename T>
+struct MpmcQueue {
+public:
+    // Fields
+    MpmcQueueCell<T>* cells;
+    size_t mask;
+    char padding_before[MPMC_QUEUE_CACHE_LINE];
+    std::atomic<size_t> enqueue_position;
+    char padding_between[MPMC_QUEUE_CACHE_LINE];
+    std::atomic<size_t> dequeue_position;
+    char padding_after[MPMC_QUEUE_CACHE_LINE];
+
+    // Constructors
+
+    /**
+     * @brief Creates an empty queue
+     *
+     * @param capacity The most elements the queue can hold, rounded up to a
+     * power of two
+     */
+    MpmcQueue(size_t capacity): cells(nullptr), mask(0),
+            enqueue_position(0), dequeue_position(0) {
+        if (!capacity) {
+            throw std::logic_error("Can't make a queue with no capacity.");
+        }
+        size_t size = 1;
+        while (size < capacity) {size *= 2;}
+        cells = new MpmcQueueCell<T>[size];
+        for (size_t i = 0; i < size; i++) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        mask = size - 1;
+    }
+    MpmcQueue(const MpmcQueue<T>& other) = delete;
+
+    // Destructor
+    ~MpmcQueue() {delete[] cells;}
+
+    // Operators
+    MpmcQueue<T>& operator = (const MpmcQueue<T>& rhs) = delete;
+};
+
+/**
+ * @brief Gets how many elements the queue can hold
+ *
+ * @tparam T The type of the queue's data
+ * @param queue The queue
+ * @return size_t The capacity
+ */
+template <typename T>
+size_t mpmcQueueGetCapacity(const MpmcQueue<T>& queue) {
+    return queue.mask + 1;
+}
+
+/**
+ * @brief Claims up to count consecutive positions from one of the queue's
+ * counters. A cell is ready when its sequence number equals its position
+ * plus offset: 0 for producers, which need empty cells, and 1 for
+ * consumers, which need full ones. Stops at the first cell that isn't
+ * ready, so only cells this thread owns are returned.
+ *
+ * @tparam T The type of the queue's data
+ * @param queue The queue
+ * @param position The counter to claim from
+ * @param offset 0 to claim empty cells or 1 to claim full ones
+ * @param count The most positions to claim
+ * @param first Set to the first claimed position
+ * @return size_t The number of positions claimed, or 0 if the first cell
+ * isn't ready
+ */
+template <typename T>
+size_t mpmcQueueClaim(
+        MpmcQueue<T>& queue,
+        std::atomic<size_t>& position,
+        size_t offset,
+        size_t count,
+        size_t& first) {
+    size_t start = position.load(std::memory_order_relaxed);
+    while (true) {
+        size_t ready = 0;
+        while (ready < count) {
+            size_t sequence = queue.cells[(start + ready) & queue.mask]
+                .sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(
+                sequence - (start + ready + offset));
+            if (difference == 0) {
+                ready++;
+            } else if (ready == 0 && difference > 0) {
+                // Another thread already claimed it, so catch up
+                ready = count + 1;
+            } else {
+                break;
+            }
+        }
+        if (ready > count) {
+            start = position.load(std::memory_order_relaxed);
+            continue;
+        }
+        if (!ready) {return 0;}
+        if (position.compare_exchange_weak(start, start + ready,
+                std::memory_order_relaxed)) {
+            first = start;
+            return ready;
+        }
+    }
+}
+
+/**
+ * @brief Pushes data onto the queue unless it's full
+ *
+ * @tparam T The type of the queue's data
+ * @param queue The queue to push to
+ * @param data The data to push, which is moved in
+ * @return true if the data was pushed, false if the queue was full
+ */
+template <typename T>
+bool mpmcQueueTryPush(MpmcQueue<T>& queue, T data) {
+    size_t position;
+    if (!mpmcQueueClaim(queue, queue.enqueue_position, 0, 1, position)) {
+        return false;
+    }
+    MpmcQueueCell<T>& cell = queue.cells[position & queue.mask];
+    cell.data = std::move(data);
+    cell.sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Pops the front of the queue unless it's empty
+ *
+ * @tparam T The type of the queue's data
+ * @param queue The queue to pop from
+ * @param data Set to the popped element
+ * @return true if an element was popped, false if the queue was empty
+ */
+template <typename T>
+bool mpmcQueueTryPop(MpmcQueue<T>& queue, T& data) {
+    size_t position;
+    if (!mpmcQueueClaim(queue, queue.dequeue_position, 1, 1, position)) {
+        return false;
+    }
+    MpmcQueueCell<T>& cell = queue.cells[position & queue.mask];
+    data = std::move(cell.data);
+    cell.sequence.store(position + queue.mask + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Pushes as many of the elements as fit, claiming all their cells
+ * with a single compare and swap. The pushed elements stay in order and
+ * next to each other in the queue.
+ *
+ * @tparam T The type of the queue's data
+ * @param queue The queue to push to
+ * @param data The elements to push
+ * @param count The number of elements
+ * @return size_t How many elements from the front of data were pushed
+ */
+template <typename T>
+size_t mpmcQueueTryPushN(MpmcQueue<T>& queue, const T* data, size_t count) {
+    if (!count) {return 0;}
+    size_t first;
+    size_t claimed = mpmcQueueClaim(
+        queue, queue.enqueue_position, 0, count, first);
+    for (size_t i = 0; i < claimed; i++) {
+        MpmcQueueCell<T>& cell = queue.cells[(first + i) & queue.mask];
+        cell.data = data[i];
+        cell.sequence.store(first + i + 1, std::memory_order_release);
+    }
+    return claimed;
+}
+
+/**
+ * @brief Pops up to count elements from the front of the queue, claiming
+ * all their cells with a single compare and swap
+ *
+ * @tparam T The type of the queue's data
+ * @param queue The queue to pop from
+ * @param data Filled with the popped elements, in order
+ * @param count The most elements to pop
+ * @return size_t The number of elements popped
+ */
+template <typename T>
+size_t mpmcQueueTryPopN(MpmcQueue<T>& queue, T* data, size_t count) {
+    if (!count) {return 0;}
+    size_t first;
+    size_t claimed = mpmcQueueClaim(
+        queue, queue.dequeue_position, 1, count, first);
+    for (size_t i = 0; i < claimed; i++) {
+        MpmcQueueCell<T>& cell = queue.cells[(first + i) & queue.mask];
+        data[i] = std::move(cell.data);
+        cell.sequence.store(
+            first + i + queue.mask + 1,
+            std::memory_order_release);
+    }
+    return claimed;
+}
+
+#endif
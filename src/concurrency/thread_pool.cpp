@@ -0,0 +1,652 @@
+#ifndef THREAD_POOL_CPP
+#define THREAD_POOL_CPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "../data_structures/dynamic_array.cpp"
+#include "mpmc_queue.cpp"
+#include "work_stealing_deque.cpp"
+
+// How many times an idle worker looks for work before going to sleep
+const int THREAD_POOL_SPIN_ROUNDS = 64;
+// Tasks handed in from outside the pool wait in a queue this big
+const size_t THREAD_POOL_INJECTED_CAPACITY = 1024;
+// The automatic grain splits a range into this many pieces per worker
+const int THREAD_POOL_PIECES_PER_WORKER = 8;
+
+struct ThreadPool;
+inline void threadPoolWork(ThreadPool* pool, int worker);
+
+/**
+ * @brief A unit of work. Derived tasks set execute, which runs the task on
+ * the given worker and then frees it.
+ */
+struct ThreadPoolTask {
+public:
+    // Fields
+    void (*execute)(ThreadPoolTask* task, int worker);
+
+    // Constructors
+    ThreadPoolTask(void (*execute)(ThreadPoolTask*, int)): execute(execute) {}
+};
+
+/**
+ * @brief Tracks a set of forked tasks so they can be joined. Keeps the
+ * first exception any of them throws, which the join rethrows.
+ */
+struct ThreadPoolGroup {
+public:
+    // Fields
+    std::atomic<int> pending;
+    std::atomic<bool> failed;
+    std::exception_ptr error;
+
+    // Constructors
+    ThreadPoolGroup(): pending(0), failed(false) {}
+    ThreadPoolGroup(const ThreadPoolGroup& other) = delete;
+
+    // Operators
+    ThreadPoolGroup& operator = (const ThreadPoolGroup& rhs) = delete;
+};
+
+/**
+ * @brief One worker's deque of tasks, padded so neighbouring workers don't
+ * share a cache line
+ */
+struct ThreadPoolWorker {
+public:
+    // Fields
+    WorkStealingDeque<ThreadPoolTask*> tasks;
+    unsigned long long random;
+    char padding[64];
+
+    // Constructors
+    ThreadPoolWorker(): random(0) {}
+};
+
+/**
+ * @brief Work-stealing thread pool. Each worker pushes the tasks it forks
+ * onto its own deque and pops them newest first, which keeps the work it
+ * touched recently in its cache. A worker that runs out steals the oldest,
+ * and so usually largest, task from a random other worker.
+ *
+ * Threads outside the pool hand work in through a shared queue and block
+ * until it's done. Idle workers spin briefly, then sleep until new tasks
+ * arrive.
+ */
+struct ThreadPool {
+public:
+    // Fields
+    int num_workers;
+    ThreadPoolWorker* workers;
+    MpmcQueue<ThreadPoolTask*> injected;
+    DynamicArray<std::thread> threads;
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    // Bumped under sleep_mutex whenever new work might wake a sleeper
+    unsigned int epoch;
+    std::atomic<int> sleeping;
+    std::atomic<bool> stopping;
+
+    // Constructors
+
+    /**
+     * @brief Starts the workers
+     *
+     * @param num_workers The number of worker threads, or 0 for one per
+     * hardware thread
+     */
+    ThreadPool(int num_workers = 0):
+            num_workers(num_workers), workers(nullptr),
+            injected(THREAD_POOL_INJECTED_CAPACITY), epoch(0), sleeping(0),
+            stopping(false) {
+        if (this->num_workers <= 0) {
+            this->num_workers =
+                static_cast<int>(std::thread::hardware_concurrency());
+        }
+        if (this->num_workers < 1) {this->num_workers = 1;}
+        workers = new ThreadPoolWorker[this->num_workers];
+        dynamicArrayReserve(threads, this->num_workers);
+        for (int i = 0; i < this->num_workers; i++) {
+            dynamicArrayEmplaceBack(threads, threadPoolWork, this, i);
+        }
+    }
+    ThreadPool(const ThreadPool& other) = delete;
+
+    // Destructor
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            stopping.store(true);
+            epoch++;
+        }
+        wake.notify_all();
+        for (size_t i = 0; i < threads.size; i++) {threads[i].join();}
+        delete[] workers;
+    }
+
+    // Operators
+    ThreadPool& operator = (const ThreadPool& rhs) = delete;
+};
+
+/**
+ * @brief One value per worker, padded to its own cache line, so workers
+ * can accumulate into their own copy without sharing and the results can
+ * be combined after a join
+ *
+ * @tparam T The type of each worker's value
+ */
+template <typename T>
+struct ThreadPoolScratchSlot {
+public:
+    // Fields
+    T value;
+    char padding[64];
+
+    // Constructors
+    ThreadPoolScratchSlot(): value() {}
+};
+
+/**
+ * @brief Per-worker scratch buffers, indexed by the worker number passed
+ * to every task
+ *
+ * @tparam T The type of each worker's buffer
+ */
+template <typename T>
+struct ThreadPoolScratch {
+public:
+    // Fields
+    DynamicArray<ThreadPoolScratchSlot<T>> slots;
+
+    // Constructors
+    ThreadPoolScratch(const ThreadPool& pool) {
+        dynamicArrayResize(slots, pool.num_workers);
+    }
+};
+
+/**
+ * @brief Gets a worker's scratch buffer
+ *
+ * @tparam T The type of each worker's buffer
+ * @param scratch The scratch buffers
+ * @param worker The worker number
+ * @return T& The worker's buffer
+ */
+template <typename T>
+T& threadPoolScratchGet(ThreadPoolScratch<T>& scratch, int worker) {
+    return scratch.slots[worker].value;
+}
+
+/**
+ * @brief The pool and worker number of the calling thread, if it's a
+ * worker
+ *
+ * @return std::pair<const ThreadPool*, int>& The pool, or nullptr, and
+ * the worker number
+ */
+inline std::pair<const ThreadPool*, int>& threadPoolCurrent() {
+    static thread_local std::pair<const ThreadPool*, int> current(nullptr, -1);
+    return current;
+}
+
+/**
+ * @brief Gets the calling thread's worker number in the pool
+ *
+ * @param pool The pool
+ * @return int The worker number, or -1 if the thread isn't in the pool
+ */
+inline int threadPoolGetWorker(const ThreadPool& pool) {
+    std::pair<const ThreadPool*, int>& current = threadPoolCurrent();
+    return current.first == &pool ? current.second : -1;
+}
+
+/**
+ * @brief Wakes a sleeping worker, if there are any, after work was queued
+ *
+ * @param pool The pool
+ */
+inline void threadPoolNotify(ThreadPool& pool) {
+    // Pairs with the sleeper counting itself before its last look for work
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!pool.sleeping.load()) {return;}
+    {
+        std::lock_guard<std::mutex> lock(pool.sleep_mutex);
+        pool.epoch++;
+    }
+    pool.wake.notify_one();
+}
+
+/**
+ * @brief Looks for a task: first on the worker's own deque, then from
+ * outside the pool, then by stealing from the others starting at a random
+ * one
+ *
+ * @param pool The pool
+ * @param worker The worker that's looking
+ * @param task Set to the task found
+ * @return true if a task was found, otherwise false
+ */
+inline bool threadPoolFindTask(
+        ThreadPool& pool,
+        int worker,
+        ThreadPoolTask*& task) {
+    ThreadPoolWorker& self = pool.workers[worker];
+    if (workStealingDequePop(self.tasks, task)) {return true;}
+    if (mpmcQueueTryPop(pool.injected, task)) {return true;}
+
+    self.random ^= self.random << 13;
+    self.random ^= self.random >> 7;
+    self.random ^= self.random << 17;
+    int start = static_cast<int>(self.random % pool.num_workers);
+    for (int i = 0; i < pool.num_workers; i++) {
+        int victim = (start + i) % pool.num_workers;
+        if (victim == worker) {continue;}
+        if (workStealingDequeSteal(pool.workers[victim].tasks, task)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief The loop every worker thread runs until the pool is destroyed
+ *
+ * @param pool The pool
+ * @param worker This thread's worker number
+ */
+inline void threadPoolWork(ThreadPool* pool, int worker) {
+    threadPoolCurrent() = std::make_pair(pool, worker);
+    pool->workers[worker].random = 0x9E3779B97F4A7C15ULL * (worker + 1);
+    ThreadPoolTask* task = nullptr;
+    int idle = 0;
+    while (true) {
+        if (threadPoolFindTask(*pool, worker, task)) {
+            task->execute(task, worker);
+            idle = 0;
+            continue;
+        }
+        if (++idle < THREAD_POOL_SPIN_ROUNDS) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Count ourselves as sleeping before the last look, so a task
+        // queued after it is sure to see us and wake us
+        std::unique_lock<std::mutex> lock(pool->sleep_mutex);
+        unsigned int epoch = pool->epoch;
+        pool->sleeping.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool found = threadPoolFindTask(*pool, worker, task);
+        while (!found && !pool->stopping.load() && pool->epoch == epoch) {
+            pool->wake.wait(lock);
+        }
+        pool->sleeping.fetch_sub(1);
+        lock.unlock();
+        idle = 0;
+        if (found) {
+            task->execute(task, worker);
+        } else if (pool->stopping.load()) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Gets the pool shared by every graph kernel that isn't given one,
+ * with one worker per hardware thread. Started on first use.
+ *
+ * @return ThreadPool& The pool
+ */
+inline ThreadPool& threadPoolGetDefault() {
+    static ThreadPool pool;
+    return pool;
+}
+
+/**
+ * @brief Gets the number of workers in the pool
+ *
+ * @param pool The pool
+ * @return int The number of workers
+ */
+inline int threadPoolGetNumWorkers(const ThreadPool& pool) {
+    return pool.num_workers;
+}
+
+/**
+ * @brief Marks one of a group's tasks as finished, keeping the first
+ * exception any of them threw
+ *
+ * @param group The group
+ * @param error The exception the task threw, or null
+ */
+inline void threadPoolGroupFinish(
+        ThreadPoolGroup& group,
+        std::exception_ptr error) {
+    if (error && !group.failed.exchange(true)) {group.error = error;}
+    group.pending.fetch_sub(1, std::memory_order_release);
+}
+
+/**
+ * @brief A forked call of a function, freed once it has run
+ *
+ * @tparam Function Takes the number of the worker running it
+ */
+template <typename Function>
+struct ThreadPoolFunctionTask: ThreadPoolTask {
+public:
+    // Fields
+    Function function;
+    ThreadPoolGroup* group;
+
+    // Constructors
+    ThreadPoolFunctionTask(Function function, ThreadPoolGroup* group):
+        ThreadPoolTask(run), function(std::move(function)), group(group) {}
+
+    // Utility Functions
+
+    /**
+     * @brief Runs the function, then frees the task and finishes it in its
+     * group
+     *
+     * @param task The task
+     * @param worker The worker running it
+     */
+    static void run(ThreadPoolTask* task, int worker) {
+        ThreadPoolFunctionTask<Function>* self =
+            static_cast<ThreadPoolFunctionTask<Function>*>(task);
+        ThreadPoolGroup* group = self->group;
+        std::exception_ptr error;
+        try {
+            self->function(worker);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        delete self;
+        threadPoolGroupFinish(*group, error);
+    }
+};
+
+/**
+ * @brief Forks a call of function(worker) into the group. The caller must
+ * be one of the pool's workers, and must join the group before anything
+ * the function uses goes out of scope.
+ *
+ * @tparam Function Takes the number of the worker running it
+ * @param pool The pool
+ * @param group The group to add the task to
+ * @param function The function to call
+ */
+template <typename Function>
+void threadPoolSpawn(
+        ThreadPool& pool,
+        ThreadPoolGroup& group,
+        Function function) {
+    int worker = threadPoolGetWorker(pool);
+    if (worker < 0) {
+        throw std::logic_error("Can't spawn a task from outside the pool.");
+    }
+    group.pending.fetch_add(1, std::memory_order_relaxed);
+    workStealingDequePush(pool.workers[worker].tasks,
+        static_cast<ThreadPoolTask*>(new ThreadPoolFunctionTask<Function>(
+            std::move(function), &group)));
+    threadPoolNotify(pool);
+}
+
+/**
+ * @brief Waits for every task in the group, running other tasks while it
+ * waits instead of blocking. Rethrows the first exception a task threw.
+ * The caller must be one of the pool's workers.
+ *
+ * @param pool The pool
+ * @param group The group to wait for
+ */
+inline void threadPoolJoin(ThreadPool& pool, ThreadPoolGroup& group) {
+    int worker = threadPoolGetWorker(pool);
+    if (worker < 0) {
+        throw std::logic_error("Can't join tasks from outside the pool.");
+    }
+    ThreadPoolTask* task = nullptr;
+    while (group.pending.load(std::memory_order_acquire)) {
+        if (threadPoolFindTask(pool, worker, task)) {
+            task->execute(task, worker);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    if (group.failed.load()) {
+        group.failed.store(false);
+        std::exception_ptr error = group.error;
+        group.error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+/**
+ * @brief A call handed to the pool by a thread outside it, which sleeps
+ * until the call is done. Lives on the waiting thread's stack.
+ *
+ * @tparam Function Takes the number of the worker running it
+ */
+template <typename Function>
+struct ThreadPoolExternalTask: ThreadPoolTask {
+public:
+    // Fields
+    Function& function;
+    std::exception_ptr error;
+    bool done;
+    std::mutex mutex;
+    std::condition_variable finished;
+
+    // Constructors
+    ThreadPoolExternalTask(Function& function):
+        ThreadPoolTask(run), function(function), done(false) {}
+
+    // Utility Functions
+
+    /**
+     * @brief Runs the function and wakes the waiting thread
+     *
+     * @param task The task
+     * @param worker The worker running it
+     */
+    static void run(ThreadPoolTask* task, int worker) {
+        ThreadPoolExternalTask<Function>* self =
+            static_cast<ThreadPoolExternalTask<Function>*>(task);
+        try {
+            self->function(worker);
+        } catch (...) {
+            self->error = std::current_exception();
+        }
+        // The waiting thread may free the task as soon as this unlocks
+        std::lock_guard<std::mutex> lock(self->mutex);
+        self->done = true;
+        self->finished.notify_one();
+    }
+};
+
+/**
+ * @brief Runs function(worker) on one of the pool's workers and waits for
+ * it, so the function may spawn and join tasks. Called from a worker, it
+ * just runs the function there.
+ *
+ * @tparam Function Takes the number of the worker running it
+ * @param pool The pool
+ * @param function The function to run
+ */
+template <typename Function>
+void threadPoolRun(ThreadPool& pool, Function function) {
+    int worker = threadPoolGetWorker(pool);
+    if (worker >= 0) {
+        function(worker);
+        return;
+    }
+
+    ThreadPoolExternalTask<Function> task(function);
+    while (!mpmcQueueTryPush(pool.injected,
+            static_cast<ThreadPoolTask*>(&task))) {
+        std::this_thread::yield();
+    }
+    threadPoolNotify(pool);
+    std::unique_lock<std::mutex> lock(task.mutex);
+    while (!task.done) {task.finished.wait(lock);}
+    if (task.error) {std::rethrow_exception(task.error);}
+}
+
+template <typename Body>
+void threadPoolParallelForRange(
+        ThreadPool& pool,
+        ThreadPoolGroup& group,
+        Body& body,
+        int begin,
+        int end,
+        int grain,
+        int worker);
+
+/**
+ * @brief The second half of a range, split off by a worker that saw its
+ * deque empty, meaning some other worker might be hungry
+ *
+ * @tparam Body The body of the loop
+ */
+template <typename Body>
+struct ThreadPoolRangeTask: ThreadPoolTask {
+public:
+    // Fields
+    ThreadPool& pool;
+    ThreadPoolGroup& group;
+    Body& body;
+    int begin;
+    int end;
+    int grain;
+
+    // Constructors
+    ThreadPoolRangeTask(
+            ThreadPool& pool,
+            ThreadPoolGroup& group,
+            Body& body,
+            int begin,
+            int end,
+            int grain):
+        ThreadPoolTask(run), pool(pool), group(group), body(body),
+        begin(begin), end(end), grain(grain) {}
+
+    // Utility Functions
+
+    /**
+     * @brief Runs the range, then frees the task and finishes it in its
+     * group
+     *
+     * @param task The task
+     * @param worker The worker running it
+     */
+    static void run(ThreadPoolTask* task, int worker) {
+        ThreadPoolRangeTask<Body>* self =
+            static_cast<ThreadPoolRangeTask<Body>*>(task);
+        ThreadPoolGroup& group = self->group;
+        std::exception_ptr error;
+        try {
+            threadPoolParallelForRange(self->pool, group, self->body,
+                self->begin, self->end, self->grain, worker);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        delete self;
+        threadPoolGroupFinish(group, error);
+    }
+};
+
+/**
+ * @brief Runs body over [begin, end) by lazy binary splitting. While the
+ * worker's deque is empty, other workers may be looking for work, so the
+ * range is halved and the second half offered for stealing. Otherwise the
+ * worker just runs grain-sized pieces. Splitting only on demand keeps the
+ * number of tasks low when every worker is already busy.
+ *
+ * @tparam Body The body of the loop
+ * @param pool The pool
+ * @param group The group to add split-off halves to
+ * @param body Called as body(begin, end, worker) on pieces of the range
+ * @param begin The start of the range
+ * @param end The end of the range
+ * @param grain The smallest piece worth running on its own
+ * @param worker The worker running the range
+ */
+template <typename Body>
+void threadPoolParallelForRange(
+        ThreadPool& pool,
+        ThreadPoolGroup& group,
+        Body& body,
+        int begin,
+        int end,
+        int grain,
+        int worker) {
+    WorkStealingDeque<ThreadPoolTask*>& tasks = pool.workers[worker].tasks;
+    while (end - begin > grain) {
+        if (pool.num_workers > 1 && !workStealingDequeSize(tasks)) {
+            int middle = begin + (end - begin) / 2;
+            group.pending.fetch_add(1, std::memory_order_relaxed);
+            workStealingDequePush(tasks,
+                static_cast<ThreadPoolTask*>(new ThreadPoolRangeTask<Body>(
+                    pool, group, body, middle, end, grain)));
+            threadPoolNotify(pool);
+            end = middle;
+        } else {
+            body(begin, begin + grain, worker);
+            begin += grain;
+        }
+    }
+    if (begin < end) {body(begin, end, worker);}
+}
+
+/**
+ * @brief Runs body over every index in [begin, end) in parallel, in
+ * contiguous pieces such as ranges of vertices. Returns once the whole
+ * range is done. Rethrows the first exception the body threw.
+ *
+ * @tparam Body Called as body(begin, end, worker), where worker indexes
+ * per-worker scratch buffers
+ * @param pool The pool
+ * @param begin The start of the range
+ * @param end The end of the range
+ * @param body The body of the loop
+ * @param grain The smallest piece worth running on its own, or 0 to pick
+ * one from the range and the number of workers
+ */
+template <typename Body>
+void threadPoolParallelFor(
+        ThreadPool& pool,
+        int begin,
+        int end,
+        Body body,
+        int grain = 0) {
+    if (grain < 0) {throw std::logic_error("Can't use a negative grain.");}
+    if (begin >= end) {return;}
+    if (!grain) {
+        grain = (end - begin)
+            / (THREAD_POOL_PIECES_PER_WORKER * pool.num_workers);
+        if (grain < 1) {grain = 1;}
+    }
+    threadPoolRun(pool, [&](int worker) {
+        ThreadPoolGroup group;
+        std::exception_ptr error;
+        try {
+            threadPoolParallelForRange(
+                pool, group, body, begin, end, grain, worker);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        // Split-off halves still use the body, so wait for them regardless
+        threadPoolJoin(pool, group);
+        if (error) {std::rethrow_exception(error);}
+    });
+}
+
+#endif
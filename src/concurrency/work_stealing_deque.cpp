@@ -0,0 +1,180 @@
+#ifndef WORK_STEALING_DEQUE_CPP
+#define WORK_STEALING_DEQUE_CPP
+
+#include <atomic>
+#include <cstdint>
+
+#include "../data_structures/dynamic_array.cpp"
+
+const int64_t WORK_STEALING_DEQUE_INITIAL_CAPACITY = 64;
+
+/**
+ * @brief The circular buffer behind a WorkStealingDeque. Elements are
+ * atomics so a thief can read a slot while the owner writes another lap
+ * of the ring without a data race.
+ *
+ * @tparam T The type of the deque's data
+ */
+template <typename T>
+struct WorkStealingDequeBuffer {
+public:
+    // Fields
+    int64_t capacity;
+    std::atomic<T>* slots;
+
+    // Constructors
+    WorkStealingDequeBuffer(int64_t capacity): capacity(capacity),
+        slots(new std::atomic<T>[capacity]) {}
+    WorkStealingDequeBuffer(const WorkStealingDequeBuffer<T>& other) = delete;
+
+    // Destructor
+    ~WorkStealingDequeBuffer() {delete[] slots;}
+
+    // Operators
+    WorkStealingDequeBuffer<T>& operator = (
+        const WorkStealingDequeBuffer<T>& rhs) = delete;
+};
+
+/**
+ * @brief Chase-Lev work-stealing deque, with the memory orders from Lê et
+ * al., "Correct and Efficient Work-Stealing for Weak Memory Models". One
+ * owner thread pushes and pops at the bottom like a stack, and any other
+ * thread may steal from the top. The owner only contends with thieves over
+ * the last element.
+ *
+ * The buffer doubles when full. Old buffers are kept until the deque is
+ * destroyed, since a thief may still be reading one.
+ *
+ * @tparam T The type of the deque's data. Must be trivially copyable, such
+ * as a pointer to a task
+ */
+template <typename T>
+struct WorkStealingDeque {
+public:
+    // Fields
+    std::atomic<int64_t> top;
+    std::atomic<int64_t> bottom;
+    std::atomic<WorkStealingDequeBuffer<T>*> buffer;
+    DynamicArray<WorkStealingDequeBuffer<T>*> retired;
+
+    // Constructors
+    WorkStealingDeque(): top(0), bottom(0), buffer(
+        new WorkStealingDequeBuffer<T>(WORK_STEALING_DEQUE_INITIAL_CAPACITY)) {}
+    WorkStealingDeque(const WorkStealingDeque<T>& other) = delete;
+
+    // Destructor
+    ~WorkStealingDeque() {
+        delete buffer.load();
+        for (size_t i = 0; i < retired.size; i++) {delete retired[i];}
+    }
+
+    // Operators
+    WorkStealingDeque<T>& operator = (const WorkStealingDeque<T>& rhs) = delete;
+};
+
+/**
+ * @brief Gets roughly how many elements are in the deque. Exact when
+ * called by the owner with no thieves around.
+ *
+ * @tparam T The type of the deque's data
+ * @param deque The deque
+ * @return int64_t The number of elements
+ */
+template <typename T>
+int64_t workStealingDequeSize(const WorkStealingDeque<T>& deque) {
+    int64_t size = deque.bottom.load(std::memory_order_relaxed)
+        - deque.top.load(std::memory_order_relaxed);
+    return size > 0 ? size : 0;
+}
+
+/**
+ * @brief Pushes data onto the bottom of the deque. Only the owner may push.
+ *
+ * @tparam T The type of the deque's data
+ * @param deque The deque to push to
+ * @param data The data to push
+ */
+template <typename T>
+void workStealingDequePush(WorkStealingDeque<T>& deque, T data) {
+    int64_t bottom = deque.bottom.load(std::memory_order_relaxed);
+    int64_t top = deque.top.load(std::memory_order_acquire);
+    WorkStealingDequeBuffer<T>* buffer =
+        deque.buffer.load(std::memory_order_relaxed);
+    if (bottom - top > buffer->capacity - 1) {
+        WorkStealingDequeBuffer<T>* grown =
+            new WorkStealingDequeBuffer<T>(2 * buffer->capacity);
+        for (int64_t i = top; i < bottom; i++) {
+            grown->slots[i & (grown->capacity - 1)].store(
+                buffer->slots[i & (buffer->capacity - 1)].load(
+                    std::memory_order_relaxed),
+                std::memory_order_relaxed);
+        }
+        dynamicArrayPushBack(deque.retired, buffer);
+        deque.buffer.store(grown, std::memory_order_release);
+        buffer = grown;
+    }
+    buffer->slots[bottom & (buffer->capacity - 1)].store(
+        data, std::memory_order_relaxed);
+    deque.bottom.store(bottom + 1, std::memory_order_release);
+}
+
+/**
+ * @brief Pops the newest element off the bottom of the deque. Only the
+ * owner may pop.
+ *
+ * @tparam T The type of the deque's data
+ * @param deque The deque to pop from
+ * @param data Set to the popped element
+ * @return true if an element was popped, false if the deque was empty or
+ * a thief took the last element
+ */
+template <typename T>
+bool workStealingDequePop(WorkStealingDeque<T>& deque, T& data) {
+    int64_t bottom = deque.bottom.load(std::memory_order_relaxed) - 1;
+    WorkStealingDequeBuffer<T>* buffer =
+        deque.buffer.load(std::memory_order_relaxed);
+    deque.bottom.store(bottom, std::memory_order_seq_cst);
+    int64_t top = deque.top.load(std::memory_order_seq_cst);
+    if (top > bottom) {
+        deque.bottom.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+    data = buffer->slots[bottom & (buffer->capacity - 1)].load(
+        std::memory_order_relaxed);
+    if (top < bottom) {return true;}
+
+    // The last element, so race the thieves for it
+    bool won = deque.top.compare_exchange_strong(top, top + 1,
+        std::memory_order_seq_cst, std::memory_order_relaxed);
+    deque.bottom.store(bottom + 1, std::memory_order_relaxed);
+    return won;
+}
+
+/**
+ * @brief Steals the oldest element off the top of the deque. Any thread
+ * may steal.
+ *
+ * @tparam T The type of the deque's data
+ * @param deque The deque to steal from
+ * @param data Set to the stolen element
+ * @return true if an element was stolen, false if the deque was empty or
+ * another thread took the element first
+ */
+template <typename T>
+bool workStealingDequeSteal(WorkStealingDeque<T>& deque, T& data) {
+    int64_t top = deque.top.load(std::memory_order_seq_cst);
+    int64_t bottom = deque.bottom.load(std::memory_order_seq_cst);
+    if (top >= bottom) {return false;}
+    WorkStealingDequeBuffer<T>* buffer =
+        deque.buffer.load(std::memory_order_acquire);
+    T stolen = buffer->slots[top & (buffer->capacity - 1)].load(
+        std::memory_order_relaxed);
+    if (!deque.top.compare_exchange_strong(top, top + 1,
+            std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return false;
+    }
+    data = stolen;
+    return true;
+}
+
+#endif
@@ -1,6 +1,12 @@
 #ifndef BINARY_TREE_CPP
 #define BINARY_TREE_CPP
 
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include "../memory/node_pool.cpp"
+#include "dynamic_array.cpp"
 #include "linked_list.cpp"
 #include "queue.cpp"
 
@@ -15,30 +21,105 @@ struct BinaryTree {
     T data;
     BinaryTree<T>* left;
     BinaryTree<T>* right;
+    // Null at the root. Set by the constructors and tree functions, so
+    // nodes linked up by hand need it set too.
+    BinaryTree<T>* parent;
+    // Height of the subtree rooted here, kept up to date by the AVL
+    // functions. A leaf has height 1.
+    int height;
 
     // Constructors
     // TODO: remove full param constructor
-    BinaryTree(): data(T()), left(nullptr), right(nullptr) {}
-    BinaryTree(const T& data): data(data), left(nullptr), right(nullptr) {}
+    BinaryTree(): data(T()), left(nullptr), right(nullptr),
+        parent(nullptr), height(1) {}
+    BinaryTree(const T& data): data(data), left(nullptr), right(nullptr),
+        parent(nullptr), height(1) {}
     BinaryTree(
             const T& data, 
             BinaryTree<T>* const& left, 
             BinaryTree<T>* const& right): 
-        data(data), left(left), right(right) {}
-    BinaryTree(const BinaryTree<T>& other) {
-        data = other.data;
-        left = other.left ? new BinaryTree<T>(*other.left) : nullptr;
-        right = other.right ? new BinaryTree<T>(*other.right) : nullptr;
+        data(data), left(left), right(right), parent(nullptr), height(1) {
+        if (left) {
+            left->parent = this;
+            if (left->height >= height) {height = left->height + 1;}
+        }
+        if (right) {
+            right->parent = this;
+            if (right->height >= height) {height = right->height + 1;}
+        }
+    }
+
+    /**
+     * @brief Copy constructor. Walks the tree with an explicit stack of
+     * nodes still to copy, so degenerate trees can't overflow the call
+     * stack
+     *
+     * @param other The binary tree to copy
+     */
+    BinaryTree(const BinaryTree<T>& other): data(other.data), left(nullptr),
+            right(nullptr), parent(nullptr), height(other.height) {
+        DynamicArray<std::pair<const BinaryTree<T>*, BinaryTree<T>*>> pending;
+        dynamicArrayEmplaceBack(pending, &other, this);
+        while (pending.size) {
+            const BinaryTree<T>* source = pending[pending.size - 1].first;
+            BinaryTree<T>* copy = pending[pending.size - 1].second;
+            dynamicArrayPopBack(pending);
+            if (source->left) {
+                copy->left = new BinaryTree<T>(source->left->data);
+                copy->left->parent = copy;
+                copy->left->height = source->left->height;
+                dynamicArrayEmplaceBack(pending, source->left, copy->left);
+            }
+            if (source->right) {
+                copy->right = new BinaryTree<T>(source->right->data);
+                copy->right->parent = copy;
+                copy->right->height = source->right->height;
+                dynamicArrayEmplaceBack(pending, source->right, copy->right);
+            }
+        }
     }
 
     // Destructors
+
+    /**
+     * @brief Destructor. Frees each subtree without recursion or extra
+     * memory by rotating left children up until the current node has none,
+     * then deleting it and moving to its right child. Every node is
+     * unlinked before it's deleted, so its own destructor has nothing to do.
+     */
     ~BinaryTree() {
-        delete left;
-        delete right;
+        BinaryTree<T>* subtrees[2] = {left, right};
+        left = nullptr;
+        right = nullptr;
+        for (int i = 0; i < 2; i++) {
+            BinaryTree<T>* node = subtrees[i];
+            while (node) {
+                if (node->left) {
+                    BinaryTree<T>* child = node->left;
+                    node->left = child->right;
+                    child->right = node;
+                    node = child;
+                } else {
+                    BinaryTree<T>* next = node->right;
+                    node->right = nullptr;
+                    delete node;
+                    node = next;
+                }
+            }
+        }
     }
 
     // Operators
 
+    // Nodes live in the node pools, see NodePool
+    static void* operator new(size_t size) {
+        return nodePoolAllocate<sizeof(BinaryTree<T>)>(size);
+    }
+
+    static void operator delete(void* pointer, size_t size) {
+        nodePoolDeallocate<sizeof(BinaryTree<T>)>(pointer, size);
+    }
+
     /**
      * @brief Copy assignment operator. Uses the copy-and-swap idiom
      * discussed in the Linked List file
@@ -47,7 +128,7 @@ struct BinaryTree {
      * @return BinaryTree<T>& A copied binary tree
      */
     BinaryTree<T>& operator = (BinaryTree<T> rhs) {
-        swap(*this, other);
+        swap(*this, rhs);
         return *this;
     }
 
@@ -59,18 +140,27 @@ struct BinaryTree {
      * @return true if the trees are equal, otherwise false
      */
     friend bool operator == (BinaryTree<T>& lhs, BinaryTree<T>& rhs) {
-        if ((lhs.data != rhs.data)
-        || (lhs.left && !rhs.left) 
-        || (!lhs.left && rhs.left) 
-        || (lhs.right && !rhs.right)
-        || (!lhs.right && rhs.right)) {return false;}
+        // Compare pairs of nodes off an explicit stack rather than recursing
+        DynamicArray<std::pair<BinaryTree<T>*, BinaryTree<T>*>> pending;
+        dynamicArrayEmplaceBack(pending, &lhs, &rhs);
+        while (pending.size) {
+            BinaryTree<T>* lhs_node = pending[pending.size - 1].first;
+            BinaryTree<T>* rhs_node = pending[pending.size - 1].second;
+            dynamicArrayPopBack(pending);
+            if ((lhs_node->data != rhs_node->data)
+            || (!lhs_node->left != !rhs_node->left)
+            || (!lhs_node->right != !rhs_node->right)) {return false;}
 
-        bool result = true;
-
-        if (lhs.left && rhs.left) {result &= *lhs.left == *rhs.left;}
-        if (lhs.right && rhs.right) {result &= *lhs.right == *rhs.right;}
-
-        return result;
+            if (lhs_node->left) {
+                dynamicArrayEmplaceBack(
+                    pending, lhs_node->left, rhs_node->left);
+            }
+            if (lhs_node->right) {
+                dynamicArrayEmplaceBack(
+                    pending, lhs_node->right, rhs_node->right);
+            }
+        }
+        return true;
     }
 
     /**
@@ -87,7 +177,8 @@ struct BinaryTree {
     // Utility Functions
 
     /**
-     * @brief Swaps the provided binary trees
+     * @brief Swaps the provided binary trees. Each node keeps its own place
+     * in its tree, so parents aren't swapped.
      * 
      * @param first The first binary tree to swap
      * @param second The second binary tree to swap
@@ -99,6 +190,11 @@ struct BinaryTree {
         swap(first.data, second.data);
         swap(first.left, second.left);
         swap(first.right, second.right);
+        swap(first.height, second.height);
+        if (first.left) {first.left->parent = &first;}
+        if (first.right) {first.right->parent = &first;}
+        if (second.left) {second.left->parent = &second;}
+        if (second.right) {second.right->parent = &second;}
     }
 };
 
@@ -145,55 +241,429 @@ int binaryTreeGetNumNodes(BinaryTree<T>* const& tree) {
 }
 
 /**
- * @brief Helper function to insert a node into the tree
+ * @brief Inserts a node into the tree without rebalancing. Walks down in a
+ * loop, so inserting sorted data makes a long path but can't overflow the
+ * stack. See binaryTreeAvlInsertNode for a balanced insert.
  * 
  * @tparam T The type of the tree's data
- * @param node The node to insert a value for
+ * @param tree The binary tree to insert data into
  * @param data The data to insert into the tree
  */
 template <typename T>
-void binaryTreeInsertNodeHelper(BinaryTree<T>** node, T data) {
-    if (*node) {binaryTreeInsertNode(node, data);} 
-    else {*node = new BinaryTree<T>(data);}
+void binaryTreeInsertNode(BinaryTree<T>** tree, T data) {
+    BinaryTree<T>** node = tree;
+    BinaryTree<T>* parent = nullptr;
+    while (*node) {
+        if ((*node)->data == data) {return;}
+        parent = *node;
+        node = data < parent->data ? &parent->left : &parent->right;
+    }
+    *node = new BinaryTree<T>(data);
+    (*node)->parent = parent;
 }
 
 /**
- * @brief Inserts a node into the tree
+ * @brief Gets the node in the binary tree with matching data
  * 
  * @tparam T The type of the tree's data
- * @param tree The binary tree to insert data into
- * @param data The data to insert into the tree
+ * @param tree The binary tree to search
+ * @param data The data to search for
+ * @return BinaryTree<T>* The node if found, otherwise nullptr
  */
 template <typename T>
-void binaryTreeInsertNode(BinaryTree<T>** tree, T data) {
-    if (!*tree) {*tree = new BinaryTree<T>(data);}
-    T node_data = (*tree)->data;
-    if (node_data == data) {return;}
-    BinaryTree<T>** next = data < node_data ? &(*tree)->left : &(*tree)->right;
-    binaryTreeInsertNodeHelper(next, data);
+BinaryTree<T>* binaryTreeGetNode(BinaryTree<T>* const& tree, T data) {
+    BinaryTree<T>* node = tree;
+    while (node && node->data != data) {
+        node = data < node->data ? node->left : node->right;
+    }
+    return node;
 }
 
 /**
- * @brief Gets preorder for the binary tree
+ * @brief Gets the first node of the inorder, the leftmost node
  * 
  * @tparam T The type of the tree's data
- * @param tree The binary tree to insert data into
- * @return LinkedList<T>* The preorder of the tree
+ * @param tree The binary tree
+ * @return BinaryTree<T>* The first node, or nullptr if the tree is empty
  */
 template <typename T>
-LinkedList<T>* binaryTreeGetPreorder(BinaryTree<T>* const& tree) {
+BinaryTree<T>* binaryTreeGetFirstInorder(BinaryTree<T>* tree) {
+    if (!tree) {return nullptr;}
+    while (tree->left) {tree = tree->left;}
+    return tree;
+}
+
+/**
+ * @brief Gets the last node of the inorder, the rightmost node
+ * 
+ * @tparam T The type of the tree's data
+ * @param tree The binary tree
+ * @return BinaryTree<T>* The last node, or nullptr if the tree is empty
+ */
+template <typename T>
+BinaryTree<T>* binaryTreeGetLastInorder(BinaryTree<T>* tree) {
+    if (!tree) {return nullptr;}
+    while (tree->right) {tree = tree->right;}
+    return tree;
+}
+
+/**
+ * @brief Gets the node after this one in the inorder using parent pointers.
+ * Takes O(h) time at worst, and walking a whole tree this way takes O(n)
+ * total, with no allocation.
+ * 
+ * @tparam T The type of the tree's data
+ * @param node The current node
+ * @param root The root of the subtree being walked, never climbed past
+ * @return BinaryTree<T>* The next node, or nullptr at the end
+ */
+template <typename T>
+BinaryTree<T>* binaryTreeGetNextInorder(
+        BinaryTree<T>* node,
+        BinaryTree<T>* root) {
+    if (!node) {return nullptr;}
+    if (node->right) {return binaryTreeGetFirstInorder(node->right);}
+    while (node != root && node->parent && node == node->parent->right) {
+        node = node->parent;
+    }
+    return node == root ? nullptr : node->parent;
+}
+
+/**
+ * @brief Gets the node after this one in the inorder of the whole tree
+ * 
+ * @tparam T The type of the tree's data
+ * @param node The current node
+ * @return BinaryTree<T>* The next node, or nullptr at the end
+ */
+template <typename T>
+BinaryTree<T>* binaryTreeGetNextInorder(BinaryTree<T>* node) {
+    BinaryTree<T>* root = nullptr;
+    return binaryTreeGetNextInorder(node, root);
+}
+
+/**
+ * @brief Gets the node before this one in the inorder using parent pointers
+ * 
+ * @tparam T The type of the tree's data
+ * @param node The current node
+ * @return BinaryTree<T>* The previous node, or nullptr at the start
+ */
+template <typename T>
+BinaryTree<T>* binaryTreeGetPrevInorder(BinaryTree<T>* node) {
+    if (!node) {return nullptr;}
+    if (node->left) {return binaryTreeGetLastInorder(node->left);}
+    while (node->parent && node == node->parent->left) {node = node->parent;}
+    return node->parent;
+}
+
+/**
+ * @brief Gets the node after this one in the preorder using parent pointers.
+ * That's the first child if there is one, otherwise the right child of the
+ * nearest ancestor we reached from its left.
+ * 
+ * @tparam T The type of the tree's data
+ * @param node The current node
+ * @param root The root of the subtree being walked, never climbed past
+ * @return BinaryTree<T>* The next node, or nullptr at the end
+ */
+template <typename T>
+BinaryTree<T>* binaryTreeGetNextPreorder(
+        BinaryTree<T>* node,
+        BinaryTree<T>* root) {
+    if (!node) {return nullptr;}
+    if (node->left) {return node->left;}
+    if (node->right) {return node->right;}
+    while (node != root && node->parent) {
+        BinaryTree<T>* parent = node->parent;
+        if (node == parent->left && parent->right) {return parent->right;}
+        node = parent;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Gets the node after this one in the preorder of the whole tree
+ * 
+ * @tparam T The type of the tree's data
+ * @param node The current node
+ * @return BinaryTree<T>* The next node, or nullptr at the end
+ */
+template <typename T>
+BinaryTree<T>* binaryTreeGetNextPreorder(BinaryTree<T>* node) {
+    BinaryTree<T>* root = nullptr;
+    return binaryTreeGetNextPreorder(node, root);
+}
+
+/**
+ * @brief Gets the node before this one in the preorder using parent
+ * pointers. That's the parent, unless we're a right child with a left
+ * sibling, in which case it's the last preorder node of the sibling.
+ * 
+ * @tparam T The type of the tree's data
+ * @param node The current node
+ * @return BinaryTree<T>* The previous node, or nullptr at the start
+ */
+template <typename T>
+BinaryTree<T>* binaryTreeGetPrevPreorder(BinaryTree<T>* node) {
+    if (!node || !node->parent) {return nullptr;}
+    BinaryTree<T>* parent = node->parent;
+    if (node == parent->left || !parent->left) {return parent;}
+    node = parent->left;
+    while (node->left || node->right) {
+        node = node->right ? node->right : node->left;
+    }
+    return node;
+}
+
+/**
+ * @brief Gets the node after this one in the postorder using parent
+ * pointers. That's the parent, unless we're a left child with a right
+ * sibling, in which case it's the first postorder node of the sibling.
+ * 
+ * @tparam T The type of the tree's data
+ * @param node The current node
+ * @param root The root of the subtree being walked, which comes last
+ * @return BinaryTree<T>* The next node, or nullptr at the end
+ */
+template <typename T>
+BinaryTree<T>* binaryTreeGetNextPostorder(
+        BinaryTree<T>* node,
+        BinaryTree<T>* root) {
+    if (!node || node == root || !node->parent) {return nullptr;}
+    BinaryTree<T>* parent = node->parent;
+    if (node == parent->right || !parent->right) {return parent;}
+    node = parent->right;
+    while (node->left || node->right) {
+        node = node->left ? node->left : node->right;
+    }
+    return node;
+}
+
+/**
+ * @brief Gets the node after this one in the postorder of the whole tree
+ * 
+ * @tparam T The type of the tree's data
+ * @param node The current node
+ * @return BinaryTree<T>* The next node, or nullptr at the end
+ */
+template <typename T>
+BinaryTree<T>* binaryTreeGetNextPostorder(BinaryTree<T>* node) {
+    BinaryTree<T>* root = nullptr;
+    return binaryTreeGetNextPostorder(node, root);
+}
+
+/**
+ * @brief Gets the node before this one in the postorder using parent
+ * pointers. That's the last child if there is one, otherwise the left
+ * child of the nearest ancestor we reached from its right.
+ * 
+ * @tparam T The type of the tree's data
+ * @param node The current node
+ * @return BinaryTree<T>* The previous node, or nullptr at the start
+ */
+template <typename T>
+BinaryTree<T>* binaryTreeGetPrevPostorder(BinaryTree<T>* node) {
+    if (!node) {return nullptr;}
+    if (node->right) {return node->right;}
+    if (node->left) {return node->left;}
+    while (node->parent) {
+        BinaryTree<T>* parent = node->parent;
+        if (node == parent->right && parent->left) {return parent->left;}
+        node = parent;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Gets the first node of the postorder, the first leaf reached by
+ * preferring left children
+ * 
+ * @tparam T The type of the tree's data
+ * @param tree The binary tree
+ * @return BinaryTree<T>* The first node, or nullptr if the tree is empty
+ */
+template <typename T>
+BinaryTree<T>* binaryTreeGetFirstPostorder(BinaryTree<T>* tree) {
     if (!tree) {return nullptr;}
+    while (tree->left || tree->right) {
+        tree = tree->left ? tree->left : tree->right;
+    }
+    return tree;
+}
+
+enum BinaryTreeOrder {
+    BINARY_TREE_PREORDER,
+    BINARY_TREE_INORDER,
+    BINARY_TREE_POSTORDER
+};
+
+/**
+ * @brief Forward iterator over the nodes of a tree in some order. Steps
+ * with the parent pointers, so it holds nothing but the current node and
+ * the root of the subtree it walks, and stopping early costs nothing. The
+ * order is a template parameter, so each step compiles down to the
+ * matching step function.
+ * 
+ * @tparam T The type of the tree's data
+ * @tparam Order The traversal order
+ */
+template <typename T, BinaryTreeOrder Order>
+struct BinaryTreeIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = BinaryTree<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = BinaryTree<T>*;
+    using reference = BinaryTree<T>&;
+
+    // Fields
+    BinaryTree<T>* node;
+    // Ancestors of the root are outside the walk
+    BinaryTree<T>* root;
+
+    // Constructors
+    BinaryTreeIterator(BinaryTree<T>* node, BinaryTree<T>* root = nullptr):
+        node(node), root(root) {}
+
+    // Operators
+    BinaryTree<T>& operator * () const {return *node;}
+    BinaryTree<T>* operator -> () const {return node;}
+
+    BinaryTreeIterator<T, Order>& operator ++ () {
+        if (Order == BINARY_TREE_PREORDER) {
+            node = binaryTreeGetNextPreorder(node, root);
+        } else if (Order == BINARY_TREE_INORDER) {
+            node = binaryTreeGetNextInorder(node, root);
+        } else {
+            node = binaryTreeGetNextPostorder(node, root);
+        }
+        return *this;
+    }
+
+    BinaryTreeIterator<T, Order> operator ++ (int) {
+        BinaryTreeIterator<T, Order> result = *this;
+        ++*this;
+        return result;
+    }
+
+    friend bool operator == (
+            const BinaryTreeIterator<T, Order>& lhs,
+            const BinaryTreeIterator<T, Order>& rhs) {
+        return lhs.node == rhs.node;
+    }
+
+    friend bool operator != (
+            const BinaryTreeIterator<T, Order>& lhs,
+            const BinaryTreeIterator<T, Order>& rhs) {
+        return lhs.node != rhs.node;
+    }
+};
+
+/**
+ * @brief A traversal of a tree that can be used in a range-based for loop.
+ * Nodes are visited lazily as the loop goes.
+ * 
+ * @tparam T The type of the tree's data
+ * @tparam Order The traversal order
+ */
+template <typename T, BinaryTreeOrder Order>
+struct BinaryTreeRange {
+public:
+    // Fields
+    BinaryTree<T>* first;
+    BinaryTree<T>* root;
+
+    // Constructors
+    BinaryTreeRange(BinaryTree<T>* first, BinaryTree<T>* root = nullptr):
+        first(first), root(root) {}
+
+    // Utility Functions
+    BinaryTreeIterator<T, Order> begin() const {
+        return BinaryTreeIterator<T, Order>(first, root);
+    }
+    BinaryTreeIterator<T, Order> end() const {
+        return BinaryTreeIterator<T, Order>(nullptr, root);
+    }
+};
+
+/**
+ * @brief Lazily traverses the tree in preorder
+ * 
+ * @tparam T The type of the tree's data
+ * @param tree The binary tree to traverse
+ * @return BinaryTreeRange<T, BINARY_TREE_PREORDER> The traversal
+ */
+template <typename T>
+BinaryTreeRange<T, BINARY_TREE_PREORDER> binaryTreePreorder(
+        BinaryTree<T>* const& tree) {
+    return BinaryTreeRange<T, BINARY_TREE_PREORDER>(tree, tree);
+}
+
+/**
+ * @brief Lazily traverses the tree in inorder
+ * 
+ * @tparam T The type of the tree's data
+ * @param tree The binary tree to traverse
+ * @return BinaryTreeRange<T, BINARY_TREE_INORDER> The traversal
+ */
+template <typename T>
+BinaryTreeRange<T, BINARY_TREE_INORDER> binaryTreeInorder(
+        BinaryTree<T>* const& tree) {
+    return BinaryTreeRange<T, BINARY_TREE_INORDER>(
+        binaryTreeGetFirstInorder(tree), tree);
+}
+
+/**
+ * @brief Lazily traverses the tree in postorder
+ * 
+ * @tparam T The type of the tree's data
+ * @param tree The binary tree to traverse
+ * @return BinaryTreeRange<T, BINARY_TREE_POSTORDER> The traversal
+ */
+template <typename T>
+BinaryTreeRange<T, BINARY_TREE_POSTORDER> binaryTreePostorder(
+        BinaryTree<T>* const& tree) {
+    return BinaryTreeRange<T, BINARY_TREE_POSTORDER>(
+        binaryTreeGetFirstPostorder(tree), tree);
+}
+
+/**
+ * @brief Copies the data of a traversal into a new linked list in O(n),
+ * appending through a tail pointer
+ * 
+ * @tparam T The type of the tree's data
+ * @tparam Order The traversal order
+ * @param range The traversal to copy
+ * @return LinkedList<T>* The data in traversal order
+ */
+template <typename T, BinaryTreeOrder Order>
+LinkedList<T>* binaryTreeRangeToList(BinaryTreeRange<T, Order> range) {
     LinkedList<T>* result = nullptr;
-    linkedListInsertAtTail(&result, tree->data);
-    LinkedList<T>* left_preorder = binaryTreeGetPreorder(tree->left);
-    linkedListConcatenate(&result, &left_preorder);
-    LinkedList<T>* right_preorder = binaryTreeGetPreorder(tree->right);
-    linkedListConcatenate(&result, &right_preorder);
+    LinkedList<T>** tail = &result;
+    for (BinaryTree<T>& node : range) {
+        *tail = new LinkedList<T>(node.data);
+        tail = &(*tail)->next;
+    }
     return result;
 }
 
 /**
- * @brief Gets inorder for the binary tree
+ * @brief Gets preorder for the binary tree. Prefer binaryTreePreorder to
+ * walk the tree without copying it.
+ * 
+ * @tparam T The type of the tree's data
+ * @param tree The binary tree to insert data into
+ * @return LinkedList<T>* The preorder of the tree
+ */
+template <typename T>
+LinkedList<T>* binaryTreeGetPreorder(BinaryTree<T>* const& tree) {
+    return binaryTreeRangeToList(binaryTreePreorder(tree));
+}
+
+/**
+ * @brief Gets inorder for the binary tree. Prefer binaryTreeInorder to
+ * walk the tree without copying it.
  * 
  * @tparam T The type of the tree's data
  * @param tree The binary tree to insert data into
@@ -201,16 +671,12 @@ LinkedList<T>* binaryTreeGetPreorder(BinaryTree<T>* const& tree) {
  */
 template <typename T>
 LinkedList<T>* binaryTreeGetInorder(BinaryTree<T>* const& tree) {
-    if (!tree) {return nullptr;}
-    LinkedList<T>* result = binaryTreeGetInorder(tree->left);
-    linkedListInsertAtTail(&result, tree->data);
-    LinkedList<T>* right_inorder = binaryTreeGetInorder(tree->right);
-    linkedListConcatenate(&result, &right_inorder);
-    return result;
+    return binaryTreeRangeToList(binaryTreeInorder(tree));
 }
 
 /**
- * @brief Gets postorder for the binary tree
+ * @brief Gets postorder for the binary tree. Prefer binaryTreePostorder to
+ * walk the tree without copying it.
  * 
  * @tparam T The type of the tree's data
  * @param tree The binary tree to insert data into
@@ -218,22 +684,19 @@ LinkedList<T>* binaryTreeGetInorder(BinaryTree<T>* const& tree) {
  */
 template <typename T>
 LinkedList<T>* binaryTreeGetPostorder(BinaryTree<T>* const& tree) {
-    if (!tree) {return nullptr;}
-    LinkedList<T>* result = binaryTreeGetPostorder(tree->left);
-    LinkedList<T>* right_postorder = binaryTreeGetPostorder(tree->right);
-    linkedListConcatenate(&result, &right_postorder);
-    linkedListInsertAtTail(&result, tree->data);
-    return result;
+    return binaryTreeRangeToList(binaryTreePostorder(tree));
 }
 
 template <typename T>
 LinkedList<T>* binaryTreeGetLevelOrder(BinaryTree<T>* const& tree) {
     if (!tree) {return nullptr;}
     LinkedList<T>* result = nullptr;
+    LinkedList<T>** tail = &result;
     Queue<BinaryTree<T>*> queue(tree);
     while (!queueEmpty(queue)) {
         BinaryTree<T>* front = queueFront(queue);
-        linkedListInsertAtTail(&result, front->data);
+        *tail = new LinkedList<T>(front->data);
+        tail = &(*tail)->next;
         if (front->left) {queuePush(queue, front->left);}
         if (front->right) {queuePush(queue, front->right);}
         queuePop(queue);
@@ -242,113 +705,66 @@ LinkedList<T>* binaryTreeGetLevelOrder(BinaryTree<T>* const& tree) {
 }
 
 /**
- * @brief Gets the node in the binary tree with matching data
- * 
- * @tparam T The type of the tree's data
- * @param tree The binary tree to search
- * @param data The data to search for
- * @return BinaryTree<T>* The node if found, otherwise nullptr
- */
-template <typename T>
-BinaryTree<T>* binaryTreeGetNode(BinaryTree<T>* const& tree, T data) {
-    if (!tree || tree->data == data) {return tree;}
-    else if (data < tree->data) {return binaryTreeGetNode(tree->left, data);}
-    else {return binaryTreeGetNode(tree->right, data);}
-}
-
-/**
- * @brief Gets the prede/suc cessor to the desired order.
+ * @brief Gets the prede/suc cessor to the desired order. Finds the node
+ * with a search and then takes one step, so it runs in O(h) without
+ * building the whole traversal.
  * 
  * @tparam T The type of the tree's data
  * @param tree The binary tree to search
  * @param data The data to search for
- * @param order_fn The tree traversal function (such as preorder)
- * @param cessor_function A function to get either the predecessor or successor
+ * @param step_fn A function to step to either the previous or next node
+ * in some order, such as binaryTreeGetNextInorder
  * @return BinaryTree<T>* The node if found, otherwise nullptr
  */
 template <typename T>
 BinaryTree<T>* binaryTreeGetOrderCessor(
         BinaryTree<T>* const& tree, 
         T data, 
-        LinkedList<T>* (*order_fn)(BinaryTree<T>* const& root),
-        LinkedList<T>* (*cessor_fn)(
-            LinkedList<T>* const& head, 
-            T data, 
-            int n, 
-            bool (*equality_fn)(const T& lhs, const T& rhs))) {
-    if (!order_fn) {return nullptr;}
-    LinkedList<T>* order = order_fn(tree);
-    LinkedList<T>* item = linkedListGetNthOccurrence(order, data, 1);
-    LinkedList<T>* prev = cessor_fn(order, item->data, 1, nullptr);
-
-    if (!prev) {return nullptr;}
-    return binaryTreeGetNode(tree, prev->data);
+        BinaryTree<T>* (*step_fn)(BinaryTree<T>* node)) {
+    if (!step_fn) {return nullptr;}
+    return step_fn(binaryTreeGetNode(tree, data));
 }
 
 template <typename T>
 BinaryTree<T>* binaryTreeGetPreorderPredecessor(
         BinaryTree<T>* const& tree, 
         T data) {
-    return binaryTreeGetOrderCessor(
-        tree, 
-        data, 
-        binaryTreeGetPreorder, 
-        linkedListGetPredecessorOfNthOccurrence);
+    return binaryTreeGetOrderCessor(tree, data, binaryTreeGetPrevPreorder);
 }
 
 template <typename T>
 BinaryTree<T>* binaryTreeGetPreorderSuccessor(
         BinaryTree<T>* const& tree, 
         T data) {
-    return binaryTreeGetOrderCessor(
-        tree, 
-        data, 
-        binaryTreeGetPreorder, 
-        linkedListGetSuccessorOfNthOccurrence);
+    return binaryTreeGetOrderCessor(tree, data, binaryTreeGetNextPreorder);
 }
 
 template <typename T>
 BinaryTree<T>* binaryTreeGetInorderPredecessor(
         BinaryTree<T>* const& tree, 
         T data) {
-    return binaryTreeGetOrderCessor(
-        tree, 
-        data, 
-        binaryTreeGetInorder, 
-        linkedListGetPredecessorOfNthOccurrence);
+    return binaryTreeGetOrderCessor(tree, data, binaryTreeGetPrevInorder);
 }
 
 template <typename T>
 BinaryTree<T>* binaryTreeGetInorderSuccessor(
         BinaryTree<T>* const& tree, 
         T data) {
-    return binaryTreeGetOrderCessor(
-        tree, 
-        data, 
-        binaryTreeGetInorder, 
-        linkedListGetSuccessorOfNthOccurrence);
+    return binaryTreeGetOrderCessor(tree, data, binaryTreeGetNextInorder);
 }
 
 template <typename T>
 BinaryTree<T>* binaryTreeGetPostorderPredecessor(
         BinaryTree<T>* const& tree, 
         T data) {
-    return binaryTreeGetOrderCessor(
-        tree, 
-        data, 
-        binaryTreeGetPostorder, 
-        linkedListGetPredecessorOfNthOccurrence);
+    return binaryTreeGetOrderCessor(tree, data, binaryTreeGetPrevPostorder);
 }
 
 template <typename T>
 BinaryTree<T>* binaryTreeGetPostorderSuccessor(
         BinaryTree<T>* const& tree, 
         T data) {
-    return binaryTreeGetOrderCessor(
-        tree, 
-        data, 
-        binaryTreeGetPostorder, 
-        linkedListGetSuccessorOfNthOccurrence);
+    return binaryTreeGetOrderCessor(tree, data, binaryTreeGetNextPostorder);
 }
 
 /**
@@ -361,24 +777,39 @@ BinaryTree<T>* binaryTreeGetPostorderSuccessor(
  */
 template <typename T>
 BinaryTree<T>* binaryTreeGetParentOf(BinaryTree<T>* const& tree, T data) {
-    // Base cases
-    if (!tree || tree->data == data) {return nullptr;}
-    BinaryTree<T> *left = tree->left, *right = tree->right;
-    if (left) {
-        if (data == left->data) {return tree;}
-        if (data < tree->data) {return binaryTreeGetParentOf(left, data);}
-    }
-    if (right) {
-        if (data == right->data) {return tree;}
-        if (data > tree->data) {return binaryTreeGetParentOf(right, data);}
-    }
-    return nullptr;
+    BinaryTree<T>* node = binaryTreeGetNode(tree, data);
+    return node ? node->parent : nullptr;
+}
+
+/**
+ * @brief Replaces a node with one of its children in the node's parent, or
+ * at the root. The node itself isn't freed.
+ * 
+ * @tparam T The type of the tree's data
+ * @param tree The pointer to the root of the tree
+ * @param node The node to unlink
+ * @param child The child to put in its place, which may be null
+ */
+template <typename T>
+void binaryTreeReplaceNode(
+        BinaryTree<T>** tree, 
+        BinaryTree<T>* node, 
+        BinaryTree<T>* child) {
+    BinaryTree<T>* parent = node->parent;
+    if (!parent) {*tree = child;}
+    else if (parent->left == node) {parent->left = child;}
+    else {parent->right = child;}
+    if (child) {child->parent = parent;}
+    node->left = nullptr;
+    node->right = nullptr;
+    node->parent = nullptr;
 }
 
 /**
- * @brief Deletes the specififed node from the list, if it exists
- * TODO: Can we refactor this with a helper function?
- * I tried using function pointers with getters but that doesn't work
+ * @brief Deletes the specififed node from the list, if it exists. A node
+ * with a left subtree takes its inorder predecessor's data, otherwise one
+ * with a right subtree takes its successor's, and that node is removed
+ * instead.
  * 
  * @tparam T The type of the tree's data
  * @param tree The tree to delete the node from
@@ -389,51 +820,221 @@ void binaryTreeDeleteNode(BinaryTree<T>** tree, T data) {
     BinaryTree<T>* to_delete = binaryTreeGetNode(*tree, data);
     if (!to_delete) {return;}
 
-    if (!to_delete->left && !to_delete->right) {
+    if (to_delete->left) {
+        BinaryTree<T>* predecessor = binaryTreeGetLastInorder(to_delete->left);
+        to_delete->data = predecessor->data;
+        binaryTreeReplaceNode(tree, predecessor, predecessor->left);
+        delete predecessor;
+    } else if (to_delete->right) {
+        BinaryTree<T>* successor = binaryTreeGetFirstInorder(to_delete->right);
+        to_delete->data = successor->data;
+        binaryTreeReplaceNode(tree, successor, successor->right);
+        delete successor;
+    } else {
+        binaryTreeReplaceNode(tree, to_delete, (BinaryTree<T>*) nullptr);
         delete to_delete;
-        return;
-    } else if (to_delete->left) {
-        BinaryTree<T>* predecessor = binaryTreeGetInorderPredecessor(
-            *tree, 
-            to_delete->data);
-        BinaryTree<T>* parent = binaryTreeGetParentOf(
-            *tree, 
-            predecessor->data);
-
-        // Set parent's child to predecessor's chlid
-        if (parent == to_delete) {
-            parent->left = predecessor->left;
-        } else {
-            parent->right = predecessor->left;
+    }
+}
+
+/**
+ * @brief Gets the height stored in an AVL node
+ * 
+ * @tparam T The type of the tree's data
+ * @param node The node, which may be null
+ * @return int The node's height, or 0 for an empty tree
+ */
+template <typename T>
+int binaryTreeAvlGetHeight(BinaryTree<T>* const& node) {
+    return node ? node->height : 0;
+}
+
+/**
+ * @brief Recomputes a node's height from its children's heights
+ * 
+ * @tparam T The type of the tree's data
+ * @param node The node to update
+ */
+template <typename T>
+void binaryTreeAvlUpdateHeight(BinaryTree<T>* node) {
+    int left = binaryTreeAvlGetHeight(node->left);
+    int right = binaryTreeAvlGetHeight(node->right);
+    node->height = 1 + (left > right ? left : right);
+}
+
+/**
+ * @brief Rotates a subtree left, so the right child becomes its root and
+ * the old root becomes that child's left child. Keeps the inorder.
+ * 
+ * @tparam T The type of the tree's data
+ * @param tree The pointer to the subtree's root, which is updated
+ */
+template <typename T>
+void binaryTreeRotateLeft(BinaryTree<T>** tree) {
+    BinaryTree<T>* root = *tree;
+    if (!root || !root->right) {
+        throw std::logic_error("Can't rotate left without a right child.");
+    }
+    BinaryTree<T>* pivot = root->right;
+    root->right = pivot->left;
+    if (root->right) {root->right->parent = root;}
+    pivot->left = root;
+    pivot->parent = root->parent;
+    root->parent = pivot;
+    binaryTreeAvlUpdateHeight(root);
+    binaryTreeAvlUpdateHeight(pivot);
+    *tree = pivot;
+}
+
+/**
+ * @brief Rotates a subtree right, so the left child becomes its root and
+ * the old root becomes that child's right child. Keeps the inorder.
+ * 
+ * @tparam T The type of the tree's data
+ * @param tree The pointer to the subtree's root, which is updated
+ */
+template <typename T>
+void binaryTreeRotateRight(BinaryTree<T>** tree) {
+    BinaryTree<T>* root = *tree;
+    if (!root || !root->left) {
+        throw std::logic_error("Can't rotate right without a left child.");
+    }
+    BinaryTree<T>* pivot = root->left;
+    root->left = pivot->right;
+    if (root->left) {root->left->parent = root;}
+    pivot->right = root;
+    pivot->parent = root->parent;
+    root->parent = pivot;
+    binaryTreeAvlUpdateHeight(root);
+    binaryTreeAvlUpdateHeight(pivot);
+    *tree = pivot;
+}
+
+/**
+ * @brief Restores the AVL property at a node whose children are balanced
+ * but may differ in height by two, with a single or double rotation
+ * 
+ * @tparam T The type of the tree's data
+ * @param tree The pointer to the subtree's root, which is updated
+ */
+template <typename T>
+void binaryTreeAvlRebalance(BinaryTree<T>** tree) {
+    BinaryTree<T>* root = *tree;
+    binaryTreeAvlUpdateHeight(root);
+    int balance = binaryTreeAvlGetHeight(root->left)
+        - binaryTreeAvlGetHeight(root->right);
+    if (balance > 1) {
+        BinaryTree<T>* left = root->left;
+        if (binaryTreeAvlGetHeight(left->left)
+                < binaryTreeAvlGetHeight(left->right)) {
+            binaryTreeRotateLeft(&root->left);
         }
-        to_delete->data = predecessor->data;
+        binaryTreeRotateRight(tree);
+    } else if (balance < -1) {
+        BinaryTree<T>* right = root->right;
+        if (binaryTreeAvlGetHeight(right->right)
+                < binaryTreeAvlGetHeight(right->left)) {
+            binaryTreeRotateRight(&root->right);
+        }
+        binaryTreeRotateLeft(tree);
+    }
+}
 
-        // Delete predecessor
-        predecessor->left = nullptr;
-        predecessor->right =  nullptr;
-        delete predecessor;
+/**
+ * @brief Inserts a node into an AVL tree, rotating on the way back up so
+ * the height stays within about 1.44 log2(n). Only valid on trees built
+ * with the AVL functions, since they rely on the stored heights.
+ * 
+ * @tparam T The type of the tree's data
+ * @param tree The binary tree to insert data into
+ * @param data The data to insert into the tree
+ */
+template <typename T>
+void binaryTreeAvlInsertNode(BinaryTree<T>** tree, T data) {
+    if (!*tree) {
+        *tree = new BinaryTree<T>(data);
         return;
-    } else /* to_delete->right */ {
-        BinaryTree<T>* successor = binaryTreeGetInorderSuccessor(
-            *tree, 
-            to_delete->data);
-        BinaryTree<T>* parent = binaryTreeGetParentOf(
-            *tree, 
-            successor->data);
-
-        // Set parent's child to predecessor's chlid
-        if (parent == to_delete) {
-            parent->right = successor->right;
-        } else {
-            parent->left = successor->right;
-        }
-        to_delete->data = successor->data;
+    }
+    if ((*tree)->data == data) {return;}
+    BinaryTree<T>* root = *tree;
+    BinaryTree<T>** child = data < root->data ? &root->left : &root->right;
+    binaryTreeAvlInsertNode(child, data);
+    (*child)->parent = root;
+    binaryTreeAvlRebalance(tree);
+}
 
-        // Delete predecessor
-        successor->left = nullptr;
-        successor->right =  nullptr;
-        delete successor;
+/**
+ * @brief Deletes a node from an AVL tree, if it exists, rebalancing on the
+ * way back up. A node with two children takes its inorder successor's data
+ * and the successor is deleted instead.
+ * 
+ * @tparam T The type of the tree's data
+ * @param tree The tree to delete the node from
+ * @param data The data of the node to delete
+ */
+template <typename T>
+void binaryTreeAvlDeleteNode(BinaryTree<T>** tree, T data) {
+    BinaryTree<T>* root = *tree;
+    if (!root) {return;}
+    if (data < root->data) {
+        binaryTreeAvlDeleteNode(&root->left, data);
+    } else if (root->data < data) {
+        binaryTreeAvlDeleteNode(&root->right, data);
+    } else if (root->left && root->right) {
+        BinaryTree<T>* successor = root->right;
+        while (successor->left) {successor = successor->left;}
+        root->data = successor->data;
+        binaryTreeAvlDeleteNode(&root->right, successor->data);
+    } else {
+        *tree = root->left ? root->left : root->right;
+        if (*tree) {(*tree)->parent = root->parent;}
+        root->left = nullptr;
+        root->right = nullptr;
+        delete root;
         return;
     }
+    binaryTreeAvlRebalance(tree);
+}
+
+/**
+ * @brief Helper function to build a perfectly balanced tree from a sorted
+ * range, using the middle element as the root of each subtree
+ * 
+ * @tparam T The type of the tree's data
+ * @param data The start of the range
+ * @param size The number of elements in the range
+ * @return BinaryTree<T>* The root of the subtree
+ */
+template <typename T>
+BinaryTree<T>* binaryTreeBuildFromSortedHelper(const T* data, int size) {
+    if (size <= 0) {return nullptr;}
+    int middle = size / 2;
+    return new BinaryTree<T>(
+        data[middle],
+        binaryTreeBuildFromSortedHelper(data, middle),
+        binaryTreeBuildFromSortedHelper(
+            data + middle + 1, 
+            size - middle - 1));
 }
+
+/**
+ * @brief Builds a balanced tree from strictly increasing data in O(n),
+ * rather than O(n log n) inserts. Heights are set, so the AVL functions
+ * can keep working on the result.
+ * 
+ * @tparam T The type of the tree's data
+ * @param data The start of the sorted range
+ * @param size The number of elements in the range
+ * @return BinaryTree<T>* The root of the tree, or nullptr if size is 0
+ */
+template <typename T>
+BinaryTree<T>* binaryTreeBuildFromSorted(const T* data, int size) {
+    for (int i = 1; i < size; i++) {
+        if (!(data[i - 1] < data[i])) {
+            throw std::logic_error(
+                "Can't build a tree from data that isn't strictly sorted.");
+        }
+    }
+    return binaryTreeBuildFromSortedHelper(data, size);
+}
+
 #endif
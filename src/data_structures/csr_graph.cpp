@@ -0,0 +1,675 @@
+#ifndef CSR_GRAPH_CPP
+#define CSR_GRAPH_CPP
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "dynamic_array.cpp"
+#include "graph.cpp"
+#include "flat_hash_map.cpp"
+#include "vertex_id_map.cpp"
+
+/**
+ * @brief Allocates the weights of a CSR graph's edges
+ *
+ * @tparam W The type of the weights
+ * @param weights Where to store the array
+ * @param num_edges The number of edges
+ */
+template <typename W>
+void csrGraphAllocateWeights(W*& weights, size_t num_edges) {
+    weights = new W[num_edges];
+}
+
+/**
+ * @brief Unweighted graphs have no weights to allocate
+ *
+ * @param weights Set to null
+ * @param num_edges The number of edges
+ */
+inline void csrGraphAllocateWeights(void*& weights, size_t num_edges) {
+    weights = nullptr;
+}
+
+/**
+ * @brief Frees the weights of a CSR graph's edges
+ *
+ * @tparam W The type of the weights
+ * @param weights The array to free
+ */
+template <typename W>
+void csrGraphFreeWeights(W* weights) {delete[] weights;}
+
+inline void csrGraphFreeWeights(void* weights) {}
+
+/**
+ * @brief Sets the weight of an edge. Weights are converted from double, so
+ * integer weights are truncated.
+ *
+ * @tparam W The type of the weights
+ * @param weights The graph's weights
+ * @param edge The index of the edge
+ * @param weight The new weight
+ */
+template <typename W>
+void csrGraphSetWeight(W* weights, size_t edge, double weight) {
+    weights[edge] = static_cast<W>(weight);
+}
+
+inline void csrGraphSetWeight(void* weights, size_t edge, double weight) {}
+
+/**
+ * @brief Gets the weight of an edge as a double
+ *
+ * @tparam W The type of the weights
+ * @param weights The graph's weights
+ * @param edge The index of the edge
+ * @return double The edge's weight
+ */
+template <typename W>
+double csrGraphGetWeight(const W* weights, size_t edge) {
+    return static_cast<double>(weights[edge]);
+}
+
+/**
+ * @brief Every edge of an unweighted graph weighs 1, which is also what a
+ * graph file's edges weigh when they leave the weight out
+ *
+ * @param weights The graph's weights, which are null
+ * @param edge The index of the edge
+ * @return double 1
+ */
+inline double csrGraphGetWeight(const void* weights, size_t edge) {return 1;}
+
+/**
+ * @brief Gets the weights of the edges from the given edge on
+ *
+ * @tparam W The type of the weights
+ * @param weights The graph's weights
+ * @param edge The index of the first edge
+ * @return const W* The weights starting at that edge
+ */
+template <typename W>
+const W* csrGraphOffsetWeights(const W* weights, size_t edge) {
+    return weights + edge;
+}
+
+inline const void* csrGraphOffsetWeights(const void* weights, size_t edge) {
+    return nullptr;
+}
+
+/**
+ * @brief Read-only view of one node's outgoing edges in a CsrGraph. The
+ * targets and weights are parallel arrays, so the nth edge goes to
+ * targets[n] with weight weights[n]. A range-for visits the target indices
+ * and never touches the weights.
+ *
+ * @tparam W The type of the weights. Unweighted graphs have void weights,
+ * which are null
+ */
+template <typename W>
+struct CsrNeighbors {
+    // Fields
+    const int* targets;
+    const W* weights;
+    size_t length;
+
+    // Constructors
+    CsrNeighbors(): targets(nullptr), weights(nullptr), length(0) {}
+    CsrNeighbors(const int* targets, const W* weights, size_t length):
+        targets(targets), weights(weights), length(length) {}
+
+    // Iterators
+    const int* begin() const {return targets;}
+    const int* end() const {return targets + length;}
+};
+
+/**
+ * @brief Immutable compressed sparse row (CSR) graph. Nodes are numbered
+ * 0 to num_nodes - 1 and the original values live in the nodes table.
+ * The outgoing edges of node i are targets[offsets[i]] up to (but not
+ * including) targets[offsets[i + 1]], with matching weights.
+ *
+ * Unlike Graph<T>, every array is contiguous, so walking a node's
+ * neighbors doesn't chase pointers. The tradeoff is that the graph
+ * can't be changed once it's built.
+ * 
+ * A graph that doesn't own its memory is a view over arrays that live
+ * somewhere else, such as a memory-mapped binary graph file. Copying a
+ * view makes a graph that owns its memory.
+ *
+ * Weights live in their own array, so walks that only follow targets,
+ * like breadth-first search, never load them. Unweighted graphs use void
+ * weights and don't store any, and every edge weighs 1.
+ *
+ * @tparam T The type of the graph's data. Assumes the type implements an
+ * equality operator and std::hash.
+ * @tparam W The type of the edge weights: double, float, an integer type,
+ * or void for an unweighted graph
+ */
+template <typename T, typename W = double>
+struct CsrGraph {
+public:
+    // Fields
+    int num_nodes;
+    size_t num_edges;
+    T* nodes;
+    size_t* offsets;
+    int* targets;
+    W* weights;
+    bool owns_memory;
+
+    // Constructors
+    CsrGraph(): num_nodes(0), num_edges(0), nodes(nullptr),
+        offsets(nullptr), targets(nullptr), weights(nullptr),
+        owns_memory(true) {}
+
+    /**
+     * @brief Freezes a Graph into CSR form. Nodes keep the order of the
+     * graph's adjacency matrix and edges keep the order of each
+     * adjacency list.
+     *
+     * @param graph The graph to freeze
+     */
+    CsrGraph(const Graph<T>& graph): num_nodes(0), num_edges(0),
+            nodes(nullptr), offsets(nullptr), targets(nullptr),
+            weights(nullptr), owns_memory(true) {
+        int node_count = 0;
+        size_t edge_count = 0;
+        FlatHashMap<T, int> indices;
+        for (LinkedList<AdjacencyList<T>>* node = graph.adjacency_matrix;
+                node;
+                node = node->next) {
+            flatHashMapInsert(indices, node->data.from, node_count);
+            node_count++;
+            edge_count += linkedListGetLength(node->data.edges);
+        }
+        // Check every target before allocating so a throw can't leak
+        for (LinkedList<AdjacencyList<T>>* node = graph.adjacency_matrix;
+                node;
+                node = node->next) {
+            for (LinkedList<Edge<T>>* edge = node->data.edges;
+                    edge;
+                    edge = edge->next) {
+                if (!flatHashMapGet(indices, edge->data.to)) {
+                    throw std::logic_error(
+                        "Can't freeze an edge to a node not in the graph.");
+                }
+            }
+        }
+        csrGraphAllocate(*this, node_count, edge_count);
+
+        int i = 0;
+        size_t k = 0;
+        for (LinkedList<AdjacencyList<T>>* node = graph.adjacency_matrix;
+                node;
+                node = node->next) {
+            nodes[i] = node->data.from;
+            offsets[i] = k;
+            for (LinkedList<Edge<T>>* edge = node->data.edges;
+                    edge;
+                    edge = edge->next) {
+                targets[k] = *flatHashMapGet(indices, edge->data.to);
+                csrGraphSetWeight(weights, k, edge->data.weight);
+                k++;
+            }
+            i++;
+        }
+        offsets[num_nodes] = k;
+    }
+
+    /**
+     * @brief Constructs a CSR graph straight from a graph file, without
+     * building a Graph first. The file format is described by the Graph
+     * file path constructor, and the resulting CSR graph matches freezing
+     * a Graph built from the same file.
+     *
+     * Integer nodes are 0 up to the first line, and each node's index is
+     * its value. Other nodes, such as strings, are given dense ids with a
+     * VertexIdMap, so each edge stores an int target and each value is
+     * stored once, in the nodes table.
+     *
+     * @param filepath The path of the text file detailing the graph
+     * @param direction Whether to add the reverse of every edge
+     */
+    CsrGraph(std::string filepath, GraphDirection direction): num_nodes(0),
+            num_edges(0), nodes(nullptr), offsets(nullptr),
+            targets(nullptr), weights(nullptr), owns_memory(true) {
+        DynamicArray<Edge<T>> edges;
+        int size = graphReadEdgeList(filepath, edges);
+        csrGraphFillFileEdges(*this, size, edges, direction);
+    }
+
+    CsrGraph(const CsrGraph<T, W>& other): num_nodes(0), num_edges(0),
+            nodes(nullptr), offsets(nullptr), targets(nullptr),
+            weights(nullptr), owns_memory(true) {
+        csrGraphAllocate(*this, other.num_nodes, other.num_edges);
+        for (int i = 0; i < num_nodes; i++) {nodes[i] = other.nodes[i];}
+        for (int i = 0; i <= num_nodes; i++) {offsets[i] = other.offsets[i];}
+        for (size_t i = 0; i < num_edges; i++) {
+            targets[i] = other.targets[i];
+            csrGraphSetWeight(weights, i, csrGraphGetWeight(other.weights, i));
+        }
+    }
+
+    // Destructor
+    ~CsrGraph() {
+        if (!owns_memory) {return;}
+        delete[] nodes;
+        delete[] offsets;
+        delete[] targets;
+        csrGraphFreeWeights(weights);
+    }
+
+    // Operators
+
+    /**
+     * @brief Copy assignment operator. Uses the copy-and-swap idiom
+     *
+     * @param rhs The CSR graph to copy
+     * @return CsrGraph<T, W>& A copied CSR graph
+     */
+    CsrGraph<T, W>& operator = (CsrGraph<T, W> rhs) {
+        swap(*this, rhs);
+        return *this;
+    }
+
+    /**
+     * @brief Checks equality of two CSR graphs. Weights are compared with
+     * the same tolerance as Edge.
+     *
+     * @param lhs The left graph to check
+     * @param rhs The right graph to check
+     * @return true if the graphs are equal, otherwise false
+     */
+    friend bool operator == (
+            const CsrGraph<T, W>& lhs,
+            const CsrGraph<T, W>& rhs) {
+        if (lhs.num_nodes != rhs.num_nodes
+            || lhs.num_edges != rhs.num_edges) {return false;}
+        for (int i = 0; i < lhs.num_nodes; i++) {
+            if (!(lhs.nodes[i] == rhs.nodes[i])
+                || lhs.offsets[i + 1] != rhs.offsets[i + 1]) {return false;}
+        }
+        for (size_t i = 0; i < lhs.num_edges; i++) {
+            if (lhs.targets[i] != rhs.targets[i]
+                || std::abs(csrGraphGetWeight(lhs.weights, i)
+                    - csrGraphGetWeight(rhs.weights, i)) >= 0.001) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Checks inequality of two CSR graphs
+     *
+     * @param lhs The left graph to check
+     * @param rhs The right graph to check
+     * @return true if the graphs are inequal, otherwise false
+     */
+    friend bool operator != (
+            const CsrGraph<T, W>& lhs,
+            const CsrGraph<T, W>& rhs) {
+        return !(lhs == rhs);
+    }
+
+    // Utility Functions
+
+    /**
+     * @brief Swaps the given CSR graphs
+     *
+     * @param lhs The left graph to swap
+     * @param rhs The right graph to swap
+     */
+    friend void swap(CsrGraph<T, W>& lhs, CsrGraph<T, W>& rhs) {
+        using std::swap;
+
+        swap(lhs.num_nodes, rhs.num_nodes);
+        swap(lhs.num_edges, rhs.num_edges);
+        swap(lhs.nodes, rhs.nodes);
+        swap(lhs.offsets, rhs.offsets);
+        swap(lhs.targets, rhs.targets);
+        swap(lhs.weights, rhs.weights);
+        swap(lhs.owns_memory, rhs.owns_memory);
+    }
+};
+
+/**
+ * @brief Allocates the arrays of an empty CSR graph
+ *
+ * @tparam T The type of the graph's data
+ * @tparam W The type of the graph's weights
+ * @param graph The graph to allocate
+ * @param num_nodes The number of nodes
+ * @param num_edges The number of edges
+ */
+template <typename T, typename W>
+void csrGraphAllocate(CsrGraph<T, W>& graph, int num_nodes, size_t num_edges) {
+    graph.num_nodes = num_nodes;
+    graph.num_edges = num_edges;
+    graph.nodes = new T[num_nodes];
+    graph.offsets = new size_t[num_nodes + 1]();
+    graph.targets = new int[num_edges];
+    csrGraphAllocateWeights(graph.weights, num_edges);
+}
+
+/**
+ * @brief Checks that both ends of every edge are node indices below
+ * num_nodes. Callers that allocate check first, so a throw can't leak.
+ *
+ * @param num_nodes The number of nodes
+ * @param edges The edges, using node indices for from and to
+ */
+inline void csrGraphCheckEdges(
+        int num_nodes,
+        const DynamicArray<Edge<int>>& edges) {
+    for (size_t i = 0; i < edges.size; i++) {
+        if (edges[i].from < 0 || edges[i].from >= num_nodes
+            || edges[i].to < 0 || edges[i].to >= num_nodes) {
+            throw std::logic_error("Can't add an edge to a missing node.");
+        }
+    }
+}
+
+/**
+ * @brief Fills the offsets, targets and weights of an allocated graph from
+ * an edge list of node indices with a counting sort. Edges from the same
+ * node keep their order in the list.
+ *
+ * @tparam T The type of the graph's data
+ * @tparam W The type of the graph's weights
+ * @param graph The allocated graph to fill
+ * @param edges The edges, using node indices for from and to
+ */
+template <typename T, typename W>
+void csrGraphFillEdges(
+        CsrGraph<T, W>& graph,
+        const DynamicArray<Edge<int>>& edges) {
+    csrGraphCheckEdges(graph.num_nodes, edges);
+    for (size_t i = 0; i < edges.size; i++) {
+        graph.offsets[edges[i].from + 1]++;
+    }
+    for (int i = 0; i < graph.num_nodes; i++) {
+        graph.offsets[i + 1] += graph.offsets[i];
+    }
+
+    DynamicArray<size_t> positions(graph.num_nodes);
+    for (int i = 0; i < graph.num_nodes; i++) {
+        dynamicArrayPushBack(positions, graph.offsets[i]);
+    }
+    for (size_t i = 0; i < edges.size; i++) {
+        size_t position = positions[edges[i].from]++;
+        graph.targets[position] = edges[i].to;
+        csrGraphSetWeight(graph.weights, position, edges[i].weight);
+    }
+}
+
+/**
+ * @brief Turns the edges of a graph file with integer nodes into edges of
+ * node indices, which are the node values themselves. Checks every edge
+ * first, so a throw leaves nothing allocated.
+ *
+ * @tparam T The type of the graph's data, an integer type
+ * @param size The number of nodes given on the file's first line
+ * @param edges The file's edges. Freed
+ * @param indexed Where to store the edges of node indices
+ */
+template <typename T>
+void csrGraphIndexFileEdges(
+        int size,
+        DynamicArray<Edge<T>>& edges,
+        DynamicArray<Edge<int>>& indexed) {
+    unsigned long long limit = size > 0 ? size : 0;
+    for (size_t i = 0; i < edges.size; i++) {
+        if (edges[i].from < T() || edges[i].to < T()
+            || static_cast<unsigned long long>(edges[i].from) >= limit
+            || static_cast<unsigned long long>(edges[i].to) >= limit) {
+            throw std::logic_error("Can't add an edge to a missing node.");
+        }
+    }
+    dynamicArrayResize(indexed, edges.size);
+    for (size_t i = 0; i < edges.size; i++) {
+        indexed[i] = Edge<int>(
+            static_cast<int>(edges[i].from),
+            static_cast<int>(edges[i].to),
+            edges[i].weight);
+    }
+    DynamicArray<Edge<T>> freed;
+    swap(edges, freed);
+}
+
+/**
+ * @brief Int nodes are already node indices, so the edges are only
+ * checked and moved
+ *
+ * @param size The number of nodes given on the file's first line
+ * @param edges The file's edges. Moved into indexed
+ * @param indexed Where to store the edges of node indices
+ */
+inline void csrGraphIndexFileEdges(
+        int size,
+        DynamicArray<Edge<int>>& edges,
+        DynamicArray<Edge<int>>& indexed) {
+    csrGraphCheckEdges(size, edges);
+    swap(edges, indexed);
+}
+
+/**
+ * @brief Fills an empty CSR graph from the edges of a graph file with
+ * integer nodes, which are 0 up to size - 1, so nodes without edges are
+ * kept and each node's index is its value
+ *
+ * @tparam T The type of the graph's data, an integer type
+ * @tparam W The type of the graph's weights
+ * @param graph The empty graph to fill
+ * @param size The number of nodes given on the file's first line
+ * @param edges The file's edges. Freed
+ * @param direction Whether to add the reverse of every edge
+ */
+template <typename T, typename W>
+void csrGraphFillFileEdges(
+        CsrGraph<T, W>& graph,
+        int size,
+        DynamicArray<Edge<T>>& edges,
+        GraphDirection direction,
+        std::true_type) {
+    graphCheckFileSize<T>(size);
+    DynamicArray<Edge<int>> indexed;
+    csrGraphIndexFileEdges(size, edges, indexed);
+    if (direction == GRAPH_UNDIRECTED) {graphAddReverseEdges(indexed);}
+    csrGraphAllocate(graph, size, indexed.size);
+    for (int i = 0; i < size; i++) {graph.nodes[i] = static_cast<T>(i);}
+    csrGraphFillEdges(graph, indexed);
+}
+
+/**
+ * @brief Fills an empty CSR graph from the edges of a graph file with
+ * other nodes, such as strings. Nodes are numbered in the order they
+ * first appear, like the nodes of a Graph built from the same file.
+ *
+ * @tparam T The type of the graph's data
+ * @tparam W The type of the graph's weights
+ * @param graph The empty graph to fill
+ * @param edges The file's edges. Freed
+ * @param direction Whether to add the reverse of every edge
+ */
+template <typename T, typename W>
+void csrGraphFillFileEdges(
+        CsrGraph<T, W>& graph,
+        int,
+        DynamicArray<Edge<T>>& edges,
+        GraphDirection direction,
+        std::false_type) {
+    VertexIdMap<T, int> ids;
+    DynamicArray<Edge<int>> indexed;
+    vertexIdMapRemapEdges(ids, edges, indexed);
+    DynamicArray<Edge<T>> freed;
+    swap(edges, freed);
+    if (direction == GRAPH_UNDIRECTED) {graphAddReverseEdges(indexed);}
+    csrGraphAllocate(graph, static_cast<int>(ids.values.size), indexed.size);
+    for (int i = 0; i < graph.num_nodes; i++) {
+        graph.nodes[i] = std::move(ids.values[i]);
+    }
+    csrGraphFillEdges(graph, indexed);
+}
+
+/**
+ * @brief Fills an empty CSR graph from the edges of a graph file, picking
+ * how by the node type
+ *
+ * @tparam T The type of the graph's data
+ * @tparam W The type of the graph's weights
+ * @param graph The empty graph to fill
+ * @param size The number of nodes given on the file's first line, which
+ * only integer graphs use
+ * @param edges The file's edges. Freed
+ * @param direction Whether to add the reverse of every edge
+ */
+template <typename T, typename W>
+void csrGraphFillFileEdges(
+        CsrGraph<T, W>& graph,
+        int size,
+        DynamicArray<Edge<T>>& edges,
+        GraphDirection direction) {
+    csrGraphFillFileEdges(
+        graph, size, edges, direction, std::is_integral<T>());
+}
+
+/**
+ * @brief Builds the transpose of a CSR graph, where every edge is reversed.
+ * Nodes keep their indices. Edges into the same node keep the order of
+ * their sources, so the transpose is sorted by target.
+ *
+ * @tparam T The type of the graph's data
+ * @tparam W The type of the graph's weights
+ * @param graph The graph to transpose
+ * @return CsrGraph<T, W> The transposed graph
+ */
+template <typename T, typename W>
+CsrGraph<T, W> csrGraphTranspose(const CsrGraph<T, W>& graph) {
+    CsrGraph<T, W> transpose;
+    csrGraphAllocate(transpose, graph.num_nodes, graph.num_edges);
+    for (int i = 0; i < graph.num_nodes; i++) {
+        transpose.nodes[i] = graph.nodes[i];
+    }
+    for (size_t i = 0; i < graph.num_edges; i++) {
+        transpose.offsets[graph.targets[i] + 1]++;
+    }
+    for (int i = 0; i < graph.num_nodes; i++) {
+        transpose.offsets[i + 1] += transpose.offsets[i];
+    }
+
+    DynamicArray<size_t> positions(graph.num_nodes);
+    for (int i = 0; i < graph.num_nodes; i++) {
+        dynamicArrayPushBack(positions, transpose.offsets[i]);
+    }
+    for (int from = 0; from < graph.num_nodes; from++) {
+        for (size_t i = graph.offsets[from]; i < graph.offsets[from + 1]; i++) {
+            size_t position = positions[graph.targets[i]]++;
+            transpose.targets[position] = from;
+            csrGraphSetWeight(transpose.weights, position,
+                csrGraphGetWeight(graph.weights, i));
+        }
+    }
+    return transpose;
+}
+
+/**
+ * @brief Gets the number of nodes in the CSR graph
+ *
+ * @tparam T The type of the graph's data
+ * @tparam W The type of the graph's weights
+ * @param graph The graph
+ * @return int The number of nodes in the graph
+ */
+template <typename T, typename W>
+int csrGraphGetNumNodes(const CsrGraph<T, W>& graph) {
+    return graph.num_nodes;
+}
+
+/**
+ * @brief Gets the number of edges in the CSR graph
+ *
+ * @tparam T The type of the graph's data
+ * @tparam W The type of the graph's weights
+ * @param graph The graph
+ * @return size_t The number of edges in the graph
+ */
+template <typename T, typename W>
+size_t csrGraphGetNumEdges(const CsrGraph<T, W>& graph) {
+    return graph.num_edges;
+}
+
+/**
+ * @brief Gets the number of outgoing edges of a node
+ *
+ * @tparam T The type of the graph's data
+ * @tparam W The type of the graph's weights
+ * @param graph The graph
+ * @param node The index of the node
+ * @return size_t The node's out-degree
+ */
+template <typename T, typename W>
+size_t csrGraphGetDegree(const CsrGraph<T, W>& graph, int node) {
+    return graph.offsets[node + 1] - graph.offsets[node];
+}
+
+/**
+ * @brief Gets the outgoing edges of a node as a contiguous span
+ *
+ * @tparam T The type of the graph's data
+ * @tparam W The type of the graph's weights
+ * @param graph The graph
+ * @param node The index of the node
+ * @return CsrNeighbors<W> The node's targets and weights
+ */
+template <typename T, typename W>
+CsrNeighbors<W> csrGraphGetNeighbors(const CsrGraph<T, W>& graph, int node) {
+    size_t start = graph.offsets[node];
+    return CsrNeighbors<W>(
+        graph.targets + start,
+        csrGraphOffsetWeights(graph.weights, start),
+        graph.offsets[node + 1] - start);
+}
+
+/**
+ * @brief Gets the index of a node from its value. This scans the nodes
+ * table, so hold on to indices rather than calling this in a loop.
+ *
+ * @tparam T The type of the graph's data
+ * @tparam W The type of the graph's weights
+ * @param graph The graph to search
+ * @param data The node to search for
+ * @return int The index of the node, or -1 if it isn't in the graph
+ */
+template <typename T, typename W>
+int csrGraphGetIndex(const CsrGraph<T, W>& graph, T data) {
+    for (int i = 0; i < graph.num_nodes; i++) {
+        if (graph.nodes[i] == data) {return i;}
+    }
+    return -1;
+}
+
+/**
+ * @brief Checks if the graph has an edge between two node indices
+ *
+ * @tparam T The type of the graph's data
+ * @tparam W The type of the graph's weights
+ * @param graph The graph to search
+ * @param from The index of the edge's source
+ * @param to The index of the edge's destination
+ * @return true if the edge is in the graph, otherwise false
+ */
+template <typename T, typename W>
+bool csrGraphHasEdge(const CsrGraph<T, W>& graph, int from, int to) {
+    for (int target : csrGraphGetNeighbors(graph, from)) {
+        if (target == to) {return true;}
+    }
+    return false;
+}
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef DOUBLE_LINKED_LIST_CPP
 #define DOUBLE_LINKED_LIST_CPP
 
+#include "../memory/node_pool.cpp"
+
 /**
  * @brief Generic double linked list class
  * 
@@ -26,19 +28,46 @@ struct DoubleLinkedList {
 
     /**
      * @brief Copy constructor for the double linked list. We only go in
-     * one direction because we will infinitely loop otherwise!
+     * one direction because we will infinitely loop otherwise! Nodes are
+     * copied in a loop so long lists can't overflow the stack.
      * 
      * @param other The double linked list to copy
      */
-    DoubleLinkedList(const DoubleLinkedList<T>& other) {
-        copyConstructorHelper(this, other, nullptr);
+    DoubleLinkedList(const DoubleLinkedList<T>& other):
+            data(other.data), prev(nullptr), next(nullptr) {
+        DoubleLinkedList<T>* tail = this;
+        for (DoubleLinkedList<T>* node = other.next;
+                node;
+                node = node->next) {
+            tail->next = new DoubleLinkedList<T>(node->data, tail, nullptr);
+            tail = tail->next;
+        }
     }
 
-    // Destructor
-    ~DoubleLinkedList() {delete next;}
+    /**
+     * @brief Destructor. Frees the nodes after this one in a loop, unlinking
+     * each before deleting it, rather than through nested destructor calls
+     */
+    ~DoubleLinkedList() {
+        while (next) {
+            DoubleLinkedList<T>* node = next;
+            next = node->next;
+            node->next = nullptr;
+            delete node;
+        }
+    }
 
     // Operators
 
+    // Nodes live in the node pools, see NodePool
+    static void* operator new(size_t size) {
+        return nodePoolAllocate<sizeof(DoubleLinkedList<T>)>(size);
+    }
+
+    static void operator delete(void* pointer, size_t size) {
+        nodePoolDeallocate<sizeof(DoubleLinkedList<T>)>(pointer, size);
+    }
+
     /**
      * @brief Copy assignment operator. Uses the copy-and-swap idiom.
      * 
@@ -46,7 +75,7 @@ struct DoubleLinkedList {
      * @return DoubleLinkedList<T>& A copied double linked list
      */
     DoubleLinkedList<T>& operator = (DoubleLinkedList<T> rhs) {
-        swap(*this, other);
+        swap(*this, rhs);
         return *this;
     }
 
@@ -90,28 +119,6 @@ struct DoubleLinkedList {
 
     // Utility Functions
 
-    /**
-     * @brief Helper function for the copy constructor
-     * 
-     * @param self The double linked list being constructed
-     * @param other The double linked list being copied
-     * @param prev The node to set self->prev to
-     */
-    void copyConstructorHelper(
-            DoubleLinkedList<T>* self, 
-            const DoubleLinkedList<T>& other, 
-            DoubleLinkedList<T>* prev) {
-        self->data = other.data;
-        self->prev = prev;
-
-        if (other.next) {
-            self->next = new DoubleLinkedList<T>(other.next->data);
-            copyConstructorHelper(self->next, *other.next, self);
-        } else {
-            self->next = nullptr;
-        }
-    }
-    
     /**
      * @brief Swaps the provided double linked lists
      * 
@@ -0,0 +1,226 @@
+#ifndef DYNAMIC_ARRAY_CPP
+#define DYNAMIC_ARRAY_CPP
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * @brief Contiguous, geometrically growing array. Elements live in one
+ * block of memory, so walking the array doesn't chase pointers the way the
+ * linked lists do.
+ *
+ * @tparam T Any type. Assumes that the type implements the equality operator
+ * if the equality operator is used
+ */
+template <typename T>
+struct DynamicArray {
+    // Fields
+    T* data;
+    size_t size;
+    size_t capacity;
+
+    // Constructors
+    DynamicArray(): data(nullptr), size(0), capacity(0) {}
+    DynamicArray(size_t capacity): data(nullptr), size(0), capacity(0) {
+        dynamicArrayReserve(*this, capacity);
+    }
+    DynamicArray(const DynamicArray<T>& other):
+            data(nullptr), size(0), capacity(0) {
+        dynamicArrayReserve(*this, other.size);
+        for (size_t i = 0; i < other.size; i++) {
+            new (data + i) T(other.data[i]);
+        }
+        size = other.size;
+    }
+    DynamicArray(DynamicArray<T>&& other):
+            data(other.data), size(other.size), capacity(other.capacity) {
+        other.data = nullptr;
+        other.size = 0;
+        other.capacity = 0;
+    }
+
+    // Destructor
+    ~DynamicArray() {
+        dynamicArrayClear(*this);
+        ::operator delete(data);
+    }
+
+    // Operators
+
+    /**
+     * @brief Copy assignment operator. Uses the copy-and-swap idiom.
+     *
+     * @param rhs The dynamic array to copy
+     * @return DynamicArray<T>& A copied dynamic array
+     */
+    DynamicArray<T>& operator = (DynamicArray<T> rhs) {
+        swap(*this, rhs);
+        return *this;
+    }
+
+    T& operator [] (size_t index) {return data[index];}
+    const T& operator [] (size_t index) const {return data[index];}
+
+    /**
+     * @brief Checks equality of two dynamic arrays. Capacity is ignored.
+     *
+     * @param lhs The first dynamic array to check
+     * @param rhs The second dynamic array to check
+     * @return true if the arrays are equal, otherwise false
+     */
+    friend bool operator == (
+            const DynamicArray<T>& lhs,
+            const DynamicArray<T>& rhs) {
+        if (lhs.size != rhs.size) {return false;}
+        for (size_t i = 0; i < lhs.size; i++) {
+            if (lhs.data[i] != rhs.data[i]) {return false;}
+        }
+        return true;
+    }
+
+    /**
+     * @brief Checks inequality of two dynamic arrays
+     *
+     * @param lhs The first dynamic array to check
+     * @param rhs The second dynamic array to check
+     * @return true if the arrays are inequal, otherwise false
+     */
+    friend bool operator != (
+            const DynamicArray<T>& lhs,
+            const DynamicArray<T>& rhs) {
+        return !(lhs == rhs);
+    }
+
+    // Utility Functions
+
+    /**
+     * @brief Swaps the provided dynamic arrays
+     *
+     * @param first The first dynamic array to swap
+     * @param second The second dynamic array to swap
+     */
+    friend void swap(DynamicArray<T>& first, DynamicArray<T>& second) {
+        using std::swap;
+
+        swap(first.data, second.data);
+        swap(first.size, second.size);
+        swap(first.capacity, second.capacity);
+    }
+};
+
+/**
+ * @brief Grows the array's storage to hold at least capacity elements.
+ * Never shrinks the array.
+ *
+ * @tparam T The type of the array's data
+ * @param array The array to grow
+ * @param capacity The minimum number of elements to hold
+ */
+template <typename T>
+void dynamicArrayReserve(DynamicArray<T>& array, size_t capacity) {
+    if (capacity <= array.capacity) {return;}
+
+    T* data = static_cast<T*>(::operator new(capacity * sizeof(T)));
+    for (size_t i = 0; i < array.size; i++) {
+        new (data + i) T(std::move(array.data[i]));
+        array.data[i].~T();
+    }
+    ::operator delete(array.data);
+    array.data = data;
+    array.capacity = capacity;
+}
+
+/**
+ * @brief Constructs an element in place at the back of the array,
+ * doubling the capacity when the array is full
+ *
+ * @tparam T The type of the array's data
+ * @tparam Args The types of the arguments to T's constructor
+ * @param array The array to insert into
+ * @param args The arguments to construct the element with
+ * @return T& A reference to the new element
+ */
+template <typename T, typename... Args>
+T& dynamicArrayEmplaceBack(DynamicArray<T>& array, Args&&... args) {
+    if (array.size == array.capacity) {
+        dynamicArrayReserve(array, array.capacity ? 2 * array.capacity : 4);
+    }
+    T* element = new (array.data + array.size) T(std::forward<Args>(args)...);
+    array.size++;
+    return *element;
+}
+
+/**
+ * @brief Inserts data at the back of the array
+ *
+ * @tparam T The type of the array's data
+ * @param array The array to insert into
+ * @param data The data to insert
+ */
+template <typename T>
+void dynamicArrayPushBack(DynamicArray<T>& array, T data) {
+    dynamicArrayEmplaceBack(array, std::move(data));
+}
+
+/**
+ * @brief Removes the last element of the array
+ *
+ * @tparam T The type of the array's data
+ * @param array The array to pop from
+ */
+template <typename T>
+void dynamicArrayPopBack(DynamicArray<T>& array) {
+    if (!array.size) {
+        throw std::logic_error("Can't pop from an empty array.");
+    }
+    array.size--;
+    array.data[array.size].~T();
+}
+
+/**
+ * @brief Gets the last element of the array
+ *
+ * @tparam T The type of the array's data
+ * @param array The array to get the back of
+ * @return T& A reference to the last element
+ */
+template <typename T>
+T& dynamicArrayBack(DynamicArray<T>& array) {
+    if (!array.size) {
+        throw std::logic_error("Can't get the back of an empty array.");
+    }
+    return array.data[array.size - 1];
+}
+
+/**
+ * @brief Resizes the array, value-initializing any new elements
+ *
+ * @tparam T The type of the array's data
+ * @param array The array to resize
+ * @param size The new number of elements
+ */
+template <typename T>
+void dynamicArrayResize(DynamicArray<T>& array, size_t size) {
+    dynamicArrayReserve(array, size);
+    while (array.size > size) {dynamicArrayPopBack(array);}
+    while (array.size < size) {
+        new (array.data + array.size) T();
+        array.size++;
+    }
+}
+
+/**
+ * @brief Destroys every element but keeps the storage for reuse
+ *
+ * @tparam T The type of the array's data
+ * @param array The array to clear
+ */
+template <typename T>
+void dynamicArrayClear(DynamicArray<T>& array) {
+    for (size_t i = 0; i < array.size; i++) {array.data[i].~T();}
+    array.size = 0;
+}
+
+#endif
@@ -0,0 +1,674 @@
+#ifndef DYNAMIC_GRAPH_CPP
+#define DYNAMIC_GRAPH_CPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+#include "csr_graph.cpp"
+#include "dynamic_array.cpp"
+#include "edge.cpp"
+#include "../concurrency/thread_pool.cpp"
+
+// Smallest block a node with edges gets, so its first few inserts don't
+// each move it
+const size_t DYNAMIC_GRAPH_MIN_BLOCK = 4;
+
+enum DynamicGraphOperation {
+    DYNAMIC_GRAPH_INSERT,
+    DYNAMIC_GRAPH_DELETE,
+    DYNAMIC_GRAPH_UPDATE
+};
+
+/**
+ * @brief One change to a DynamicGraph's edges. Inserts and updates set the
+ * edge's weight, and deletes ignore it.
+ */
+struct DynamicGraphUpdate {
+    // Fields
+    DynamicGraphOperation operation;
+    Edge<int> edge;
+
+    // Constructors
+    DynamicGraphUpdate(): operation(DYNAMIC_GRAPH_INSERT) {}
+    DynamicGraphUpdate(DynamicGraphOperation operation, Edge<int> edge):
+        operation(operation), edge(edge) {}
+};
+
+/**
+ * @brief One worker's copy of the block it's merging updates into
+ */
+struct DynamicGraphBuffer {
+    // Fields
+    DynamicArray<int> targets;
+    DynamicArray<double> weights;
+};
+
+/**
+ * @brief Directed graph over the node ids 0 to num_nodes - 1 that takes
+ * batches of edge inserts, deletes and updates. Each node's edges are one
+ * block of a shared slab, sorted by target, with targets and weights in
+ * separate arrays like a CsrGraph. Reading a node's neighbors is one
+ * contiguous scan, and finding an edge is a binary search.
+ *
+ * Blocks keep some slack for inserts. A block that outgrows its slack is
+ * moved to the end of the slab with room to spare. Once moved-out blocks
+ * waste about half the slab, the slab is compacted back into node order.
+ *
+ * Give other node values ids with a VertexIdMap.
+ *
+ * @tparam W The type of the edge weights, as for CsrGraph
+ */
+template <typename W = double>
+struct DynamicGraph {
+public:
+    // Fields
+    int num_nodes;
+    size_t num_edges;
+    DynamicArray<size_t> starts;
+    DynamicArray<size_t> degrees;
+    DynamicArray<size_t> capacities;
+    int* targets;
+    W* weights;
+    // Slots handed out to blocks, including ones moved out of
+    size_t slab_size;
+    size_t slab_capacity;
+
+    // Constructors
+    DynamicGraph(): num_nodes(0), num_edges(0), targets(nullptr),
+        weights(nullptr), slab_size(0), slab_capacity(0) {}
+
+    /**
+     * @brief Makes a graph with the given number of nodes and no edges
+     *
+     * @param num_nodes The number of nodes
+     */
+    DynamicGraph(int num_nodes): DynamicGraph() {
+        dynamicGraphAddNodes(*this, num_nodes);
+    }
+
+    /**
+     * @brief Copies the graph. Only the nodes' blocks are copied, so the
+     * copy is as compact as the original.
+     *
+     * @param other The graph to copy
+     */
+    DynamicGraph(const DynamicGraph<W>& other): num_nodes(other.num_nodes),
+            num_edges(other.num_edges), starts(other.starts),
+            degrees(other.degrees), capacities(other.capacities),
+            targets(nullptr), weights(nullptr), slab_size(other.slab_size),
+            slab_capacity(other.slab_size) {
+        targets = new int[slab_capacity];
+        csrGraphAllocateWeights(weights, slab_capacity);
+        for (int node = 0; node < num_nodes; node++) {
+            size_t end = starts[node] + degrees[node];
+            for (size_t i = starts[node]; i < end; i++) {
+                targets[i] = other.targets[i];
+                csrGraphSetWeight(weights, i,
+                    csrGraphGetWeight(other.weights, i));
+            }
+        }
+    }
+
+    // Destructor
+    ~DynamicGraph() {
+        delete[] targets;
+        csrGraphFreeWeights(weights);
+    }
+
+    // Operators
+
+    /**
+     * @brief Copy assignment operator. Uses the copy-and-swap idiom.
+     *
+     * @param rhs The graph to copy
+     * @return DynamicGraph<W>& A copied graph
+     */
+    DynamicGraph<W>& operator = (DynamicGraph<W> rhs) {
+        swap(*this, rhs);
+        return *this;
+    }
+
+    /**
+     * @brief Checks that the graphs have the same nodes and edges, wherever
+     * their blocks are in the slab. Weights are compared within 0.001
+     *
+     * @param lhs The left graph to check
+     * @param rhs The right graph to check
+     * @return true if the graphs are equal, otherwise false
+     */
+    friend bool operator == (
+            const DynamicGraph<W>& lhs,
+            const DynamicGraph<W>& rhs) {
+        if (lhs.num_nodes != rhs.num_nodes
+            || lhs.num_edges != rhs.num_edges) {
+            return false;
+        }
+        for (int node = 0; node < lhs.num_nodes; node++) {
+            if (lhs.degrees[node] != rhs.degrees[node]) {return false;}
+            for (size_t i = 0; i < lhs.degrees[node]; i++) {
+                size_t left = lhs.starts[node] + i;
+                size_t right = rhs.starts[node] + i;
+                if (lhs.targets[left] != rhs.targets[right]
+                    || std::abs(csrGraphGetWeight(lhs.weights, left)
+                        - csrGraphGetWeight(rhs.weights, right)) >= 0.001) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Checks inequality of the two graphs
+     *
+     * @param lhs The left graph to check
+     * @param rhs The right graph to check
+     * @return true if the graphs are not equal, otherwise false
+     */
+    friend bool operator != (
+            const DynamicGraph<W>& lhs,
+            const DynamicGraph<W>& rhs) {
+        return !(lhs == rhs);
+    }
+
+    // Utility Functions
+
+    /**
+     * @brief Swaps the given graphs
+     *
+     * @param lhs The left graph to swap
+     * @param rhs The right graph to swap
+     */
+    friend void swap(DynamicGraph<W>& lhs, DynamicGraph<W>& rhs) {
+        using std::swap;
+
+        swap(lhs.num_nodes, rhs.num_nodes);
+        swap(lhs.num_edges, rhs.num_edges);
+        swap(lhs.starts, rhs.starts);
+        swap(lhs.degrees, rhs.degrees);
+        swap(lhs.capacities, rhs.capacities);
+        swap(lhs.targets, rhs.targets);
+        swap(lhs.weights, rhs.weights);
+        swap(lhs.slab_size, rhs.slab_size);
+        swap(lhs.slab_capacity, rhs.slab_capacity);
+    }
+};
+
+/**
+ * @brief Gets the size of the block a node with the given degree gets when
+ * its block is moved or compacted. A quarter again as much is left for
+ * inserts; more slack makes reads cover more memory
+ *
+ * @param degree The node's number of edges
+ * @return size_t The number of slots in the block
+ */
+inline size_t dynamicGraphBlockCapacity(size_t degree) {
+    if (!degree) {return 0;}
+    size_t capacity = degree + degree / 4;
+    return capacity < DYNAMIC_GRAPH_MIN_BLOCK
+        ? DYNAMIC_GRAPH_MIN_BLOCK
+        : capacity;
+}
+
+/**
+ * @brief Orders updates by source, then by target
+ *
+ * @param lhs The left update to compare
+ * @param rhs The right update to compare
+ * @return true if lhs goes before rhs, otherwise false
+ */
+inline bool dynamicGraphUpdateLess(
+        const DynamicGraphUpdate& lhs,
+        const DynamicGraphUpdate& rhs) {
+    if (lhs.edge.from != rhs.edge.from) {return lhs.edge.from < rhs.edge.from;}
+    return lhs.edge.to < rhs.edge.to;
+}
+
+/**
+ * @brief Sorts a batch of updates by source, then by target, the order
+ * dynamicGraphApplyUpdates takes them in
+ *
+ * @param updates The updates to sort
+ */
+inline void dynamicGraphSortUpdates(DynamicArray<DynamicGraphUpdate>& updates) {
+    std::stable_sort(updates.data, updates.data + updates.size,
+        dynamicGraphUpdateLess);
+}
+
+/**
+ * @brief Adds nodes with no edges to the graph. They get the next ids
+ *
+ * @tparam W The type of the graph's weights
+ * @param graph The graph to add nodes to
+ * @param count The number of nodes to add
+ */
+template <typename W>
+void dynamicGraphAddNodes(DynamicGraph<W>& graph, int count) {
+    if (count < 0) {
+        throw std::logic_error("Can't add a negative number of nodes.");
+    }
+    graph.num_nodes += count;
+    dynamicArrayResize(graph.starts, graph.num_nodes);
+    dynamicArrayResize(graph.degrees, graph.num_nodes);
+    dynamicArrayResize(graph.capacities, graph.num_nodes);
+}
+
+/**
+ * @brief Gets the number of nodes in the graph
+ *
+ * @tparam W The type of the graph's weights
+ * @param graph The graph
+ * @return int The number of nodes in the graph
+ */
+template <typename W>
+int dynamicGraphGetNumNodes(const DynamicGraph<W>& graph) {
+    return graph.num_nodes;
+}
+
+/**
+ * @brief Gets the number of edges in the graph
+ *
+ * @tparam W The type of the graph's weights
+ * @param graph The graph
+ * @return size_t The number of edges in the graph
+ */
+template <typename W>
+size_t dynamicGraphGetNumEdges(const DynamicGraph<W>& graph) {
+    return graph.num_edges;
+}
+
+/**
+ * @brief Gets the number of outgoing edges of a node
+ *
+ * @tparam W The type of the graph's weights
+ * @param graph The graph
+ * @param node The id of the node
+ * @return size_t The node's out-degree
+ */
+template <typename W>
+size_t dynamicGraphGetDegree(const DynamicGraph<W>& graph, int node) {
+    return graph.degrees[node];
+}
+
+/**
+ * @brief Gets the outgoing edges of a node as a contiguous span, sorted by
+ * target. The span is good until the next batch of updates.
+ *
+ * @tparam W The type of the graph's weights
+ * @param graph The graph
+ * @param node The id of the node
+ * @return CsrNeighbors<W> The node's targets and weights
+ */
+template <typename W>
+CsrNeighbors<W> dynamicGraphGetNeighbors(
+        const DynamicGraph<W>& graph,
+        int node) {
+    size_t start = graph.starts[node];
+    return CsrNeighbors<W>(
+        graph.targets + start,
+        csrGraphOffsetWeights(graph.weights, start),
+        graph.degrees[node]);
+}
+
+/**
+ * @brief Finds an edge's slot in the slab with a binary search of its
+ * source's block
+ *
+ * @tparam W The type of the graph's weights
+ * @param graph The graph to search
+ * @param from The id of the edge's source
+ * @param to The id of the edge's destination
+ * @param slot Where to store the edge's slot, if found
+ * @return true if the edge is in the graph, otherwise false
+ */
+template <typename W>
+bool dynamicGraphFindEdge(
+        const DynamicGraph<W>& graph,
+        int from,
+        int to,
+        size_t* slot) {
+    const int* begin = graph.targets + graph.starts[from];
+    const int* end = begin + graph.degrees[from];
+    const int* found = std::lower_bound(begin, end, to);
+    if (found == end || *found != to) {return false;}
+    *slot = static_cast<size_t>(found - graph.targets);
+    return true;
+}
+
+/**
+ * @brief Checks if the graph has an edge between two node ids
+ *
+ * @tparam W The type of the graph's weights
+ * @param graph The graph to search
+ * @param from The id of the edge's source
+ * @param to The id of the edge's destination
+ * @return true if the edge is in the graph, otherwise false
+ */
+template <typename W>
+bool dynamicGraphHasEdge(const DynamicGraph<W>& graph, int from, int to) {
+    size_t slot = 0;
+    return dynamicGraphFindEdge(graph, from, to, &slot);
+}
+
+/**
+ * @brief Gets the weight of an edge
+ *
+ * @tparam W The type of the graph's weights
+ * @param graph The graph to search
+ * @param from The id of the edge's source
+ * @param to The id of the edge's destination
+ * @param weight Where to store the weight, if the edge is found
+ * @return true if the edge is in the graph, otherwise false
+ */
+template <typename W>
+bool dynamicGraphGetWeight(
+        const DynamicGraph<W>& graph,
+        int from,
+        int to,
+        double* weight) {
+    size_t slot = 0;
+    if (!dynamicGraphFindEdge(graph, from, to, &slot)) {return false;}
+    *weight = csrGraphGetWeight(graph.weights, slot);
+    return true;
+}
+
+/**
+ * @brief Makes the slab hold at least the given number of slots, at least
+ * doubling it so moving blocks to the end stays amortized O(1) per slot.
+ * Only the nodes' blocks are copied over.
+ *
+ * @tparam W The type of the graph's weights
+ * @param graph The graph to grow
+ * @param capacity The number of slots needed
+ */
+template <typename W>
+void dynamicGraphGrowSlab(DynamicGraph<W>& graph, size_t capacity) {
+    if (capacity <= graph.slab_capacity) {return;}
+    if (capacity < 2 * graph.slab_capacity) {
+        capacity = 2 * graph.slab_capacity;
+    }
+    int* targets = new int[capacity];
+    W* weights = nullptr;
+    csrGraphAllocateWeights(weights, capacity);
+    for (int node = 0; node < graph.num_nodes; node++) {
+        size_t end = graph.starts[node] + graph.degrees[node];
+        for (size_t i = graph.starts[node]; i < end; i++) {
+            targets[i] = graph.targets[i];
+            csrGraphSetWeight(weights, i, csrGraphGetWeight(graph.weights, i));
+        }
+    }
+    delete[] graph.targets;
+    csrGraphFreeWeights(graph.weights);
+    graph.targets = targets;
+    graph.weights = weights;
+    graph.slab_capacity = capacity;
+}
+
+/**
+ * @brief Rewrites the slab with every node's block in node order and only
+ * the usual slack, dropping the space of blocks that were moved out of.
+ * Reads then walk the slab in order, like a CsrGraph.
+ *
+ * @tparam W The type of the graph's weights
+ * @param graph The graph to compact
+ * @param pool The pool to copy the blocks on
+ */
+template <typename W>
+void dynamicGraphCompact(
+        DynamicGraph<W>& graph,
+        ThreadPool& pool = threadPoolGetDefault()) {
+    DynamicArray<size_t> starts;
+    dynamicArrayResize(starts, graph.num_nodes);
+    size_t size = 0;
+    for (int node = 0; node < graph.num_nodes; node++) {
+        starts[node] = size;
+        size += dynamicGraphBlockCapacity(graph.degrees[node]);
+    }
+    int* targets = new int[size];
+    W* weights = nullptr;
+    csrGraphAllocateWeights(weights, size);
+    threadPoolParallelFor(pool, 0, graph.num_nodes,
+            [&](int begin, int end, int worker) {
+        for (int node = begin; node < end; node++) {
+            size_t from = graph.starts[node];
+            for (size_t i = 0; i < graph.degrees[node]; i++) {
+                targets[starts[node] + i] = graph.targets[from + i];
+                csrGraphSetWeight(weights, starts[node] + i,
+                    csrGraphGetWeight(graph.weights, from + i));
+            }
+        }
+    });
+
+    for (int node = 0; node < graph.num_nodes; node++) {
+        graph.capacities[node] = dynamicGraphBlockCapacity(graph.degrees[node]);
+    }
+    delete[] graph.targets;
+    csrGraphFreeWeights(graph.weights);
+    graph.targets = targets;
+    graph.weights = weights;
+    swap(graph.starts, starts);
+    graph.slab_size = size;
+    graph.slab_capacity = size;
+}
+
+/**
+ * @brief Checks one node's updates against its block and counts its edges
+ * once they're applied
+ *
+ * @tparam W The type of the graph's weights
+ * @param graph The graph to update
+ * @param updates The node's updates, sorted by target
+ * @param length The number of updates
+ * @return size_t The node's new out-degree
+ */
+template <typename W>
+size_t dynamicGraphCountUpdates(
+        const DynamicGraph<W>& graph,
+        const DynamicGraphUpdate* updates,
+        size_t length) {
+    int from = updates[0].edge.from;
+    const int* block = graph.targets + graph.starts[from];
+    size_t degree = graph.degrees[from];
+    size_t new_degree = degree;
+    size_t k = 0;
+    for (size_t i = 0; i < length; i++) {
+        int to = updates[i].edge.to;
+        while (k < degree && block[k] < to) {k++;}
+        bool found = k < degree && block[k] == to;
+        if (updates[i].operation == DYNAMIC_GRAPH_INSERT) {
+            if (found) {
+                throw std::logic_error(
+                    "Can't insert an edge if the edge already exists.");
+            }
+            new_degree++;
+        } else if (updates[i].operation == DYNAMIC_GRAPH_UPDATE) {
+            if (!found) {
+                throw std::logic_error(
+                    "Can't update an edge that doesn't exist.");
+            }
+        } else if (found) {
+            new_degree--;
+        }
+    }
+    return new_degree;
+}
+
+/**
+ * @brief Merges one node's block with its updates and writes the result
+ * to the node's new block. The old block is copied to the worker's buffer
+ * first, so a block that stays where it is can't be overwritten before
+ * it's read.
+ *
+ * @tparam W The type of the graph's weights
+ * @param graph The graph to update
+ * @param updates The node's updates, sorted by target and already checked
+ * @param length The number of updates
+ * @param destination The slot the node's new block starts at
+ * @param buffer The worker's buffer
+ */
+template <typename W>
+void dynamicGraphMergeUpdates(
+        DynamicGraph<W>& graph,
+        const DynamicGraphUpdate* updates,
+        size_t length,
+        size_t destination,
+        DynamicGraphBuffer& buffer) {
+    int from = updates[0].edge.from;
+    size_t start = graph.starts[from];
+    size_t degree = graph.degrees[from];
+    dynamicArrayResize(buffer.targets, degree);
+    dynamicArrayResize(buffer.weights, degree);
+    for (size_t k = 0; k < degree; k++) {
+        buffer.targets[k] = graph.targets[start + k];
+        buffer.weights[k] = csrGraphGetWeight(graph.weights, start + k);
+    }
+
+    size_t k = 0;
+    size_t out = destination;
+    for (size_t i = 0; i < length; i++) {
+        int to = updates[i].edge.to;
+        for (; k < degree && buffer.targets[k] < to; k++, out++) {
+            graph.targets[out] = buffer.targets[k];
+            csrGraphSetWeight(graph.weights, out, buffer.weights[k]);
+        }
+        if (k < degree && buffer.targets[k] == to) {k++;}
+        if (updates[i].operation != DYNAMIC_GRAPH_DELETE) {
+            graph.targets[out] = to;
+            csrGraphSetWeight(graph.weights, out, updates[i].edge.weight);
+            out++;
+        }
+    }
+    for (; k < degree; k++, out++) {
+        graph.targets[out] = buffer.targets[k];
+        csrGraphSetWeight(graph.weights, out, buffer.weights[k]);
+    }
+}
+
+/**
+ * @brief Applies a batch of edge inserts, deletes and updates. The batch
+ * must be strictly sorted by source, then target, so it touches each edge
+ * at most once; see dynamicGraphSortUpdates.
+ *
+ * The updates to each node are merged with its sorted block in one pass,
+ * and different nodes are merged in parallel on the pool, so a batch
+ * costs O(updates + degrees of the nodes it touches).
+ *
+ * Throws if an edge's nodes don't exist, an inserted edge already exists,
+ * or an updated edge doesn't exist. Deleting a missing edge does nothing,
+ * like graphDeleteEdge. Every update is checked before any are applied,
+ * so a failed batch leaves the graph as is.
+ *
+ * @tparam W The type of the graph's weights
+ * @param graph The graph to update
+ * @param updates The sorted batch of updates
+ * @param pool The pool to apply the updates on
+ */
+template <typename W>
+void dynamicGraphApplyUpdates(
+        DynamicGraph<W>& graph,
+        const DynamicArray<DynamicGraphUpdate>& updates,
+        ThreadPool& pool = threadPoolGetDefault()) {
+    // Split the batch into runs of updates to the same node
+    DynamicArray<size_t> runs;
+    for (size_t i = 0; i < updates.size; i++) {
+        const Edge<int>& edge = updates[i].edge;
+        if (edge.from < 0 || edge.from >= graph.num_nodes
+            || edge.to < 0 || edge.to >= graph.num_nodes) {
+            throw std::logic_error("Can't update an edge of a missing node.");
+        }
+        if (i && !dynamicGraphUpdateLess(updates[i - 1], updates[i])) {
+            throw std::logic_error(
+                "Can't apply updates that aren't strictly sorted.");
+        }
+        if (!i || updates[i - 1].edge.from != edge.from) {
+            dynamicArrayPushBack(runs, i);
+        }
+    }
+    if (!runs.size) {return;}
+    dynamicArrayPushBack(runs, updates.size);
+    int num_runs = static_cast<int>(runs.size) - 1;
+
+    DynamicArray<size_t> new_degrees;
+    dynamicArrayResize(new_degrees, num_runs);
+    threadPoolParallelFor(pool, 0, num_runs,
+            [&](int begin, int end, int worker) {
+        for (int run = begin; run < end; run++) {
+            new_degrees[run] = dynamicGraphCountUpdates(graph,
+                updates.data + runs[run], runs[run + 1] - runs[run]);
+        }
+    });
+
+    // Blocks that outgrow their slack move to the end of the slab
+    DynamicArray<size_t> destinations;
+    dynamicArrayResize(destinations, num_runs);
+    size_t slab_size = graph.slab_size;
+    for (int run = 0; run < num_runs; run++) {
+        int from = updates[runs[run]].edge.from;
+        if (new_degrees[run] <= graph.capacities[from]) {
+            destinations[run] = graph.starts[from];
+        } else {
+            destinations[run] = slab_size;
+            slab_size += dynamicGraphBlockCapacity(new_degrees[run]);
+        }
+    }
+    dynamicGraphGrowSlab(graph, slab_size);
+    graph.slab_size = slab_size;
+
+    ThreadPoolScratch<DynamicGraphBuffer> buffers(pool);
+    threadPoolParallelFor(pool, 0, num_runs,
+            [&](int begin, int end, int worker) {
+        DynamicGraphBuffer& buffer = threadPoolScratchGet(buffers, worker);
+        for (int run = begin; run < end; run++) {
+            dynamicGraphMergeUpdates(graph, updates.data + runs[run],
+                runs[run + 1] - runs[run], destinations[run], buffer);
+        }
+    });
+    for (int run = 0; run < num_runs; run++) {
+        int from = updates[runs[run]].edge.from;
+        if (new_degrees[run] > graph.capacities[from]) {
+            graph.starts[from] = destinations[run];
+            graph.capacities[from] =
+                dynamicGraphBlockCapacity(new_degrees[run]);
+        }
+        graph.num_edges += new_degrees[run];
+        graph.num_edges -= graph.degrees[from];
+        graph.degrees[from] = new_degrees[run];
+    }
+
+    // Compacting shrinks the slab to at most compact_size, so the slab
+    // has to double again before the next compaction
+    size_t compact_size = graph.num_edges + graph.num_edges / 4
+        + DYNAMIC_GRAPH_MIN_BLOCK * graph.num_nodes;
+    if (graph.slab_size > 2 * compact_size) {dynamicGraphCompact(graph, pool);}
+}
+
+/**
+ * @brief Freezes the graph into a CsrGraph whose nodes are the ids, for
+ * the algorithms that run on CSR graphs. Edges keep their sorted order.
+ *
+ * @tparam W The type of the graph's weights
+ * @param graph The graph to freeze
+ * @return CsrGraph<int, W> The frozen graph
+ */
+template <typename W>
+CsrGraph<int, W> dynamicGraphToCsr(const DynamicGraph<W>& graph) {
+    CsrGraph<int, W> csr;
+    csrGraphAllocate(csr, graph.num_nodes, graph.num_edges);
+    for (int node = 0; node < graph.num_nodes; node++) {
+        csr.nodes[node] = node;
+        size_t offset = csr.offsets[node];
+        csr.offsets[node + 1] = offset + graph.degrees[node];
+        for (size_t i = 0; i < graph.degrees[node]; i++) {
+            size_t slot = graph.starts[node] + i;
+            csr.targets[offset + i] = graph.targets[slot];
+            csrGraphSetWeight(csr.weights, offset + i,
+                csrGraphGetWeight(graph.weights, slot));
+        }
+    }
+    return csr;
+}
+
+#endif
@@ -0,0 +1,239 @@
+#ifndef EYTZINGER_TREE_CPP
+#define EYTZINGER_TREE_CPP
+
+#include <iterator>
+#include <stdexcept>
+
+#include "binary_tree.cpp"
+#include "dynamic_array.cpp"
+
+// Searches run in lockstep in groups of this many keys
+const int EYTZINGER_TREE_BATCH_SIZE = 8;
+
+/**
+ * @brief Gets the index of the first node in order in an Eytzinger
+ * array, the leftmost node
+ *
+ * @param size The number of keys
+ * @return int The index, or 0 if there are no keys
+ */
+inline int eytzingerTreeGetFirst(int size) {
+    if (!size) {return 0;}
+    int k = 1;
+    while (2 * k <= size) {k *= 2;}
+    return k;
+}
+
+/**
+ * @brief Gets the index of the next node in order
+ *
+ * @param k The index of the current node
+ * @param size The number of keys
+ * @return int The index, or 0 after the last node
+ */
+inline int eytzingerTreeGetNext(int k, int size) {
+    if (2 * k + 1 <= size) {
+        k = 2 * k + 1;
+        while (2 * k <= size) {k *= 2;}
+        return k;
+    }
+    // Climb while we're a right child, then once more to the parent
+    while (k & 1) {k >>= 1;}
+    return k >> 1;
+}
+
+/**
+ * @brief Read-only search tree stored in one array in Eytzinger (BFS)
+ * order. The root is keys[1] and node k has children 2k and 2k + 1, so a
+ * search is a loop over indices with no pointers to chase. keys[0] is
+ * unused.
+ *
+ * The top levels of the tree share a few cache lines that stay hot, and
+ * the 16 descendants four levels below node k sit next to each other, so
+ * a search can prefetch them while it works through the levels in between.
+ *
+ * Built once by freezing a BinaryTree, the same way CsrGraph freezes a
+ * Graph. Searches are branchless, so they don't stall on mispredictions.
+ *
+ * @tparam T The type of the keys. Assumes the type implements the less
+ * than and equality operators
+ */
+template <typename T>
+struct EytzingerTree {
+public:
+    // Fields
+    DynamicArray<T> keys;
+    int size;
+
+    // Constructors
+    EytzingerTree(): size(0) {}
+
+    /**
+     * @brief Freezes a binary search tree into Eytzinger order. Walks the
+     * implicit tree in order by index arithmetic while reading the binary
+     * tree in order, so it takes O(n) time and no recursion.
+     *
+     * @param tree The binary search tree to freeze
+     */
+    EytzingerTree(BinaryTree<T>* const& tree): size(0) {
+        BinaryTreeRange<T, BINARY_TREE_INORDER> inorder =
+            binaryTreeInorder(tree);
+        size = static_cast<int>(std::distance(inorder.begin(), inorder.end()));
+        dynamicArrayResize(keys, size + 1);
+
+        int k = eytzingerTreeGetFirst(size);
+        for (BinaryTree<T>& node : inorder) {
+            keys[k] = node.data;
+            k = eytzingerTreeGetNext(k, size);
+        }
+    }
+};
+
+/**
+ * @brief Gets the number of keys in the tree
+ *
+ * @tparam T The type of the keys
+ * @param tree The tree
+ * @return int The number of keys
+ */
+template <typename T>
+int eytzingerTreeGetSize(const EytzingerTree<T>& tree) {
+    return tree.size;
+}
+
+/**
+ * @brief Hints the processor to load the cache line at the pointer. A
+ * no-op on compilers without the builtin.
+ *
+ * @param pointer The address to prefetch
+ */
+inline void eytzingerTreePrefetch(const void* pointer) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(pointer);
+#else
+    (void) pointer;
+#endif
+}
+
+/**
+ * @brief Strips the trailing right turns and the left turn before them
+ * from a search's final index, giving the last node where it went left.
+ * Shifts by the lowest zero bit on compilers with the builtin, and loops
+ * over the trailing ones otherwise.
+ *
+ * @param k The index below a leaf that the search ended at
+ * @return unsigned int The index of the last node where it went left, or 0
+ * if it never did
+ */
+inline unsigned int eytzingerTreeStripRightTurns(unsigned int k) {
+#if defined(__GNUC__) || defined(__clang__)
+    // k + 1 clears the trailing ones, so shift them and the last zero out
+    return k >> __builtin_ffs(static_cast<int>(~k));
+#else
+    while (k & 1) {k >>= 1;}
+    return k >> 1;
+#endif
+}
+
+/**
+ * @brief Gets how many indices ahead to prefetch, enough that the 16
+ * descendants four levels down are roughly one cache line of keys
+ *
+ * @tparam T The type of the keys
+ * @return int The prefetch stride
+ */
+template <typename T>
+int eytzingerTreeGetPrefetchStride() {
+    return sizeof(T) >= 64 ? 1 : static_cast<int>(64 / sizeof(T));
+}
+
+/**
+ * @brief Gets the index of the smallest key that isn't less than the
+ * search key. The loop always descends to below a leaf, adding one bit per
+ * level for whether it went right, then strips the trailing right turns
+ * to recover the last node where it went left.
+ *
+ * @tparam T The type of the keys
+ * @param tree The tree to search
+ * @param key The key to search for
+ * @return int The index into tree.keys, or 0 if every key is less
+ */
+template <typename T>
+int eytzingerTreeLowerBound(const EytzingerTree<T>& tree, const T& key) {
+    const T* keys = tree.keys.data;
+    int stride = eytzingerTreeGetPrefetchStride<T>();
+    unsigned int k = 1;
+    while (k <= static_cast<unsigned int>(tree.size)) {
+        eytzingerTreePrefetch(keys + k * stride);
+        k = 2 * k + (keys[k] < key);
+    }
+    return static_cast<int>(eytzingerTreeStripRightTurns(k));
+}
+
+/**
+ * @brief Gets the matching key in the tree
+ *
+ * @tparam T The type of the keys
+ * @param tree The tree to search
+ * @param key The key to search for
+ * @return const T* The key if found, otherwise nullptr
+ */
+template <typename T>
+const T* eytzingerTreeGet(const EytzingerTree<T>& tree, const T& key) {
+    int k = eytzingerTreeLowerBound(tree, key);
+    if (!k || !(tree.keys[k] == key)) {return nullptr;}
+    return &tree.keys[k];
+}
+
+/**
+ * @brief Looks up many keys at once. Each group of keys descends the tree
+ * together one level at a time, so the cache misses of different searches
+ * overlap instead of waiting on each other.
+ *
+ * @tparam T The type of the keys
+ * @param tree The tree to search
+ * @param keys The keys to search for
+ * @param count The number of keys
+ * @param results Filled with a pointer to each matching key in the tree,
+ * or nullptr if it isn't there
+ */
+template <typename T>
+void eytzingerTreeGetBatch(
+        const EytzingerTree<T>& tree,
+        const T* keys,
+        int count,
+        const T** results) {
+    if (count < 0) {
+        throw std::logic_error("Can't search for a negative number of keys.");
+    }
+    const T* data = tree.keys.data;
+    unsigned int size = static_cast<unsigned int>(tree.size);
+    int stride = eytzingerTreeGetPrefetchStride<T>();
+
+    // Every search takes either depth or depth - 1 steps
+    int depth = 0;
+    while (size >> depth) {depth++;}
+
+    for (int start = 0; start < count; start += EYTZINGER_TREE_BATCH_SIZE) {
+        int batch = count - start < EYTZINGER_TREE_BATCH_SIZE
+            ? count - start : EYTZINGER_TREE_BATCH_SIZE;
+        unsigned int k[EYTZINGER_TREE_BATCH_SIZE];
+        for (int i = 0; i < batch; i++) {k[i] = 1;}
+
+        for (int level = 0; level < depth; level++) {
+            for (int i = 0; i < batch; i++) {
+                if (k[i] > size) {continue;}
+                eytzingerTreePrefetch(data + k[i] * stride);
+                k[i] = 2 * k[i] + (data[k[i]] < keys[start + i]);
+            }
+        }
+
+        for (int i = 0; i < batch; i++) {
+            unsigned int found = eytzingerTreeStripRightTurns(k[i]);
+            results[start + i] = found && data[found] == keys[start + i]
+                ? &data[found] : nullptr;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,538 @@
+#ifndef FLAT_HASH_MAP_CPP
+#define FLAT_HASH_MAP_CPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <utility>
+
+#include "hash_map.cpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define FLAT_HASH_MAP_SSE2
+#endif
+
+// Control bytes are probed a group at a time, which is one SSE2 register
+const size_t FLAT_HASH_MAP_GROUP_WIDTH = 16;
+// A full slot's control byte holds 7 bits of its hash, so it's never negative
+const int8_t FLAT_HASH_MAP_EMPTY = -128;
+const int8_t FLAT_HASH_MAP_DELETED = -2;
+const size_t FLAT_HASH_MAP_MIN_CAPACITY = 8;
+
+/**
+ * @brief Open-addressing hash map in the style of Swiss tables. Every slot
+ * has a control byte that says if it's empty, deleted, or full, and a full
+ * slot's byte also holds 7 bits of its key's hash. A lookup compares 16
+ * control bytes at once, and only looks at keys whose 7 bits matched, so
+ * it rarely compares keys that aren't the one it's after.
+ *
+ * Entries live in one flat array rather than in separately allocated
+ * nodes, so inserting doesn't allocate unless the table grows, and the
+ * table stays at most 7/8 full. Pointers to values are invalidated when
+ * the table grows.
+ *
+ * The hash and equality functors may accept other types than K, so a map
+ * with std::string keys can be searched with a const char*, for example.
+ * Either way, equal keys must hash the same.
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the value
+ * @tparam Hash The hash functor for the key
+ * @tparam Equal The equality functor for the key
+ */
+template <
+    typename K,
+    typename V,
+    typename Hash = std::hash<K>,
+    typename Equal = std::equal_to<K>>
+struct FlatHashMap {
+public:
+    // Fields
+    // capacity + FLAT_HASH_MAP_GROUP_WIDTH bytes. The last group mirrors
+    // the start of the table, so a group can be read from any slot
+    int8_t* ctrl;
+    HashMapEntry<K, V>* slots;
+    size_t capacity;
+    size_t size;
+    size_t deleted;
+
+    // Constructors
+    FlatHashMap(): ctrl(nullptr), slots(nullptr), capacity(0), size(0),
+        deleted(0) {}
+    FlatHashMap(const FlatHashMap<K, V, Hash, Equal>& other): ctrl(nullptr),
+            slots(nullptr), capacity(other.capacity), size(other.size),
+            deleted(other.deleted) {
+        if (!capacity) {return;}
+        ctrl = new int8_t[capacity + FLAT_HASH_MAP_GROUP_WIDTH];
+        std::memcpy(ctrl, other.ctrl, capacity + FLAT_HASH_MAP_GROUP_WIDTH);
+        slots = static_cast<HashMapEntry<K, V>*>(
+            operator new(capacity * sizeof(HashMapEntry<K, V>)));
+        for (size_t i = 0; i < capacity; i++) {
+            if (ctrl[i] >= 0) {
+                new (slots + i) HashMapEntry<K, V>(other.slots[i]);
+            }
+        }
+    }
+    FlatHashMap(FlatHashMap<K, V, Hash, Equal>&& other): ctrl(nullptr),
+            slots(nullptr), capacity(0), size(0), deleted(0) {
+        swap(*this, other);
+    }
+
+    // Destructor
+    ~FlatHashMap() {
+        for (size_t i = 0; i < capacity; i++) {
+            if (ctrl[i] >= 0) {slots[i].~HashMapEntry<K, V>();}
+        }
+        operator delete(slots);
+        delete[] ctrl;
+    }
+
+    // Operators
+
+    /**
+     * @brief Copy assignment operator. Uses the copy-and-swap idiom
+     *
+     * @param rhs The hash map to copy
+     * @return FlatHashMap<K, V, Hash, Equal>& A copied hash map
+     */
+    FlatHashMap<K, V, Hash, Equal>& operator = (
+            FlatHashMap<K, V, Hash, Equal> rhs) {
+        swap(*this, rhs);
+        return *this;
+    }
+
+    // Utility Functions
+
+    /**
+     * @brief Swaps the provided hash maps
+     *
+     * @param first The first hash map to swap
+     * @param second The second hash map to swap
+     */
+    friend void swap(
+            FlatHashMap<K, V, Hash, Equal>& first,
+            FlatHashMap<K, V, Hash, Equal>& second) {
+        using std::swap;
+
+        swap(first.ctrl, second.ctrl);
+        swap(first.slots, second.slots);
+        swap(first.capacity, second.capacity);
+        swap(first.size, second.size);
+        swap(first.deleted, second.deleted);
+    }
+};
+
+/**
+ * @brief Finds the bytes in a group equal to value, without SIMD
+ *
+ * @param group The first of FLAT_HASH_MAP_GROUP_WIDTH control bytes
+ * @param value The byte to look for
+ * @return uint32_t A mask with bit i set if group[i] is value
+ */
+inline uint32_t flatHashMapMatchPortable(const int8_t* group, int8_t value) {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < FLAT_HASH_MAP_GROUP_WIDTH; i++) {
+        mask |= static_cast<uint32_t>(group[i] == value) << i;
+    }
+    return mask;
+}
+
+/**
+ * @brief Finds the bytes in a group equal to value
+ *
+ * @param group The first of FLAT_HASH_MAP_GROUP_WIDTH control bytes
+ * @param value The byte to look for
+ * @return uint32_t A mask with bit i set if group[i] is value
+ */
+inline uint32_t flatHashMapMatch(const int8_t* group, int8_t value) {
+#ifdef FLAT_HASH_MAP_SSE2
+    __m128i bytes =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    return static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(value))));
+#else
+    return flatHashMapMatchPortable(group, value);
+#endif
+}
+
+/**
+ * @brief Finds the empty and deleted bytes in a group, which are the only
+ * negative ones
+ *
+ * @param group The first of FLAT_HASH_MAP_GROUP_WIDTH control bytes
+ * @return uint32_t A mask with bit i set if group[i] isn't full
+ */
+inline uint32_t flatHashMapMatchFree(const int8_t* group) {
+#ifdef FLAT_HASH_MAP_SSE2
+    __m128i bytes =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    return static_cast<uint32_t>(_mm_movemask_epi8(bytes));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < FLAT_HASH_MAP_GROUP_WIDTH; i++) {
+        mask |= static_cast<uint32_t>(group[i] < 0) << i;
+    }
+    return mask;
+#endif
+}
+
+/**
+ * @brief Counts the zero bits below the lowest set bit
+ *
+ * @param mask A non-zero group mask
+ * @return size_t The index of the lowest set bit
+ */
+inline size_t flatHashMapLowestBit(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(mask);
+#else
+    size_t bit = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+/**
+ * @brief Counts the zero bits above the highest set bit of a group mask
+ *
+ * @param mask A non-zero group mask
+ * @return size_t The number of leading zeros out of the group's bits
+ */
+inline size_t flatHashMapLeadingZeros(uint32_t mask) {
+    size_t zeros = 0;
+    for (uint32_t bit = 1u << (FLAT_HASH_MAP_GROUP_WIDTH - 1);
+            !(mask & bit);
+            bit >>= 1) {
+        zeros++;
+    }
+    return zeros;
+}
+
+/**
+ * @brief Scrambles a key's hash. std::hash<int> is the identity on most
+ * standard libraries, so nearby keys would otherwise land in the same
+ * groups with control bytes that differ in only a bit or two.
+ *
+ * @param hash The hash from the map's hash functor
+ * @return uint64_t The scrambled hash
+ */
+inline uint64_t flatHashMapMix(size_t hash) {
+    uint64_t mixed = static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ULL;
+    return mixed ^ (mixed >> 32);
+}
+
+/**
+ * @brief Sets a slot's control byte, along with its copy in the mirrored
+ * group at the end
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the value
+ * @tparam Hash The hash functor for the key
+ * @tparam Equal The equality functor for the key
+ * @param map The hash map
+ * @param index The slot
+ * @param value The new control byte
+ */
+template <typename K, typename V, typename Hash, typename Equal>
+void flatHashMapSetCtrl(
+        FlatHashMap<K, V, Hash, Equal>& map,
+        size_t index,
+        int8_t value) {
+    map.ctrl[index] = value;
+    for (size_t i = index; i < FLAT_HASH_MAP_GROUP_WIDTH; i += map.capacity) {
+        map.ctrl[map.capacity + i] = value;
+    }
+}
+
+/**
+ * @brief Finds the slot holding a key. Probes a group at a time, moving
+ * on by one more group each time, which visits every group of a table
+ * whose capacity is a power of two. Stops at the first group with an
+ * empty slot, since an insert would have used that slot.
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the value
+ * @tparam Hash The hash functor for the key
+ * @tparam Equal The equality functor for the key
+ * @tparam Key The type of the key to search for
+ * @param map The hash map to search
+ * @param key The key to search for
+ * @return size_t The key's slot, or the capacity if it's not in the map
+ */
+template <
+    typename K,
+    typename V,
+    typename Hash,
+    typename Equal,
+    typename Key>
+size_t flatHashMapFind(
+        const FlatHashMap<K, V, Hash, Equal>& map,
+        const Key& key) {
+    if (!map.size) {return map.capacity;}
+    uint64_t hash = flatHashMapMix(Hash()(key));
+    int8_t tag = static_cast<int8_t>(hash & 0x7F);
+    size_t mask = map.capacity - 1;
+    size_t position = static_cast<size_t>(hash >> 7) & mask;
+    for (size_t step = FLAT_HASH_MAP_GROUP_WIDTH; ;
+            step += FLAT_HASH_MAP_GROUP_WIDTH) {
+        const int8_t* group = map.ctrl + position;
+        for (uint32_t matches = flatHashMapMatch(group, tag);
+                matches;
+                matches &= matches - 1) {
+            size_t index =
+                (position + flatHashMapLowestBit(matches)) & mask;
+            if (Equal()(map.slots[index].key, key)) {return index;}
+        }
+        if (flatHashMapMatch(group, FLAT_HASH_MAP_EMPTY)) {
+            return map.capacity;
+        }
+        position = (position + step) & mask;
+    }
+}
+
+/**
+ * @brief Gets the value associated with the key
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the value
+ * @tparam Hash The hash functor for the key
+ * @tparam Equal The equality functor for the key
+ * @tparam Key The type of the key to search for
+ * @param map The hash map to search
+ * @param key The key to search for
+ * @return V* A pointer to the value in the map, or nullptr if not found
+ */
+template <
+    typename K,
+    typename V,
+    typename Hash,
+    typename Equal,
+    typename Key>
+V* flatHashMapGet(FlatHashMap<K, V, Hash, Equal>& map, const Key& key) {
+    size_t index = flatHashMapFind(map, key);
+    return index < map.capacity ? &map.slots[index].value : nullptr;
+}
+
+/**
+ * @brief Checks if the map has the given key
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the value
+ * @tparam Hash The hash functor for the key
+ * @tparam Equal The equality functor for the key
+ * @tparam Key The type of the key to search for
+ * @param map The hash map to search
+ * @param key The key to search for
+ * @return true if the key is found, otherwise false
+ */
+template <
+    typename K,
+    typename V,
+    typename Hash,
+    typename Equal,
+    typename Key>
+bool flatHashMapHas(
+        const FlatHashMap<K, V, Hash, Equal>& map,
+        const Key& key) {
+    return flatHashMapFind(map, key) < map.capacity;
+}
+
+/**
+ * @brief Finds the first free slot on a hash's probe sequence. The table
+ * must have one
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the value
+ * @tparam Hash The hash functor for the key
+ * @tparam Equal The equality functor for the key
+ * @param map The hash map
+ * @param hash The scrambled hash of the key to place
+ * @return size_t The free slot
+ */
+template <typename K, typename V, typename Hash, typename Equal>
+size_t flatHashMapFindFree(
+        const FlatHashMap<K, V, Hash, Equal>& map,
+        uint64_t hash) {
+    size_t mask = map.capacity - 1;
+    size_t position = static_cast<size_t>(hash >> 7) & mask;
+    for (size_t step = FLAT_HASH_MAP_GROUP_WIDTH; ;
+            step += FLAT_HASH_MAP_GROUP_WIDTH) {
+        uint32_t free = flatHashMapMatchFree(map.ctrl + position);
+        if (free) {return (position + flatHashMapLowestBit(free)) & mask;}
+        position = (position + step) & mask;
+    }
+}
+
+/**
+ * @brief Moves every entry into a new table with the given capacity, which
+ * also clears out the deleted slots
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the value
+ * @tparam Hash The hash functor for the key
+ * @tparam Equal The equality functor for the key
+ * @param map The hash map to rehash
+ * @param capacity The new capacity. Must be a power of two that fits every
+ * entry
+ */
+template <typename K, typename V, typename Hash, typename Equal>
+void flatHashMapRehash(
+        FlatHashMap<K, V, Hash, Equal>& map,
+        size_t capacity) {
+    FlatHashMap<K, V, Hash, Equal> rehashed;
+    rehashed.capacity = capacity;
+    rehashed.ctrl = new int8_t[capacity + FLAT_HASH_MAP_GROUP_WIDTH];
+    std::memset(rehashed.ctrl, static_cast<unsigned char>(FLAT_HASH_MAP_EMPTY),
+        capacity + FLAT_HASH_MAP_GROUP_WIDTH);
+    rehashed.slots = static_cast<HashMapEntry<K, V>*>(
+        operator new(capacity * sizeof(HashMapEntry<K, V>)));
+
+    for (size_t i = 0; i < map.capacity; i++) {
+        if (map.ctrl[i] < 0) {continue;}
+        uint64_t hash = flatHashMapMix(Hash()(map.slots[i].key));
+        size_t index = flatHashMapFindFree(rehashed, hash);
+        new (rehashed.slots + index)
+            HashMapEntry<K, V>(std::move(map.slots[i]));
+        flatHashMapSetCtrl(rehashed, index, static_cast<int8_t>(hash & 0x7F));
+        rehashed.size++;
+    }
+    swap(map, rehashed);
+}
+
+/**
+ * @brief Makes room for at least count entries, so inserting that many
+ * doesn't rehash
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the value
+ * @tparam Hash The hash functor for the key
+ * @tparam Equal The equality functor for the key
+ * @param map The hash map
+ * @param count The number of entries to make room for
+ */
+template <typename K, typename V, typename Hash, typename Equal>
+void flatHashMapReserve(FlatHashMap<K, V, Hash, Equal>& map, size_t count) {
+    size_t capacity = FLAT_HASH_MAP_MIN_CAPACITY;
+    while (capacity / 8 * 7 < count) {capacity *= 2;}
+    if (capacity > map.capacity) {flatHashMapRehash(map, capacity);}
+}
+
+/**
+ * @brief Associates the value with the key, replacing any existing value
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the value
+ * @tparam Hash The hash functor for the key
+ * @tparam Equal The equality functor for the key
+ * @param map The hash map to insert into
+ * @param key The key to insert
+ * @param value The value to associate with the key
+ */
+template <typename K, typename V, typename Hash, typename Equal>
+void flatHashMapInsert(FlatHashMap<K, V, Hash, Equal>& map, K key, V value) {
+    size_t index = flatHashMapFind(map, key);
+    if (index < map.capacity) {
+        map.slots[index].value = std::move(value);
+        return;
+    }
+
+    // Deleted slots still lengthen probes, so they count towards the load.
+    // If they're most of it, rehashing in place is enough to clear them
+    if (map.size + map.deleted >= map.capacity / 8 * 7) {
+        size_t capacity = map.capacity;
+        if (!capacity) {
+            capacity = FLAT_HASH_MAP_MIN_CAPACITY;
+        } else if (map.size >= map.capacity / 16 * 7) {
+            capacity *= 2;
+        }
+        flatHashMapRehash(map, capacity);
+    }
+    uint64_t hash = flatHashMapMix(Hash()(key));
+    index = flatHashMapFindFree(map, hash);
+    if (map.ctrl[index] == FLAT_HASH_MAP_DELETED) {map.deleted--;}
+    new (map.slots + index)
+        HashMapEntry<K, V>(std::move(key), std::move(value));
+    flatHashMapSetCtrl(map, index, static_cast<int8_t>(hash & 0x7F));
+    map.size++;
+}
+
+/**
+ * @brief Removes the key from the map, if it exists.
+ *
+ * The slot is marked empty rather than deleted whenever that can't cut
+ * off a probe. Probes only continue past groups with no empty slot, so
+ * if the run of occupied slots around this one is shorter than a group,
+ * no probe ever passed through it.
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the value
+ * @tparam Hash The hash functor for the key
+ * @tparam Equal The equality functor for the key
+ * @tparam Key The type of the key to delete
+ * @param map The hash map to delete from
+ * @param key The key to delete
+ */
+template <
+    typename K,
+    typename V,
+    typename Hash,
+    typename Equal,
+    typename Key>
+void flatHashMapDelete(FlatHashMap<K, V, Hash, Equal>& map, const Key& key) {
+    size_t index = flatHashMapFind(map, key);
+    if (index >= map.capacity) {return;}
+    map.slots[index].~HashMapEntry<K, V>();
+    map.size--;
+
+    bool never_full = map.capacity <= FLAT_HASH_MAP_GROUP_WIDTH;
+    if (!never_full) {
+        size_t before = (index - FLAT_HASH_MAP_GROUP_WIDTH)
+            & (map.capacity - 1);
+        uint32_t empty_before =
+            flatHashMapMatch(map.ctrl + before, FLAT_HASH_MAP_EMPTY);
+        uint32_t empty_after =
+            flatHashMapMatch(map.ctrl + index, FLAT_HASH_MAP_EMPTY);
+        never_full = empty_before && empty_after
+            && flatHashMapLowestBit(empty_after)
+                + flatHashMapLeadingZeros(empty_before)
+                < FLAT_HASH_MAP_GROUP_WIDTH;
+    }
+    if (never_full) {
+        flatHashMapSetCtrl(map, index, FLAT_HASH_MAP_EMPTY);
+    } else {
+        flatHashMapSetCtrl(map, index, FLAT_HASH_MAP_DELETED);
+        map.deleted++;
+    }
+}
+
+/**
+ * @brief Calls visit on every entry, in no particular order. The map
+ * mustn't be changed while visiting, other than through the values
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the value
+ * @tparam Hash The hash functor for the key
+ * @tparam Equal The equality functor for the key
+ * @tparam Visit Called as visit(key, value)
+ * @param map The hash map to visit
+ * @param visit The function to call on each entry
+ */
+template <
+    typename K,
+    typename V,
+    typename Hash,
+    typename Equal,
+    typename Visit>
+void flatHashMapForEach(FlatHashMap<K, V, Hash, Equal>& map, Visit visit) {
+    for (size_t i = 0; i < map.capacity; i++) {
+        if (map.ctrl[i] >= 0) {visit(map.slots[i].key, map.slots[i].value);}
+    }
+}
+
+#endif
@@ -1,23 +1,71 @@
 #ifndef GRAPH_CPP
 #define GRAPH_CPP
 
-#include <fstream>
-#include <sstream>
+#include <limits>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 
 #include "linked_list.cpp"
 #include "adjacency_list.cpp"
+#include "dynamic_array.cpp"
+#include "flat_hash_map.cpp"
+#include "../concurrency/concurrent_hash_map.cpp"
+#include "../io/edge_list_loader.cpp"
 
 enum GraphDirection {
     GRAPH_UNDIRECTED,
     GRAPH_DIRECTED
 };
 
+/**
+ * @brief Reads a graph file into a flat list of edges. The file format is
+ * described by the Graph file path constructor. Missing weights default to 1.
+ * See edgeListLoad for how the file is parsed.
+ * 
+ * @tparam T The type of the graph's data
+ * @param filepath The path of the text file detailing the graph
+ * @param edges The list to append the file's edges to, in file order
+ * @param stats Where to store the load's timing and throughput, if not null
+ * @return int The number of nodes in the graph (the first line + 1)
+ */
+template <typename T>
+int graphReadEdgeList(
+        std::string filepath, 
+        DynamicArray<Edge<T>>& edges,
+        EdgeListLoadStats* stats = nullptr) {
+    return edgeListLoad(filepath, edges, stats);
+}
+
+/**
+ * @brief Adds the reverse of every edge right after it, which is the order
+ * an undirected graph adds them in
+ * 
+ * @tparam T The type of the edges' data
+ * @param edges The edges to add reverse edges to
+ */
+template <typename T>
+void graphAddReverseEdges(DynamicArray<Edge<T>>& edges) {
+    DynamicArray<Edge<T>> both(2 * edges.size);
+    for (size_t i = 0; i < edges.size; i++) {
+        dynamicArrayPushBack(both, edges[i]);
+        dynamicArrayPushBack(
+            both, 
+            Edge<T>(edges[i].to, edges[i].from, edges[i].weight));
+    }
+    swap(edges, both);
+}
+
 /**
  * @brief Implementation of graphs
  * 
+ * Nodes are also indexed by value in node_index, so node lookups take
+ * constant time on average. The index is maintained by graphAddNode,
+ * graphUpdateNode and graphDeleteNode, so nodes should only be added,
+ * renamed or removed through those functions.
+ * 
  * @tparam T The type of the graph's data. Assumes the type implements an
- * equality operator. 
+ * equality operator and std::hash.
  * 
  * TODO: is there a way to explicitly filter types passed
  * in to only allow for those that have implemented this operator?
@@ -27,9 +75,11 @@ struct Graph {
 public:
     // Fields
     LinkedList<AdjacencyList<T>>* adjacency_matrix;
+    LinkedList<AdjacencyList<T>>* tail;
+    FlatHashMap<T, LinkedList<AdjacencyList<T>>*> node_index;
 
     // Constructors
-    Graph(): adjacency_matrix(nullptr) {}
+    Graph(): adjacency_matrix(nullptr), tail(nullptr) {}
 
     /**
      * @brief Constructs a new Graph object with zero-indexed nodes from a 
@@ -46,40 +96,34 @@ public:
      * 
      * This project stores its example graphs in the resources folder
      * 
-     * Note: Only works with Graph<int> for now due to relying on std::stoi
-     * TODO: make other types work
+     * The file is parsed by edgeListLoad and the edges are added in one
+     * batch with graphAddEdges.
+     * 
+     * Nodes may be any type edgeListParseVertex parses, such as 64-bit
+     * ids or strings. Graphs with integer nodes have the nodes 0 to the
+     * first line, while other graphs have the nodes the edges name, in the
+     * order they first appear. Either way the first line is required.
      * 
      * @param filepath The path of the text file detailing the graph
      * @param is_directed A flag to determine if the graph is directed
      */
     Graph(std::string filepath, GraphDirection direction): 
-            adjacency_matrix(nullptr) {
-        std::ifstream reader(filepath);
-        std::string line;
-        std::getline(reader, line);
-        int size = std::stoi(line) + 1;
-        for (int i = 0; i < size; i++) {graphAddNode(*this, i);}
-
-        while (std::getline(reader, line)) {
-            std::istringstream iss(line);
-            std::string token;
-            double vals[3] = {0, 0, 1};
-            int i = 0;
-            while (std::getline(iss, token, ' ')) {
-                vals[i] = std::stod(token);
-                i++;
-            }
-            graphAddEdge(*this, Edge<int>(vals[0], vals[1], vals[2]));
-            if (direction == GRAPH_UNDIRECTED) {
-                graphAddEdge(*this, Edge<int>(vals[1], vals[0], vals[2]));
-            }
-        }
-        reader.close();
+            adjacency_matrix(nullptr), tail(nullptr) {
+        DynamicArray<Edge<T>> edges;
+        int size = graphReadEdgeList(filepath, edges);
+        graphAddFileNodes(*this, size, edges);
+
+        if (direction == GRAPH_UNDIRECTED) {graphAddReverseEdges(edges);}
+        graphAddEdges(*this, edges);
     }
 
-    Graph(const Graph<T>& other): 
-        adjacency_matrix(new LinkedList<AdjacencyList<T>>(
-            *other.adjacency_matrix)) {}
+    Graph(const Graph<T>& other): adjacency_matrix(nullptr), tail(nullptr) {
+        if (other.adjacency_matrix) {
+            adjacency_matrix = new LinkedList<AdjacencyList<T>>(
+                *other.adjacency_matrix);
+        }
+        graphIndexNodes(*this);
+    }
 
     // Destructor
     ~Graph() {delete adjacency_matrix;}
@@ -93,7 +137,7 @@ public:
      * @return const Graph<T>& The copied graph
      */
     const Graph<T>& operator = (Graph<T> rhs) {
-        swap(*this, other);
+        swap(*this, rhs);
         return *this;
     }
 
@@ -130,9 +174,30 @@ public:
         using std::swap;
 
         swap(lhs.adjacency_matrix, rhs.adjacency_matrix);
+        swap(lhs.tail, rhs.tail);
+        swap(lhs.node_index, rhs.node_index);
     }
 };
 
+/**
+ * @brief Rebuilds the node index and tail from the adjacency matrix. Used
+ * after the adjacency matrix is copied, since the index holds node pointers.
+ * 
+ * @tparam T The type of the graph's data
+ * @param graph The graph to index
+ */
+template <typename T>
+void graphIndexNodes(Graph<T>& graph) {
+    graph.node_index = FlatHashMap<T, LinkedList<AdjacencyList<T>>*>();
+    graph.tail = nullptr;
+    for (LinkedList<AdjacencyList<T>>* node = graph.adjacency_matrix;
+            node;
+            node = node->next) {
+        flatHashMapInsert(graph.node_index, node->data.from, node);
+        graph.tail = node;
+    }
+}
+
 /**
  * @brief Gets the number of nodes in the graph
  * 
@@ -155,11 +220,9 @@ int graphGetNumNodes(Graph<T>& graph) {
  */
 template <typename T>
 LinkedList<AdjacencyList<T>>* graphGetNode(Graph<T>& graph, T data) {
-    return linkedListGetNthOccurrence(
-        graph.adjacency_matrix, 
-        AdjacencyList<T>(data), 
-        1,
-        adjacencyListWeakEquality);
+    LinkedList<AdjacencyList<T>>** node =
+        flatHashMapGet(graph.node_index, data);
+    return node ? *node : nullptr;
 }
 
 /**
@@ -184,9 +247,14 @@ bool graphHasNode(Graph<T>& graph, T data) {
  */
 template <typename T>
 void graphAddNode(Graph<T>& graph, T data) {
-    if (!graphHasNode(graph, data)) {
-        linkedListInsertAtTail(&graph.adjacency_matrix, AdjacencyList<T>(data));
-    }
+    if (graphHasNode(graph, data)) {return;}
+
+    LinkedList<AdjacencyList<T>>* node = 
+        new LinkedList<AdjacencyList<T>>(AdjacencyList<T>(data));
+    if (graph.tail) {graph.tail->next = node;} 
+    else {graph.adjacency_matrix = node;}
+    graph.tail = node;
+    flatHashMapInsert(graph.node_index, data, node);
 }
 
 /**
@@ -202,7 +270,13 @@ void graphUpdateNode(Graph<T>& graph, T old_id, T new_id) {
     if (graphHasNode(graph, new_id)) {
         throw std::logic_error("Can't update a node to an existing node.");
     }
-    graphGetNode(graph, old_id)->data.from = new_id;
+    LinkedList<AdjacencyList<T>>* node = graphGetNode(graph, old_id);
+    if (!node) {
+        throw std::logic_error("Can't update a node that doesn't exist.");
+    }
+    node->data.from = new_id;
+    flatHashMapDelete(graph.node_index, old_id);
+    flatHashMapInsert(graph.node_index, new_id, node);
 }
 
 /**
@@ -214,11 +288,18 @@ void graphUpdateNode(Graph<T>& graph, T old_id, T new_id) {
  */
 template <typename T>
 void graphDeleteNode(Graph<T>& graph, T to_delete) {
+    LinkedList<AdjacencyList<T>>* node = graphGetNode(graph, to_delete);
+    if (!node) {return;}
+
+    flatHashMapDelete(graph.node_index, to_delete);
     linkedListDeleteNthOccurrence(
         &graph.adjacency_matrix, 
         AdjacencyList<T>(to_delete),
         1,
         adjacencyListWeakEquality);
+    if (node == graph.tail) {
+        graph.tail = linkedListGetTail(&graph.adjacency_matrix);
+    }
 }
 
 /**
@@ -283,7 +364,204 @@ void graphAddEdge(Graph<T>& graph, Edge<T> edge) {
     linkedListInsertAtTail(&adj_list->data.edges, edge);
 }
 
-// TODO: add delete/update for node/edge
+/**
+ * @brief Checks that the integer node type of a graph file holds every
+ * node from 0 up to the size given on the file's first line
+ * 
+ * @tparam T The type of the graph's data, an integer type
+ * @param size The number of nodes
+ */
+template <typename T>
+void graphCheckFileSize(int size) {
+    if (size > 0 && static_cast<unsigned long long>(size - 1)
+            > static_cast<unsigned long long>(std::numeric_limits<T>::max())) {
+        throw std::logic_error("Can't have more nodes than the type holds.");
+    }
+}
+
+/**
+ * @brief Adds the nodes of a graph file with integer nodes, which are 0
+ * up to the size given on the file's first line, so nodes without edges
+ * are kept
+ * 
+ * @tparam T The type of the graph's data, an integer type
+ * @param graph The graph to add nodes to
+ * @param size The number of nodes
+ */
+template <typename T>
+void graphAddFileNodes(
+        Graph<T>& graph,
+        int size,
+        const DynamicArray<Edge<T>>&,
+        std::true_type) {
+    graphCheckFileSize<T>(size);
+    for (int i = 0; i < size; i++) {graphAddNode(graph, static_cast<T>(i));}
+}
+
+/**
+ * @brief Adds the nodes of a graph file with other nodes, such as strings,
+ * which are the nodes its edges name, in the order they first appear
+ * 
+ * @tparam T The type of the graph's data
+ * @param graph The graph to add nodes to
+ * @param edges The file's edges
+ */
+template <typename T>
+void graphAddFileNodes(
+        Graph<T>& graph,
+        int,
+        const DynamicArray<Edge<T>>& edges,
+        std::false_type) {
+    for (size_t i = 0; i < edges.size; i++) {
+        if (!graphHasNode(graph, edges[i].from)) {
+            graphAddNode(graph, edges[i].from);
+        }
+        if (!graphHasNode(graph, edges[i].to)) {
+            graphAddNode(graph, edges[i].to);
+        }
+    }
+}
+
+/**
+ * @brief Adds the nodes of a graph file, picking how by the node type
+ * 
+ * @tparam T The type of the graph's data
+ * @param graph The graph to add nodes to
+ * @param size The number of nodes on the file's first line, which only
+ * integer graphs use
+ * @param edges The file's edges
+ */
+template <typename T>
+void graphAddFileNodes(
+        Graph<T>& graph,
+        int size,
+        const DynamicArray<Edge<T>>& edges) {
+    graphAddFileNodes(graph, size, edges, std::is_integral<T>());
+}
+
+/**
+ * @brief Adds a batch of edges to the graph in O(V + E) expected time,
+ * instead of the O(degree) duplicate scan graphAddEdge does per edge.
+ * Edges from the same node keep their order in the batch.
+ * 
+ * Like graphAddEdge, throws if an edge's from node doesn't exist or if an
+ * edge already exists, including twice in the batch. Every edge is
+ * checked before any are added, so a failed batch leaves the graph as is.
+ * 
+ * @tparam T The type of the graph's data
+ * @param graph The graph to add edges to
+ * @param edges The edges to add
+ * @param pool The pool to give the edges' nodes dense ids on
+ */
+template <typename T>
+void graphAddEdges(
+        Graph<T>& graph,
+        const DynamicArray<Edge<T>>& edges,
+        ThreadPool& pool = threadPoolGetDefault()) {
+    // Give every value a dense id so the checks below can use arrays.
+    // Sources are numbered first, so they take the ids below num_sources
+    ConcurrentHashMap<T, int> ids;
+    DynamicArray<int> from_ids, to_ids;
+    concurrentHashMapAssignIds(ids, edges.size,
+        [&](size_t i) -> const T& {return edges[i].from;}, from_ids, pool);
+    int num_sources = static_cast<int>(ids.size.load());
+    DynamicArray<LinkedList<AdjacencyList<T>>*> nodes;
+    dynamicArrayResize(nodes, num_sources);
+    for (size_t i = 0; i < edges.size; i++) {
+        LinkedList<AdjacencyList<T>>*& node = nodes[from_ids[i]];
+        if (node) {continue;}
+        node = graphGetNode(graph, edges[i].from);
+        if (!node) {
+            throw std::logic_error(
+                "Can't add an edge if the graph doesn't exist.");
+        }
+    }
+    concurrentHashMapAssignIds(ids, edges.size,
+        [&](size_t i) -> const T& {return edges[i].to;}, to_ids, pool);
+    int num_ids = static_cast<int>(ids.size.load());
+
+    // Group the batch by source, then mark each source's targets
+    DynamicArray<size_t> starts;
+    dynamicArrayResize(starts, num_sources + 1);
+    for (size_t i = 0; i < edges.size; i++) {starts[from_ids[i] + 1]++;}
+    for (int i = 0; i < num_sources; i++) {starts[i + 1] += starts[i];}
+    DynamicArray<size_t> grouped, positions(starts);
+    dynamicArrayResize(grouped, edges.size);
+    for (size_t i = 0; i < edges.size; i++) {
+        grouped[positions[from_ids[i]]++] = i;
+    }
+
+    // Only this thread uses ids now, so look in the shards without locking
+    DynamicArray<int> marked;
+    dynamicArrayResize(marked, num_ids);
+    for (int i = 0; i < num_ids; i++) {marked[i] = -1;}
+    for (int source = 0; source < num_sources; source++) {
+        for (LinkedList<Edge<T>>* edge = nodes[source]->data.edges; 
+                edge; 
+                edge = edge->next) {
+            int* to = flatHashMapGet(
+                concurrentHashMapGetShard(ids, edge->data.to).map,
+                edge->data.to);
+            if (to) {marked[*to] = source;}
+        }
+        for (size_t i = starts[source]; i < starts[source + 1]; i++) {
+            int to = to_ids[grouped[i]];
+            if (marked[to] == source) {
+                throw std::logic_error(
+                    "Can't add an edge if the edge already exists."
+                    "Instead use graphUpdateNode.");
+            }
+            marked[to] = source;
+        }
+    }
+
+    // Append at each list's tail, found once per source
+    DynamicArray<LinkedList<Edge<T>>*> tails;
+    dynamicArrayResize(tails, num_sources);
+    for (int source = 0; source < num_sources; source++) {
+        tails[source] = linkedListGetTail(&nodes[source]->data.edges);
+    }
+    for (size_t i = 0; i < edges.size; i++) {
+        LinkedList<Edge<T>>* edge = new LinkedList<Edge<T>>(edges[i]);
+        LinkedList<Edge<T>>*& tail = tails[from_ids[i]];
+        if (tail) {tail->next = edge;}
+        else {nodes[from_ids[i]]->data.edges = edge;}
+        tail = edge;
+    }
+}
+
+/**
+ * @brief Updates the weight of an edge in the graph
+ * 
+ * @tparam T The type of the graph's data
+ * @param graph The graph to update
+ * @param edge The edge to update, with its new weight
+ */
+template <typename T>
+void graphUpdateEdge(Graph<T>& graph, Edge<T> edge) {
+    LinkedList<AdjacencyList<T>>* node = graphGetNode(graph, edge.from);
+    LinkedList<Edge<T>>* original = node
+        ? adjacencyListGetEdge(node->data, edge)
+        : nullptr;
+    if (!original) {
+        throw std::logic_error("Can't update an edge that doesn't exist.");
+    }
+    original->data.weight = edge.weight;
+}
+
+/**
+ * @brief Attempts to delete an edge from the graph
+ * 
+ * @tparam T The type of the graph's data
+ * @param graph The graph to delete from
+ * @param edge The edge to delete. Only needs from and to values
+ */
+template <typename T>
+void graphDeleteEdge(Graph<T>& graph, Edge<T> edge) {
+    LinkedList<AdjacencyList<T>>* node = graphGetNode(graph, edge.from);
+    if (!node) {return;}
+    adjacencyListDeleteEdge(node->data, edge);
+}
 
 
 #endif
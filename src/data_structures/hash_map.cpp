@@ -0,0 +1,269 @@
+#ifndef HASH_MAP_CPP
+#define HASH_MAP_CPP
+
+#include <cstddef>
+#include <functional>
+
+#include "linked_list.cpp"
+
+/**
+ * @brief A key-value pair stored in a hash map bucket
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the value
+ */
+template <typename K, typename V>
+struct HashMapEntry {
+    // Fields
+    K key;
+    V value;
+
+    // Constructors
+    HashMapEntry(): key(K()), value(V()) {}
+    HashMapEntry(K key, V value): key(key), value(value) {}
+
+    // Operators
+
+    /**
+     * @brief Checks equality of two entries
+     *
+     * @param lhs The left entry to check
+     * @param rhs The right entry to check
+     * @return true if both the keys and values are equal, otherwise false
+     */
+    friend bool operator == (
+            const HashMapEntry<K, V>& lhs,
+            const HashMapEntry<K, V>& rhs) {
+        return lhs.key == rhs.key && lhs.value == rhs.value;
+    }
+
+    /**
+     * @brief Checks inequality of two entries
+     *
+     * @param lhs The left entry to check
+     * @param rhs The right entry to check
+     * @return true if the entries are inequal, otherwise false
+     */
+    friend bool operator != (
+            const HashMapEntry<K, V>& lhs,
+            const HashMapEntry<K, V>& rhs) {
+        return !(lhs == rhs);
+    }
+};
+
+/**
+ * @brief Weak equality check for two entries. Ignores the values, so it can
+ * be used to search a bucket by key.
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the value
+ * @param lhs The left entry to check
+ * @param rhs The right entry to check
+ * @return true if the keys are equal, otherwise false
+ */
+template <typename K, typename V>
+bool hashMapEntryWeakEquality(
+        const HashMapEntry<K, V>& lhs,
+        const HashMapEntry<K, V>& rhs) {
+    return lhs.key == rhs.key;
+}
+
+/**
+ * @brief Hash map with separate chaining. Each bucket is a linked list of
+ * entries, and the table doubles once there are more entries than buckets,
+ * so lookups take constant time on average.
+ *
+ * @tparam K The type of the key. Assumes the type implements an equality
+ * operator.
+ * @tparam V The type of the value
+ * @tparam Hash The hash functor for the key
+ */
+template <typename K, typename V, typename Hash = std::hash<K>>
+struct HashMap {
+    // Fields
+    LinkedList<HashMapEntry<K, V>>** buckets;
+    size_t num_buckets;
+    size_t size;
+
+    // Constructors
+    HashMap(): buckets(nullptr), num_buckets(0), size(0) {}
+    HashMap(const HashMap<K, V, Hash>& other):
+            buckets(nullptr), num_buckets(other.num_buckets), size(other.size) {
+        if (!num_buckets) {return;}
+        buckets = new LinkedList<HashMapEntry<K, V>>*[num_buckets]();
+        for (size_t i = 0; i < num_buckets; i++) {
+            if (other.buckets[i]) {
+                buckets[i] = new LinkedList<HashMapEntry<K, V>>(
+                    *other.buckets[i]);
+            }
+        }
+    }
+
+    // Destructor
+    ~HashMap() {
+        for (size_t i = 0; i < num_buckets; i++) {delete buckets[i];}
+        delete[] buckets;
+    }
+
+    // Operators
+
+    /**
+     * @brief Copy assignment operator. Uses the copy-and-swap idiom
+     *
+     * @param rhs The hash map to copy
+     * @return HashMap<K, V, Hash>& A copied hash map
+     */
+    HashMap<K, V, Hash>& operator = (HashMap<K, V, Hash> rhs) {
+        swap(*this, rhs);
+        return *this;
+    }
+
+    // Utility Functions
+
+    /**
+     * @brief Swaps the provided hash maps
+     *
+     * @param first The first hash map to swap
+     * @param second The second hash map to swap
+     */
+    friend void swap(HashMap<K, V, Hash>& first, HashMap<K, V, Hash>& second) {
+        using std::swap;
+
+        swap(first.buckets, second.buckets);
+        swap(first.num_buckets, second.num_buckets);
+        swap(first.size, second.size);
+    }
+};
+
+/**
+ * @brief Gets the bucket a key belongs in
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the value
+ * @tparam Hash The hash functor for the key
+ * @param map The hash map. Must have at least one bucket
+ * @param key The key to hash
+ * @return LinkedList<HashMapEntry<K, V>>*& The key's bucket
+ */
+template <typename K, typename V, typename Hash>
+LinkedList<HashMapEntry<K, V>>*& hashMapGetBucket(
+        HashMap<K, V, Hash>& map,
+        const K& key) {
+    return map.buckets[Hash()(key) % map.num_buckets];
+}
+
+/**
+ * @brief Moves every entry into a new table with the given number of buckets
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the value
+ * @tparam Hash The hash functor for the key
+ * @param map The hash map to rehash
+ * @param num_buckets The new number of buckets
+ */
+template <typename K, typename V, typename Hash>
+void hashMapRehash(HashMap<K, V, Hash>& map, size_t num_buckets) {
+    LinkedList<HashMapEntry<K, V>>** old_buckets = map.buckets;
+    size_t old_num_buckets = map.num_buckets;
+    map.buckets = new LinkedList<HashMapEntry<K, V>>*[num_buckets]();
+    map.num_buckets = num_buckets;
+
+    // Relink the existing nodes rather than copying the entries
+    for (size_t i = 0; i < old_num_buckets; i++) {
+        LinkedList<HashMapEntry<K, V>>* node = old_buckets[i];
+        while (node) {
+            LinkedList<HashMapEntry<K, V>>* next = node->next;
+            LinkedList<HashMapEntry<K, V>>*& bucket =
+                hashMapGetBucket(map, node->data.key);
+            node->next = bucket;
+            bucket = node;
+            node = next;
+        }
+    }
+    delete[] old_buckets;
+}
+
+/**
+ * @brief Gets the value associated with the key
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the value
+ * @tparam Hash The hash functor for the key
+ * @param map The hash map to search
+ * @param key The key to search for
+ * @return V* A pointer to the value in the map, or nullptr if not found
+ */
+template <typename K, typename V, typename Hash>
+V* hashMapGet(HashMap<K, V, Hash>& map, const K& key) {
+    if (!map.size) {return nullptr;}
+    LinkedList<HashMapEntry<K, V>>* node = hashMapGetBucket(map, key);
+    while (node) {
+        if (node->data.key == key) {return &node->data.value;}
+        node = node->next;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Checks if the map has the given key
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the value
+ * @tparam Hash The hash functor for the key
+ * @param map The hash map to search
+ * @param key The key to search for
+ * @return true if the key is found, otherwise false
+ */
+template <typename K, typename V, typename Hash>
+bool hashMapHas(HashMap<K, V, Hash>& map, const K& key) {
+    return hashMapGet(map, key) != nullptr;
+}
+
+/**
+ * @brief Associates the value with the key, replacing any existing value
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the value
+ * @tparam Hash The hash functor for the key
+ * @param map The hash map to insert into
+ * @param key The key to insert
+ * @param value The value to associate with the key
+ */
+template <typename K, typename V, typename Hash>
+void hashMapInsert(HashMap<K, V, Hash>& map, K key, V value) {
+    V* existing = hashMapGet(map, key);
+    if (existing) {
+        *existing = value;
+        return;
+    }
+
+    if (map.size >= map.num_buckets) {
+        hashMapRehash(map, map.num_buckets ? 2 * map.num_buckets : 8);
+    }
+    linkedListInsertAtHead(
+        &hashMapGetBucket(map, key),
+        HashMapEntry<K, V>(key, value));
+    map.size++;
+}
+
+/**
+ * @brief Removes the key from the map, if it exists
+ *
+ * @tparam K The type of the key
+ * @tparam V The type of the value
+ * @tparam Hash The hash functor for the key
+ * @param map The hash map to delete from
+ * @param key The key to delete
+ */
+template <typename K, typename V, typename Hash>
+void hashMapDelete(HashMap<K, V, Hash>& map, const K& key) {
+    if (!hashMapHas(map, key)) {return;}
+    linkedListDeleteNthOccurrence(
+        &hashMapGetBucket(map, key),
+        HashMapEntry<K, V>(key, V()),
+        1,
+        hashMapEntryWeakEquality);
+    map.size--;
+}
+
+#endif
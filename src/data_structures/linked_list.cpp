@@ -1,6 +1,8 @@
 #ifndef LINKED_LIST_CPP
 #define LINKED_LIST_CPP
 
+#include "../memory/node_pool.cpp"
+
 /**
  * @brief Generic linked list class
  * 
@@ -19,16 +21,45 @@ struct LinkedList {
 
     LinkedList(T data): data(data), next(nullptr) {}
     LinkedList(T data, LinkedList<T>* next): data(data), next(next) {}
-    LinkedList(const LinkedList<T>& other) {
-        data = other.data;
-        next = other.next ? new LinkedList<T>(*other.next) : nullptr;
+
+    /**
+     * @brief Copy constructor. Copies node by node from the front rather
+     * than recursing, so long lists can't overflow the stack
+     *
+     * @param other The linked list to copy
+     */
+    LinkedList(const LinkedList<T>& other): data(other.data), next(nullptr) {
+        LinkedList<T>* tail = this;
+        for (LinkedList<T>* node = other.next; node; node = node->next) {
+            tail->next = new LinkedList<T>(node->data);
+            tail = tail->next;
+        }
     }
 
-    // Destructor
-    ~LinkedList() {delete next;}
+    /**
+     * @brief Destructor. Unlinks each following node before deleting it so
+     * the nodes are freed in a loop rather than a chain of destructor calls
+     */
+    ~LinkedList() {
+        while (next) {
+            LinkedList<T>* node = next;
+            next = node->next;
+            node->next = nullptr;
+            delete node;
+        }
+    }
 
     // Operators
 
+    // Nodes live in the node pools, see NodePool
+    static void* operator new(size_t size) {
+        return nodePoolAllocate<sizeof(LinkedList<T>)>(size);
+    }
+
+    static void operator delete(void* pointer, size_t size) {
+        nodePoolDeallocate<sizeof(LinkedList<T>)>(pointer, size);
+    }
+
     /**
      * @brief Copy assignment operator. Uses the copy-and-swap idiom from
      * https://stackoverflow.com/questions/3279543/what-is-the-copy-and-swap-idiom
@@ -279,15 +310,16 @@ void linkedListDeleteNthOccurrence(
 
     // no need to make separate cases for head and not head
     LinkedList<T> *dummy = new LinkedList<T>(T(), *head), *prev = dummy;
-    for (int i = 0; i < position - 1; i++) {prev = prev->next;}
+    for (int i = 0; i < position; i++) {prev = prev->next;}
 
     LinkedList<T> *temp = prev->next;
     prev->next = temp->next;
     temp->next = nullptr;
     delete temp;
 
-    // need to delete dummy down here because for case of head, prev = dummy
-    *head = prev->next;
+    // need to delete dummy down here because for case of head, prev = dummy.
+    // dummy->next is the head whether or not the head was deleted
+    *head = dummy->next;
     dummy->next = nullptr;
     delete dummy;
 }
@@ -0,0 +1,173 @@
+#ifndef PAIRING_HEAP_CPP
+#define PAIRING_HEAP_CPP
+
+#include <cstddef>
+#include <stdexcept>
+
+#include "dynamic_array.cpp"
+#include "priority_queue.cpp"
+
+/**
+ * @brief A node in a pairing heap. Children are kept as a singly linked
+ * list through sibling, using indices into the heap's node pool.
+ *
+ * @tparam V The type of the value
+ */
+template <typename V>
+struct PairingHeapNode {
+    // Fields
+    PriorityQueueEntry<V> entry;
+    int child;
+    int sibling;
+
+    // Constructors
+    PairingHeapNode(): entry(), child(-1), sibling(-1) {}
+    PairingHeapNode(PriorityQueueEntry<V> entry):
+        entry(entry), child(-1), sibling(-1) {}
+};
+
+/**
+ * @brief Min pairing heap. Pushes are a single comparison and link, and the
+ * restructuring work is deferred to pops, which makes it fast when there
+ * are many more pushes than pops.
+ *
+ * Nodes live in one pool and refer to each other by index, and popped
+ * nodes are reused, so the heap doesn't allocate per push.
+ *
+ * @tparam V The type of the values
+ */
+template <typename V>
+struct PairingHeap {
+    // Fields
+    DynamicArray<PairingHeapNode<V>> nodes;
+    DynamicArray<int> free_nodes;
+    DynamicArray<int> scratch;
+    int root;
+    size_t size;
+
+    // Constructors
+    PairingHeap(): root(-1), size(0) {}
+};
+
+/**
+ * @brief Links two heap roots, making the larger a child of the smaller
+ *
+ * @tparam V The type of the values
+ * @param heap The heap that owns both nodes
+ * @param first The first root
+ * @param second The second root
+ * @return int The new root
+ */
+template <typename V>
+int pairingHeapMeld(PairingHeap<V>& heap, int first, int second) {
+    if (first == -1) {return second;}
+    if (second == -1) {return first;}
+    if (heap.nodes[second].entry.key < heap.nodes[first].entry.key) {
+        int temp = first;
+        first = second;
+        second = temp;
+    }
+    heap.nodes[second].sibling = heap.nodes[first].child;
+    heap.nodes[first].child = second;
+    return first;
+}
+
+/**
+ * @brief Adds a value to the heap
+ *
+ * @tparam V The type of the values
+ * @param heap The heap to push to
+ * @param key The value's priority. Smaller keys come out first
+ * @param value The value to push
+ */
+template <typename V>
+void priorityQueuePush(PairingHeap<V>& heap, double key, V value) {
+    PairingHeapNode<V> node(PriorityQueueEntry<V>(key, value));
+    int index;
+    if (heap.free_nodes.size) {
+        index = dynamicArrayBack(heap.free_nodes);
+        dynamicArrayPopBack(heap.free_nodes);
+        heap.nodes[index] = node;
+    } else {
+        index = static_cast<int>(heap.nodes.size);
+        dynamicArrayPushBack(heap.nodes, node);
+    }
+    heap.root = pairingHeapMeld(heap, heap.root, index);
+    heap.size++;
+}
+
+/**
+ * @brief Gets the entry with the smallest key
+ *
+ * @tparam V The type of the values
+ * @param heap The heap to check. Must not be empty
+ * @return const PriorityQueueEntry<V>& The smallest entry
+ */
+template <typename V>
+const PriorityQueueEntry<V>& priorityQueueTop(PairingHeap<V>& heap) {
+    if (heap.root == -1) {
+        throw std::logic_error("Can't get the top of an empty heap.");
+    }
+    return heap.nodes[heap.root].entry;
+}
+
+/**
+ * @brief Removes the entry with the smallest key. The root's children are
+ * melded in pairs from left to right, then the pairs are melded from right
+ * to left into the new root.
+ *
+ * @tparam V The type of the values
+ * @param heap The heap to pop from. Must not be empty
+ */
+template <typename V>
+void priorityQueuePop(PairingHeap<V>& heap) {
+    if (heap.root == -1) {
+        throw std::logic_error("Can't pop from an empty heap.");
+    }
+    int old_root = heap.root;
+    dynamicArrayClear(heap.scratch);
+    int child = heap.nodes[old_root].child;
+    while (child != -1) {
+        int first = child;
+        int second = heap.nodes[first].sibling;
+        child = second == -1 ? -1 : heap.nodes[second].sibling;
+        heap.nodes[first].sibling = -1;
+        if (second != -1) {heap.nodes[second].sibling = -1;}
+        int pair = pairingHeapMeld(heap, first, second);
+        dynamicArrayPushBack(heap.scratch, pair);
+    }
+
+    int root = -1;
+    for (size_t i = heap.scratch.size; i > 0; i--) {
+        root = pairingHeapMeld(heap, heap.scratch[i - 1], root);
+    }
+    heap.root = root;
+    dynamicArrayPushBack(heap.free_nodes, old_root);
+    heap.size--;
+}
+
+/**
+ * @brief Checks if the heap is empty
+ *
+ * @tparam V The type of the values
+ * @param heap The heap to check
+ * @return true if the heap has no entries, otherwise false
+ */
+template <typename V>
+bool priorityQueueEmpty(const PairingHeap<V>& heap) {
+    return heap.root == -1;
+}
+
+/**
+ * @brief Gets the number of entries in the heap
+ *
+ * @tparam V The type of the values
+ * @param heap The heap to check
+ * @return size_t The number of entries
+ */
+template <typename V>
+size_t priorityQueueGetSize(const PairingHeap<V>& heap) {
+    return heap.size;
+}
+
+#endif
@@ -0,0 +1,150 @@
+#ifndef PRIORITY_QUEUE_CPP
+#define PRIORITY_QUEUE_CPP
+
+#include <cstddef>
+#include <stdexcept>
+
+#include "dynamic_array.cpp"
+
+/**
+ * @brief A value and its priority in a min priority queue. Every priority
+ * queue (DaryHeap, PairingHeap and RadixHeap) shares the same free function
+ * API: priorityQueuePush, priorityQueueTop, priorityQueuePop,
+ * priorityQueueEmpty and priorityQueueGetSize. Code that takes the queue as
+ * a template parameter, like dijkstra, works with any of them.
+ *
+ * @tparam V The type of the value
+ */
+template <typename V>
+struct PriorityQueueEntry {
+    // Fields
+    double key;
+    V value;
+
+    // Constructors
+    PriorityQueueEntry(): key(0), value(V()) {}
+    PriorityQueueEntry(double key, V value): key(key), value(value) {}
+};
+
+/**
+ * @brief Implicit min-heap where every node has D children, stored in one
+ * contiguous array. A wider heap is shallower, so pops do fewer levels of
+ * work and the children being compared share cache lines.
+ *
+ * @tparam V The type of the values
+ * @tparam D The number of children per node
+ */
+template <typename V, int D>
+struct DaryHeap {
+    // Fields
+    DynamicArray<PriorityQueueEntry<V>> entries;
+};
+
+template <typename V>
+using BinaryHeap = DaryHeap<V, 2>;
+
+template <typename V>
+using QuaternaryHeap = DaryHeap<V, 4>;
+
+/**
+ * @brief Adds a value to the heap
+ *
+ * @tparam V The type of the values
+ * @tparam D The number of children per node
+ * @param heap The heap to push to
+ * @param key The value's priority. Smaller keys come out first
+ * @param value The value to push
+ */
+template <typename V, int D>
+void priorityQueuePush(DaryHeap<V, D>& heap, double key, V value) {
+    dynamicArrayPushBack(heap.entries, PriorityQueueEntry<V>());
+
+    // Move parents down into the hole rather than swapping at every level
+    size_t hole = heap.entries.size - 1;
+    while (hole) {
+        size_t parent = (hole - 1) / D;
+        if (!(key < heap.entries[parent].key)) {break;}
+        heap.entries[hole] = heap.entries[parent];
+        hole = parent;
+    }
+    heap.entries[hole] = PriorityQueueEntry<V>(key, value);
+}
+
+/**
+ * @brief Gets the entry with the smallest key
+ *
+ * @tparam V The type of the values
+ * @tparam D The number of children per node
+ * @param heap The heap to check. Must not be empty
+ * @return const PriorityQueueEntry<V>& The smallest entry
+ */
+template <typename V, int D>
+const PriorityQueueEntry<V>& priorityQueueTop(DaryHeap<V, D>& heap) {
+    if (!heap.entries.size) {
+        throw std::logic_error("Can't get the top of an empty heap.");
+    }
+    return heap.entries[0];
+}
+
+/**
+ * @brief Removes the entry with the smallest key
+ *
+ * @tparam V The type of the values
+ * @tparam D The number of children per node
+ * @param heap The heap to pop from. Must not be empty
+ */
+template <typename V, int D>
+void priorityQueuePop(DaryHeap<V, D>& heap) {
+    if (!heap.entries.size) {
+        throw std::logic_error("Can't pop from an empty heap.");
+    }
+    PriorityQueueEntry<V> last = dynamicArrayBack(heap.entries);
+    dynamicArrayPopBack(heap.entries);
+    size_t size = heap.entries.size;
+    if (!size) {return;}
+
+    size_t hole = 0;
+    while (true) {
+        size_t first = D * hole + 1;
+        if (first >= size) {break;}
+        size_t end = first + D < size ? first + D : size;
+        size_t smallest = first;
+        for (size_t child = first + 1; child < end; child++) {
+            if (heap.entries[child].key < heap.entries[smallest].key) {
+                smallest = child;
+            }
+        }
+        if (!(heap.entries[smallest].key < last.key)) {break;}
+        heap.entries[hole] = heap.entries[smallest];
+        hole = smallest;
+    }
+    heap.entries[hole] = last;
+}
+
+/**
+ * @brief Checks if the heap is empty
+ *
+ * @tparam V The type of the values
+ * @tparam D The number of children per node
+ * @param heap The heap to check
+ * @return true if the heap has no entries, otherwise false
+ */
+template <typename V, int D>
+bool priorityQueueEmpty(const DaryHeap<V, D>& heap) {
+    return heap.entries.size == 0;
+}
+
+/**
+ * @brief Gets the number of entries in the heap
+ *
+ * @tparam V The type of the values
+ * @tparam D The number of children per node
+ * @param heap The heap to check
+ * @return size_t The number of entries
+ */
+template <typename V, int D>
+size_t priorityQueueGetSize(const DaryHeap<V, D>& heap) {
+    return heap.entries.size;
+}
+
+#endif
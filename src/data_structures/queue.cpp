@@ -1,65 +1,88 @@
 #ifndef QUEUE_CPP
 #define QUEUE_CPP
 
-#include "linked_list.cpp"
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <utility>
 
  /**
-  * @brief Generic queue implementation
-  * 
+  * @brief Generic queue implementation. The elements live in a circular
+  * buffer whose capacity is a power of two, so pushing and popping are
+  * index updates and the length is always known. The buffer doubles when
+  * it fills up.
+  *
   * @tparam T Any type. Assumes that the type implements the equality operator
+  * if the equality operator is used
   */
 template <typename T>
 struct Queue {
     // Fields
-    LinkedList<T>* head;
-    LinkedList<T>* tail;
+    T* data;
+    size_t capacity;
+    size_t head;
+    size_t size;
 
     // Constructors
-    Queue(): head(nullptr), tail(nullptr) {}
-    Queue(T data): head(new LinkedList<T>(data)), tail(head) {}
-    Queue(Queue<T>& other) {
-      if (other.head) {
-        head = new LinkedList<T>(*other.head);
-        tail = linkedListGetTail(&head);
-      } else {
-        head = nullptr;
-        tail = nullptr;
+    Queue(): data(nullptr), capacity(0), head(0), size(0) {}
+    Queue(T data): data(nullptr), capacity(0), head(0), size(0) {
+      queuePush(*this, std::move(data));
+    }
+    Queue(const Queue<T>& other):
+        data(nullptr), capacity(0), head(0), size(0) {
+      queueReserve(*this, other.size);
+      for (size_t i = 0; i < other.size; i++) {
+        new (data + i) T(queueGet(other, i));
       }
+      size = other.size;
+    }
+    Queue(Queue<T>&& other): data(other.data), capacity(other.capacity),
+        head(other.head), size(other.size) {
+      other.data = nullptr;
+      other.capacity = 0;
+      other.head = 0;
+      other.size = 0;
     }
 
     // Destructor
-    ~Queue() {delete head;}
+    ~Queue() {
+      queueClear(*this);
+      ::operator delete(data);
+    }
 
     // Operators
 
     /**
-     * @brief Copy assignment operator
-     * 
+     * @brief Copy assignment operator. Uses the copy-and-swap idiom.
+     *
      * @param rhs The queue to copy
      * @return Queue<T>& A copied queue
      */
     Queue<T>& operator = (Queue<T> rhs) {
-      *head = *rhs.head;
-      *tail = *rhs.tail;
+      swap(*this, rhs);
       return *this;
     }
 
     /**
-     * @brief Checks equality of two queues. We could probably just check
-     * for the heads being equal, but then we would think the lists are equal
-     * if the tails somehow get changed.
-     * 
+     * @brief Checks equality of two queues. Queues are equal when they
+     * hold the same elements in the same order, wherever those sit in the
+     * buffer.
+     *
      * @param lhs The first queue to check
      * @param rhs The second queue to check
      * @return true if the queues are equal, otherwise false
      */
     friend bool operator == (Queue<T>& lhs, Queue<T>& rhs) {
-      return *lhs.head == *rhs.head && *lhs.tail == *rhs.tail;
+      if (lhs.size != rhs.size) {return false;}
+      for (size_t i = 0; i < lhs.size; i++) {
+        if (queueGet(lhs, i) != queueGet(rhs, i)) {return false;}
+      }
+      return true;
     }
 
     /**
      * @brief Checks inequality of two queues
-     * 
+     *
      * @param lhs The first queue to check
      * @param rhs The second queue to check
      * @return true if the queues are inequal, otherwise false
@@ -67,69 +90,211 @@ struct Queue {
     friend bool operator != (Queue<T>& lhs, Queue<T>& rhs) {
       return !(lhs == rhs);
     }
+
+    // Utility Functions
+
+    /**
+     * @brief Swaps the provided queues
+     *
+     * @param first The first queue to swap
+     * @param second The second queue to swap
+     */
+    friend void swap(Queue<T>& first, Queue<T>& second) {
+      // enables ADL
+      using std::swap;
+      swap(first.data, second.data);
+      swap(first.capacity, second.capacity);
+      swap(first.head, second.head);
+      swap(first.size, second.size);
+    }
 };
 
+/**
+ * @brief Gets the element at a position from the front of the queue,
+ * without bounds checking
+ *
+ * @tparam T The type of the queue's data
+ * @param queue The queue
+ * @param index The position, where 0 is the front
+ * @return const T& The element
+ */
+template <typename T>
+const T& queueGet(const Queue<T>& queue, size_t index) {
+  return queue.data[(queue.head + index) & (queue.capacity - 1)];
+}
+
+/**
+ * @brief Grows the buffer to hold at least capacity elements, rounded up to
+ * a power of two. The elements are moved to the start of the new buffer.
+ * Never shrinks the queue.
+ *
+ * @tparam T The type of the queue's data
+ * @param queue The queue to grow
+ * @param capacity The minimum number of elements to hold
+ */
+template <typename T>
+void queueReserve(Queue<T>& queue, size_t capacity) {
+  if (capacity <= queue.capacity) {return;}
+  size_t new_capacity = queue.capacity ? queue.capacity : 4;
+  while (new_capacity < capacity) {new_capacity *= 2;}
+
+  T* data = static_cast<T*>(::operator new(new_capacity * sizeof(T)));
+  for (size_t i = 0; i < queue.size; i++) {
+    T& element = queue.data[(queue.head + i) & (queue.capacity - 1)];
+    new (data + i) T(std::move(element));
+    element.~T();
+  }
+  ::operator delete(queue.data);
+  queue.data = data;
+  queue.capacity = new_capacity;
+  queue.head = 0;
+}
+
 /**
  * @brief Checks if the queue is empty
- * 
+ *
  * @tparam T The type of the queue's data
  * @param queue The queue to check
  * @return true if empty, otherwise false
  */
 template <typename T>
 bool queueEmpty(const Queue<T>& queue) {
-  return !queue.head;
+  return queue.size == 0;
 }
 
 /**
  * @brief Get the number of elements in the queue
- * 
+ *
  * @tparam T The type of the queue's data
  * @param queue The queue to check
  * @return int The length of the queue
  */
 template <typename T>
 int queueLength(const Queue<T>& queue) {
-  return linkedListGetLength(queue.head);
+  return static_cast<int>(queue.size);
 }
 
 /**
- * @brief Pushes data to the end of the queue
- * 
+ * @brief Pushes data to the end of the queue. The data is moved in.
+ *
  * @tparam T The type of the queue's data
  * @param queue The queue to push to
  * @param data The data to push into the queue
  */
 template <typename T>
 void queuePush(Queue<T>& queue, T data) {
-  linkedListInsertAtTail(&queue.tail, data);
-  if (!queue.head) {queue.head = queue.tail;} 
-  else {queue.tail = queue.tail->next;}
+  if (queue.size == queue.capacity) {queueReserve(queue, queue.size + 1);}
+  size_t tail = (queue.head + queue.size) & (queue.capacity - 1);
+  new (queue.data + tail) T(std::move(data));
+  queue.size++;
+}
+
+/**
+ * @brief Pushes several elements to the end of the queue in order. Grows
+ * the buffer at most once and copies in at most two contiguous runs.
+ *
+ * @tparam T The type of the queue's data
+ * @param queue The queue to push to
+ * @param data The elements to push
+ * @param count The number of elements
+ */
+template <typename T>
+void queuePushN(Queue<T>& queue, const T* data, size_t count) {
+  queueReserve(queue, queue.size + count);
+  size_t tail = (queue.head + queue.size) & (queue.capacity - 1);
+  size_t first_run = queue.capacity - tail;
+  if (first_run > count) {first_run = count;}
+  for (size_t i = 0; i < first_run; i++) {
+    new (queue.data + tail + i) T(data[i]);
+  }
+  for (size_t i = first_run; i < count; i++) {
+    new (queue.data + i - first_run) T(data[i]);
+  }
+  queue.size += count;
 }
 
 /**
  * @brief Gets the front of the queue
- * 
+ *
  * @tparam T The type of the queue's data
  * @param queue The queue to get the front of
- * @return T The front of the queue
+ * @return T& The front of the queue
  */
 template <typename T>
-T queueFront(const Queue<T>& queue) {
+T& queueFront(Queue<T>& queue) {
   if (queueEmpty(queue)) {
     throw std::logic_error("Can't get the front of an empty queue.");
-  } else {
-    return queue.head->data;
   }
+  return queue.data[queue.head];
 }
 
+/**
+ * @brief Gets the front of the queue
+ *
+ * @tparam T The type of the queue's data
+ * @param queue The queue to get the front of
+ * @return const T& The front of the queue
+ */
+template <typename T>
+const T& queueFront(const Queue<T>& queue) {
+  if (queueEmpty(queue)) {
+    throw std::logic_error("Can't get the front of an empty queue.");
+  }
+  return queue.data[queue.head];
+}
+
+/**
+ * @brief Removes the front of the queue
+ *
+ * @tparam T The type of the queue's data
+ * @param queue The queue to pop from
+ */
 template <typename T>
 void queuePop(Queue<T>& queue) {
   if (queueEmpty(queue)) {
     throw std::logic_error("Can't pop from an empty queue.");
-  } else {
-    linkedListDeleteNthOccurrence(&queue.head, queue.head->data, 1);
   }
+  queue.data[queue.head].~T();
+  queue.head = (queue.head + 1) & (queue.capacity - 1);
+  queue.size--;
+}
+
+/**
+ * @brief Moves up to count elements off the front of the queue, in order
+ *
+ * @tparam T The type of the queue's data
+ * @param queue The queue to pop from
+ * @param out Filled with the popped elements
+ * @param count The most elements to pop
+ * @return size_t The number of elements popped, which is less than count
+ * if the queue runs out
+ */
+template <typename T>
+size_t queuePopN(Queue<T>& queue, T* out, size_t count) {
+  if (count > queue.size) {count = queue.size;}
+  for (size_t i = 0; i < count; i++) {
+    T& element = queue.data[(queue.head + i) & (queue.capacity - 1)];
+    out[i] = std::move(element);
+    element.~T();
+  }
+  if (count) {queue.head = (queue.head + count) & (queue.capacity - 1);}
+  queue.size -= count;
+  return count;
+}
+
+/**
+ * @brief Destroys every element but keeps the buffer for reuse
+ *
+ * @tparam T The type of the queue's data
+ * @param queue The queue to clear
+ */
+template <typename T>
+void queueClear(Queue<T>& queue) {
+  for (size_t i = 0; i < queue.size; i++) {
+    queue.data[(queue.head + i) & (queue.capacity - 1)].~T();
+  }
+  queue.head = 0;
+  queue.size = 0;
 }
 
-#endif
\ No newline at end of file
+#endif
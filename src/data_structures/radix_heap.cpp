@@ -0,0 +1,177 @@
+#ifndef RADIX_HEAP_CPP
+#define RADIX_HEAP_CPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include "dynamic_array.cpp"
+#include "priority_queue.cpp"
+
+/**
+ * @brief Monotone min priority queue. An entry sits in the bucket numbered
+ * by the highest bit where its key differs from the last popped key, so a
+ * push is just an append. Each entry can only move to lower buckets, so it
+ * moves at most 64 times over its life.
+ *
+ * Keys are compared through their IEEE 754 bit patterns, which sort the
+ * same way as non-negative doubles. Keys must be non-negative and no
+ * smaller than the last popped key. Dijkstra with non-negative weights
+ * meets both rules.
+ *
+ * @tparam V The type of the values
+ */
+template <typename V>
+struct RadixHeap {
+    // Fields
+    DynamicArray<PriorityQueueEntry<V>> buckets[65];
+    uint64_t last;
+    size_t size;
+
+    // Constructors
+    RadixHeap(): last(0), size(0) {}
+};
+
+/**
+ * @brief Gets the bit pattern of a non-negative key
+ *
+ * @param key The key
+ * @return uint64_t The key's bits, ordered the same way as the keys
+ */
+inline uint64_t radixHeapGetBits(double key) {
+    uint64_t bits;
+    std::memcpy(&bits, &key, sizeof(bits));
+    return bits;
+}
+
+/**
+ * @brief Gets the bucket for a key's bits, which is one past the highest
+ * bit that differs from the last popped key, or 0 if they're equal
+ *
+ * @param bits The key's bits
+ * @param last The last popped key's bits
+ * @return int The bucket number, from 0 to 64
+ */
+inline int radixHeapGetBucket(uint64_t bits, uint64_t last) {
+    uint64_t difference = bits ^ last;
+#if defined(__GNUC__) || defined(__clang__)
+    return difference ? 64 - __builtin_clzll(difference) : 0;
+#else
+    int bucket = 0;
+    while (difference) {
+        difference >>= 1;
+        bucket++;
+    }
+    return bucket;
+#endif
+}
+
+/**
+ * @brief Adds a value to the heap
+ *
+ * @tparam V The type of the values
+ * @param heap The heap to push to
+ * @param key The value's priority. Must be non-negative and no smaller
+ * than the last popped key
+ * @param value The value to push
+ */
+template <typename V>
+void priorityQueuePush(RadixHeap<V>& heap, double key, V value) {
+    uint64_t bits = radixHeapGetBits(key);
+    if (!(key >= 0) || bits >> 63 || bits < heap.last) {
+        throw std::logic_error(
+            "Can't push a key smaller than the last popped key.");
+    }
+    dynamicArrayPushBack(
+        heap.buckets[radixHeapGetBucket(bits, heap.last)],
+        PriorityQueueEntry<V>(key, value));
+    heap.size++;
+}
+
+/**
+ * @brief Makes sure bucket 0 has entries by finding the smallest key in the
+ * first non-empty bucket and redistributing that bucket around it
+ *
+ * @tparam V The type of the values
+ * @param heap The heap to refill. Must not be empty
+ */
+template <typename V>
+void radixHeapRefill(RadixHeap<V>& heap) {
+    if (heap.buckets[0].size) {return;}
+    int i = 1;
+    while (!heap.buckets[i].size) {i++;}
+
+    DynamicArray<PriorityQueueEntry<V>>& bucket = heap.buckets[i];
+    uint64_t smallest = radixHeapGetBits(bucket[0].key);
+    for (size_t j = 1; j < bucket.size; j++) {
+        uint64_t bits = radixHeapGetBits(bucket[j].key);
+        if (bits < smallest) {smallest = bits;}
+    }
+    heap.last = smallest;
+    for (size_t j = 0; j < bucket.size; j++) {
+        uint64_t bits = radixHeapGetBits(bucket[j].key);
+        dynamicArrayPushBack(
+            heap.buckets[radixHeapGetBucket(bits, heap.last)],
+            bucket[j]);
+    }
+    dynamicArrayClear(bucket);
+}
+
+/**
+ * @brief Gets the entry with the smallest key
+ *
+ * @tparam V The type of the values
+ * @param heap The heap to check. Must not be empty
+ * @return const PriorityQueueEntry<V>& The smallest entry
+ */
+template <typename V>
+const PriorityQueueEntry<V>& priorityQueueTop(RadixHeap<V>& heap) {
+    if (!heap.size) {
+        throw std::logic_error("Can't get the top of an empty heap.");
+    }
+    radixHeapRefill(heap);
+    return dynamicArrayBack(heap.buckets[0]);
+}
+
+/**
+ * @brief Removes the entry with the smallest key
+ *
+ * @tparam V The type of the values
+ * @param heap The heap to pop from. Must not be empty
+ */
+template <typename V>
+void priorityQueuePop(RadixHeap<V>& heap) {
+    if (!heap.size) {
+        throw std::logic_error("Can't pop from an empty heap.");
+    }
+    radixHeapRefill(heap);
+    dynamicArrayPopBack(heap.buckets[0]);
+    heap.size--;
+}
+
+/**
+ * @brief Checks if the heap is empty
+ *
+ * @tparam V The type of the values
+ * @param heap The heap to check
+ * @return true if the heap has no entries, otherwise false
+ */
+template <typename V>
+bool priorityQueueEmpty(const RadixHeap<V>& heap) {
+    return heap.size == 0;
+}
+
+/**
+ * @brief Gets the number of entries in the heap
+ *
+ * @tparam V The type of the values
+ * @param heap The heap to check
+ * @return size_t The number of entries
+ */
+template <typename V>
+size_t priorityQueueGetSize(const RadixHeap<V>& heap) {
+    return heap.size;
+}
+
+#endif
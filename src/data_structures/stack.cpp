@@ -1,25 +1,29 @@
 #ifndef STACK_CPP
 #define STACK_CPP
 
-#include "double_linked_list.cpp"
+#include <stdexcept>
+#include <utility>
+
+#include "dynamic_array.cpp"
 
 /**
- * @brief Stack implementation
+ * @brief Stack implementation. The elements live in a contiguous,
+ * geometrically growing array with the top at the back, so every
+ * operation is O(1) (amortized for pushes).
  * 
- * @tparam T The type of the stack's data
+ * @tparam T The type of the stack's data. Move-only types work with
+ * stackPush and stackEmplace
  */
 template <typename T>
 struct Stack {
     // Fields
-    DoubleLinkedList<T>* top;
+    DynamicArray<T> elements;
 
     // Constructors
-    Stack(): top(nullptr) {}
-    Stack(T data): top(new DoubleLinkedList<T>(data)) {}
-    Stack(const Stack<T>& other): top(new DoubleLinkedList<T>(*other.top)) {}
-
-    // Destructor
-    ~Stack() {delete top;}
+    Stack() {}
+    Stack(T data) {dynamicArrayPushBack(elements, std::move(data));}
+    Stack(const Stack<T>& other) = default;
+    Stack(Stack<T>&& other) = default;
 
     // Operators
     /**
@@ -29,7 +33,7 @@ struct Stack {
      * @return Stack<T>& A copied stack
      */
     Stack<T>& operator = (Stack<T> rhs) {
-        swap (*this, other);
+        swap(*this, rhs);
         return *this;
     }
 
@@ -41,7 +45,7 @@ struct Stack {
      * @return true if the stacks are equal, otherwise false
      */
     friend bool operator == (Stack<T>& lhs, Stack<T>& rhs) {
-        return *lhs.top == *rhs.top;
+        return lhs.elements == rhs.elements;
     }
 
     /**
@@ -66,7 +70,7 @@ struct Stack {
     friend void swap (Stack<T>& first, Stack<T>& second) {
         // enables ADL
         using std::swap;
-        swap(first.top, second.top);
+        swap(first.elements, second.elements);
     }
 };
 
@@ -79,7 +83,7 @@ struct Stack {
  */
 template <typename T>
 int stackSize(Stack<T>& stack) {
-    return doubleLinkedListGetLength(stack.top);
+    return static_cast<int>(stack.elements.size);
 }
 
 /**
@@ -91,11 +95,12 @@ int stackSize(Stack<T>& stack) {
  */
 template <typename T>
 bool stackEmpty(Stack<T>& stack) {
-    return stackSize(stack) == 0;
+    return stack.elements.size == 0;
 }
 
 /**
- * @brief Push a value onto the stack
+ * @brief Push a value onto the stack. The value is moved in, so pass an
+ * rvalue to avoid a copy.
  * 
  * @tparam T The type of the stack's data
  * @param stack The stack to push onto
@@ -103,8 +108,21 @@ bool stackEmpty(Stack<T>& stack) {
  */
 template <typename T>
 void stackPush(Stack<T>& stack, T data) {
-    doubleLinkedListInsertAtTail(&(stack.top), data);
-    if (stack.top->next) {stack.top = stack.top->next;}
+    dynamicArrayPushBack(stack.elements, std::move(data));
+}
+
+/**
+ * @brief Constructs a value in place on top of the stack
+ * 
+ * @tparam T The type of the stack's data
+ * @tparam Args The types of the arguments to T's constructor
+ * @param stack The stack to push onto
+ * @param args The arguments to construct the value with
+ * @return T& A reference to the new top of the stack
+ */
+template <typename T, typename... Args>
+T& stackEmplace(Stack<T>& stack, Args&&... args) {
+    return dynamicArrayEmplaceBack(stack.elements, std::forward<Args>(args)...);
 }
 
 /**
@@ -117,11 +135,9 @@ void stackPush(Stack<T>& stack, T data) {
 template <typename T>
 T& stackTop(Stack<T>& stack) {
     if (stackEmpty(stack)) {
-        throw std::logic_error("Can't take the top of an empty list!");
-    } else {
-        T& top = doubleLinkedListGetFromBackwardPosition(&stack.top, 0)->data;
-        return top;
+        throw std::logic_error("Can't take the top of an empty stack!");
     }
+    return dynamicArrayBack(stack.elements);
 }
 
 /**
@@ -133,10 +149,9 @@ T& stackTop(Stack<T>& stack) {
 template <typename T>
 void stackPop(Stack<T>& stack) {
     if (stackEmpty(stack)) {
-        throw std::logic_error("Can't pop from an empty list!");
-    } else {
-        doubleLinkedListDeleteFromBackwardPosition(&(stack.top), 0);
+        throw std::logic_error("Can't pop from an empty stack!");
     }
+    dynamicArrayPopBack(stack.elements);
 }
 
-#endif
\ No newline at end of file
+#endif
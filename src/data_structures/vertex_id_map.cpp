@@ -0,0 +1,142 @@
+#ifndef VERTEX_ID_MAP_CPP
+#define VERTEX_ID_MAP_CPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "dynamic_array.cpp"
+#include "edge.cpp"
+#include "../concurrency/concurrent_hash_map.cpp"
+#include "../concurrency/thread_pool.cpp"
+
+/**
+ * @brief Two-way map between a graph's vertex values and dense ids 0 to
+ * size - 1, so kernels can work on small integers and keep the values,
+ * such as strings or 64-bit ids, in one side table. Ids are handed out in
+ * the order the values are first added.
+ *
+ * Lookups may run on many threads at once, but adding values may not.
+ *
+ * @tparam T The type of the vertex values. Assumes the type implements an
+ * equality operator and std::hash.
+ * @tparam Id The type of the ids. Must be an integer type
+ */
+template <typename T, typename Id = uint32_t>
+struct VertexIdMap {
+public:
+    // Fields
+    ConcurrentHashMap<T, Id> ids;
+    DynamicArray<T> values;
+
+    // Constructors
+    VertexIdMap() {}
+    VertexIdMap(const VertexIdMap<T, Id>& other) = delete;
+
+    // Operators
+    VertexIdMap<T, Id>& operator = (const VertexIdMap<T, Id>& rhs) = delete;
+};
+
+/**
+ * @brief Gets the number of values in the map
+ *
+ * @tparam T The type of the vertex values
+ * @tparam Id The type of the ids
+ * @param map The map
+ * @return size_t The number of values, which is also the next id
+ */
+template <typename T, typename Id>
+size_t vertexIdMapGetSize(const VertexIdMap<T, Id>& map) {
+    return map.values.size;
+}
+
+/**
+ * @brief Gets the value's id, giving it the next one if it's new
+ *
+ * @tparam T The type of the vertex values
+ * @tparam Id The type of the ids
+ * @param map The map
+ * @param value The value
+ * @return Id The value's id
+ */
+template <typename T, typename Id>
+Id vertexIdMapAdd(VertexIdMap<T, Id>& map, const T& value) {
+    Id id = concurrentHashMapGetOrAssignId(map.ids, value);
+    if (static_cast<size_t>(id) == map.values.size) {
+        dynamicArrayPushBack(map.values, value);
+    }
+    return id;
+}
+
+/**
+ * @brief Looks up the id of a value
+ *
+ * @tparam T The type of the vertex values
+ * @tparam Id The type of the ids
+ * @param map The map
+ * @param value The value to look up
+ * @param id Where to store the id, if found
+ * @return true if the value has an id, otherwise false
+ */
+template <typename T, typename Id>
+bool vertexIdMapGetId(VertexIdMap<T, Id>& map, const T& value, Id* id) {
+    return concurrentHashMapGet(map.ids, value, id);
+}
+
+/**
+ * @brief Gets the value an id stands for
+ *
+ * @tparam T The type of the vertex values
+ * @tparam Id The type of the ids
+ * @param map The map
+ * @param id The id
+ * @return const T& The value
+ */
+template <typename T, typename Id>
+const T& vertexIdMapGetValue(const VertexIdMap<T, Id>& map, Id id) {
+    if (static_cast<size_t>(id) >= map.values.size) {
+        throw std::logic_error("Can't get the value of an id not in the map.");
+    }
+    return map.values[id];
+}
+
+/**
+ * @brief Rewrites a list of edges in terms of ids, adding every new
+ * endpoint to the map. Endpoints get ids in the order they first appear,
+ * from before to, edge by edge, so the result doesn't depend on the
+ * number of threads. The ids are assigned in parallel on the pool.
+ *
+ * @tparam T The type of the vertex values
+ * @tparam Id The type of the ids
+ * @param map The map to add the endpoints to
+ * @param edges The edges to rewrite
+ * @param remapped The list to append the rewritten edges to, in order
+ * @param pool The pool to assign the ids on
+ */
+template <typename T, typename Id>
+void vertexIdMapRemapEdges(
+        VertexIdMap<T, Id>& map,
+        const DynamicArray<Edge<T>>& edges,
+        DynamicArray<Edge<Id>>& remapped,
+        ThreadPool& pool = threadPoolGetDefault()) {
+    DynamicArray<Id> ids;
+    concurrentHashMapAssignIds(map.ids, 2 * edges.size,
+        [&](size_t i) -> const T& {
+            return i % 2 ? edges[i / 2].to : edges[i / 2].from;
+        }, ids, pool);
+
+    // New ids are handed out in order, so each one is the next slot
+    for (size_t i = 0; i < ids.size; i++) {
+        if (static_cast<size_t>(ids[i]) == map.values.size) {
+            dynamicArrayPushBack(map.values,
+                i % 2 ? edges[i / 2].to : edges[i / 2].from);
+        }
+    }
+    dynamicArrayReserve(remapped, remapped.size + edges.size);
+    for (size_t i = 0; i < edges.size; i++) {
+        dynamicArrayPushBack(remapped,
+            Edge<Id>(ids[2 * i], ids[2 * i + 1], edges[i].weight));
+    }
+}
+
+#endif
@@ -0,0 +1,296 @@
+#ifndef BINARY_GRAPH_CPP
+#define BINARY_GRAPH_CPP
+
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "../data_structures/csr_graph.cpp"
+#include "mapped_file.cpp"
+
+// Every section starts on a cache line
+const uint64_t BINARY_GRAPH_ALIGNMENT = 64;
+const char BINARY_GRAPH_MAGIC[8] = {'G', 'T', 'R', 'G', 'R', 'A', 'P', 'H'};
+const uint32_t BINARY_GRAPH_VERSION = 1;
+const uint32_t BINARY_GRAPH_BYTE_ORDER = 0x01020304;
+
+// How much of a binary graph file to check when opening it
+enum BinaryGraphCheck {
+    // Only the header and the ends of the offsets, in constant time
+    BINARY_GRAPH_CHECK_HEADER,
+    // Every offset and target too, in time linear in the graph's size
+    BINARY_GRAPH_CHECK_ALL
+};
+
+/**
+ * @brief The header at the start of a binary graph file. The file holds a
+ * CsrGraph's arrays exactly as they are laid out in memory:
+ *
+ *     header | nodes | offsets | targets | weights
+ *
+ * Each section starts at a multiple of BINARY_GRAPH_ALIGNMENT, and the
+ * section offsets are stored so a reader can check them before use.
+ * The sizes of the node and offset types are stored too, since the arrays
+ * are only readable by a build that agrees on them.
+ */
+struct BinaryGraphHeader {
+    // Fields
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t node_size;
+    uint32_t offset_size;
+    uint64_t num_nodes;
+    uint64_t num_edges;
+    uint64_t nodes_offset;
+    uint64_t offsets_offset;
+    uint64_t targets_offset;
+    uint64_t weights_offset;
+    uint64_t file_size;
+};
+
+/**
+ * @brief Rounds a file offset up to the next section boundary
+ *
+ * @param offset The offset to round
+ * @return uint64_t The aligned offset
+ */
+inline uint64_t binaryGraphAlign(uint64_t offset) {
+    return (offset + BINARY_GRAPH_ALIGNMENT - 1)
+        / BINARY_GRAPH_ALIGNMENT * BINARY_GRAPH_ALIGNMENT;
+}
+
+/**
+ * @brief Builds the header for a graph of the given size. Writing and
+ * reading both go through here, so they always agree on the layout.
+ *
+ * @tparam T The type of the graph's data
+ * @param num_nodes The number of nodes
+ * @param num_edges The number of edges
+ * @return BinaryGraphHeader The header, with every section placed
+ */
+template <typename T>
+BinaryGraphHeader binaryGraphLayout(uint64_t num_nodes, uint64_t num_edges) {
+    BinaryGraphHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, BINARY_GRAPH_MAGIC, sizeof(header.magic));
+    header.version = BINARY_GRAPH_VERSION;
+    header.byte_order = BINARY_GRAPH_BYTE_ORDER;
+    header.node_size = sizeof(T);
+    header.offset_size = sizeof(size_t);
+    header.num_nodes = num_nodes;
+    header.num_edges = num_edges;
+    header.nodes_offset = binaryGraphAlign(sizeof(BinaryGraphHeader));
+    header.offsets_offset = binaryGraphAlign(
+        header.nodes_offset + num_nodes * sizeof(T));
+    header.targets_offset = binaryGraphAlign(
+        header.offsets_offset + (num_nodes + 1) * sizeof(size_t));
+    header.weights_offset = binaryGraphAlign(
+        header.targets_offset + num_edges * sizeof(int));
+    header.file_size = header.weights_offset + num_edges * sizeof(double);
+    return header;
+}
+
+/**
+ * @brief Writes a section to the file, padded up to the section's offset
+ *
+ * @param file The file to write to
+ * @param position The number of bytes written so far. Updated
+ * @param offset Where the section starts
+ * @param data The section's bytes
+ * @param bytes The number of bytes in the section
+ */
+inline void binaryGraphWriteSection(
+        std::ofstream& file,
+        uint64_t& position,
+        uint64_t offset,
+        const void* data,
+        uint64_t bytes) {
+    static const char PADDING[BINARY_GRAPH_ALIGNMENT] = {};
+    file.write(PADDING, static_cast<std::streamsize>(offset - position));
+    file.write(
+        static_cast<const char*>(data),
+        static_cast<std::streamsize>(bytes));
+    position = offset + bytes;
+}
+
+/**
+ * @brief Writes a CSR graph to a binary graph file, which can be opened
+ * with MappedCsrGraph without parsing it
+ *
+ * @tparam T The type of the graph's data. Must be trivially copyable, since
+ * the nodes are written as raw bytes
+ * @param graph The graph to write
+ * @param filepath The path of the file to write
+ */
+template <typename T>
+void binaryGraphWrite(const CsrGraph<T>& graph, std::string filepath) {
+    static_assert(
+        std::is_trivially_copyable<T>::value,
+        "Binary graph nodes must be trivially copyable.");
+
+    BinaryGraphHeader header = binaryGraphLayout<T>(
+        graph.num_nodes,
+        graph.num_edges);
+    std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+    if (!file) {throw std::logic_error("Can't open " + filepath + ".");}
+
+    uint64_t position = 0;
+    size_t empty_offsets[1] = {0};
+    binaryGraphWriteSection(file, position, 0, &header, sizeof(header));
+    binaryGraphWriteSection(file, position, header.nodes_offset,
+        graph.nodes, header.num_nodes * sizeof(T));
+    binaryGraphWriteSection(file, position, header.offsets_offset,
+        graph.offsets ? graph.offsets : empty_offsets,
+        (header.num_nodes + 1) * sizeof(size_t));
+    binaryGraphWriteSection(file, position, header.targets_offset,
+        graph.targets, header.num_edges * sizeof(int));
+    binaryGraphWriteSection(file, position, header.weights_offset,
+        graph.weights, header.num_edges * sizeof(double));
+
+    file.flush();
+    if (!file) {throw std::logic_error("Can't write " + filepath + ".");}
+}
+
+/**
+ * @brief Checks that a mapped file is a binary graph this build can read.
+ * Only the header and the first and last offsets are checked, so this
+ * takes constant time no matter how big the graph is. A file that passes
+ * can still have offsets out of order or targets past the last node; use
+ * binaryGraphCheckArrays to rule those out.
+ *
+ * @tparam T The type of the graph's data
+ * @param file The mapped file
+ * @param filepath The path of the file, for error messages
+ * @return const BinaryGraphHeader* The file's header
+ */
+template <typename T>
+const BinaryGraphHeader* binaryGraphCheckHeader(
+        const MappedFile& file,
+        std::string filepath) {
+    if (file.size < sizeof(BinaryGraphHeader)) {
+        throw std::logic_error(filepath + " is not a binary graph.");
+    }
+    const BinaryGraphHeader* header =
+        reinterpret_cast<const BinaryGraphHeader*>(file.data);
+    if (std::memcmp(header->magic, BINARY_GRAPH_MAGIC, sizeof(header->magic))) {
+        throw std::logic_error(filepath + " is not a binary graph.");
+    }
+    if (header->version != BINARY_GRAPH_VERSION) {
+        throw std::logic_error(
+            "Can't read version " + std::to_string(header->version)
+            + " of the binary graph format.");
+    }
+    if (header->byte_order != BINARY_GRAPH_BYTE_ORDER
+        || header->node_size != sizeof(T)
+        || header->offset_size != sizeof(size_t)) {
+        throw std::logic_error(
+            filepath + " was written for a different platform or node type.");
+    }
+
+    // Counts are checked before the layout so its arithmetic can't overflow
+    if (header->num_nodes > INT_MAX
+        || header->num_edges > file.size / sizeof(double)) {
+        throw std::logic_error(filepath + " is corrupt.");
+    }
+    BinaryGraphHeader expected = binaryGraphLayout<T>(
+        header->num_nodes,
+        header->num_edges);
+    if (std::memcmp(header, &expected, sizeof(expected))
+        || expected.file_size > file.size) {
+        throw std::logic_error(filepath + " is corrupt.");
+    }
+    const size_t* offsets =
+        reinterpret_cast<const size_t*>(file.data + header->offsets_offset);
+    if (offsets[0] != 0 || offsets[header->num_nodes] != header->num_edges) {
+        throw std::logic_error(filepath + " is corrupt.");
+    }
+    return header;
+}
+
+/**
+ * @brief Checks the arrays of a graph read from a binary graph file: that
+ * the offsets never decrease and that every target is a node. Takes O(V +
+ * E) time, reading the whole file, so opening a file only does this when
+ * asked to with BINARY_GRAPH_CHECK_ALL.
+ *
+ * @tparam T The type of the graph's data
+ * @param graph The graph, which already passed binaryGraphCheckHeader
+ * @param filepath The path of the file, for error messages
+ */
+template <typename T>
+void binaryGraphCheckArrays(const CsrGraph<T>& graph, std::string filepath) {
+    for (int i = 0; i < graph.num_nodes; i++) {
+        if (graph.offsets[i] > graph.offsets[i + 1]) {
+            throw std::logic_error(filepath + " is corrupt.");
+        }
+    }
+    for (size_t i = 0; i < graph.num_edges; i++) {
+        if (graph.targets[i] < 0 || graph.targets[i] >= graph.num_nodes) {
+            throw std::logic_error(filepath + " is corrupt.");
+        }
+    }
+}
+
+/**
+ * @brief A read-only CsrGraph backed by a memory-mapped binary graph file.
+ * Opening only maps the file and checks its header; the graph's arrays
+ * point straight into the mapping, and the operating system pages them in
+ * as they're used. Processes that open the same file share those pages.
+ *
+ * The graph is a view that doesn't own its memory, and writing to it is
+ * undefined since the mapping is read-only. Copy the graph to change it.
+ *
+ * @tparam T The type of the graph's data. Must be trivially copyable
+ */
+template <typename T>
+struct MappedCsrGraph {
+public:
+    // Fields
+    MappedFile file;
+    CsrGraph<T> graph;
+
+    // Constructors
+
+    /**
+     * @brief Opens a binary graph file written by binaryGraphWrite
+     *
+     * @param filepath The path of the binary graph file
+     * @param check How much of the file to check. Only files that might
+     * be damaged or come from elsewhere need BINARY_GRAPH_CHECK_ALL
+     */
+    MappedCsrGraph(
+            std::string filepath,
+            BinaryGraphCheck check = BINARY_GRAPH_CHECK_HEADER):
+            file(filepath) {
+        static_assert(
+            std::is_trivially_copyable<T>::value,
+            "Binary graph nodes must be trivially copyable.");
+
+        const BinaryGraphHeader* header =
+            binaryGraphCheckHeader<T>(file, filepath);
+        char* data = const_cast<char*>(file.data);
+        graph.owns_memory = false;
+        graph.num_nodes = static_cast<int>(header->num_nodes);
+        graph.num_edges = static_cast<size_t>(header->num_edges);
+        graph.nodes = reinterpret_cast<T*>(data + header->nodes_offset);
+        graph.offsets =
+            reinterpret_cast<size_t*>(data + header->offsets_offset);
+        graph.targets = reinterpret_cast<int*>(data + header->targets_offset);
+        graph.weights =
+            reinterpret_cast<double*>(data + header->weights_offset);
+        if (check == BINARY_GRAPH_CHECK_ALL) {
+            binaryGraphCheckArrays(graph, filepath);
+        }
+    }
+    MappedCsrGraph(const MappedCsrGraph<T>& other) = delete;
+
+    // Operators
+    MappedCsrGraph<T>& operator = (const MappedCsrGraph<T>& rhs) = delete;
+};
+
+#endif
@@ -0,0 +1,454 @@
+#ifndef EDGE_LIST_LOADER_CPP
+#define EDGE_LIST_LOADER_CPP
+
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "../concurrency/thread_pool.cpp"
+#include "../data_structures/dynamic_array.cpp"
+#include "../data_structures/edge.cpp"
+#include "mapped_file.cpp"
+
+/**
+ * @brief Timing and size information about one edge list load
+ */
+struct EdgeListLoadStats {
+    // Fields
+    size_t bytes;
+    size_t edges;
+    int num_threads;
+    double seconds;
+    double megabytes_per_second;
+
+    // Constructors
+    EdgeListLoadStats(): bytes(0), edges(0), num_threads(0), seconds(0),
+        megabytes_per_second(0) {}
+};
+
+/**
+ * @brief Checks if the character separates tokens on a line
+ *
+ * @param c The character to check
+ * @return true if the character is a space, tab or carriage return
+ */
+inline bool edgeListIsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+/**
+ * @brief Parses an integer at the cursor, in the style of std::from_chars.
+ * The cursor is only moved past the number if parsing succeeds.
+ *
+ * @param cursor The position to parse from
+ * @param end The end of the buffer
+ * @param value Where to store the parsed integer
+ * @return true if an integer was parsed, otherwise false
+ */
+inline bool edgeListParseInt(
+        const char*& cursor,
+        const char* end,
+        int* value) {
+    const char* c = cursor;
+    bool negative = c < end && *c == '-';
+    if (c < end && (*c == '-' || *c == '+')) {c++;}
+    if (c == end || *c < '0' || *c > '9') {return false;}
+
+    long long result = 0;
+    while (c < end && *c >= '0' && *c <= '9') {
+        result = 10 * result + (*c - '0');
+        if (result > static_cast<long long>(INT_MAX) + 1) {return false;}
+        c++;
+    }
+    if (!negative && result > INT_MAX) {return false;}
+
+    *value = static_cast<int>(negative ? -result : result);
+    cursor = c;
+    return true;
+}
+
+/**
+ * @brief Parses an integer of any built-in integer type at the cursor. The
+ * cursor is only moved past the number if parsing succeeds.
+ *
+ * @tparam Integer The type of the integer
+ * @param cursor The position to parse from
+ * @param end The end of the buffer
+ * @param value Where to store the parsed integer
+ * @return true if an integer that fits the type was parsed, otherwise false
+ */
+template <typename Integer>
+inline bool edgeListParseInteger(
+        const char*& cursor,
+        const char* end,
+        Integer* value) {
+    const char* c = cursor;
+    bool negative = c < end && *c == '-';
+    if (negative && !std::numeric_limits<Integer>::is_signed) {return false;}
+    if (c < end && (*c == '-' || *c == '+')) {c++;}
+    if (c == end || *c < '0' || *c > '9') {return false;}
+
+    unsigned long long limit =
+        static_cast<unsigned long long>(std::numeric_limits<Integer>::max())
+        + negative;
+    unsigned long long result = 0;
+    while (c < end && *c >= '0' && *c <= '9') {
+        unsigned long long digit = *c - '0';
+        if (result > (limit - digit) / 10) {return false;}
+        result = 10 * result + digit;
+        c++;
+    }
+
+    // Negating after the cast keeps the type's minimum in range
+    *value = negative && result
+        ? static_cast<Integer>(-static_cast<Integer>(result - 1) - 1)
+        : static_cast<Integer>(result);
+    cursor = c;
+    return true;
+}
+
+/**
+ * @brief Parses a vertex at the cursor. Overloaded by vertex type, so
+ * edge lists can name their vertices with any integer type or with
+ * strings. The cursor is only moved past the vertex if parsing succeeds.
+ *
+ * @param cursor The position to parse from
+ * @param end The end of the buffer
+ * @param value Where to store the parsed vertex
+ * @return true if a vertex was parsed, otherwise false
+ */
+inline bool edgeListParseVertex(
+        const char*& cursor,
+        const char* end,
+        short* value) {
+    return edgeListParseInteger(cursor, end, value);
+}
+
+inline bool edgeListParseVertex(
+        const char*& cursor,
+        const char* end,
+        unsigned short* value) {
+    return edgeListParseInteger(cursor, end, value);
+}
+
+inline bool edgeListParseVertex(
+        const char*& cursor,
+        const char* end,
+        int* value) {
+    return edgeListParseInt(cursor, end, value);
+}
+
+inline bool edgeListParseVertex(
+        const char*& cursor,
+        const char* end,
+        unsigned int* value) {
+    return edgeListParseInteger(cursor, end, value);
+}
+
+inline bool edgeListParseVertex(
+        const char*& cursor,
+        const char* end,
+        long* value) {
+    return edgeListParseInteger(cursor, end, value);
+}
+
+inline bool edgeListParseVertex(
+        const char*& cursor,
+        const char* end,
+        unsigned long* value) {
+    return edgeListParseInteger(cursor, end, value);
+}
+
+inline bool edgeListParseVertex(
+        const char*& cursor,
+        const char* end,
+        long long* value) {
+    return edgeListParseInteger(cursor, end, value);
+}
+
+inline bool edgeListParseVertex(
+        const char*& cursor,
+        const char* end,
+        unsigned long long* value) {
+    return edgeListParseInteger(cursor, end, value);
+}
+
+/**
+ * @brief Parses a string vertex, which is every character up to the next
+ * space or line break
+ *
+ * @param cursor The position to parse from
+ * @param end The end of the buffer
+ * @param value Where to store the parsed vertex
+ * @return true if the vertex isn't empty, otherwise false
+ */
+inline bool edgeListParseVertex(
+        const char*& cursor,
+        const char* end,
+        std::string* value) {
+    const char* c = cursor;
+    while (c < end && !edgeListIsSpace(*c) && *c != '\n') {c++;}
+    if (c == cursor) {return false;}
+    value->assign(cursor, c);
+    cursor = c;
+    return true;
+}
+
+/**
+ * @brief Parses a decimal floating point number at the cursor, in the style
+ * of std::from_chars. Numbers with at most 15 significant digits and a small
+ * exponent are converted exactly with one multiply or divide; anything else
+ * falls back to std::strtod. The cursor is only moved if parsing succeeds.
+ *
+ * @param cursor The position to parse from
+ * @param end The end of the buffer
+ * @param value Where to store the parsed number
+ * @return true if a number was parsed, otherwise false
+ */
+inline bool edgeListParseDouble(
+        const char*& cursor,
+        const char* end,
+        double* value) {
+    static const double POWERS_OF_TEN[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    const char* c = cursor;
+    bool negative = c < end && *c == '-';
+    if (c < end && (*c == '-' || *c == '+')) {c++;}
+
+    unsigned long long mantissa = 0;
+    int digits = 0, significant = 0, exponent = 0;
+    while (c < end && *c >= '0' && *c <= '9') {
+        if (mantissa || *c != '0') {significant++;}
+        mantissa = 10 * mantissa + (*c - '0');
+        digits++;
+        c++;
+    }
+    if (c < end && *c == '.') {
+        c++;
+        while (c < end && *c >= '0' && *c <= '9') {
+            if (mantissa || *c != '0') {significant++;}
+            mantissa = 10 * mantissa + (*c - '0');
+            exponent--;
+            digits++;
+            c++;
+        }
+    }
+    if (!digits) {return false;}
+
+    if (c < end && (*c == 'e' || *c == 'E')) {
+        const char* exponent_start = c + 1;
+        int written = 0;
+        if (!edgeListParseInt(exponent_start, end, &written)) {return false;}
+        exponent += written;
+        c = exponent_start;
+    }
+
+    if (significant <= 15 && exponent >= -22 && exponent <= 22) {
+        double result = static_cast<double>(mantissa);
+        if (exponent < 0) {result /= POWERS_OF_TEN[-exponent];}
+        else {result *= POWERS_OF_TEN[exponent];}
+        *value = negative ? -result : result;
+    } else {
+        *value = std::strtod(std::string(cursor, c).c_str(), nullptr);
+    }
+    cursor = c;
+    return true;
+}
+
+/**
+ * @brief Parses one "from to [weight]" line. Missing weights default to 1.
+ *
+ * @tparam T The type of the vertices. See edgeListParseVertex
+ * @param cursor The start of the line. Moved to the start of the next line
+ * @param end The end of the buffer
+ * @param edges The list to append the edge to. Blank lines add nothing
+ */
+template <typename T>
+void edgeListParseLine(
+        const char*& cursor,
+        const char* end,
+        DynamicArray<Edge<T>>& edges) {
+    const char* c = cursor;
+    while (c < end && edgeListIsSpace(*c)) {c++;}
+    if (c == end || *c == '\n') {
+        cursor = c < end ? c + 1 : c;
+        return;
+    }
+
+    T from = T(), to = T();
+    double weight = 1;
+    bool valid = edgeListParseVertex(c, end, &from);
+    while (valid && c < end && edgeListIsSpace(*c)) {c++;}
+    valid = valid && edgeListParseVertex(c, end, &to);
+    while (valid && c < end && edgeListIsSpace(*c)) {c++;}
+    if (valid && c < end && *c != '\n') {
+        valid = edgeListParseDouble(c, end, &weight);
+        while (valid && c < end && edgeListIsSpace(*c)) {c++;}
+    }
+    if (!valid || (c < end && *c != '\n')) {
+        const char* line_end = cursor;
+        while (line_end < end && *line_end != '\n') {line_end++;}
+        throw std::logic_error(
+            "Expected \"from to [weight]\" but got \""
+            + std::string(cursor, line_end) + "\".");
+    }
+
+    dynamicArrayEmplaceBack(edges, std::move(from), std::move(to), weight);
+    cursor = c < end ? c + 1 : c;
+}
+
+/**
+ * @brief Parses every line in [begin, end). The range must start at the
+ * beginning of a line.
+ *
+ * @tparam T The type of the vertices
+ * @param begin The start of the range
+ * @param end The end of the range
+ * @param edges The list to append the edges to, in file order
+ * @param error Where to store an exception thrown while parsing, since
+ * exceptions can't cross threads on their own
+ */
+template <typename T>
+void edgeListParseChunk(
+        const char* begin,
+        const char* end,
+        DynamicArray<Edge<T>>* edges,
+        std::exception_ptr* error) {
+    try {
+        // Rough guess of 12 bytes per line saves most of the regrowth
+        dynamicArrayReserve(*edges, (end - begin) / 12 + 1);
+        while (begin < end) {edgeListParseLine(begin, end, *edges);}
+    } catch (...) {
+        *error = std::current_exception();
+    }
+}
+
+/**
+ * @brief Finds the start of the line after position, or end
+ *
+ * @param position Where to start searching
+ * @param end The end of the buffer
+ * @return const char* The start of the next line
+ */
+inline const char* edgeListNextLine(const char* position, const char* end) {
+    while (position < end && *position != '\n') {position++;}
+    return position < end ? position + 1 : end;
+}
+
+/**
+ * @brief Loads a graph file into a flat list of edges. The file format is
+ * described by the Graph file path constructor. Vertices may be any type
+ * edgeListParseVertex can parse, such as 64-bit ids or strings.
+ *
+ * The file is memory-mapped and split into chunks on line boundaries,
+ * which the pool's workers parse in parallel. Each chunk is parsed without
+ * allocating per line, and the chunks are joined back together in file
+ * order.
+ *
+ * @tparam T The type of the vertices
+ * @param filepath The path of the text file detailing the graph
+ * @param edges The list to append the file's edges to, in file order
+ * @param stats Where to store the load's timing and throughput, if not null
+ * @param num_threads The number of chunks to parse in parallel. 0 picks
+ * one per worker in the pool. Small files are always one chunk
+ * @param pool The pool to parse on
+ * @return int The number of nodes in the graph (the first line + 1)
+ */
+template <typename T>
+int edgeListLoad(
+        std::string filepath,
+        DynamicArray<Edge<T>>& edges,
+        EdgeListLoadStats* stats = nullptr,
+        int num_threads = 0,
+        ThreadPool& pool = threadPoolGetDefault()) {
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    MappedFile file(filepath);
+    const char* cursor = file.data;
+    const char* end = file.data + file.size;
+
+    while (cursor < end && (edgeListIsSpace(*cursor) || *cursor == '\n')) {
+        cursor++;
+    }
+    int last_node = 0;
+    if (!edgeListParseInt(cursor, end, &last_node)) {
+        throw std::logic_error(
+            "Expected the number of nodes on the first line of "
+            + filepath + ".");
+    }
+    cursor = edgeListNextLine(cursor, end);
+
+    // Chunks aren't worth handing out for less than a megabyte each
+    const size_t MIN_CHUNK_BYTES = 1 << 20;
+    if (num_threads <= 0) {num_threads = threadPoolGetNumWorkers(pool);}
+    size_t body = end - cursor;
+    size_t max_threads = body / MIN_CHUNK_BYTES + 1;
+    if (num_threads < 1) {num_threads = 1;}
+    if (static_cast<size_t>(num_threads) > max_threads) {
+        num_threads = static_cast<int>(max_threads);
+    }
+
+    DynamicArray<const char*> bounds(num_threads + 1);
+    dynamicArrayPushBack(bounds, cursor);
+    for (int i = 1; i < num_threads; i++) {
+        const char* split = cursor + body / num_threads * i;
+        split = edgeListNextLine(split - 1, end);
+        if (split < bounds[i - 1]) {split = bounds[i - 1];}
+        dynamicArrayPushBack(bounds, split);
+    }
+    dynamicArrayPushBack(bounds, end);
+
+    DynamicArray<DynamicArray<Edge<T>>> chunks;
+    DynamicArray<std::exception_ptr> errors;
+    dynamicArrayResize(chunks, num_threads);
+    dynamicArrayResize(errors, num_threads);
+    if (num_threads == 1) {
+        edgeListParseChunk(bounds[0], bounds[1], &chunks[0], &errors[0]);
+    } else {
+        threadPoolParallelFor(pool, 0, num_threads,
+            [&](int begin, int end, int) {
+                for (int i = begin; i < end; i++) {
+                    edgeListParseChunk(
+                        bounds[i], bounds[i + 1], &chunks[i], &errors[i]);
+                }
+            }, 1);
+    }
+    for (int i = 0; i < num_threads; i++) {
+        if (errors[i]) {std::rethrow_exception(errors[i]);}
+    }
+
+    size_t total = edges.size;
+    for (int i = 0; i < num_threads; i++) {total += chunks[i].size;}
+    dynamicArrayReserve(edges, total);
+    size_t loaded = 0;
+    for (int i = 0; i < num_threads; i++) {
+        for (size_t j = 0; j < chunks[i].size; j++) {
+            dynamicArrayPushBack(edges, std::move(chunks[i][j]));
+        }
+        loaded += chunks[i].size;
+    }
+
+    if (stats) {
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        stats->bytes = file.size;
+        stats->edges = loaded;
+        stats->num_threads = num_threads;
+        stats->seconds = elapsed.count();
+        stats->megabytes_per_second = stats->seconds > 0
+            ? file.size / 1e6 / stats->seconds
+            : 0;
+    }
+    return last_node + 1;
+}
+
+#endif
@@ -0,0 +1,878 @@
+#ifndef GRAPH_GENERATOR_CPP
+#define GRAPH_GENERATOR_CPP
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "../concurrency/thread_pool.cpp"
+#include "../data_structures/csr_graph.cpp"
+#include "../data_structures/dynamic_array.cpp"
+#include "../data_structures/edge.cpp"
+#include "../data_structures/graph.cpp"
+#include "binary_graph.cpp"
+
+// Edges are generated in blocks of this many, one block per pool task
+const uint64_t GRAPH_GENERATOR_BLOCK_EDGES = 1 << 16;
+// The default cap on how many edges graphGeneratorWriteBinary holds at once
+const size_t GRAPH_GENERATOR_MAX_EDGES_IN_MEMORY = 1 << 26;
+const uint64_t GRAPH_GENERATOR_GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL;
+
+enum GraphGeneratorModel {
+    // Recursive matrix (R-MAT), the Kronecker graphs used by Graph500
+    GRAPH_GENERATOR_RMAT,
+    // Erdos-Renyi G(n, m): every edge picks both ends uniformly
+    GRAPH_GENERATOR_UNIFORM,
+    // 2D or 3D lattice, with edges between neighboring cells
+    GRAPH_GENERATOR_GRID,
+    // Barabasi-Albert: new nodes attach to nodes in proportion to degree
+    GRAPH_GENERATOR_PREFERENTIAL
+};
+
+/**
+ * @brief Describes a seeded random graph. Make one with graphGeneratorRmat,
+ * graphGeneratorUniform, graphGeneratorGrid or graphGeneratorPreferential.
+ *
+ * Edge i depends only on the seed and i, not on the edges before it, so
+ * any range of edges can be generated on its own. That's what lets the
+ * pool generate blocks of edges in parallel, and lets the writers stream
+ * graphs far bigger than memory. The same seed always gives the same
+ * graph, no matter how many workers generate it.
+ *
+ * Nodes are numbered 0 to num_nodes - 1, and weights are whole numbers
+ * from 1 to max_weight. Like Graph500, R-MAT, uniform and preferential
+ * graphs can repeat edges and have self loops.
+ */
+struct GraphGenerator {
+public:
+    // Fields
+    GraphGeneratorModel model;
+    uint64_t seed;
+    int num_nodes;
+    uint64_t num_edges;
+    int max_weight;
+    // R-MAT: num_nodes is 2^scale, and a, b and c are the chances of
+    // recursing into the top left, top right and bottom left quadrants
+    int scale;
+    double a;
+    double b;
+    double c;
+    // Grid: depth is 1 for a 2D grid
+    int width;
+    int height;
+    int depth;
+    // Preferential attachment: the out-degree of every node
+    int edges_per_node;
+
+    // Constructors
+    GraphGenerator(): model(GRAPH_GENERATOR_UNIFORM), seed(0), num_nodes(0),
+        num_edges(0), max_weight(1), scale(0), a(0), b(0), c(0), width(0),
+        height(0), depth(0), edges_per_node(0) {}
+};
+
+/**
+ * @brief The splitmix64 finalizer. A bijection on 64 bit numbers that
+ * spreads every input bit across the output
+ *
+ * @param x The number to mix
+ * @return uint64_t The mixed number
+ */
+inline uint64_t graphGeneratorMix(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief Draws the next random number from a splitmix64 stream
+ *
+ * @param state The stream's state. Updated
+ * @return uint64_t The random number
+ */
+inline uint64_t graphGeneratorNext(uint64_t& state) {
+    state += GRAPH_GENERATOR_GOLDEN_GAMMA;
+    return graphGeneratorMix(state);
+}
+
+/**
+ * @brief Checks the settings every model shares and fills them in
+ *
+ * @param model The model
+ * @param seed The seed
+ * @param max_weight The largest weight
+ * @return GraphGenerator A generator with only the shared settings filled
+ */
+inline GraphGenerator graphGeneratorMake(
+        GraphGeneratorModel model,
+        uint64_t seed,
+        int max_weight) {
+    if (max_weight < 1) {
+        throw std::logic_error("Can't generate weights below 1.");
+    }
+    GraphGenerator generator;
+    generator.model = model;
+    generator.seed = seed;
+    generator.max_weight = max_weight;
+    return generator;
+}
+
+/**
+ * @brief Describes an R-MAT graph with 2^scale nodes. Each edge starts
+ * with the whole adjacency matrix and recurses into one of its quadrants
+ * scale times, which gives the skewed, power-law-like degrees of real
+ * networks. Node ids are scrambled afterwards, so the busiest nodes
+ * aren't all at the start.
+ *
+ * @param scale log2 of the number of nodes, from 1 to 30
+ * @param num_edges The number of edges. Graph500 uses 16 per node
+ * @param seed The seed
+ * @param max_weight The largest weight
+ * @param a The chance of the top left quadrant
+ * @param b The chance of the top right quadrant
+ * @param c The chance of the bottom left quadrant. The bottom right gets
+ * the rest
+ * @return GraphGenerator The generator
+ */
+inline GraphGenerator graphGeneratorRmat(
+        int scale,
+        uint64_t num_edges,
+        uint64_t seed,
+        int max_weight = 100,
+        double a = 0.57,
+        double b = 0.19,
+        double c = 0.19) {
+    if (scale < 1 || scale > 30) {
+        throw std::logic_error("Can't generate an R-MAT graph of that scale.");
+    }
+    if (a < 0 || b < 0 || c < 0 || a + b + c > 1) {
+        throw std::logic_error(
+            "Can't generate an R-MAT graph from those probabilities.");
+    }
+    GraphGenerator generator =
+        graphGeneratorMake(GRAPH_GENERATOR_RMAT, seed, max_weight);
+    generator.scale = scale;
+    generator.num_nodes = 1 << scale;
+    generator.num_edges = num_edges;
+    generator.a = a;
+    generator.b = b;
+    generator.c = c;
+    return generator;
+}
+
+/**
+ * @brief Describes a uniform random graph, where both ends of every edge
+ * are picked uniformly from all the nodes
+ *
+ * @param num_nodes The number of nodes
+ * @param num_edges The number of edges
+ * @param seed The seed
+ * @param max_weight The largest weight
+ * @return GraphGenerator The generator
+ */
+inline GraphGenerator graphGeneratorUniform(
+        int num_nodes,
+        uint64_t num_edges,
+        uint64_t seed,
+        int max_weight = 100) {
+    if (num_nodes < 1) {
+        throw std::logic_error("Can't generate a graph without nodes.");
+    }
+    GraphGenerator generator =
+        graphGeneratorMake(GRAPH_GENERATOR_UNIFORM, seed, max_weight);
+    generator.num_nodes = num_nodes;
+    generator.num_edges = num_edges;
+    return generator;
+}
+
+/**
+ * @brief Describes a width by height by depth grid. Node (x, y, z) is
+ * x + width * (y + height * z), and has an edge to the next node along
+ * each axis. Only the random weights depend on the seed.
+ *
+ * @param width The number of nodes along x
+ * @param height The number of nodes along y
+ * @param depth The number of nodes along z, or 1 for a 2D grid
+ * @param seed The seed
+ * @param max_weight The largest weight
+ * @return GraphGenerator The generator
+ */
+inline GraphGenerator graphGeneratorGrid(
+        int width,
+        int height,
+        int depth,
+        uint64_t seed,
+        int max_weight = 100) {
+    if (width < 1 || height < 1 || depth < 1) {
+        throw std::logic_error("Can't generate a grid without nodes.");
+    }
+    if (static_cast<int64_t>(width) * height * depth > INT_MAX) {
+        throw std::logic_error("Can't generate a grid that big.");
+    }
+    GraphGenerator generator =
+        graphGeneratorMake(GRAPH_GENERATOR_GRID, seed, max_weight);
+    generator.width = width;
+    generator.height = height;
+    generator.depth = depth;
+    generator.num_nodes = width * height * depth;
+    generator.num_edges =
+        static_cast<uint64_t>(width - 1) * height * depth
+        + static_cast<uint64_t>(width) * (height - 1) * depth
+        + static_cast<uint64_t>(width) * height * (depth - 1);
+    return generator;
+}
+
+/**
+ * @brief Describes a Barabasi-Albert preferential attachment graph. Nodes
+ * arrive in order, and each adds edges_per_node edges to nodes picked in
+ * proportion to their degree so far, so early nodes become hubs.
+ *
+ * @param num_nodes The number of nodes
+ * @param edges_per_node The number of edges each node adds
+ * @param seed The seed
+ * @param max_weight The largest weight
+ * @return GraphGenerator The generator
+ */
+inline GraphGenerator graphGeneratorPreferential(
+        int num_nodes,
+        int edges_per_node,
+        uint64_t seed,
+        int max_weight = 100) {
+    if (num_nodes < 1) {
+        throw std::logic_error("Can't generate a graph without nodes.");
+    }
+    if (edges_per_node < 1) {
+        throw std::logic_error("Can't attach a node with fewer than 1 edge.");
+    }
+    GraphGenerator generator =
+        graphGeneratorMake(GRAPH_GENERATOR_PREFERENTIAL, seed, max_weight);
+    generator.num_nodes = num_nodes;
+    generator.edges_per_node = edges_per_node;
+    generator.num_edges = static_cast<uint64_t>(num_nodes) * edges_per_node;
+    return generator;
+}
+
+/**
+ * @brief Relabels an R-MAT node with a seeded bijection on [0, 2^scale).
+ * Multiplying by an odd number and xor-ing with a right shift each undo
+ * cleanly within scale bits, so no two nodes get the same label.
+ *
+ * @param generator The generator
+ * @param node The node to relabel
+ * @return int The new label
+ */
+inline int graphGeneratorScramble(
+        const GraphGenerator& generator,
+        uint64_t node) {
+    uint64_t mask = (static_cast<uint64_t>(1) << generator.scale) - 1;
+    int shift = (generator.scale + 1) / 2;
+    uint64_t key = generator.seed;
+    for (int round = 0; round < 2; round++) {
+        key = graphGeneratorMix(key + GRAPH_GENERATOR_GOLDEN_GAMMA);
+        node = ((node ^ key) * (key | 1)) & mask;
+        node ^= node >> shift;
+    }
+    return static_cast<int>(node);
+}
+
+/**
+ * @brief Generates one of the graph's edges
+ *
+ * @param generator The generator
+ * @param index Which edge, from 0 to num_edges - 1
+ * @return Edge<int> The edge
+ */
+inline Edge<int> graphGeneratorEdge(
+        const GraphGenerator& generator,
+        uint64_t index) {
+    uint64_t state = graphGeneratorMix(
+        generator.seed + index * GRAPH_GENERATOR_GOLDEN_GAMMA);
+    uint64_t from = 0;
+    uint64_t to = 0;
+    if (generator.model == GRAPH_GENERATOR_RMAT) {
+        // Each level only needs a 16 bit draw, so one number covers four
+        const double ONE = 1 << 16;
+        uint64_t top_left = static_cast<uint64_t>(generator.a * ONE);
+        uint64_t top = static_cast<uint64_t>(
+            (generator.a + generator.b) * ONE);
+        uint64_t left = static_cast<uint64_t>(
+            (generator.a + generator.b + generator.c) * ONE);
+        uint64_t bits = 0;
+        for (int level = 0; level < generator.scale; level++) {
+            if (level % 4 == 0) {bits = graphGeneratorNext(state);}
+            uint64_t quadrant = bits & 0xFFFF;
+            bits >>= 16;
+            from = from << 1 | (quadrant >= top);
+            to = to << 1 | ((quadrant >= top_left) != (quadrant >= top)
+                || quadrant >= left);
+        }
+        from = graphGeneratorScramble(generator, from);
+        to = graphGeneratorScramble(generator, to);
+    } else if (generator.model == GRAPH_GENERATOR_UNIFORM) {
+        from = graphGeneratorNext(state) % generator.num_nodes;
+        to = graphGeneratorNext(state) % generator.num_nodes;
+    } else if (generator.model == GRAPH_GENERATOR_GRID) {
+        uint64_t width = generator.width;
+        uint64_t layer = width * generator.height;
+        uint64_t along_x = (width - 1) * generator.height * generator.depth;
+        uint64_t along_y = width * (generator.height - 1) * generator.depth;
+        if (index < along_x) {
+            from = index / (width - 1) * width + index % (width - 1);
+            to = from + 1;
+        } else if (index < along_x + along_y) {
+            uint64_t rest = index - along_x;
+            uint64_t per_layer = layer - width;
+            from = rest / per_layer * layer + rest % per_layer;
+            to = from + width;
+        } else {
+            from = index - along_x - along_y;
+            to = from + layer;
+        }
+    } else {
+        // Edge i fills two slots in a list of every edge's ends: 2i is its
+        // source and 2i + 1 its target. A target copies a uniformly random
+        // earlier slot, and a node fills as many slots as its degree, so
+        // that's preferential attachment. Copies of copies are followed
+        // back until they reach a source slot, which only takes two hops
+        // on average. This is the parallel generator of Sanders and Schulz.
+        uint64_t slot = 2 * index + 1;
+        while (slot % 2) {
+            slot = graphGeneratorMix(generator.seed ^ graphGeneratorMix(slot))
+                % slot;
+        }
+        from = index / generator.edges_per_node;
+        to = slot / 2 / generator.edges_per_node;
+    }
+    double weight = static_cast<double>(
+        1 + graphGeneratorNext(state) % generator.max_weight);
+    return Edge<int>(static_cast<int>(from), static_cast<int>(to), weight);
+}
+
+/**
+ * @brief Gets the number of directed edges the graph has, which doubles
+ * when every edge is also added reversed
+ *
+ * @param generator The generator
+ * @param direction Whether every edge is also added reversed
+ * @return uint64_t The number of directed edges
+ */
+inline uint64_t graphGeneratorGetNumEdges(
+        const GraphGenerator& generator,
+        GraphDirection direction) {
+    return direction == GRAPH_UNDIRECTED
+        ? 2 * generator.num_edges
+        : generator.num_edges;
+}
+
+/**
+ * @brief Generates one of the graph's directed edges. An undirected graph
+ * has every edge followed by its reverse, like graphAddReverseEdges.
+ *
+ * @param generator The generator
+ * @param direction Whether every edge is also added reversed
+ * @param index Which directed edge
+ * @return Edge<int> The edge
+ */
+inline Edge<int> graphGeneratorDirectedEdge(
+        const GraphGenerator& generator,
+        GraphDirection direction,
+        uint64_t index) {
+    if (direction == GRAPH_DIRECTED) {
+        return graphGeneratorEdge(generator, index);
+    }
+    Edge<int> edge = graphGeneratorEdge(generator, index / 2);
+    if (index % 2) {return Edge<int>(edge.to, edge.from, edge.weight);}
+    return edge;
+}
+
+/**
+ * @brief Gets how many blocks a number of edges is generated in
+ *
+ * @param num_edges The number of edges
+ * @return int The number of blocks
+ */
+inline int graphGeneratorGetNumBlocks(uint64_t num_edges) {
+    uint64_t num_blocks = (num_edges + GRAPH_GENERATOR_BLOCK_EDGES - 1)
+        / GRAPH_GENERATOR_BLOCK_EDGES;
+    if (num_blocks > INT_MAX) {
+        throw std::logic_error("Can't generate that many edges.");
+    }
+    return static_cast<int>(num_blocks);
+}
+
+/**
+ * @brief Generates the directed edges whose source is in [first, last) in
+ * parallel, and appends them in order
+ *
+ * @param generator The generator
+ * @param direction Whether every edge is also added reversed
+ * @param first The first source to keep
+ * @param last One past the last source to keep
+ * @param edges The list to append the edges to
+ * @param pool The pool to generate on
+ */
+inline void graphGeneratorCollect(
+        const GraphGenerator& generator,
+        GraphDirection direction,
+        int first,
+        int last,
+        DynamicArray<Edge<int>>& edges,
+        ThreadPool& pool) {
+    uint64_t total = graphGeneratorGetNumEdges(generator, direction);
+    int num_blocks = graphGeneratorGetNumBlocks(total);
+    DynamicArray<DynamicArray<Edge<int>>> blocks;
+    dynamicArrayResize(blocks, num_blocks);
+    threadPoolParallelFor(pool, 0, num_blocks, [&](int begin, int end, int) {
+        for (int block = begin; block < end; block++) {
+            uint64_t start = block * GRAPH_GENERATOR_BLOCK_EDGES;
+            uint64_t stop = start + GRAPH_GENERATOR_BLOCK_EDGES;
+            if (stop > total) {stop = total;}
+            for (uint64_t i = start; i < stop; i++) {
+                Edge<int> edge =
+                    graphGeneratorDirectedEdge(generator, direction, i);
+                if (first <= edge.from && edge.from < last) {
+                    dynamicArrayPushBack(blocks[block], edge);
+                }
+            }
+        }
+    }, 1);
+
+    size_t size = edges.size;
+    for (int i = 0; i < num_blocks; i++) {size += blocks[i].size;}
+    dynamicArrayReserve(edges, size);
+    for (int i = 0; i < num_blocks; i++) {
+        for (size_t j = 0; j < blocks[i].size; j++) {
+            dynamicArrayPushBack(edges, blocks[i][j]);
+        }
+    }
+}
+
+/**
+ * @brief Generates every directed edge of the graph in parallel, in order
+ *
+ * @param generator The generator
+ * @param edges The list to append the edges to
+ * @param direction Whether every edge is also added reversed
+ * @param pool The pool to generate on
+ */
+inline void graphGeneratorGenerateEdges(
+        const GraphGenerator& generator,
+        DynamicArray<Edge<int>>& edges,
+        GraphDirection direction = GRAPH_DIRECTED,
+        ThreadPool& pool = threadPoolGetDefault()) {
+    graphGeneratorCollect(
+        generator, direction, 0, generator.num_nodes, edges, pool);
+}
+
+/**
+ * @brief Generates the graph as a CSR graph. Matches loading the graph's
+ * edge list file with the CsrGraph file path constructor.
+ *
+ * @param generator The generator
+ * @param direction Whether every edge is also added reversed
+ * @param pool The pool to generate on
+ * @return CsrGraph<int> The graph
+ */
+inline CsrGraph<int> graphGeneratorGenerateCsr(
+        const GraphGenerator& generator,
+        GraphDirection direction = GRAPH_DIRECTED,
+        ThreadPool& pool = threadPoolGetDefault()) {
+    DynamicArray<Edge<int>> edges;
+    graphGeneratorGenerateEdges(generator, edges, direction, pool);
+    CsrGraph<int> graph;
+    csrGraphAllocate(graph, generator.num_nodes, edges.size);
+    for (int i = 0; i < generator.num_nodes; i++) {graph.nodes[i] = i;}
+    csrGraphFillEdges(graph, edges);
+    return graph;
+}
+
+/**
+ * @brief Generates the graph into an empty Graph. Graph doesn't allow an
+ * edge twice, so only the first copy of a repeated edge is kept.
+ *
+ * @param generator The generator
+ * @param graph The empty graph to fill
+ * @param direction Whether every edge is also added reversed
+ * @param pool The pool to generate on
+ */
+inline void graphGeneratorGenerateGraph(
+        const GraphGenerator& generator,
+        Graph<int>& graph,
+        GraphDirection direction = GRAPH_DIRECTED,
+        ThreadPool& pool = threadPoolGetDefault()) {
+    if (graph.adjacency_matrix) {
+        throw std::logic_error("Can't generate into a graph with nodes.");
+    }
+    // Grouping the edges by source lets one marker per node find repeats
+    CsrGraph<int> csr = graphGeneratorGenerateCsr(generator, direction, pool);
+    DynamicArray<Edge<int>> edges(csr.num_edges);
+    DynamicArray<int> marked;
+    dynamicArrayResize(marked, csr.num_nodes);
+    for (int i = 0; i < csr.num_nodes; i++) {marked[i] = -1;}
+    for (int from = 0; from < csr.num_nodes; from++) {
+        for (size_t k = csr.offsets[from]; k < csr.offsets[from + 1]; k++) {
+            if (marked[csr.targets[k]] == from) {continue;}
+            marked[csr.targets[k]] = from;
+            dynamicArrayPushBack(
+                edges, Edge<int>(from, csr.targets[k], csr.weights[k]));
+        }
+    }
+    for (int i = 0; i < csr.num_nodes; i++) {graphAddNode(graph, i);}
+    graphAddEdges(graph, edges);
+}
+
+/**
+ * @brief Appends a number to a string in decimal
+ *
+ * @param text The string to append to
+ * @param number The number
+ */
+inline void graphGeneratorAppendNumber(std::string& text, uint64_t number) {
+    char digits[20];
+    int length = 0;
+    do {
+        digits[length++] = static_cast<char>('0' + number % 10);
+        number /= 10;
+    } while (number);
+    while (length) {text += digits[--length];}
+}
+
+/**
+ * @brief Writes the graph to a graph file, in the format described by the
+ * Graph file path constructor. Each edge is written once, so load the file
+ * as undirected to get the reverse edges too.
+ *
+ * The workers format a round of blocks in parallel, which is written out
+ * before the next round starts, so only a few blocks are in memory at once.
+ *
+ * @param generator The generator
+ * @param filepath The path of the file to write
+ * @param pool The pool to generate on
+ */
+inline void graphGeneratorWriteEdgeList(
+        const GraphGenerator& generator,
+        std::string filepath,
+        ThreadPool& pool = threadPoolGetDefault()) {
+    std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+    if (!file) {throw std::logic_error("Can't open " + filepath + ".");}
+    file << generator.num_nodes - 1 << '\n';
+
+    int num_blocks = graphGeneratorGetNumBlocks(generator.num_edges);
+    int round_blocks = 4 * threadPoolGetNumWorkers(pool);
+    DynamicArray<std::string> texts;
+    dynamicArrayResize(texts, round_blocks);
+    for (int round = 0; round < num_blocks; round += round_blocks) {
+        int round_end = round + round_blocks;
+        if (round_end > num_blocks) {round_end = num_blocks;}
+        threadPoolParallelFor(pool, round, round_end,
+            [&](int begin, int end, int) {
+                for (int block = begin; block < end; block++) {
+                    std::string& text = texts[block - round];
+                    text.clear();
+                    uint64_t start = block * GRAPH_GENERATOR_BLOCK_EDGES;
+                    uint64_t stop = start + GRAPH_GENERATOR_BLOCK_EDGES;
+                    if (stop > generator.num_edges) {
+                        stop = generator.num_edges;
+                    }
+                    for (uint64_t i = start; i < stop; i++) {
+                        Edge<int> edge = graphGeneratorEdge(generator, i);
+                        graphGeneratorAppendNumber(text, edge.from);
+                        text += ' ';
+                        graphGeneratorAppendNumber(text, edge.to);
+                        text += ' ';
+                        graphGeneratorAppendNumber(
+                            text, static_cast<uint64_t>(edge.weight));
+                        text += '\n';
+                    }
+                }
+            }, 1);
+        for (int block = round; block < round_end; block++) {
+            file.write(
+                texts[block - round].data(),
+                static_cast<std::streamsize>(texts[block - round].size()));
+        }
+    }
+
+    file.flush();
+    if (!file) {throw std::logic_error("Can't write " + filepath + ".");}
+}
+
+/**
+ * @brief Generates every directed edge once, at most max_edges at a time,
+ * and writes each to its range's section of a spill file. A range's
+ * section starts at its first edge's offset, and holds the range's edges
+ * in the order they're generated.
+ *
+ * @param generator The generator
+ * @param direction Whether every edge is also added reversed
+ * @param spill_path The path of the spill file to write
+ * @param starts The first node of each range, then the number of nodes
+ * @param offsets The offset of each node's first edge, then the number of
+ * edges
+ * @param max_edges The most edges to hold in memory at once
+ * @param pool The pool to generate on
+ */
+inline void graphGeneratorSpillEdges(
+        const GraphGenerator& generator,
+        GraphDirection direction,
+        std::string spill_path,
+        const DynamicArray<int>& starts,
+        const DynamicArray<size_t>& offsets,
+        size_t max_edges,
+        ThreadPool& pool) {
+    std::ofstream spill(spill_path, std::ios::binary | std::ios::trunc);
+    if (!spill) {throw std::logic_error("Can't open " + spill_path + ".");}
+    uint64_t total = graphGeneratorGetNumEdges(generator, direction);
+    int num_blocks = graphGeneratorGetNumBlocks(total);
+    int num_ranges = static_cast<int>(starts.size) - 1;
+    int round_blocks = static_cast<int>(
+        std::min<uint64_t>(max_edges / GRAPH_GENERATOR_BLOCK_EDGES,
+            static_cast<uint64_t>(num_blocks)));
+    if (round_blocks < 1) {round_blocks = 1;}
+
+    // Where each range's next edge goes, and how many edges each range
+    // gets this round. Counts are only reset for the ranges a round
+    // touched, so a round costs time in its edges, not in the ranges.
+    DynamicArray<size_t> cursors(num_ranges);
+    for (int range = 0; range < num_ranges; range++) {
+        dynamicArrayPushBack(cursors, offsets[starts[range]]);
+    }
+    DynamicArray<size_t> counts;
+    dynamicArrayResize(counts, num_ranges);
+    DynamicArray<DynamicArray<Edge<int>>> blocks;
+    dynamicArrayResize(blocks, round_blocks);
+    DynamicArray<DynamicArray<int>> block_ranges;
+    dynamicArrayResize(block_ranges, round_blocks);
+    DynamicArray<int> touched;
+    DynamicArray<Edge<int>> grouped;
+    for (int round = 0; round < num_blocks; round += round_blocks) {
+        int round_end = round + round_blocks;
+        if (round_end > num_blocks) {round_end = num_blocks;}
+        threadPoolParallelFor(pool, round, round_end,
+                [&](int begin, int end, int) {
+            for (int block = begin; block < end; block++) {
+                DynamicArray<Edge<int>>& block_edges = blocks[block - round];
+                DynamicArray<int>& ranges = block_ranges[block - round];
+                dynamicArrayClear(block_edges);
+                dynamicArrayClear(ranges);
+                uint64_t start = block * GRAPH_GENERATOR_BLOCK_EDGES;
+                uint64_t stop = start + GRAPH_GENERATOR_BLOCK_EDGES;
+                if (stop > total) {stop = total;}
+                for (uint64_t i = start; i < stop; i++) {
+                    Edge<int> edge =
+                        graphGeneratorDirectedEdge(generator, direction, i);
+                    dynamicArrayPushBack(block_edges, edge);
+                    dynamicArrayPushBack(ranges, static_cast<int>(
+                        std::upper_bound(starts.data,
+                            starts.data + starts.size, edge.from)
+                        - starts.data - 1));
+                }
+            }
+        }, 1);
+
+        // Group the round's edges by range, keeping their order
+        dynamicArrayClear(touched);
+        size_t round_size = 0;
+        for (int block = 0; block < round_end - round; block++) {
+            for (size_t i = 0; i < blocks[block].size; i++) {
+                int range = block_ranges[block][i];
+                if (!counts[range]++) {
+                    dynamicArrayPushBack(touched, range);
+                }
+            }
+            round_size += blocks[block].size;
+        }
+        std::sort(touched.data, touched.data + touched.size);
+        size_t running = 0;
+        for (size_t i = 0; i < touched.size; i++) {
+            size_t count = counts[touched[i]];
+            counts[touched[i]] = running;
+            running += count;
+        }
+        dynamicArrayResize(grouped, round_size);
+        for (int block = 0; block < round_end - round; block++) {
+            for (size_t i = 0; i < blocks[block].size; i++) {
+                int range = block_ranges[block][i];
+                grouped[counts[range]++] = blocks[block][i];
+            }
+        }
+
+        // Each touched range's edges are now together, ending at its count
+        size_t begin = 0;
+        for (size_t i = 0; i < touched.size; i++) {
+            int range = touched[i];
+            size_t end = counts[range];
+            spill.seekp(static_cast<std::streamoff>(
+                cursors[range] * sizeof(Edge<int>)));
+            spill.write(reinterpret_cast<const char*>(grouped.data + begin),
+                static_cast<std::streamsize>(
+                    (end - begin) * sizeof(Edge<int>)));
+            cursors[range] += end - begin;
+            counts[range] = 0;
+            begin = end;
+        }
+    }
+
+    spill.flush();
+    if (!spill) {throw std::logic_error("Can't write " + spill_path + ".");}
+}
+
+/**
+ * @brief Writes the graph to a binary graph file, which can be opened with
+ * MappedCsrGraph. The file matches binaryGraphWrite of the CSR graph.
+ *
+ * Degrees are counted first, so every node's place in the file is known.
+ * The nodes are then split into ranges with at most max_edges edges
+ * between them (or one node, if it has more). A graph with one range is
+ * generated and written in one go. Otherwise the edges are generated once
+ * more, at most max_edges at a time, and appended in order to their
+ * range's section of a spill file next to the output. Each range is then
+ * read back and written on its own, so a graph bigger than memory is
+ * generated twice in all, however many ranges it takes, at the cost of
+ * 16 bytes of disk per edge while it's written.
+ *
+ * @param generator The generator
+ * @param filepath The path of the file to write
+ * @param direction Whether every edge is also added reversed
+ * @param max_edges The most edges to hold in memory at once
+ * @param pool The pool to generate on
+ */
+inline void graphGeneratorWriteBinary(
+        const GraphGenerator& generator,
+        std::string filepath,
+        GraphDirection direction = GRAPH_DIRECTED,
+        size_t max_edges = GRAPH_GENERATOR_MAX_EDGES_IN_MEMORY,
+        ThreadPool& pool = threadPoolGetDefault()) {
+    if (max_edges < 1) {
+        throw std::logic_error("Can't write a graph holding no edges.");
+    }
+    int num_nodes = generator.num_nodes;
+    uint64_t total = graphGeneratorGetNumEdges(generator, direction);
+    int num_blocks = graphGeneratorGetNumBlocks(total);
+
+    std::unique_ptr<std::atomic<size_t>[]> degrees(
+        new std::atomic<size_t>[num_nodes]);
+    for (int i = 0; i < num_nodes; i++) {degrees[i].store(0);}
+    threadPoolParallelFor(pool, 0, num_blocks, [&](int begin, int end, int) {
+        uint64_t start = begin * GRAPH_GENERATOR_BLOCK_EDGES;
+        uint64_t stop = end * GRAPH_GENERATOR_BLOCK_EDGES;
+        if (stop > total) {stop = total;}
+        for (uint64_t i = start; i < stop; i++) {
+            Edge<int> edge =
+                graphGeneratorDirectedEdge(generator, direction, i);
+            degrees[edge.from].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    DynamicArray<size_t> offsets(num_nodes + 1);
+    dynamicArrayPushBack(offsets, static_cast<size_t>(0));
+    for (int i = 0; i < num_nodes; i++) {
+        dynamicArrayPushBack(offsets, offsets[i] + degrees[i].load());
+    }
+    degrees.reset();
+    DynamicArray<int> nodes(num_nodes);
+    for (int i = 0; i < num_nodes; i++) {dynamicArrayPushBack(nodes, i);}
+
+    BinaryGraphHeader header = binaryGraphLayout<int>(num_nodes, total);
+    std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+    if (!file) {throw std::logic_error("Can't open " + filepath + ".");}
+    uint64_t position = 0;
+    binaryGraphWriteSection(file, position, 0, &header, sizeof(header));
+    binaryGraphWriteSection(file, position, header.nodes_offset,
+        nodes.data, header.num_nodes * sizeof(int));
+    binaryGraphWriteSection(file, position, header.offsets_offset,
+        offsets.data, (header.num_nodes + 1) * sizeof(size_t));
+    binaryGraphWriteSection(file, position, header.targets_offset,
+        nullptr, 0);
+
+    // Each range starts at a node, and the last start is num_nodes
+    DynamicArray<int> starts;
+    dynamicArrayPushBack(starts, 0);
+    while (starts[starts.size - 1] < num_nodes) {
+        int first = starts[starts.size - 1];
+        int last = first + 1;
+        while (last < num_nodes
+            && offsets[last + 1] - offsets[first] <= max_edges) {last++;}
+        dynamicArrayPushBack(starts, last);
+    }
+    int num_ranges = static_cast<int>(starts.size) - 1;
+
+    DynamicArray<Edge<int>> edges;
+    std::string spill_path = filepath + ".spill";
+    try {
+        if (num_ranges > 1) {
+            graphGeneratorSpillEdges(
+                generator, direction, spill_path, starts, offsets,
+                max_edges, pool);
+        }
+        std::ifstream spill;
+        if (num_ranges > 1) {
+            spill.open(spill_path, std::ios::binary);
+            if (!spill) {
+                throw std::logic_error("Can't open " + spill_path + ".");
+            }
+        }
+
+        DynamicArray<int> targets;
+        DynamicArray<double> weights;
+        DynamicArray<size_t> positions;
+        for (int range = 0; range < num_ranges; range++) {
+            int first = starts[range];
+            int last = starts[range + 1];
+            dynamicArrayClear(edges);
+            if (num_ranges > 1) {
+                dynamicArrayResize(edges, offsets[last] - offsets[first]);
+                spill.seekg(static_cast<std::streamoff>(
+                    offsets[first] * sizeof(Edge<int>)));
+                spill.read(reinterpret_cast<char*>(edges.data),
+                    static_cast<std::streamsize>(
+                        edges.size * sizeof(Edge<int>)));
+                if (!spill) {
+                    throw std::logic_error("Can't read " + spill_path + ".");
+                }
+            } else {
+                graphGeneratorCollect(
+                    generator, direction, first, last, edges, pool);
+            }
+            dynamicArrayResize(targets, edges.size);
+            dynamicArrayResize(weights, edges.size);
+            dynamicArrayClear(positions);
+            for (int i = first; i < last; i++) {
+                dynamicArrayPushBack(positions, offsets[i] - offsets[first]);
+            }
+            for (size_t i = 0; i < edges.size; i++) {
+                size_t slot = positions[edges[i].from - first]++;
+                targets[slot] = edges[i].to;
+                weights[slot] = edges[i].weight;
+            }
+
+            file.seekp(static_cast<std::streamoff>(
+                header.targets_offset + offsets[first] * sizeof(int)));
+            file.write(reinterpret_cast<const char*>(targets.data),
+                static_cast<std::streamsize>(edges.size * sizeof(int)));
+            file.seekp(static_cast<std::streamoff>(
+                header.weights_offset + offsets[first] * sizeof(double)));
+            file.write(reinterpret_cast<const char*>(weights.data),
+                static_cast<std::streamsize>(edges.size * sizeof(double)));
+        }
+    } catch (...) {
+        std::remove(spill_path.c_str());
+        throw;
+    }
+    std::remove(spill_path.c_str());
+
+    // Without edges, nothing above reached the end of the file
+    if (!total) {
+        binaryGraphWriteSection(file, position, header.weights_offset,
+            nullptr, 0);
+    }
+
+    file.flush();
+    if (!file) {throw std::logic_error("Can't write " + filepath + ".");}
+}
+
+#endif
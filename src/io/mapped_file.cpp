@@ -0,0 +1,123 @@
+#ifndef MAPPED_FILE_CPP
+#define MAPPED_FILE_CPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+struct MappedFile;
+inline void mappedFileClose(MappedFile& file);
+
+/**
+ * @brief Read-only memory mapping of a whole file. The operating system
+ * pages the file in on demand and shares those pages between every process
+ * that maps the same file, so opening is cheap no matter how big the file is.
+ *
+ * The mapping lives as long as the object, so it can't be copied.
+ */
+struct MappedFile {
+public:
+    // Fields
+    const char* data;
+    size_t size;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#else
+    int file;
+#endif
+
+    // Constructors
+
+    /**
+     * @brief Maps the file at filepath into memory
+     *
+     * @param filepath The path of the file to map
+     */
+    MappedFile(std::string filepath): data(nullptr), size(0) {
+#ifdef _WIN32
+        mapping = nullptr;
+        file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ,
+            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw std::logic_error("Can't open " + filepath + ".");
+        }
+        LARGE_INTEGER file_size;
+        GetFileSizeEx(file, &file_size);
+        size = static_cast<size_t>(file_size.QuadPart);
+        if (!size) {return;}
+
+        mapping = CreateFileMappingA(
+            file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) {
+            data = static_cast<const char*>(
+                MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        }
+        if (!data) {
+            mappedFileClose(*this);
+            throw std::logic_error("Can't map " + filepath + ".");
+        }
+#else
+        file = open(filepath.c_str(), O_RDONLY);
+        if (file == -1) {
+            throw std::logic_error("Can't open " + filepath + ".");
+        }
+        struct stat file_stat;
+        fstat(file, &file_stat);
+        size = static_cast<size_t>(file_stat.st_size);
+        if (!size) {return;}
+
+        void* address = mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0);
+        if (address == MAP_FAILED) {
+            mappedFileClose(*this);
+            throw std::logic_error("Can't map " + filepath + ".");
+        }
+        data = static_cast<const char*>(address);
+#endif
+    }
+    MappedFile(const MappedFile& other) = delete;
+
+    // Destructor
+    ~MappedFile() {mappedFileClose(*this);}
+
+    // Operators
+    MappedFile& operator = (const MappedFile& rhs) = delete;
+};
+
+/**
+ * @brief Unmaps the file and closes its handles. Safe to call more than once
+ *
+ * @param file The mapped file to close
+ */
+inline void mappedFileClose(MappedFile& file) {
+#ifdef _WIN32
+    if (file.data) {UnmapViewOfFile(file.data);}
+    if (file.mapping) {CloseHandle(file.mapping);}
+    if (file.file != INVALID_HANDLE_VALUE) {CloseHandle(file.file);}
+    file.mapping = nullptr;
+    file.file = INVALID_HANDLE_VALUE;
+#else
+    if (file.data) {munmap(const_cast<char*>(file.data), file.size);}
+    if (file.file != -1) {close(file.file);}
+    file.file = -1;
+#endif
+    file.data = nullptr;
+    file.size = 0;
+}
+
+#endif
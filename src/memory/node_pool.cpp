@@ -0,0 +1,236 @@
+#ifndef NODE_POOL_CPP
+#define NODE_POOL_CPP
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+// Blocks are padded to this so any node type is suitably aligned
+const size_t NODE_POOL_ALIGNMENT = alignof(std::max_align_t);
+const size_t NODE_POOL_SLAB_BYTES = 64 * 1024;
+
+/**
+ * @brief A freed block, reused to link the free list. The first block of
+ * a run of blocks handed between threads also links the next run.
+ */
+struct NodePoolBlock {
+    // Fields
+    NodePoolBlock* next;
+    NodePoolBlock* next_run;
+};
+
+/**
+ * @brief Runs of free blocks of one size that any thread can take. Threads
+ * that free more blocks than they allocate give them back here, and so do
+ * threads that exit, so the threads allocating can reuse them.
+ */
+struct NodePoolShared {
+public:
+    // Fields
+    std::mutex mutex;
+    NodePoolBlock* runs;
+
+    // Constructors
+    NodePoolShared(): runs(nullptr) {}
+    NodePoolShared(const NodePoolShared& other) = delete;
+
+    // Operators
+    NodePoolShared& operator = (const NodePoolShared& rhs) = delete;
+};
+
+/**
+ * @brief Adds a run of free blocks to the shared runs
+ *
+ * @param shared The shared runs
+ * @param run The first block of the run, linked to the rest by next
+ */
+inline void nodePoolSharedPush(NodePoolShared& shared, NodePoolBlock* run) {
+    if (!run) {return;}
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    run->next_run = shared.runs;
+    shared.runs = run;
+}
+
+/**
+ * @brief Takes a run of free blocks from the shared runs
+ *
+ * @param shared The shared runs
+ * @return NodePoolBlock* The first block of the run, or nullptr if there
+ * are none
+ */
+inline NodePoolBlock* nodePoolSharedPop(NodePoolShared& shared) {
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    NodePoolBlock* run = shared.runs;
+    if (run) {shared.runs = run->next_run;}
+    return run;
+}
+
+/**
+ * @brief The head of the list of every slab ever allocated. Slabs are
+ * never freed, since a node can outlive the thread that allocated it,
+ * and keeping them all reachable tells leak checkers they aren't lost.
+ *
+ * @return std::atomic<void*>& The newest slab, which links to the rest
+ */
+inline std::atomic<void*>& nodePoolSlabs() {
+    static std::atomic<void*> slabs(nullptr);
+    return slabs;
+}
+
+/**
+ * @brief Free list of same-sized node blocks, carved out of 64 KB slabs.
+ * Each thread has its own pool per block size, so allocating and freeing
+ * a node is a couple of pointer moves with no locking. Blocks of the same
+ * size are interchangeable, so a node freed on another thread just goes
+ * on that thread's free list.
+ *
+ * To keep a thread that only frees from hoarding blocks that a thread
+ * that only allocates then has to carve new slabs for, a free list longer
+ * than two slabs gives a slab's worth back to the shared runs, and an
+ * empty one takes a run from there before growing. A thread that exits
+ * gives back its whole free list.
+ *
+ * Node types back their class operator new and delete with
+ * nodePoolAllocate and nodePoolDeallocate, so building and tearing down
+ * big structures doesn't pay for a full malloc and free per node. Memory
+ * goes back to the pools, not to the operating system, so they're as big
+ * as the most nodes there have ever been alive at once.
+ */
+struct NodePool {
+public:
+    // Fields
+    size_t block_size;
+    // Blocks per slab, which is also how many move to the shared runs
+    size_t run_size;
+    NodePoolBlock* free_blocks;
+    size_t num_free;
+    NodePoolShared& shared;
+
+    // Constructors
+    NodePool(size_t block_size, NodePoolShared& shared):
+            block_size(block_size), run_size(NODE_POOL_SLAB_BYTES / block_size),
+            free_blocks(nullptr), num_free(0), shared(shared) {
+        if (run_size < 16) {run_size = 16;}
+    }
+    NodePool(const NodePool& other) = delete;
+
+    // Destructor
+    ~NodePool() {nodePoolSharedPush(shared, free_blocks);}
+
+    // Operators
+    NodePool& operator = (const NodePool& rhs) = delete;
+};
+
+/**
+ * @brief Gets the calling thread's pool for blocks of Size bytes
+ *
+ * @tparam Size The size of the node type
+ * @return NodePool& The pool
+ */
+template <size_t Size>
+NodePool& nodePoolGet() {
+    static const size_t BLOCK_SIZE =
+        ((Size < sizeof(NodePoolBlock) ? sizeof(NodePoolBlock) : Size)
+        + NODE_POOL_ALIGNMENT - 1) & ~(NODE_POOL_ALIGNMENT - 1);
+    // Never destroyed, like the slabs, since pools on threads that outlive
+    // static destruction, such as the default thread pool's, still use it
+    static NodePoolShared& shared = *new NodePoolShared;
+    static thread_local NodePool pool(BLOCK_SIZE, shared);
+    return pool;
+}
+
+/**
+ * @brief Refills an empty free list, with a run from the shared runs if
+ * there is one, otherwise by allocating a new slab and threading all its
+ * blocks onto the list
+ *
+ * @param pool The pool to grow
+ */
+inline void nodePoolGrow(NodePool& pool) {
+    NodePoolBlock* run = nodePoolSharedPop(pool.shared);
+    if (run) {
+        pool.free_blocks = run;
+        for (; run; run = run->next) {pool.num_free++;}
+        return;
+    }
+
+    // The first block links the slab into the list of all slabs
+    size_t num_blocks = pool.run_size;
+    char* slab = static_cast<char*>(
+        ::operator new((num_blocks + 1) * pool.block_size));
+
+    std::atomic<void*>& slabs = nodePoolSlabs();
+    void* head = slabs.load();
+    do {
+        *reinterpret_cast<void**>(slab) = head;
+    } while (!slabs.compare_exchange_weak(head, slab));
+
+    for (size_t i = num_blocks; i > 0; i--) {
+        NodePoolBlock* block =
+            reinterpret_cast<NodePoolBlock*>(slab + i * pool.block_size);
+        block->next = pool.free_blocks;
+        pool.free_blocks = block;
+    }
+    pool.num_free += num_blocks;
+}
+
+/**
+ * @brief Gives the newest slab's worth of a long free list to the shared
+ * runs
+ *
+ * @param pool The pool to shrink
+ */
+inline void nodePoolShrink(NodePool& pool) {
+    NodePoolBlock* run = pool.free_blocks;
+    NodePoolBlock* last = run;
+    for (size_t i = 1; i < pool.run_size; i++) {last = last->next;}
+    pool.free_blocks = last->next;
+    last->next = nullptr;
+    pool.num_free -= pool.run_size;
+    nodePoolSharedPush(pool.shared, run);
+}
+
+/**
+ * @brief Allocates memory for a node. Meant to back a node type's class
+ * operator new
+ *
+ * @tparam Size The size of the node type
+ * @param size The requested size. Anything but Size goes to the global
+ * allocator, which covers types derived from the node
+ * @return void* The memory
+ */
+template <size_t Size>
+void* nodePoolAllocate(size_t size) {
+    if (size != Size) {return ::operator new(size);}
+    NodePool& pool = nodePoolGet<Size>();
+    if (!pool.free_blocks) {nodePoolGrow(pool);}
+    NodePoolBlock* block = pool.free_blocks;
+    pool.free_blocks = block->next;
+    pool.num_free--;
+    return block;
+}
+
+/**
+ * @brief Returns a node's memory to the calling thread's pool. Meant to
+ * back a node type's class operator delete
+ *
+ * @tparam Size The size of the node type
+ * @param pointer The memory from nodePoolAllocate
+ * @param size The size that was requested
+ */
+template <size_t Size>
+void nodePoolDeallocate(void* pointer, size_t size) {
+    if (!pointer) {return;}
+    if (size != Size) {
+        ::operator delete(pointer);
+        return;
+    }
+    NodePool& pool = nodePoolGet<Size>();
+    NodePoolBlock* block = static_cast<NodePoolBlock*>(pointer);
+    block->next = pool.free_blocks;
+    pool.free_blocks = block;
+    if (++pool.num_free > 2 * pool.run_size) {nodePoolShrink(pool);}
+}
+
+#endif
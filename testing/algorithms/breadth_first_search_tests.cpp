@@ -0,0 +1,108 @@
+#include "breadth_first_search_tests.hpp"
+#include <algorithms/breadth_first_search.cpp>
+
+const std::string TESTING = "../resources/testing/";
+
+/**
+ * @brief Builds an undirected graph of 8 hubs in a ring that touch most
+ * nodes, with a path of 20 nodes leading in and another leading out.
+ * Searching from the start of the path in, the frontier stays small, blows
+ * up at the hubs, then shrinks again down the path out.
+ */
+CsrGraph<int> breadthFirstSearchTestHubGraph(int num_nodes) {
+    Graph<int> graph;
+    for (int i = 0; i < num_nodes; i++) {graphAddNode(graph, i);}
+
+    DynamicArray<Edge<int>> edges;
+    for (int hub = 0; hub < 8; hub++) {
+        dynamicArrayPushBack(edges, Edge<int>(hub, (hub + 1) % 8));
+    }
+    unsigned int state = 12345;
+    for (int from = 8; from < num_nodes - 40; from++) {
+        state = state * 1103515245 + 12345;
+        int hub = static_cast<int>((state >> 16) % 8);
+        dynamicArrayPushBack(edges, Edge<int>(from, hub));
+    }
+    for (int from = num_nodes - 40; from < num_nodes - 1; from++) {
+        if (from == num_nodes - 21) {continue;}
+        dynamicArrayPushBack(edges, Edge<int>(from, from + 1));
+    }
+    dynamicArrayPushBack(edges, Edge<int>(num_nodes - 21, 0));
+    dynamicArrayPushBack(edges, Edge<int>(7, num_nodes - 20));
+    graphAddReverseEdges(edges);
+    graphAddEdges(graph, edges);
+    return CsrGraph<int>(graph);
+}
+
+bool breadthFirstSearchTestFile() {
+    bool result = true;
+
+    CsrGraph<int> graph(
+        TESTING + "file_path_constructor.txt",
+        GRAPH_DIRECTED);
+    BreadthFirstSearchResult search = breadthFirstSearch(graph, 3);
+    result &= search.distances[3] == 0;
+    result &= search.parents[3] == 3;
+    result &= search.distances[4] == 1;
+    result &= search.distances[5] == 1;
+    result &= search.parents[5] == 3;
+    result &= search.distances[6] == -1;
+    result &= search.parents[6] == -1;
+
+    CsrGraph<int> undirected(
+        TESTING + "file_path_constructor.txt",
+        GRAPH_UNDIRECTED);
+    BreadthFirstSearchResult both_ways = 
+        breadthFirstSearch(undirected, undirected, 9);
+    result &= both_ways.distances[7] == 2;
+    result &= both_ways.distances[3] == -1;
+
+    try {
+        breadthFirstSearch(graph, 10);
+        result &= false;
+    } catch (std::logic_error) {
+        result &= true;
+    } catch (...) {
+        result &= false;
+    }
+
+    return result;
+}
+
+bool breadthFirstSearchTestDirectionOptimizing() {
+    bool result = true;
+
+    CsrGraph<int> graph = breadthFirstSearchTestHubGraph(5000);
+    BreadthFirstSearchResult top_down = 
+        breadthFirstSearch(graph, graph, 4960, 0);
+    BreadthFirstSearchResult optimized = 
+        breadthFirstSearch(graph, graph, 4960);
+    result &= top_down.bottom_up_steps == 0;
+    result &= optimized.bottom_up_steps > 0;
+    result &= optimized.top_down_steps > 0;
+    result &= optimized.distances == top_down.distances;
+
+    for (int node = 0; node < graph.num_nodes; node++) {
+        int parent = optimized.parents[node];
+        if (node == 4960) {
+            result &= parent == node;
+            continue;
+        }
+        result &= parent != -1;
+        result &= optimized.distances[parent] == optimized.distances[node] - 1;
+        result &= csrGraphHasEdge(graph, parent, node);
+    }
+
+    return result;
+}
+
+void breadthFirstSearchTestRegisterTests(TestManager* test_manager) {
+    TestGroup test_group("breadth first search");
+
+    testGroupAddTest(&test_group, UnitTest("file graph",
+        breadthFirstSearchTestFile));
+    testGroupAddTest(&test_group, UnitTest("direction optimizing",
+        breadthFirstSearchTestDirectionOptimizing));
+
+    testManagerAddTestGroup(test_manager, test_group);
+}
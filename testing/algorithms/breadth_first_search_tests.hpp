@@ -0,0 +1,8 @@
+#ifndef BREADTH_FIRST_SEARCH_TESTS_HPP
+#define BREADTH_FIRST_SEARCH_TESTS_HPP
+
+#include "test_utils/test_manager.hpp"
+
+void breadthFirstSearchTestRegisterTests(TestManager* test_manager);
+
+#endif
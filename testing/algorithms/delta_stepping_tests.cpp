@@ -0,0 +1,124 @@
+#include "delta_stepping_tests.hpp"
+#include <algorithms/delta_stepping.cpp>
+#include <io/graph_generator.cpp>
+
+const std::string TESTING = "../resources/testing/";
+
+/**
+ * @brief Checks that every parent is on a shortest path
+ */
+bool deltaSteppingTestParents(
+        const CsrGraph<int>& graph,
+        const ShortestPathResult& search) {
+    bool result = true;
+    for (int node = 0; node < graph.num_nodes; node++) {
+        int parent = search.parents[node];
+        if (parent == -1 || parent == node) {continue;}
+        bool tight = false;
+        CsrNeighbors<double> neighbors = csrGraphGetNeighbors(graph, parent);
+        for (size_t i = 0; i < neighbors.length; i++) {
+            tight |= neighbors.targets[i] == node
+                && search.distances[parent] + neighbors.weights[i]
+                    == search.distances[node];
+        }
+        result &= tight;
+    }
+    return result;
+}
+
+bool deltaSteppingTestChooseDelta() {
+    bool result = true;
+
+    CsrGraph<int> graph(TESTING + "dijkstra/weighted.txt", GRAPH_DIRECTED);
+    // Largest weight 5, average degree 7 / 6
+    result &= std::abs(deltaSteppingChooseDelta(graph) - 5 / (7.0 / 6))
+        < 0.001;
+
+    CsrGraph<int> unweighted(
+        TESTING + "file_path_constructor.txt",
+        GRAPH_DIRECTED);
+    for (size_t i = 0; i < unweighted.num_edges; i++) {
+        unweighted.weights[i] = 0;
+    }
+    result &= deltaSteppingChooseDelta(unweighted) == 1;
+
+    return result;
+}
+
+bool deltaSteppingTestFile() {
+    bool result = true;
+
+    CsrGraph<int> graph(TESTING + "dijkstra/weighted.txt", GRAPH_DIRECTED);
+    ShortestPathResult expected = dijkstra(graph, 0);
+    double deltas[3] = {0, 0.5, 100};
+    for (int i = 0; i < 3; i++) {
+        for (int threads = 1; threads <= 3; threads++) {
+            ShortestPathResult search = 
+                deltaStepping(graph, 0, deltas[i], threads);
+            result &= search.distances == expected.distances;
+            result &= search.parents == expected.parents;
+        }
+    }
+
+    CsrGraph<int, void> unweighted(
+        TESTING + "dijkstra/weighted.txt",
+        GRAPH_DIRECTED);
+    result &= deltaStepping(unweighted, 0).distances
+        == dijkstra(unweighted, 0).distances;
+
+    CsrGraph<int> negative(graph);
+    negative.weights[0] = -1;
+    const double invalid_deltas[2] = {0, -1};
+    CsrGraph<int>* invalid_graphs[2] = {&negative, &graph};
+    for (int i = 0; i < 2; i++) {
+        try {
+            deltaStepping(*invalid_graphs[i], 0, invalid_deltas[i]);
+            result &= false;
+        } catch (std::logic_error) {
+            result &= true;
+        } catch (...) {
+            result &= false;
+        }
+    }
+
+    return result;
+}
+
+bool deltaSteppingTestMatchesDijkstra() {
+    bool result = true;
+
+    // Whole number weights, so both algorithms add up exactly the same
+    // distances
+    CsrGraph<int> graph = graphGeneratorGenerateCsr(
+        graphGeneratorUniform(20000, 100000, 7, 100));
+    ShortestPathResult expected = dijkstra<RadixHeap>(graph, 0);
+    const double deltas[3] = {0, 1, 1000};
+    for (int i = 0; i < 3; i++) {
+        ShortestPathResult search = deltaStepping(graph, 0, deltas[i], 4);
+        result &= search.distances == expected.distances;
+        result &= deltaSteppingTestParents(graph, search);
+    }
+
+    // Weights far bigger than delta push most nodes into the overflow
+    CsrGraph<int> wide = graphGeneratorGenerateCsr(
+        graphGeneratorUniform(5000, 20000, 7, 1000000));
+    ShortestPathResult wide_expected = dijkstra(wide, 3);
+    ShortestPathResult wide_search = deltaStepping(wide, 3, 1, 3);
+    result &= wide_search.distances == wide_expected.distances;
+    result &= deltaSteppingTestParents(wide, wide_search);
+
+    return result;
+}
+
+void deltaSteppingTestRegisterTests(TestManager* test_manager) {
+    TestGroup test_group("delta stepping");
+
+    testGroupAddTest(&test_group, UnitTest("choose delta",
+        deltaSteppingTestChooseDelta));
+    testGroupAddTest(&test_group, UnitTest("file graph",
+        deltaSteppingTestFile));
+    testGroupAddTest(&test_group, UnitTest("matches dijkstra",
+        deltaSteppingTestMatchesDijkstra));
+
+    testManagerAddTestGroup(test_manager, test_group);
+}
@@ -0,0 +1,8 @@
+#ifndef DELTA_STEPPING_TESTS_HPP
+#define DELTA_STEPPING_TESTS_HPP
+
+#include "test_utils/test_manager.hpp"
+
+void deltaSteppingTestRegisterTests(TestManager* test_manager);
+
+#endif
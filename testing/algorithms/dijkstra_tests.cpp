@@ -0,0 +1,153 @@
+#include "dijkstra_tests.hpp"
+#include <cmath>
+#include <algorithms/breadth_first_search.cpp>
+#include <algorithms/dijkstra.cpp>
+#include <io/graph_generator.cpp>
+
+const std::string TESTING = "../resources/testing/";
+
+bool dijkstraTestFile() {
+    bool result = true;
+
+    CsrGraph<int> graph(TESTING + "dijkstra/weighted.txt", GRAPH_DIRECTED);
+    ShortestPathResult search = dijkstra(graph, 0);
+    double expected[6] = {0, 3, 1, 4, 7, INFINITY};
+    for (int i = 0; i < 6; i++) {result &= search.distances[i] == expected[i];}
+    result &= search.parents[1] == 2;
+    result &= search.parents[5] == -1;
+
+    DynamicArray<int> path = shortestPathGetPath(search, 4);
+    result &= path.size == 5;
+    int expected_path[5] = {0, 2, 1, 3, 4};
+    for (int i = 0; i < 5; i++) {result &= path[i] == expected_path[i];}
+    result &= shortestPathGetPath(search, 5).size == 0;
+    result &= shortestPathGetPath(search, 0).size == 1;
+
+    // Every edge of an unweighted graph weighs 1
+    CsrGraph<int, void> unweighted(
+        TESTING + "dijkstra/weighted.txt",
+        GRAPH_DIRECTED);
+    ShortestPathResult hops = dijkstra(unweighted, 0);
+    double expected_hops[6] = {0, 1, 1, 2, 3, INFINITY};
+    for (int i = 0; i < 6; i++) {
+        result &= hops.distances[i] == expected_hops[i];
+    }
+    result &= breadthFirstSearch(unweighted, 0).distances[4] == 3;
+
+    try {
+        dijkstra(graph, 6);
+        result &= false;
+    } catch (std::logic_error) {
+        result &= true;
+    } catch (...) {
+        result &= false;
+    }
+
+    return result;
+}
+
+bool dijkstraTestEarlyExit() {
+    bool result = true;
+
+    CsrGraph<int> graph(TESTING + "dijkstra/weighted.txt", GRAPH_DIRECTED);
+    ShortestPathResult search = dijkstra<PairingHeap>(graph, 0, 1);
+    result &= search.distances[1] == 3;
+    result &= search.distances[4] == INFINITY;
+    result &= shortestPathGetPath(search, 1).size == 3;
+
+    return result;
+}
+
+bool dijkstraTestQueues() {
+    bool result = true;
+
+    // Whole number weights, so every queue adds up exactly the same
+    // distances
+    CsrGraph<int> graph = graphGeneratorGenerateCsr(
+        graphGeneratorUniform(2000, 10000, 2024, 20));
+    ShortestPathResult binary = dijkstra<BinaryHeap>(graph, 0);
+    ShortestPathResult quaternary = dijkstra<QuaternaryHeap>(graph, 0);
+    ShortestPathResult pairing = dijkstra<PairingHeap>(graph, 0);
+    ShortestPathResult radix = dijkstra<RadixHeap>(graph, 0);
+    result &= binary.distances == quaternary.distances;
+    result &= binary.distances == pairing.distances;
+    result &= binary.distances == radix.distances;
+
+    // Every parent has to be on a shortest path
+    for (int node = 1; node < graph.num_nodes; node++) {
+        int parent = radix.parents[node];
+        if (parent == -1) {continue;}
+        bool tight = false;
+        CsrNeighbors<double> neighbors = csrGraphGetNeighbors(graph, parent);
+        for (size_t i = 0; i < neighbors.length; i++) {
+            tight |= neighbors.targets[i] == node
+                && radix.distances[parent] + neighbors.weights[i]
+                    == radix.distances[node];
+        }
+        result &= tight;
+    }
+
+    // With unit weights, distances are the breadth-first search depths
+    for (size_t i = 0; i < graph.num_edges; i++) {graph.weights[i] = 1;}
+    ShortestPathResult unit = dijkstra<QuaternaryHeap>(graph, 0);
+    BreadthFirstSearchResult depths = breadthFirstSearch(graph, 0);
+    for (int node = 0; node < graph.num_nodes; node++) {
+        result &= depths.distances[node] == -1
+            ? std::isinf(unit.distances[node])
+            : unit.distances[node] == depths.distances[node];
+    }
+
+    return result;
+}
+
+bool dijkstraTestGetPath() {
+    bool result = true;
+
+    Graph<char> graph;
+    graphAddNode(graph, 'a');
+    graphAddNode(graph, 'b');
+    graphAddNode(graph, 'c');
+    graphAddEdge(graph, Edge<char>('a', 'b', 5));
+    graphAddEdge(graph, Edge<char>('a', 'c', 1));
+    graphAddEdge(graph, Edge<char>('c', 'b', 1));
+
+    double distance = 0;
+    LinkedList<char>* path = dijkstraGetPath(graph, 'a', 'b', &distance);
+    LinkedList<char>* expected = nullptr;
+    linkedListInsertAtTail(&expected, 'a');
+    linkedListInsertAtTail(&expected, 'c');
+    linkedListInsertAtTail(&expected, 'b');
+    result &= *path == *expected;
+    result &= distance == 2;
+    delete path;
+    delete expected;
+
+    result &= !dijkstraGetPath<RadixHeap>(graph, 'b', 'a', &distance);
+    result &= std::isinf(distance);
+
+    Graph<char> negative;
+    graphAddNode(negative, 'a');
+    graphAddNode(negative, 'b');
+    graphAddEdge(negative, Edge<char>('a', 'b', -1));
+    try {
+        dijkstraGetPath(negative, 'a', 'b');
+        result &= false;
+    } catch (std::logic_error) {
+        result &= true;
+    } catch (...) {
+        result &= false;
+    }
+
+    return result;
+}
+
+void dijkstraTestRegisterTests(TestManager* test_manager) {
+    TestGroup test_group("dijkstra");
+
+    testGroupAddTest(&test_group, UnitTest("file graph", dijkstraTestFile));
+    testGroupAddTest(&test_group, UnitTest("early exit", dijkstraTestEarlyExit));
+    testGroupAddTest(&test_group, UnitTest("queues", dijkstraTestQueues));
+    testGroupAddTest(&test_group, UnitTest("get path", dijkstraTestGetPath));
+
+    testManagerAddTestGroup(test_manager, test_group);
+}
@@ -0,0 +1,8 @@
+#ifndef DIJKSTRA_TESTS_HPP
+#define DIJKSTRA_TESTS_HPP
+
+#include "test_utils/test_manager.hpp"
+
+void dijkstraTestRegisterTests(TestManager* test_manager);
+
+#endif
@@ -0,0 +1,230 @@
+#include "concurrent_hash_map_tests.hpp"
+#include <string>
+#include <thread>
+#include <concurrency/concurrent_hash_map.cpp>
+#include <data_structures/dynamic_array.cpp>
+
+bool concurrentHashMapTestConstructor() {
+    bool result = true;
+
+    ConcurrentHashMap<int, int> automatic;
+    result &= automatic.num_shards == CONCURRENT_HASH_MAP_DEFAULT_SHARDS;
+    result &= automatic.size.load() == 0;
+
+    ConcurrentHashMap<int, int> rounded(5);
+    result &= rounded.num_shards == 8;
+
+    // A single shard still works, it just never runs in parallel
+    ConcurrentHashMap<int, int> single(1);
+    result &= single.num_shards == 1;
+    concurrentHashMapInsert(single, 3, 9);
+    int value = 0;
+    result &= concurrentHashMapGet(single, 3, &value) && value == 9;
+
+    return result;
+}
+
+bool concurrentHashMapTestInsertGetDelete() {
+    bool result = true;
+
+    ConcurrentHashMap<std::string, int> map;
+    int value = -1;
+    result &= !concurrentHashMapGet(map, std::string("a"), &value);
+    result &= value == -1;
+    concurrentHashMapInsert(map, std::string("a"), 1);
+    concurrentHashMapInsert(map, std::string("a"), 2);
+    result &= concurrentHashMapGet(map, std::string("a"), &value);
+    result &= value == 2;
+    result &= map.size.load() == 1;
+
+    // Only the first insert of a key wins
+    result &= !concurrentHashMapInsertIfAbsent(
+        map, std::string("a"), 3, &value);
+    result &= value == 2;
+    result &= concurrentHashMapInsertIfAbsent(
+        map, std::string("b"), 4, &value);
+    result &= value == 4;
+    result &= concurrentHashMapHas(map, std::string("b"));
+    result &= map.size.load() == 2;
+
+    concurrentHashMapDelete(map, std::string("a"));
+    concurrentHashMapDelete(map, std::string("c"));
+    result &= !concurrentHashMapHas(map, std::string("a"));
+    result &= map.size.load() == 1;
+
+    int count = 0;
+    concurrentHashMapForEach(map, [&](const std::string& key, int& value) {
+        count++;
+        result &= key == "b" && value == 4;
+    });
+    result &= count == 1;
+
+    return result;
+}
+
+bool concurrentHashMapTestThreads() {
+    bool result = true;
+
+    // Threads insert overlapping ranges, so every key is raced for
+    const int NUM_THREADS = 4;
+    const int COUNT = 20000;
+    ConcurrentHashMap<int, int> map;
+    DynamicArray<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; t++) {
+        dynamicArrayEmplaceBack(threads, [&map, t]() {
+            for (int i = 0; i < COUNT; i++) {
+                int key = (i + t * COUNT / NUM_THREADS) % COUNT;
+                concurrentHashMapInsertIfAbsent(map, key, key * 3);
+            }
+        });
+    }
+    for (size_t t = 0; t < threads.size; t++) {threads[t].join();}
+    result &= map.size.load() == COUNT;
+    for (int i = 0; i < COUNT; i++) {
+        int value = 0;
+        result &= concurrentHashMapGet(map, i, &value) && value == i * 3;
+    }
+
+    return result;
+}
+
+bool concurrentHashMapTestGetOrAssignId() {
+    bool result = true;
+
+    ConcurrentHashMap<int, int> map;
+    result &= concurrentHashMapGetOrAssignId(map, 50) == 0;
+    result &= concurrentHashMapGetOrAssignId(map, 7) == 1;
+    result &= concurrentHashMapGetOrAssignId(map, 50) == 0;
+
+    // Racing threads still hand out every id exactly once
+    const int NUM_THREADS = 4;
+    const int COUNT = 10000;
+    ConcurrentHashMap<int, int> raced;
+    DynamicArray<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; t++) {
+        dynamicArrayEmplaceBack(threads, [&raced, t]() {
+            for (int i = 0; i < COUNT; i++) {
+                concurrentHashMapGetOrAssignId(raced, (i * (t + 1)) % COUNT);
+            }
+        });
+    }
+    for (size_t t = 0; t < threads.size; t++) {threads[t].join();}
+    result &= raced.size.load() == COUNT;
+    DynamicArray<int> seen;
+    dynamicArrayResize(seen, COUNT);
+    concurrentHashMapForEach(raced, [&](const int& key, int& id) {
+        result &= id >= 0 && id < COUNT;
+        if (id >= 0 && id < COUNT) {seen[id]++;}
+    });
+    for (int i = 0; i < COUNT; i++) {result &= seen[i] == 1;}
+
+    ConcurrentHashMap<int, signed char> small;
+    try {
+        for (int i = 0; i < 200; i++) {
+            concurrentHashMapGetOrAssignId(small, i);
+        }
+        result &= false;
+    } catch (std::logic_error) {
+        result &= true;
+    } catch (...) {
+        result &= false;
+    }
+
+    return result;
+}
+
+bool concurrentHashMapTestAssignIds() {
+    bool result = true;
+
+    // Lots of repeats spread over many blocks, so first appearances race
+    const size_t COUNT = 10 * CONCURRENT_HASH_MAP_ID_BLOCK + 123;
+    DynamicArray<int> keys(COUNT);
+    unsigned int state = 1;
+    for (size_t i = 0; i < COUNT; i++) {
+        state = state * 1103515245 + 12345;
+        dynamicArrayPushBack(keys, static_cast<int>((state >> 8) % 20000));
+    }
+
+    // Matches numbering the keys one at a time, including keys that had
+    // ids before the batch
+    ThreadPool pool(4);
+    ConcurrentHashMap<int, int> map;
+    ConcurrentHashMap<int, int> expected;
+    for (int i = 0; i < 100; i++) {
+        concurrentHashMapGetOrAssignId(map, keys[i * 37]);
+        concurrentHashMapGetOrAssignId(expected, keys[i * 37]);
+    }
+    DynamicArray<int> ids;
+    concurrentHashMapAssignIds(map, COUNT,
+        [&](size_t i) -> const int& {return keys[i];}, ids, pool);
+    result &= ids.size == COUNT;
+    for (size_t i = 0; i < COUNT; i++) {
+        result &= ids[i] == concurrentHashMapGetOrAssignId(expected, keys[i]);
+    }
+    result &= map.size.load() == expected.size.load();
+    for (size_t i = 0; i < COUNT; i++) {
+        int id = -1;
+        result &= concurrentHashMapGet(map, keys[i], &id) && id == ids[i];
+    }
+
+    // A second batch only numbers the keys that are new
+    DynamicArray<int> more;
+    concurrentHashMapAssignIds(map, COUNT,
+        [&](size_t i) -> int {return keys[i] + 10000;}, more, pool);
+    for (size_t i = 0; i < COUNT; i++) {
+        result &= more[i]
+            == concurrentHashMapGetOrAssignId(expected, keys[i] + 10000);
+    }
+    result &= map.size.load() == expected.size.load();
+
+    DynamicArray<int> empty;
+    concurrentHashMapAssignIds(map, 0,
+        [&](size_t i) -> const int& {return keys[i];}, empty, pool);
+    result &= empty.size == 0;
+
+    // Batches too big for the id type, or for the int ranges the passes
+    // run over, throw before touching the keys
+    const size_t too_many[2] = {
+        static_cast<size_t>(std::numeric_limits<int>::max()) + 1,
+        (static_cast<size_t>(std::numeric_limits<int>::max()) + 1)
+            * CONCURRENT_HASH_MAP_ID_BLOCK
+    };
+    ConcurrentHashMap<int, long long> wide;
+    for (int i = 0; i < 2; i++) {
+        try {
+            if (i == 0) {
+                concurrentHashMapAssignIds(map, too_many[i],
+                    [&](size_t) -> int {return 0;}, empty, pool);
+            } else {
+                DynamicArray<long long> wide_ids;
+                concurrentHashMapAssignIds(wide, too_many[i],
+                    [&](size_t) -> int {return 0;}, wide_ids, pool);
+            }
+            result &= false;
+        } catch (std::logic_error) {
+            result &= true;
+        } catch (...) {
+            result &= false;
+        }
+    }
+    result &= empty.size == 0 && wide.size.load() == 0;
+
+    return result;
+}
+
+void concurrentHashMapTestRegisterTests(TestManager* test_manager) {
+    TestGroup test_group("concurrent hash map");
+
+    testGroupAddTest(&test_group, UnitTest("constructor",
+        concurrentHashMapTestConstructor));
+    testGroupAddTest(&test_group, UnitTest("insert, get and delete",
+        concurrentHashMapTestInsertGetDelete));
+    testGroupAddTest(&test_group, UnitTest("threads",
+        concurrentHashMapTestThreads));
+    testGroupAddTest(&test_group, UnitTest("get or assign id",
+        concurrentHashMapTestGetOrAssignId));
+    testGroupAddTest(&test_group, UnitTest("assign ids",
+        concurrentHashMapTestAssignIds));
+
+    testManagerAddTestGroup(test_manager, test_group);
+}
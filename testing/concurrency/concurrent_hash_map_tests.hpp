@@ -0,0 +1,8 @@
+#ifndef CONCURRENT_HASH_MAP_TESTS_HPP
+#define CONCURRENT_HASH_MAP_TESTS_HPP
+
+#include "test_utils/test_manager.hpp"
+
+void concurrentHashMapTestRegisterTests(TestManager* test_manager);
+
+#endif
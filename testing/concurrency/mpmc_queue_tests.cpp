@@ -0,0 +1,204 @@
+#include "mpmc_queue_tests.hpp"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <concurrency/mpmc_queue.cpp>
+#include <data_structures/dynamic_array.cpp>
+
+bool mpmcQueueTestConstructor() {
+    bool result = true;
+
+    MpmcQueue<int> exact(8);
+    result &= mpmcQueueGetCapacity(exact) == 8;
+
+    MpmcQueue<int> rounded(5);
+    result &= mpmcQueueGetCapacity(rounded) == 8;
+
+    try {
+        MpmcQueue<int> empty(0);
+        result &= false;
+    } catch (std::logic_error) {
+        result &= true;
+    } catch (...) {
+        result &= false;
+    }
+
+    return result;
+}
+
+bool mpmcQueueTestTryPush() {
+    bool result = true;
+
+    MpmcQueue<int> queue(4);
+    for (int i = 0; i < 4; i++) {result &= mpmcQueueTryPush(queue, i);}
+    result &= !mpmcQueueTryPush(queue, 4);
+
+    // Popping frees a cell for the next lap around the ring
+    int popped;
+    result &= mpmcQueueTryPop(queue, popped) && popped == 0;
+    result &= mpmcQueueTryPush(queue, 4);
+    result &= !mpmcQueueTryPush(queue, 5);
+
+    // Move-only types are moved in
+    MpmcQueue<std::unique_ptr<int>> pointers(2);
+    result &= mpmcQueueTryPush(pointers, std::unique_ptr<int>(new int(3)));
+    std::unique_ptr<int> pointer;
+    result &= mpmcQueueTryPop(pointers, pointer) && *pointer == 3;
+
+    return result;
+}
+
+bool mpmcQueueTestTryPop() {
+    bool result = true;
+
+    MpmcQueue<int> queue(4);
+    int popped = -1;
+    result &= !mpmcQueueTryPop(queue, popped);
+    result &= popped == -1;
+
+    // Wrap around the ring a few times, keeping the order
+    int next = 0;
+    for (int i = 0; i < 10; i++) {
+        result &= mpmcQueueTryPush(queue, i);
+        result &= mpmcQueueTryPush(queue, i + 100);
+        result &= mpmcQueueTryPop(queue, popped) && popped == next;
+        next = i + 100;
+        result &= mpmcQueueTryPop(queue, popped) && popped == next;
+        next = i + 1;
+    }
+    result &= !mpmcQueueTryPop(queue, popped);
+
+    return result;
+}
+
+bool mpmcQueueTestTryPushN() {
+    bool result = true;
+
+    const int data[6] = {0, 1, 2, 3, 4, 5};
+    MpmcQueue<int> queue(4);
+    result &= mpmcQueueTryPushN(queue, data, 0) == 0;
+
+    // Only as many as fit are pushed
+    result &= mpmcQueueTryPushN(queue, data, 3) == 3;
+    result &= mpmcQueueTryPushN(queue, data + 3, 3) == 1;
+    result &= mpmcQueueTryPushN(queue, data + 4, 2) == 0;
+
+    // The next batch wraps around the end of the ring
+    int popped[6];
+    result &= mpmcQueueTryPopN(queue, popped, 2) == 2;
+    result &= mpmcQueueTryPushN(queue, data + 4, 2) == 2;
+    for (int i = 2; i < 6; i++) {
+        int element;
+        result &= mpmcQueueTryPop(queue, element) && element == i;
+    }
+
+    return result;
+}
+
+bool mpmcQueueTestTryPopN() {
+    bool result = true;
+
+    const int data[5] = {3, 1, 4, 1, 5};
+    MpmcQueue<int> queue(8);
+    int popped[5];
+    result &= mpmcQueueTryPopN(queue, popped, 5) == 0;
+
+    mpmcQueueTryPushN(queue, data, 5);
+    result &= mpmcQueueTryPopN(queue, popped, 2) == 2;
+    result &= popped[0] == 3 && popped[1] == 1;
+
+    // Asking for more than are left pops the rest
+    result &= mpmcQueueTryPopN(queue, popped, 5) == 3;
+    result &= popped[0] == 4 && popped[1] == 1 && popped[2] == 5;
+    result &= mpmcQueueTryPopN(queue, popped, 5) == 0;
+
+    return result;
+}
+
+/**
+ * @brief Pushes the values from first up to last, alternating single and
+ * batched pushes and spinning while the queue is full
+ */
+void mpmcQueueTestProducer(MpmcQueue<int>* queue, int first, int last) {
+    const int BATCH = 5;
+    int batch[BATCH];
+    int next = first;
+    while (next < last) {
+        if (next & 1) {
+            if (mpmcQueueTryPush(*queue, next)) {next++;}
+        } else {
+            int count = last - next < BATCH ? last - next : BATCH;
+            for (int i = 0; i < count; i++) {batch[i] = next + i;}
+            next += static_cast<int>(mpmcQueueTryPushN(*queue, batch, count));
+        }
+        std::this_thread::yield();
+    }
+}
+
+/**
+ * @brief Pops until every value has been seen, marking each one
+ */
+void mpmcQueueTestConsumer(
+        MpmcQueue<int>* queue,
+        std::atomic<int>* remaining,
+        std::atomic<int>* seen) {
+    const int BATCH = 3;
+    int batch[BATCH];
+    while (remaining->load() > 0) {
+        int count = static_cast<int>(mpmcQueueTryPopN(*queue, batch, BATCH));
+        for (int i = 0; i < count; i++) {seen[batch[i]].fetch_add(1);}
+        remaining->fetch_sub(count);
+        if (!count) {std::this_thread::yield();}
+    }
+}
+
+bool mpmcQueueTestThreads() {
+    bool result = true;
+
+    // A small ring keeps the producers running into a full queue
+    const int NUM_PRODUCERS = 4;
+    const int NUM_CONSUMERS = 4;
+    const int PER_PRODUCER = 5000;
+    const int TOTAL = NUM_PRODUCERS * PER_PRODUCER;
+    MpmcQueue<int> queue(16);
+    std::atomic<int> remaining(TOTAL);
+    std::unique_ptr<std::atomic<int>[]> seen(new std::atomic<int>[TOTAL]);
+    for (int i = 0; i < TOTAL; i++) {seen[i].store(0);}
+
+    DynamicArray<std::thread> threads;
+    for (int i = 0; i < NUM_PRODUCERS; i++) {
+        dynamicArrayEmplaceBack(threads, mpmcQueueTestProducer,
+            &queue, i * PER_PRODUCER, (i + 1) * PER_PRODUCER);
+    }
+    for (int i = 0; i < NUM_CONSUMERS; i++) {
+        dynamicArrayEmplaceBack(threads, mpmcQueueTestConsumer,
+            &queue, &remaining, seen.get());
+    }
+    for (int i = 0; i < NUM_PRODUCERS + NUM_CONSUMERS; i++) {
+        threads[i].join();
+    }
+
+    // Every value came out exactly once
+    result &= remaining.load() == 0;
+    for (int i = 0; i < TOTAL; i++) {result &= seen[i].load() == 1;}
+    int popped;
+    result &= !mpmcQueueTryPop(queue, popped);
+
+    return result;
+}
+
+void mpmcQueueTestRegisterTests(TestManager* test_manager) {
+    TestGroup test_group("mpmc queue");
+
+    testGroupAddTest(&test_group, UnitTest("constructor",
+        mpmcQueueTestConstructor));
+    testGroupAddTest(&test_group, UnitTest("try push", mpmcQueueTestTryPush));
+    testGroupAddTest(&test_group, UnitTest("try pop", mpmcQueueTestTryPop));
+    testGroupAddTest(&test_group, UnitTest("try push n",
+        mpmcQueueTestTryPushN));
+    testGroupAddTest(&test_group, UnitTest("try pop n",
+        mpmcQueueTestTryPopN));
+    testGroupAddTest(&test_group, UnitTest("threads", mpmcQueueTestThreads));
+
+    testManagerAddTestGroup(test_manager, test_group);
+}
@@ -0,0 +1,8 @@
+#ifndef MPMC_QUEUE_TESTS_HPP
+#define MPMC_QUEUE_TESTS_HPP
+
+#include "test_utils/test_manager.hpp"
+
+void mpmcQueueTestRegisterTests(TestManager* test_manager);
+
+#endif
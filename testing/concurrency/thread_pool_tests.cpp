@@ -0,0 +1,198 @@
+#include "thread_pool_tests.hpp"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <concurrency/thread_pool.cpp>
+
+bool threadPoolTestConstructor() {
+    bool result = true;
+
+    ThreadPool pool(3);
+    result &= threadPoolGetNumWorkers(pool) == 3;
+    result &= pool.threads.size == 3;
+    result &= threadPoolGetWorker(pool) == -1;
+
+    ThreadPool automatic;
+    int hardware = static_cast<int>(std::thread::hardware_concurrency());
+    result &= threadPoolGetNumWorkers(automatic)
+        == (hardware > 0 ? hardware : 1);
+
+    return result;
+}
+
+bool threadPoolTestRun() {
+    bool result = true;
+
+    ThreadPool pool(2);
+    int ran_on = -1;
+    threadPoolRun(pool, [&](int worker) {
+        ran_on = worker;
+        // Runs inline when already inside the pool
+        threadPoolRun(pool, [&](int inner) {result &= inner == worker;});
+    });
+    result &= ran_on == 0 || ran_on == 1;
+
+    try {
+        threadPoolRun(pool, [](int) {throw std::logic_error("Failed.");});
+        result &= false;
+    } catch (std::logic_error) {
+        result &= true;
+    } catch (...) {
+        result &= false;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Fibonacci by forking both halves, to exercise deep fork/join
+ */
+int threadPoolTestFibonacci(ThreadPool& pool, int n) {
+    if (n < 2) {return n;}
+    int first = 0;
+    ThreadPoolGroup group;
+    threadPoolSpawn(pool, group, [&](int) {
+        first = threadPoolTestFibonacci(pool, n - 1);
+    });
+    int second = threadPoolTestFibonacci(pool, n - 2);
+    threadPoolJoin(pool, group);
+    return first + second;
+}
+
+bool threadPoolTestSpawnJoin() {
+    bool result = true;
+
+    ThreadPool pool(4);
+    int fibonacci = 0;
+    threadPoolRun(pool, [&](int) {
+        fibonacci = threadPoolTestFibonacci(pool, 20);
+    });
+    result &= fibonacci == 6765;
+
+    // Joining rethrows a forked task's exception once every task is done
+    std::atomic<int> finished(0);
+    threadPoolRun(pool, [&](int) {
+        ThreadPoolGroup group;
+        for (int i = 0; i < 10; i++) {
+            threadPoolSpawn(pool, group, [&, i](int) {
+                finished.fetch_add(1);
+                if (i == 5) {throw std::logic_error("Failed.");}
+            });
+        }
+        try {
+            threadPoolJoin(pool, group);
+            result &= false;
+        } catch (std::logic_error) {
+            result &= true;
+        } catch (...) {
+            result &= false;
+        }
+        result &= finished.load() == 10;
+    });
+
+    ThreadPoolGroup outside;
+    try {
+        threadPoolSpawn(pool, outside, [](int) {});
+        result &= false;
+    } catch (std::logic_error) {
+        result &= true;
+    } catch (...) {
+        result &= false;
+    }
+
+    return result;
+}
+
+bool threadPoolTestParallelFor() {
+    bool result = true;
+
+    ThreadPool pool(4);
+    const int SIZE = 100000;
+    std::unique_ptr<std::atomic<int>[]> seen(new std::atomic<int>[SIZE]);
+    const int grains[3] = {0, 1, 5000};
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < SIZE; j++) {seen[j].store(0);}
+        threadPoolParallelFor(pool, 0, SIZE, [&](int begin, int end, int) {
+            for (int j = begin; j < end; j++) {seen[j].fetch_add(1);}
+        }, grains[i]);
+        for (int j = 0; j < SIZE; j++) {result &= seen[j].load() == 1;}
+    }
+
+    // Empty ranges do nothing, and ranges needn't start at 0
+    bool called = false;
+    threadPoolParallelFor(pool, 5, 5, [&](int, int, int) {called = true;});
+    result &= !called;
+    std::atomic<int> sum(0);
+    threadPoolParallelFor(pool, -10, 11, [&](int begin, int end, int) {
+        for (int j = begin; j < end; j++) {sum.fetch_add(j);}
+    });
+    result &= sum.load() == 0;
+
+    // Loops nest, with the inner ones run by whichever worker got there
+    std::atomic<int> cells(0);
+    threadPoolParallelFor(pool, 0, 20, [&](int begin, int end, int) {
+        for (int j = begin; j < end; j++) {
+            threadPoolParallelFor(pool, 0, 30, [&](int first, int last, int) {
+                cells.fetch_add(last - first);
+            });
+        }
+    });
+    result &= cells.load() == 600;
+
+    try {
+        threadPoolParallelFor(pool, 0, SIZE, [](int begin, int end, int) {
+            if (begin <= 1234 && 1234 < end) {
+                throw std::logic_error("Failed.");
+            }
+        });
+        result &= false;
+    } catch (std::logic_error) {
+        result &= true;
+    } catch (...) {
+        result &= false;
+    }
+
+    try {
+        threadPoolParallelFor(pool, 0, SIZE, [](int, int, int) {}, -1);
+        result &= false;
+    } catch (std::logic_error) {
+        result &= true;
+    } catch (...) {
+        result &= false;
+    }
+
+    return result;
+}
+
+bool threadPoolTestScratch() {
+    bool result = true;
+
+    // Each worker sums into its own slot, and the slots add up after
+    ThreadPool pool(3);
+    ThreadPoolScratch<long long> sums(pool);
+    result &= sums.slots.size == 3;
+    threadPoolParallelFor(pool, 1, 100001, [&](int begin, int end, int worker) {
+        long long& sum = threadPoolScratchGet(sums, worker);
+        for (int i = begin; i < end; i++) {sum += i;}
+    });
+    long long total = 0;
+    for (int i = 0; i < 3; i++) {total += threadPoolScratchGet(sums, i);}
+    result &= total == 5000050000LL;
+
+    return result;
+}
+
+void threadPoolTestRegisterTests(TestManager* test_manager) {
+    TestGroup test_group("thread pool");
+
+    testGroupAddTest(&test_group, UnitTest("constructor",
+        threadPoolTestConstructor));
+    testGroupAddTest(&test_group, UnitTest("run", threadPoolTestRun));
+    testGroupAddTest(&test_group, UnitTest("spawn and join",
+        threadPoolTestSpawnJoin));
+    testGroupAddTest(&test_group, UnitTest("parallel for",
+        threadPoolTestParallelFor));
+    testGroupAddTest(&test_group, UnitTest("scratch", threadPoolTestScratch));
+
+    testManagerAddTestGroup(test_manager, test_group);
+}
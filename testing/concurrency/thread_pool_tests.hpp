@@ -0,0 +1,8 @@
+#ifndef THREAD_POOL_TESTS_HPP
+#define THREAD_POOL_TESTS_HPP
+
+#include "test_utils/test_manager.hpp"
+
+void threadPoolTestRegisterTests(TestManager* test_manager);
+
+#endif
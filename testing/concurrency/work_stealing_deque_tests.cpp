@@ -0,0 +1,112 @@
+#include "work_stealing_deque_tests.hpp"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <concurrency/work_stealing_deque.cpp>
+#include <data_structures/dynamic_array.cpp>
+
+bool workStealingDequeTestPushPop() {
+    bool result = true;
+
+    WorkStealingDeque<int> deque;
+    int popped = -1;
+    result &= !workStealingDequePop(deque, popped);
+    result &= popped == -1;
+
+    // The owner pops newest first, across a few buffer doublings
+    const int COUNT = 1000;
+    for (int i = 0; i < COUNT; i++) {workStealingDequePush(deque, i);}
+    result &= workStealingDequeSize(deque) == COUNT;
+    result &= deque.retired.size > 0;
+    for (int i = COUNT - 1; i >= 0; i--) {
+        result &= workStealingDequePop(deque, popped) && popped == i;
+    }
+    result &= !workStealingDequePop(deque, popped);
+    result &= workStealingDequeSize(deque) == 0;
+
+    return result;
+}
+
+bool workStealingDequeTestSteal() {
+    bool result = true;
+
+    WorkStealingDeque<int> deque;
+    int stolen = -1;
+    result &= !workStealingDequeSteal(deque, stolen);
+    result &= stolen == -1;
+
+    // Thieves take oldest first, from the other end to the owner
+    for (int i = 0; i < 4; i++) {workStealingDequePush(deque, i);}
+    result &= workStealingDequeSteal(deque, stolen) && stolen == 0;
+    result &= workStealingDequeSteal(deque, stolen) && stolen == 1;
+    int popped;
+    result &= workStealingDequePop(deque, popped) && popped == 3;
+    result &= workStealingDequeSteal(deque, stolen) && stolen == 2;
+    result &= !workStealingDequeSteal(deque, stolen);
+    result &= !workStealingDequePop(deque, popped);
+
+    return result;
+}
+
+/**
+ * @brief Steals until the owner is done, marking everything taken
+ */
+void workStealingDequeTestThief(
+        WorkStealingDeque<int>* deque,
+        std::atomic<bool>* done,
+        std::atomic<int>* seen) {
+    int stolen;
+    while (!done->load() || workStealingDequeSize(*deque)) {
+        if (workStealingDequeSteal(*deque, stolen)) {
+            seen[stolen].fetch_add(1);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool workStealingDequeTestThreads() {
+    bool result = true;
+
+    // The owner pushes and pops while thieves steal, and every element
+    // must be taken exactly once, including the contested last ones
+    const int NUM_THIEVES = 3;
+    const int TOTAL = 100000;
+    WorkStealingDeque<int> deque;
+    std::atomic<bool> done(false);
+    std::unique_ptr<std::atomic<int>[]> seen(new std::atomic<int>[TOTAL]);
+    for (int i = 0; i < TOTAL; i++) {seen[i].store(0);}
+
+    DynamicArray<std::thread> threads;
+    for (int i = 0; i < NUM_THIEVES; i++) {
+        dynamicArrayEmplaceBack(threads, workStealingDequeTestThief,
+            &deque, &done, seen.get());
+    }
+    int popped;
+    for (int i = 0; i < TOTAL; i++) {
+        workStealingDequePush(deque, i);
+        if (i % 3 == 0 && workStealingDequePop(deque, popped)) {
+            seen[popped].fetch_add(1);
+        }
+    }
+    while (workStealingDequePop(deque, popped)) {seen[popped].fetch_add(1);}
+    done.store(true);
+    for (int i = 0; i < NUM_THIEVES; i++) {threads[i].join();}
+
+    for (int i = 0; i < TOTAL; i++) {result &= seen[i].load() == 1;}
+
+    return result;
+}
+
+void workStealingDequeTestRegisterTests(TestManager* test_manager) {
+    TestGroup test_group("work stealing deque");
+
+    testGroupAddTest(&test_group, UnitTest("push and pop",
+        workStealingDequeTestPushPop));
+    testGroupAddTest(&test_group, UnitTest("steal",
+        workStealingDequeTestSteal));
+    testGroupAddTest(&test_group, UnitTest("threads",
+        workStealingDequeTestThreads));
+
+    testManagerAddTestGroup(test_manager, test_group);
+}
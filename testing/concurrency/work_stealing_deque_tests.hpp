@@ -0,0 +1,8 @@
+#ifndef WORK_STEALING_DEQUE_TESTS_HPP
+#define WORK_STEALING_DEQUE_TESTS_HPP
+
+#include "test_utils/test_manager.hpp"
+
+void workStealingDequeTestRegisterTests(TestManager* test_manager);
+
+#endif
@@ -1,4 +1,5 @@
 #include "binary_tree_tests.hpp"
+#include <iterator>
 #include <data_structures/binary_tree.cpp>
 
 bool binaryTreeTestDefaultConstructor() {
@@ -504,8 +505,7 @@ bool binaryTreeTestGetOrderCessor() {
     result &= binaryTreeGetOrderCessor(
         preorder_predecessor, 
         2, 
-        binaryTreeGetPreorder, 
-        linkedListGetPredecessorOfNthOccurrence) == preorder_predecessor;
+        binaryTreeGetPrevPreorder) == preorder_predecessor;
     delete preorder_predecessor;
 
     BinaryTree<int>* inorder_predecessor = new BinaryTree<int>(4);
@@ -513,8 +513,7 @@ bool binaryTreeTestGetOrderCessor() {
     result &= binaryTreeGetOrderCessor(
         inorder_predecessor, 
         4, 
-        binaryTreeGetInorder, 
-        linkedListGetPredecessorOfNthOccurrence) == inorder_predecessor->left;
+        binaryTreeGetPrevInorder) == inorder_predecessor->left;
     delete inorder_predecessor;
 
     BinaryTree<int>* postorder_successor = new BinaryTree<int>(4);
@@ -523,8 +522,7 @@ bool binaryTreeTestGetOrderCessor() {
     result &= binaryTreeGetOrderCessor(
         postorder_successor, 
         5, 
-        binaryTreeGetPostorder, 
-        linkedListGetSuccessorOfNthOccurrence) == postorder_successor;
+        binaryTreeGetNextPostorder) == postorder_successor;
     delete postorder_successor;
 
     return result;
@@ -568,6 +566,7 @@ bool binaryTreeTestDeleteNode() {
 
     BinaryTree<int>* delete_root = new BinaryTree<int>(4);
     binaryTreeDeleteNode(&delete_root, 4);
+    result &= !delete_root;
 
     BinaryTree<int>* delete_head_left_leaf = new BinaryTree<int>(5);
     binaryTreeInsertNode(&delete_head_left_leaf, 2);
@@ -604,11 +603,329 @@ bool binaryTreeTestDeleteNode() {
     binaryTreeInsertNode(&delete_left, 1);
     binaryTreeDeleteNode(&delete_left, 2);
     result &= delete_left->left->data == 1;
+
+    // Deleting a leaf unlinks it from its parent
+    binaryTreeDeleteNode(&delete_left, 1);
+    result &= !delete_left->left;
     delete delete_left;
 
     return result;
 }
 
+bool binaryTreeTestDegenerateTree() {
+    bool result = true;
+
+    // A sorted insert order makes a path that recursion couldn't handle
+    const int depth = 1000000;
+    BinaryTree<int>* tree = new BinaryTree<int>(0);
+    BinaryTree<int>* tail = tree;
+    for (int i = 1; i < depth; i++) {
+        tail->right = new BinaryTree<int>(i);
+        tail = tail->right;
+    }
+    tail->left = new BinaryTree<int>(-1);
+
+    BinaryTree<int>* copy = new BinaryTree<int>(*tree);
+    result &= *copy == *tree;
+    tail->left->data = -2;
+    result &= *copy != *tree;
+
+    delete tree;
+    delete copy;
+
+    return result;
+}
+
+/**
+ * @brief Checks that stored heights are right, children differ in height by
+ * at most one and every key is strictly between lower and upper
+ */
+bool binaryTreeTestIsAvl(BinaryTree<int>* tree, long lower, long upper) {
+    if (!tree) {return true;}
+    int left = binaryTreeAvlGetHeight(tree->left);
+    int right = binaryTreeAvlGetHeight(tree->right);
+    return tree->data > lower && tree->data < upper
+        && tree->height == 1 + (left > right ? left : right)
+        && left - right <= 1 && right - left <= 1
+        && binaryTreeTestIsAvl(tree->left, lower, tree->data)
+        && binaryTreeTestIsAvl(tree->right, tree->data, upper);
+}
+
+bool binaryTreeTestRotate() {
+    bool result = true;
+
+    BinaryTree<int>* tree = new BinaryTree<int>(4,
+        new BinaryTree<int>(2, new BinaryTree<int>(1), new BinaryTree<int>(3)),
+        new BinaryTree<int>(5));
+    result &= tree->height == 3;
+
+    binaryTreeRotateRight(&tree);
+    result &= tree->data == 2 && tree->left->data == 1;
+    result &= tree->right->data == 4 && tree->right->left->data == 3;
+    result &= tree->height == 3 && tree->right->height == 2;
+
+    binaryTreeRotateLeft(&tree);
+    result &= tree->data == 4 && tree->left->right->data == 3;
+    result &= tree->height == 3;
+
+    BinaryTree<int>* leaf = tree->right;
+    try {
+        binaryTreeRotateLeft(&leaf);
+        result &= false;
+    } catch (std::logic_error) {
+        result &= true;
+    } catch (...) {
+        result &= false;
+    }
+    delete tree;
+
+    return result;
+}
+
+bool binaryTreeTestAvlInsertNode() {
+    bool result = true;
+
+    // Sorted inserts would make a path without rebalancing
+    const int size = 100000;
+    BinaryTree<int>* tree = nullptr;
+    for (int i = 0; i < size; i++) {binaryTreeAvlInsertNode(&tree, i);}
+    binaryTreeAvlInsertNode(&tree, 50);
+    result &= binaryTreeTestIsAvl(tree, -1, size);
+    result &= binaryTreeGetNumNodes(tree) == size;
+    result &= binaryTreeGetHeight(tree) == tree->height;
+    // 1.44 log2(100000) is about 24
+    result &= tree->height <= 24;
+    for (int i = 0; i < size; i += 997) {
+        result &= binaryTreeGetNode(tree, i)->data == i;
+    }
+    result &= !binaryTreeGetNode(tree, size);
+    delete tree;
+
+    BinaryTree<int>* reverse = nullptr;
+    for (int i = 100; i > 0; i--) {binaryTreeAvlInsertNode(&reverse, i);}
+    result &= binaryTreeTestIsAvl(reverse, 0, 101);
+    delete reverse;
+
+    return result;
+}
+
+bool binaryTreeTestAvlDeleteNode() {
+    bool result = true;
+
+    BinaryTree<int>* tree = nullptr;
+    for (int i = 0; i < 1000; i++) {binaryTreeAvlInsertNode(&tree, i);}
+
+    // Missing keys are ignored
+    binaryTreeAvlDeleteNode(&tree, 1000);
+    result &= binaryTreeGetNumNodes(tree) == 1000;
+
+    // Includes the root and nodes with two children
+    for (int i = 0; i < 1000; i += 3) {
+        binaryTreeAvlDeleteNode(&tree, tree->data);
+        binaryTreeAvlDeleteNode(&tree, i);
+    }
+    result &= binaryTreeTestIsAvl(tree, -1, 1000);
+    for (int i = 0; i < 1000; i += 3) {result &= !binaryTreeGetNode(tree, i);}
+
+    while (tree) {binaryTreeAvlDeleteNode(&tree, tree->data);}
+    result &= !tree;
+
+    return result;
+}
+
+bool binaryTreeTestBuildFromSorted() {
+    bool result = true;
+
+    result &= !binaryTreeBuildFromSorted((int*) nullptr, 0);
+
+    const int size = 1000;
+    int data[size];
+    for (int i = 0; i < size; i++) {data[i] = 2 * i;}
+    BinaryTree<int>* tree = binaryTreeBuildFromSorted(data, size);
+    result &= binaryTreeTestIsAvl(tree, -1, 2 * size);
+    result &= binaryTreeGetNumNodes(tree) == size;
+    // A perfectly balanced tree of 1000 nodes has height 10
+    result &= tree->height == 10;
+
+    // The AVL functions keep working on the result
+    binaryTreeAvlInsertNode(&tree, 1);
+    binaryTreeAvlDeleteNode(&tree, 0);
+    result &= binaryTreeTestIsAvl(tree, -1, 2 * size);
+    result &= binaryTreeGetNode(tree, 1) && !binaryTreeGetNode(tree, 0);
+    delete tree;
+
+    const int unsorted[3] = {1, 3, 3};
+    try {
+        binaryTreeBuildFromSorted(unsorted, 3);
+        result &= false;
+    } catch (std::logic_error) {
+        result &= true;
+    } catch (...) {
+        result &= false;
+    }
+
+    return result;
+}
+
+bool binaryTreeTestOrderSteps() {
+    bool result = true;
+
+    // 4 with children 2 and 6, 2 with children 1 and 3, 6 with right child 7
+    BinaryTree<int>* tree = nullptr;
+    const int inserts[6] = {4, 2, 6, 1, 3, 7};
+    for (int i = 0; i < 6; i++) {binaryTreeInsertNode(&tree, inserts[i]);}
+    const int preorder[6] = {4, 2, 1, 3, 6, 7};
+    const int inorder[6] = {1, 2, 3, 4, 6, 7};
+    const int postorder[6] = {1, 3, 2, 7, 6, 4};
+
+    // Walk each order forwards and backwards without allocating
+    BinaryTree<int>* node = tree;
+    for (int i = 0; i < 6; i++, node = binaryTreeGetNextPreorder(node)) {
+        result &= node && node->data == preorder[i];
+    }
+    result &= !node;
+    node = binaryTreeGetNode(tree, 7);
+    for (int i = 5; i >= 0; i--, node = binaryTreeGetPrevPreorder(node)) {
+        result &= node && node->data == preorder[i];
+    }
+    result &= !node;
+
+    node = binaryTreeGetFirstInorder(tree);
+    for (int i = 0; i < 6; i++, node = binaryTreeGetNextInorder(node)) {
+        result &= node && node->data == inorder[i];
+    }
+    result &= !node;
+    node = binaryTreeGetLastInorder(tree);
+    for (int i = 5; i >= 0; i--, node = binaryTreeGetPrevInorder(node)) {
+        result &= node && node->data == inorder[i];
+    }
+    result &= !node;
+
+    node = binaryTreeGetNode(tree, 1);
+    for (int i = 0; i < 6; i++, node = binaryTreeGetNextPostorder(node)) {
+        result &= node && node->data == postorder[i];
+    }
+    result &= !node;
+    node = tree;
+    for (int i = 5; i >= 0; i--, node = binaryTreeGetPrevPostorder(node)) {
+        result &= node && node->data == postorder[i];
+    }
+    result &= !node;
+
+    result &= !binaryTreeGetInorderSuccessor(tree, 5);
+    result &= binaryTreeGetInorderSuccessor(tree, 3)->data == 4;
+    result &= binaryTreeGetPreorderSuccessor(tree, 3)->data == 6;
+    result &= binaryTreeGetPostorderPredecessor(tree, 6)->data == 7;
+    delete tree;
+
+    // Parents survive rotations, copies and deletes
+    BinaryTree<int>* avl = nullptr;
+    for (int i = 0; i < 1000; i++) {binaryTreeAvlInsertNode(&avl, i);}
+    for (int i = 0; i < 1000; i += 2) {binaryTreeAvlDeleteNode(&avl, i);}
+    BinaryTree<int>* copy = new BinaryTree<int>(*avl);
+    for (int i = 1; i < 1000; i += 2) {binaryTreeDeleteNode(&avl, i);}
+    result &= !avl;
+
+    int count = 0;
+    node = binaryTreeGetFirstInorder(copy);
+    for (; node; node = binaryTreeGetNextInorder(node)) {
+        result &= node->data == 2 * count + 1;
+        result &= !node->left || node->left->parent == node;
+        result &= !node->right || node->right->parent == node;
+        count++;
+    }
+    result &= count == 500 && !copy->parent;
+    delete copy;
+
+    return result;
+}
+
+bool binaryTreeTestIterators() {
+    bool result = true;
+
+    BinaryTree<int>* empty = nullptr;
+    BinaryTreeRange<int, BINARY_TREE_INORDER> none = binaryTreeInorder(empty);
+    result &= none.begin() == none.end();
+
+    // 4 with children 2 and 6, 2 with children 1 and 3, 6 with right child 7
+    BinaryTree<int>* tree = nullptr;
+    const int inserts[6] = {4, 2, 6, 1, 3, 7};
+    for (int i = 0; i < 6; i++) {binaryTreeInsertNode(&tree, inserts[i]);}
+    const int preorder[6] = {4, 2, 1, 3, 6, 7};
+    const int inorder[6] = {1, 2, 3, 4, 6, 7};
+    const int postorder[6] = {1, 3, 2, 7, 6, 4};
+
+    int i = 0;
+    for (BinaryTree<int>& node : binaryTreePreorder(tree)) {
+        result &= node.data == preorder[i++];
+    }
+    result &= i == 6;
+    i = 0;
+    for (BinaryTree<int>& node : binaryTreeInorder(tree)) {
+        result &= node.data == inorder[i++];
+    }
+    result &= i == 6;
+    i = 0;
+    for (BinaryTree<int>& node : binaryTreePostorder(tree)) {
+        result &= node.data == postorder[i++];
+    }
+    result &= i == 6;
+
+    // Stopping early leaves nothing to clean up
+    BinaryTreeRange<int, BINARY_TREE_INORDER> range = binaryTreeInorder(tree);
+    BinaryTreeIterator<int, BINARY_TREE_INORDER> it = range.begin();
+    while (it != range.end() && it->data < 3) {it++;}
+    result &= it->data == 3;
+    result &= std::distance(range.begin(), range.end()) == 6;
+
+    // Walking a subtree stays inside it rather than climbing to the root
+    const int sub_preorder[3] = {2, 1, 3};
+    const int sub_inorder[3] = {1, 2, 3};
+    const int sub_postorder[3] = {1, 3, 2};
+    const int* sub_orders[3] = {sub_preorder, sub_inorder, sub_postorder};
+    LinkedList<int>* sub_lists[3] = {
+        binaryTreeGetPreorder(tree->left),
+        binaryTreeGetInorder(tree->left),
+        binaryTreeGetPostorder(tree->left)
+    };
+    for (int j = 0; j < 3; j++) {
+        result &= linkedListGetLength(sub_lists[j]) == 3;
+        LinkedList<int>* sub_node = sub_lists[j];
+        for (int k = 0; sub_node && k < 3; k++, sub_node = sub_node->next) {
+            result &= sub_node->data == sub_orders[j][k];
+        }
+        delete sub_lists[j];
+    }
+    // A right spine ends the inorder at the subtree's last node, and a
+    // lone leaf is a whole traversal by itself
+    BinaryTree<int>* six = tree->right;
+    result &= std::distance(
+        binaryTreeInorder(six).begin(), binaryTreeInorder(six).end()) == 2;
+    result &= std::distance(
+        binaryTreePreorder(six).begin(), binaryTreePreorder(six).end()) == 2;
+    BinaryTree<int>* leaf = tree->left->left;
+    BinaryTreeRange<int, BINARY_TREE_POSTORDER> leaf_range =
+        binaryTreePostorder(leaf);
+    result &= std::distance(leaf_range.begin(), leaf_range.end()) == 1;
+    delete tree;
+
+    // A path, linked by hand since sorted inserts take quadratic time
+    BinaryTree<int>* path = new BinaryTree<int>(0);
+    BinaryTree<int>* tail = path;
+    for (int j = 1; j < 100000; j++) {
+        tail->right = new BinaryTree<int>(j);
+        tail->right->parent = tail;
+        tail = tail->right;
+    }
+    LinkedList<int>* path_inorder = binaryTreeGetInorder(path);
+    result &= linkedListGetLength(path_inorder) == 100000;
+    result &= linkedListGetTail(&path_inorder)->data == 99999;
+    delete path_inorder;
+    delete path;
+
+    return result;
+}
+
 void binaryTreeTestRegisterTests(TestManager* test_manager) {
     TestGroup test_group("binary tree");
     testGroupAddTest(&test_group, 
@@ -645,5 +962,19 @@ void binaryTreeTestRegisterTests(TestManager* test_manager) {
         UnitTest("get parent of", binaryTreeTestGetParentOf));
     testGroupAddTest(&test_group,
         UnitTest("delete node", binaryTreeTestDeleteNode));
+    testGroupAddTest(&test_group,
+        UnitTest("degenerate tree", binaryTreeTestDegenerateTree));
+    testGroupAddTest(&test_group,
+        UnitTest("rotate", binaryTreeTestRotate));
+    testGroupAddTest(&test_group,
+        UnitTest("avl insert node", binaryTreeTestAvlInsertNode));
+    testGroupAddTest(&test_group,
+        UnitTest("avl delete node", binaryTreeTestAvlDeleteNode));
+    testGroupAddTest(&test_group,
+        UnitTest("build from sorted", binaryTreeTestBuildFromSorted));
+    testGroupAddTest(&test_group,
+        UnitTest("order steps", binaryTreeTestOrderSteps));
+    testGroupAddTest(&test_group,
+        UnitTest("iterators", binaryTreeTestIterators));
     testManagerAddTestGroup(test_manager, test_group);
 }
@@ -0,0 +1,340 @@
+#include "csr_graph_tests.hpp"
+#include <data_structures/csr_graph.cpp>
+
+const std::string TESTING = "../resources/testing/";
+
+bool csrGraphTestDefaultConstructor() {
+    bool result = true;
+
+    CsrGraph<int> empty;
+    result &= csrGraphGetNumNodes(empty) == 0;
+    result &= csrGraphGetNumEdges(empty) == 0;
+    result &= !empty.offsets;
+
+    return result;
+}
+
+bool csrGraphTestGraphConstructor() {
+    bool result = true;
+
+    Graph<int> empty_graph;
+    CsrGraph<int> empty(empty_graph);
+    result &= csrGraphGetNumNodes(empty) == 0;
+    result &= empty.offsets[0] == 0;
+
+    Graph<char> graph;
+    graphAddNode(graph, 'a');
+    graphAddNode(graph, 'b');
+    graphAddNode(graph, 'c');
+    graphAddEdge(graph, Edge<char>('a', 'c', 2.5));
+    graphAddEdge(graph, Edge<char>('a', 'b'));
+    graphAddEdge(graph, Edge<char>('c', 'a'));
+    CsrGraph<char> csr(graph);
+    result &= csrGraphGetNumNodes(csr) == 3;
+    result &= csrGraphGetNumEdges(csr) == 3;
+    result &= csr.nodes[0] == 'a';
+    result &= csr.nodes[2] == 'c';
+    result &= csrGraphGetDegree(csr, 0) == 2;
+    result &= csrGraphGetDegree(csr, 1) == 0;
+    result &= csr.targets[0] == 2;
+    result &= csr.weights[0] == 2.5;
+    result &= csr.targets[1] == 1;
+    result &= csr.targets[2] == 0;
+
+    Graph<int> missing_target;
+    graphAddNode(missing_target, 1);
+    graphAddEdge(missing_target, Edge<int>(1, 2));
+    try {
+        CsrGraph<int> invalid(missing_target);
+        result &= false;
+    } catch (std::logic_error) {
+        result &= true;
+    } catch (...) {
+        result &= false;
+    }
+
+    return result;
+}
+
+bool csrGraphTestFilePathConstructor() {
+    bool result = true;
+
+    std::string graph_file = TESTING + "file_path_constructor.txt";
+
+    CsrGraph<int> directed(graph_file, GRAPH_DIRECTED);
+    result &= csrGraphGetNumNodes(directed) == 10;
+    result &= csrGraphGetNumEdges(directed) == 8;
+    result &= csrGraphGetDegree(directed, 0) == 0;
+    result &= csrGraphGetDegree(directed, 3) == 2;
+    result &= directed.targets[directed.offsets[3]] == 4;
+    result &= directed.targets[directed.offsets[3] + 1] == 5;
+    result &= directed.weights[directed.offsets[3]] == 1;
+
+    CsrGraph<int> undirected(graph_file, GRAPH_UNDIRECTED);
+    result &= csrGraphGetNumEdges(undirected) == 16;
+    result &= csrGraphGetDegree(undirected, 5) == 2;
+    result &= undirected.targets[undirected.offsets[5]] == 3;
+    result &= undirected.targets[undirected.offsets[5] + 1] == 4;
+
+    Graph<int> directed_graph(graph_file, GRAPH_DIRECTED);
+    result &= CsrGraph<int>(directed_graph) == directed;
+    Graph<int> undirected_graph(graph_file, GRAPH_UNDIRECTED);
+    result &= CsrGraph<int>(undirected_graph) == undirected;
+
+    // Every integer node type keeps the nodes that have no edges, and
+    // each node's index is its value, just like freezing a Graph
+    CsrGraph<long long> wide(graph_file, GRAPH_DIRECTED);
+    result &= csrGraphGetNumNodes(wide) == 10;
+    result &= wide.nodes[0] == 0 && wide.nodes[9] == 9;
+    result &= wide.targets[wide.offsets[3]] == 4;
+    result &= CsrGraph<long long>(Graph<long long>(graph_file, GRAPH_DIRECTED))
+        == wide;
+    CsrGraph<short> narrow(graph_file, GRAPH_UNDIRECTED);
+    result &= csrGraphGetNumNodes(narrow) == 10;
+    result &= csrGraphGetNumEdges(narrow) == 16;
+    result &= CsrGraph<short>(Graph<short>(graph_file, GRAPH_UNDIRECTED))
+        == narrow;
+
+    // Node 9 is past the 3 nodes the file declares, and 64-bit ids are
+    // past the 3 nodes int64.txt declares
+    try {
+        CsrGraph<int> invalid(TESTING + "missing_node.txt", GRAPH_DIRECTED);
+        result &= false;
+    } catch (std::logic_error) {
+        result &= true;
+    } catch (...) {
+        result &= false;
+    }
+    try {
+        CsrGraph<short> invalid(
+            TESTING + "too_many_nodes.txt", GRAPH_DIRECTED);
+        result &= false;
+    } catch (std::logic_error) {
+        result &= true;
+    } catch (...) {
+        result &= false;
+    }
+    try {
+        CsrGraph<long long> invalid(
+            TESTING + "edge_list_loader/int64.txt", GRAPH_DIRECTED);
+        result &= false;
+    } catch (std::logic_error) {
+        result &= true;
+    } catch (...) {
+        result &= false;
+    }
+
+    return result;
+}
+
+bool csrGraphTestFilePathConstructorStrings() {
+    bool result = true;
+
+    std::string graph_file = TESTING + "string_vertices.txt";
+
+    // Names are stored once in the nodes table, and edges use indices
+    CsrGraph<std::string> directed(graph_file, GRAPH_DIRECTED);
+    result &= csrGraphGetNumNodes(directed) == 4;
+    result &= csrGraphGetNumEdges(directed) == 4;
+    result &= directed.nodes[0] == "paris" && directed.nodes[3] == "rome";
+    result &= directed.targets[directed.offsets[3]] == 0;
+    result &= directed.weights[directed.offsets[3]] == 4;
+
+    Graph<std::string> directed_graph(graph_file, GRAPH_DIRECTED);
+    result &= CsrGraph<std::string>(directed_graph) == directed;
+    CsrGraph<std::string> undirected(graph_file, GRAPH_UNDIRECTED);
+    Graph<std::string> undirected_graph(graph_file, GRAPH_UNDIRECTED);
+    result &= CsrGraph<std::string>(undirected_graph) == undirected;
+
+    return result;
+}
+
+bool csrGraphTestCopyConstructor() {
+    bool result = true;
+
+    CsrGraph<int> original(
+        TESTING + "file_path_constructor.txt",
+        GRAPH_DIRECTED);
+    CsrGraph<int> copy(original);
+    result &= copy == original;
+    result &= copy.targets != original.targets;
+
+    return result;
+}
+
+bool csrGraphTestAssignmentOperator() {
+    bool result = true;
+
+    CsrGraph<int> original(
+        TESTING + "file_path_constructor.txt",
+        GRAPH_DIRECTED);
+    CsrGraph<int> assigned;
+    assigned = original;
+    result &= assigned == original;
+    result &= assigned.offsets != original.offsets;
+
+    return result;
+}
+
+bool csrGraphTestEqualityOperator() {
+    const std::string directory = TESTING + "equality_operator/";
+    bool result = true;
+
+    CsrGraph<int> inequal_lhs(directory + "inequal_lhs.txt", GRAPH_DIRECTED);
+    CsrGraph<int> inequal_rhs(directory + "inequal_rhs.txt", GRAPH_DIRECTED);
+    result &= inequal_lhs != inequal_rhs;
+
+    CsrGraph<int> equal_lhs(directory + "equal_lhs.txt", GRAPH_DIRECTED);
+    CsrGraph<int> equal_rhs(directory + "equal_rhs.txt", GRAPH_DIRECTED);
+    result &= equal_lhs == equal_rhs;
+
+    return result;
+}
+
+bool csrGraphTestGetNeighbors() {
+    bool result = true;
+
+    CsrGraph<int> graph(
+        TESTING + "file_path_constructor.txt",
+        GRAPH_DIRECTED);
+
+    CsrNeighbors<double> none = csrGraphGetNeighbors(graph, 0);
+    result &= none.length == 0;
+    result &= none.begin() == none.end();
+
+    CsrNeighbors<double> neighbors = csrGraphGetNeighbors(graph, 6);
+    result &= neighbors.length == 2;
+    int expected[2] = {7, 9};
+    int i = 0;
+    for (int target : neighbors) {
+        result &= target == expected[i];
+        result &= neighbors.weights[i] == 1;
+        i++;
+    }
+    result &= i == 2;
+
+    return result;
+}
+
+bool csrGraphTestGetIndex() {
+    bool result = true;
+
+    Graph<char> graph;
+    graphAddNode(graph, 'x');
+    graphAddNode(graph, 'y');
+    CsrGraph<char> csr(graph);
+    result &= csrGraphGetIndex(csr, 'y') == 1;
+    result &= csrGraphGetIndex(csr, 'z') == -1;
+
+    return result;
+}
+
+bool csrGraphTestHasEdge() {
+    bool result = true;
+
+    CsrGraph<int> graph(
+        TESTING + "file_path_constructor.txt",
+        GRAPH_DIRECTED);
+    result &= csrGraphHasEdge(graph, 8, 9);
+    result &= !csrGraphHasEdge(graph, 9, 8);
+
+    return result;
+}
+
+bool csrGraphTestTranspose() {
+    bool result = true;
+
+    CsrGraph<int> empty;
+    result &= csrGraphGetNumNodes(csrGraphTranspose(empty)) == 0;
+
+    CsrGraph<int> graph(
+        TESTING + "file_path_constructor.txt",
+        GRAPH_DIRECTED);
+    CsrGraph<int> transpose = csrGraphTranspose(graph);
+    result &= csrGraphGetNumEdges(transpose) == csrGraphGetNumEdges(graph);
+    for (int from = 0; from < csrGraphGetNumNodes(graph); from++) {
+        for (int to : csrGraphGetNeighbors(graph, from)) {
+            result &= csrGraphHasEdge(transpose, to, from);
+        }
+    }
+    result &= csrGraphGetDegree(transpose, 9) == 2;
+    result &= transpose.targets[transpose.offsets[9]] == 6;
+    result &= transpose.targets[transpose.offsets[9] + 1] == 8;
+    result &= csrGraphTranspose(transpose) == graph;
+
+    CsrGraph<int> undirected(
+        TESTING + "file_path_constructor.txt",
+        GRAPH_UNDIRECTED);
+    result &= csrGraphGetNumEdges(csrGraphTranspose(undirected)) == 16;
+
+    return result;
+}
+
+bool csrGraphTestWeightTypes() {
+    bool result = true;
+
+    Graph<char> graph;
+    graphAddNode(graph, 'a');
+    graphAddNode(graph, 'b');
+    graphAddEdge(graph, Edge<char>('a', 'b', 2.5));
+    graphAddEdge(graph, Edge<char>('b', 'a', -1.5));
+    CsrGraph<char, float> floats(graph);
+    result &= floats.weights[0] == 2.5f;
+    result &= csrGraphGetWeight(floats.weights, 1) == -1.5;
+    CsrGraph<char, int32_t> integers(graph);
+    result &= integers.weights[0] == 2;
+    result &= integers.weights[1] == -1;
+    result &= csrGraphTranspose(integers).weights[0] == -1;
+
+    // Unweighted graphs store no weights, and every edge weighs 1
+    CsrGraph<int, void> unweighted(
+        TESTING + "file_path_constructor.txt",
+        GRAPH_DIRECTED);
+    CsrGraph<int> weighted(
+        TESTING + "file_path_constructor.txt",
+        GRAPH_DIRECTED);
+    result &= !unweighted.weights;
+    result &= csrGraphGetNumEdges(unweighted) == csrGraphGetNumEdges(weighted);
+    for (size_t i = 0; i < weighted.num_edges; i++) {
+        result &= unweighted.targets[i] == weighted.targets[i];
+        result &= csrGraphGetWeight(unweighted.weights, i) == 1;
+    }
+    CsrNeighbors<void> neighbors = csrGraphGetNeighbors(unweighted, 6);
+    result &= neighbors.length == 2 && !neighbors.weights;
+    result &= csrGraphHasEdge(unweighted, 8, 9);
+
+    CsrGraph<int, void> copy(unweighted);
+    result &= copy == unweighted && !copy.weights;
+    CsrGraph<int, void> transpose = csrGraphTranspose(unweighted);
+    result &= csrGraphTranspose(transpose) == unweighted;
+
+    return result;
+}
+
+void csrGraphTestRegisterTests(TestManager* test_manager) {
+    TestGroup test_group("csr graph");
+
+    testGroupAddTest(&test_group, UnitTest("default constructor",
+        csrGraphTestDefaultConstructor));
+    testGroupAddTest(&test_group, UnitTest("graph constructor",
+        csrGraphTestGraphConstructor));
+    testGroupAddTest(&test_group, UnitTest("file path constructor",
+        csrGraphTestFilePathConstructor));
+    testGroupAddTest(&test_group, UnitTest("file path constructor strings",
+        csrGraphTestFilePathConstructorStrings));
+    testGroupAddTest(&test_group, UnitTest("copy constructor",
+        csrGraphTestCopyConstructor));
+    testGroupAddTest(&test_group, UnitTest("assignment operator",
+        csrGraphTestAssignmentOperator));
+    testGroupAddTest(&test_group, UnitTest("equality operator",
+        csrGraphTestEqualityOperator));
+    testGroupAddTest(&test_group, UnitTest("get neighbors",
+        csrGraphTestGetNeighbors));
+    testGroupAddTest(&test_group, UnitTest("get index", csrGraphTestGetIndex));
+    testGroupAddTest(&test_group, UnitTest("has edge", csrGraphTestHasEdge));
+    testGroupAddTest(&test_group, UnitTest("transpose", csrGraphTestTranspose));
+    testGroupAddTest(&test_group, UnitTest("weight types",
+        csrGraphTestWeightTypes));
+
+    testManagerAddTestGroup(test_manager, test_group);
+}
@@ -0,0 +1,8 @@
+#ifndef CSR_GRAPH_TESTS_HPP
+#define CSR_GRAPH_TESTS_HPP
+
+#include "test_utils/test_manager.hpp"
+
+void csrGraphTestRegisterTests(TestManager* test_manager);
+
+#endif
@@ -730,6 +730,31 @@ bool doubleLinkedListTestDeleteBackwardNthOccurrence() {
     return result;
 }
 
+bool doubleLinkedListTestLongList() {
+    bool result = true;
+
+    // Long enough that recursive copies or deletes would blow the stack
+    const int length = 1000000;
+    DoubleLinkedList<int>* list = nullptr;
+    for (int i = length - 1; i >= 0; i--) {
+        list = new DoubleLinkedList<int>(i, nullptr, list);
+        if (list->next) {list->next->prev = list;}
+    }
+
+    DoubleLinkedList<int>* copy = new DoubleLinkedList<int>(*list);
+    result &= *copy == *list;
+    result &= doubleLinkedListGetLength(copy) == length;
+    DoubleLinkedList<int>* tail = doubleLinkedListGetTail(&copy);
+    result &= tail->data == length - 1 && tail->prev->next == tail;
+    tail->data = -1;
+    result &= *copy != *list;
+
+    delete list;
+    delete copy;
+
+    return result;
+}
+
 void doubleLinkedListTestRegisterTests(TestManager* test_manager) {
     TestGroup test_group("double linked list");
     testGroupAddTest(&test_group, UnitTest("default constructor", 
@@ -780,5 +805,7 @@ void doubleLinkedListTestRegisterTests(TestManager* test_manager) {
         doubleLinkedListTestDeleteForwardNthOccurrence));
     testGroupAddTest(&test_group, UnitTest("delete backward nth occurrence",
         doubleLinkedListTestDeleteBackwardNthOccurrence));
+    testGroupAddTest(&test_group, UnitTest("long list",
+        doubleLinkedListTestLongList));
     testManagerAddTestGroup(test_manager, test_group);
 }
@@ -0,0 +1,174 @@
+#include "dynamic_array_tests.hpp"
+#include <string>
+#include <data_structures/dynamic_array.cpp>
+
+bool dynamicArrayTestDefaultConstructor() {
+    bool result = true;
+
+    DynamicArray<int> empty;
+    result &= !empty.data;
+    result &= empty.size == 0;
+    result &= empty.capacity == 0;
+
+    return result;
+}
+
+bool dynamicArrayTestCapacityConstructor() {
+    bool result = true;
+
+    DynamicArray<int> reserved(10);
+    result &= reserved.size == 0;
+    result &= reserved.capacity == 10;
+
+    return result;
+}
+
+bool dynamicArrayTestCopyConstructor() {
+    bool result = true;
+
+    DynamicArray<std::string> original;
+    dynamicArrayPushBack(original, std::string("a"));
+    dynamicArrayPushBack(original, std::string("b"));
+    DynamicArray<std::string> copy(original);
+    result &= copy.size == 2;
+    result &= copy[0] == "a";
+    result &= copy[1] == "b";
+    result &= copy.data != original.data;
+
+    return result;
+}
+
+bool dynamicArrayTestAssignmentOperator() {
+    bool result = true;
+
+    DynamicArray<int> original;
+    dynamicArrayPushBack(original, 4);
+    DynamicArray<int> assigned;
+    assigned = original;
+    result &= assigned.size == 1;
+    result &= assigned[0] == 4;
+    result &= assigned.data != original.data;
+
+    return result;
+}
+
+bool dynamicArrayTestEqualityOperator() {
+    bool result = true;
+
+    DynamicArray<int> different_size_lhs, different_size_rhs;
+    dynamicArrayPushBack(different_size_lhs, 1);
+    result &= !(different_size_lhs == different_size_rhs);
+
+    DynamicArray<int> different_data_lhs, different_data_rhs;
+    dynamicArrayPushBack(different_data_lhs, 1);
+    dynamicArrayPushBack(different_data_rhs, 2);
+    result &= !(different_data_lhs == different_data_rhs);
+
+    DynamicArray<int> equal_lhs, equal_rhs(8);
+    dynamicArrayPushBack(equal_lhs, 3);
+    dynamicArrayPushBack(equal_rhs, 3);
+    result &= equal_lhs == equal_rhs;
+
+    return result;
+}
+
+bool dynamicArrayTestPushBack() {
+    bool result = true;
+
+    DynamicArray<int> array;
+    for (int i = 0; i < 100; i++) {dynamicArrayPushBack(array, i);}
+    result &= array.size == 100;
+    result &= array.capacity >= 100;
+    for (int i = 0; i < 100; i++) {result &= array[i] == i;}
+
+    return result;
+}
+
+bool dynamicArrayTestEmplaceBack() {
+    bool result = true;
+
+    DynamicArray<std::string> array;
+    std::string& emplaced = dynamicArrayEmplaceBack(array, 3, 'x');
+    result &= emplaced == "xxx";
+    result &= array[0] == "xxx";
+
+    return result;
+}
+
+bool dynamicArrayTestPopBack() {
+    bool result = true;
+
+    DynamicArray<int> empty;
+    try {
+        dynamicArrayPopBack(empty);
+        result &= false;
+    } catch (std::logic_error) {
+        result &= true;
+    } catch (...) {
+        result &= false;
+    }
+
+    DynamicArray<int> two_elements;
+    dynamicArrayPushBack(two_elements, 1);
+    dynamicArrayPushBack(two_elements, 2);
+    dynamicArrayPopBack(two_elements);
+    result &= two_elements.size == 1;
+    result &= dynamicArrayBack(two_elements) == 1;
+
+    return result;
+}
+
+bool dynamicArrayTestResize() {
+    bool result = true;
+
+    DynamicArray<int> array;
+    dynamicArrayPushBack(array, 7);
+    dynamicArrayResize(array, 3);
+    result &= array.size == 3;
+    result &= array[0] == 7;
+    result &= array[1] == 0;
+    result &= array[2] == 0;
+    dynamicArrayResize(array, 1);
+    result &= array.size == 1;
+    result &= array[0] == 7;
+
+    return result;
+}
+
+bool dynamicArrayTestClear() {
+    bool result = true;
+
+    DynamicArray<int> array;
+    dynamicArrayPushBack(array, 1);
+    size_t capacity = array.capacity;
+    dynamicArrayClear(array);
+    result &= array.size == 0;
+    result &= array.capacity == capacity;
+
+    return result;
+}
+
+void dynamicArrayTestRegisterTests(TestManager* test_manager) {
+    TestGroup test_group("dynamic array");
+
+    testGroupAddTest(&test_group, UnitTest("default constructor",
+        dynamicArrayTestDefaultConstructor));
+    testGroupAddTest(&test_group, UnitTest("capacity constructor",
+        dynamicArrayTestCapacityConstructor));
+    testGroupAddTest(&test_group, UnitTest("copy constructor",
+        dynamicArrayTestCopyConstructor));
+    testGroupAddTest(&test_group, UnitTest("assignment operator",
+        dynamicArrayTestAssignmentOperator));
+    testGroupAddTest(&test_group, UnitTest("equality operator",
+        dynamicArrayTestEqualityOperator));
+    testGroupAddTest(&test_group, UnitTest("push back",
+        dynamicArrayTestPushBack));
+    testGroupAddTest(&test_group, UnitTest("emplace back",
+        dynamicArrayTestEmplaceBack));
+    testGroupAddTest(&test_group, UnitTest("pop back",
+        dynamicArrayTestPopBack));
+    testGroupAddTest(&test_group, UnitTest("resize", dynamicArrayTestResize));
+    testGroupAddTest(&test_group, UnitTest("clear", dynamicArrayTestClear));
+
+    testManagerAddTestGroup(test_manager, test_group);
+}
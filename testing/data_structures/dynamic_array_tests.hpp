@@ -0,0 +1,8 @@
+#ifndef DYNAMIC_ARRAY_TESTS_HPP
+#define DYNAMIC_ARRAY_TESTS_HPP
+
+#include "test_utils/test_manager.hpp"
+
+void dynamicArrayTestRegisterTests(TestManager* test_manager);
+
+#endif
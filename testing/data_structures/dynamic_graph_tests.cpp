@@ -0,0 +1,264 @@
+#include "dynamic_graph_tests.hpp"
+#include <algorithms/breadth_first_search.cpp>
+#include <data_structures/dynamic_graph.cpp>
+
+/**
+ * @brief Checks every node's block against an adjacency matrix, where
+ * missing edges have a negative weight
+ */
+template <typename W>
+bool dynamicGraphTestMatches(
+        const DynamicGraph<W>& graph,
+        const DynamicArray<double>& matrix) {
+    bool result = true;
+    int n = graph.num_nodes;
+    size_t num_edges = 0;
+    for (int from = 0; from < n; from++) {
+        CsrNeighbors<W> neighbors = dynamicGraphGetNeighbors(graph, from);
+        size_t i = 0;
+        for (int to = 0; to < n; to++) {
+            double weight = matrix[from * n + to];
+            if (weight < 0) {continue;}
+            result &= i < neighbors.length && neighbors.targets[i] == to
+                && csrGraphGetWeight(neighbors.weights, i) == weight;
+            i++;
+        }
+        result &= i == neighbors.length;
+        result &= neighbors.length <= graph.capacities[from];
+        num_edges += i;
+    }
+    result &= dynamicGraphGetNumEdges(graph) == num_edges;
+    return result;
+}
+
+bool dynamicGraphTestConstructor() {
+    bool result = true;
+
+    DynamicGraph<> empty;
+    result &= dynamicGraphGetNumNodes(empty) == 0;
+    result &= dynamicGraphGetNumEdges(empty) == 0;
+    result &= !empty.targets;
+
+    DynamicGraph<> graph(3);
+    result &= dynamicGraphGetNumNodes(graph) == 3;
+    result &= dynamicGraphGetDegree(graph, 2) == 0;
+    result &= dynamicGraphGetNeighbors(graph, 2).length == 0;
+    dynamicGraphAddNodes(graph, 2);
+    result &= dynamicGraphGetNumNodes(graph) == 5;
+    result &= !dynamicGraphHasEdge(graph, 4, 0);
+
+    try {
+        dynamicGraphAddNodes(graph, -1);
+        result &= false;
+    } catch (std::logic_error) {
+        result &= true;
+    } catch (...) {
+        result &= false;
+    }
+
+    return result;
+}
+
+bool dynamicGraphTestApplyUpdates() {
+    bool result = true;
+
+    DynamicGraph<> graph(4);
+    DynamicArray<DynamicGraphUpdate> updates;
+    dynamicArrayPushBack(updates,
+        DynamicGraphUpdate(DYNAMIC_GRAPH_INSERT, Edge<int>(0, 3, 1.5)));
+    dynamicArrayPushBack(updates,
+        DynamicGraphUpdate(DYNAMIC_GRAPH_INSERT, Edge<int>(2, 0, 4)));
+    dynamicArrayPushBack(updates,
+        DynamicGraphUpdate(DYNAMIC_GRAPH_INSERT, Edge<int>(0, 1, 2)));
+    dynamicArrayPushBack(updates,
+        DynamicGraphUpdate(DYNAMIC_GRAPH_INSERT, Edge<int>(0, 2, 3)));
+    dynamicGraphSortUpdates(updates);
+    dynamicGraphApplyUpdates(graph, updates);
+    result &= dynamicGraphGetNumEdges(graph) == 4;
+    result &= dynamicGraphGetDegree(graph, 0) == 3;
+    int expected[3] = {1, 2, 3};
+    int i = 0;
+    for (int to : dynamicGraphGetNeighbors(graph, 0)) {
+        result &= to == expected[i++];
+    }
+    double weight = 0;
+    result &= dynamicGraphGetWeight(graph, 0, 3, &weight) && weight == 1.5;
+    result &= !dynamicGraphGetWeight(graph, 3, 0, &weight);
+
+    dynamicArrayClear(updates);
+    dynamicArrayPushBack(updates,
+        DynamicGraphUpdate(DYNAMIC_GRAPH_DELETE, Edge<int>(0, 1)));
+    dynamicArrayPushBack(updates,
+        DynamicGraphUpdate(DYNAMIC_GRAPH_UPDATE, Edge<int>(0, 3, 7)));
+    dynamicArrayPushBack(updates,
+        DynamicGraphUpdate(DYNAMIC_GRAPH_DELETE, Edge<int>(1, 2)));
+    dynamicArrayPushBack(updates,
+        DynamicGraphUpdate(DYNAMIC_GRAPH_INSERT, Edge<int>(3, 3, 1)));
+    dynamicGraphApplyUpdates(graph, updates);
+    result &= dynamicGraphGetNumEdges(graph) == 4;
+    result &= !dynamicGraphHasEdge(graph, 0, 1);
+    result &= dynamicGraphHasEdge(graph, 0, 2);
+    result &= dynamicGraphGetWeight(graph, 0, 3, &weight) && weight == 7;
+    result &= dynamicGraphHasEdge(graph, 3, 3);
+
+    DynamicGraph<> copy(graph);
+    result &= copy == graph;
+    result &= copy.targets != graph.targets;
+    DynamicGraph<> assigned;
+    assigned = graph;
+    result &= assigned == graph;
+    dynamicArrayClear(updates);
+    dynamicArrayPushBack(updates,
+        DynamicGraphUpdate(DYNAMIC_GRAPH_UPDATE, Edge<int>(2, 0, 5)));
+    dynamicGraphApplyUpdates(assigned, updates);
+    result &= assigned != graph;
+
+    return result;
+}
+
+bool dynamicGraphTestInvalidUpdates() {
+    bool result = true;
+
+    DynamicGraph<> graph(3);
+    DynamicArray<DynamicGraphUpdate> setup;
+    dynamicArrayPushBack(setup,
+        DynamicGraphUpdate(DYNAMIC_GRAPH_INSERT, Edge<int>(0, 1, 1)));
+    dynamicGraphApplyUpdates(graph, setup);
+    DynamicGraph<> original(graph);
+
+    // A missing node, the same edge twice, out of order, updating a
+    // missing edge and inserting an existing one. The valid update in
+    // each batch mustn't be applied either
+    DynamicGraphUpdate batches[5][2] = {
+        {DynamicGraphUpdate(DYNAMIC_GRAPH_INSERT, Edge<int>(1, 0)),
+            DynamicGraphUpdate(DYNAMIC_GRAPH_INSERT, Edge<int>(2, 3))},
+        {DynamicGraphUpdate(DYNAMIC_GRAPH_INSERT, Edge<int>(1, 0)),
+            DynamicGraphUpdate(DYNAMIC_GRAPH_DELETE, Edge<int>(1, 0))},
+        {DynamicGraphUpdate(DYNAMIC_GRAPH_INSERT, Edge<int>(2, 1)),
+            DynamicGraphUpdate(DYNAMIC_GRAPH_INSERT, Edge<int>(1, 0))},
+        {DynamicGraphUpdate(DYNAMIC_GRAPH_INSERT, Edge<int>(1, 0)),
+            DynamicGraphUpdate(DYNAMIC_GRAPH_UPDATE, Edge<int>(2, 2, 1))},
+        {DynamicGraphUpdate(DYNAMIC_GRAPH_INSERT, Edge<int>(0, 1)),
+            DynamicGraphUpdate(DYNAMIC_GRAPH_INSERT, Edge<int>(1, 0))}
+    };
+    for (int i = 0; i < 5; i++) {
+        DynamicArray<DynamicGraphUpdate> updates;
+        dynamicArrayPushBack(updates, batches[i][0]);
+        dynamicArrayPushBack(updates, batches[i][1]);
+        try {
+            dynamicGraphApplyUpdates(graph, updates);
+            result &= false;
+        } catch (std::logic_error) {
+            result &= true;
+        } catch (...) {
+            result &= false;
+        }
+        result &= graph == original;
+    }
+
+    return result;
+}
+
+bool dynamicGraphTestRandomBatches() {
+    bool result = true;
+
+    const int NUM_NODES = 300;
+    const int BATCH_SIZE = 2000;
+    ThreadPool pool(4);
+    DynamicGraph<> graph(NUM_NODES);
+    DynamicArray<double> matrix;
+    DynamicArray<int> touched;
+    dynamicArrayResize(matrix, NUM_NODES * NUM_NODES);
+    dynamicArrayResize(touched, NUM_NODES * NUM_NODES);
+    for (size_t i = 0; i < matrix.size; i++) {matrix[i] = -1;}
+
+    // Mostly inserts for a few batches, then deletes half the edges at a
+    // time, which leaves enough moved-out blocks behind to compact
+    unsigned int state = 77;
+    bool compacted = false;
+    for (int batch = 1; batch <= 12; batch++) {
+        DynamicArray<DynamicGraphUpdate> updates;
+        for (int i = 0; batch <= 6 && i < BATCH_SIZE; i++) {
+            state = state * 1103515245 + 12345;
+            int from = static_cast<int>((state >> 8) % NUM_NODES);
+            state = state * 1103515245 + 12345;
+            int to = static_cast<int>((state >> 8) % NUM_NODES);
+            int edge = from * NUM_NODES + to;
+            if (touched[edge] == batch) {continue;}
+            touched[edge] = batch;
+
+            bool keep = (state >> 4) % 4;
+            double weight = static_cast<double>((state >> 12) % 100);
+            DynamicGraphOperation operation = !keep ? DYNAMIC_GRAPH_DELETE
+                : matrix[edge] < 0 ? DYNAMIC_GRAPH_INSERT
+                : DYNAMIC_GRAPH_UPDATE;
+            dynamicArrayPushBack(updates,
+                DynamicGraphUpdate(operation, Edge<int>(from, to, weight)));
+            matrix[edge] = keep ? weight : -1;
+        }
+        for (int edge = 0; batch > 6 && edge < NUM_NODES * NUM_NODES; edge++) {
+            state = state * 1103515245 + 12345;
+            if (matrix[edge] < 0 || (state >> 8) % 2) {continue;}
+            dynamicArrayPushBack(updates, DynamicGraphUpdate(
+                DYNAMIC_GRAPH_DELETE,
+                Edge<int>(edge / NUM_NODES, edge % NUM_NODES)));
+            matrix[edge] = -1;
+        }
+        dynamicGraphSortUpdates(updates);
+        size_t slab_size = graph.slab_size;
+        dynamicGraphApplyUpdates(graph, updates, pool);
+        compacted |= graph.slab_size < slab_size;
+        result &= dynamicGraphTestMatches(graph, matrix);
+    }
+    result &= compacted;
+
+    dynamicGraphCompact(graph, pool);
+    result &= dynamicGraphTestMatches(graph, matrix);
+    for (int node = 1; node < NUM_NODES; node++) {
+        result &= graph.starts[node] >= graph.starts[node - 1];
+    }
+
+    return result;
+}
+
+bool dynamicGraphTestToCsr() {
+    bool result = true;
+
+    DynamicGraph<void> graph(5);
+    DynamicArray<DynamicGraphUpdate> updates;
+    int edges[5][2] = {{0, 1}, {0, 2}, {1, 3}, {2, 3}, {3, 4}};
+    for (int i = 0; i < 5; i++) {
+        dynamicArrayPushBack(updates, DynamicGraphUpdate(DYNAMIC_GRAPH_INSERT,
+            Edge<int>(edges[i][0], edges[i][1], 5)));
+    }
+    dynamicGraphApplyUpdates(graph, updates);
+    result &= !graph.weights;
+    double weight = 0;
+    result &= dynamicGraphGetWeight(graph, 3, 4, &weight) && weight == 1;
+
+    CsrGraph<int, void> csr = dynamicGraphToCsr(graph);
+    result &= csrGraphGetNumEdges(csr) == 5;
+    result &= csrGraphHasEdge(csr, 2, 3);
+    result &= breadthFirstSearch(csr, 0).distances[4] == 3;
+
+    DynamicGraph<void> copy(graph);
+    result &= copy == graph;
+
+    return result;
+}
+
+void dynamicGraphTestRegisterTests(TestManager* test_manager) {
+    TestGroup test_group("dynamic graph");
+
+    testGroupAddTest(&test_group, UnitTest("constructor",
+        dynamicGraphTestConstructor));
+    testGroupAddTest(&test_group, UnitTest("apply updates",
+        dynamicGraphTestApplyUpdates));
+    testGroupAddTest(&test_group, UnitTest("invalid updates",
+        dynamicGraphTestInvalidUpdates));
+    testGroupAddTest(&test_group, UnitTest("random batches",
+        dynamicGraphTestRandomBatches));
+    testGroupAddTest(&test_group, UnitTest("to csr", dynamicGraphTestToCsr));
+
+    testManagerAddTestGroup(test_manager, test_group);
+}
@@ -0,0 +1,8 @@
+#ifndef DYNAMIC_GRAPH_TESTS_HPP
+#define DYNAMIC_GRAPH_TESTS_HPP
+
+#include "test_utils/test_manager.hpp"
+
+void dynamicGraphTestRegisterTests(TestManager* test_manager);
+
+#endif
@@ -0,0 +1,120 @@
+#include "eytzinger_tree_tests.hpp"
+#include <data_structures/eytzinger_tree.cpp>
+
+bool eytzingerTreeTestInorderIndices() {
+    bool result = true;
+
+    // Walking the indices in order visits every node of the implicit tree
+    for (int size = 0; size < 40; size++) {
+        bool seen[40] = {false};
+        int count = 0;
+        for (int k = eytzingerTreeGetFirst(size);
+                k;
+                k = eytzingerTreeGetNext(k, size)) {
+            result &= k >= 1 && k <= size && !seen[k - 1];
+            seen[k - 1] = true;
+            count++;
+        }
+        result &= count == size;
+    }
+    result &= eytzingerTreeGetFirst(6) == 4;
+    result &= eytzingerTreeGetNext(4, 6) == 2;
+    result &= eytzingerTreeGetNext(2, 6) == 5;
+    result &= eytzingerTreeGetNext(5, 6) == 1;
+    result &= eytzingerTreeGetNext(1, 6) == 6;
+    result &= eytzingerTreeGetNext(6, 6) == 3;
+    result &= eytzingerTreeGetNext(3, 6) == 0;
+
+    return result;
+}
+
+bool eytzingerTreeTestBinaryTreeConstructor() {
+    bool result = true;
+
+    BinaryTree<int>* empty = nullptr;
+    EytzingerTree<int> empty_tree(empty);
+    result &= eytzingerTreeGetSize(empty_tree) == 0;
+    result &= !eytzingerTreeGet(empty_tree, 1);
+
+    BinaryTree<int>* tree = nullptr;
+    const int inserts[6] = {4, 2, 6, 1, 3, 7};
+    for (int i = 0; i < 6; i++) {binaryTreeInsertNode(&tree, inserts[i]);}
+    EytzingerTree<int> frozen(tree);
+    delete tree;
+
+    // The sorted keys 1 2 3 4 6 7 laid out breadth first
+    const int expected[7] = {0, 4, 2, 7, 1, 3, 6};
+    result &= eytzingerTreeGetSize(frozen) == 6;
+    for (int i = 1; i <= 6; i++) {result &= frozen.keys[i] == expected[i];}
+
+    return result;
+}
+
+bool eytzingerTreeTestGet() {
+    bool result = true;
+
+    BinaryTree<int>* tree = nullptr;
+    for (int i = 0; i < 1000; i++) {binaryTreeAvlInsertNode(&tree, 3 * i);}
+    EytzingerTree<int> frozen(tree);
+    delete tree;
+
+    for (int i = -3; i < 3003; i++) {
+        const int* found = eytzingerTreeGet(frozen, i);
+        if (i >= 0 && i < 3000 && i % 3 == 0) {
+            result &= found && *found == i;
+        } else {
+            result &= !found;
+        }
+    }
+
+    // Lower bounds land on the next key up
+    result &= frozen.keys[eytzingerTreeLowerBound(frozen, 4)] == 6;
+    result &= frozen.keys[eytzingerTreeLowerBound(frozen, -10)] == 0;
+    result &= eytzingerTreeLowerBound(frozen, 2998) == 0;
+
+    return result;
+}
+
+bool eytzingerTreeTestGetBatch() {
+    bool result = true;
+
+    BinaryTree<int>* tree = nullptr;
+    for (int i = 0; i < 777; i++) {binaryTreeAvlInsertNode(&tree, 2 * i);}
+    EytzingerTree<int> frozen(tree);
+    delete tree;
+
+    // Not a multiple of the batch size, to cover the last partial batch
+    const int count = 1555;
+    int keys[count];
+    const int* results[count];
+    for (int i = 0; i < count; i++) {keys[i] = (i * 389) % count - 1;}
+    eytzingerTreeGetBatch(frozen, keys, count, results);
+    for (int i = 0; i < count; i++) {
+        result &= results[i] == eytzingerTreeGet(frozen, keys[i]);
+    }
+
+    try {
+        eytzingerTreeGetBatch(frozen, keys, -1, results);
+        result &= false;
+    } catch (std::logic_error) {
+        result &= true;
+    } catch (...) {
+        result &= false;
+    }
+
+    return result;
+}
+
+void eytzingerTreeTestRegisterTests(TestManager* test_manager) {
+    TestGroup test_group("eytzinger tree");
+
+    testGroupAddTest(&test_group, UnitTest("inorder indices",
+        eytzingerTreeTestInorderIndices));
+    testGroupAddTest(&test_group, UnitTest("binary tree constructor",
+        eytzingerTreeTestBinaryTreeConstructor));
+    testGroupAddTest(&test_group, UnitTest("get", eytzingerTreeTestGet));
+    testGroupAddTest(&test_group, UnitTest("get batch",
+        eytzingerTreeTestGetBatch));
+
+    testManagerAddTestGroup(test_manager, test_group);
+}
@@ -0,0 +1,8 @@
+#ifndef EYTZINGER_TREE_TESTS_HPP
+#define EYTZINGER_TREE_TESTS_HPP
+
+#include "test_utils/test_manager.hpp"
+
+void eytzingerTreeTestRegisterTests(TestManager* test_manager);
+
+#endif
@@ -0,0 +1,234 @@
+#include "flat_hash_map_tests.hpp"
+#include <cstring>
+#include <string>
+#include <data_structures/flat_hash_map.cpp>
+
+/**
+ * @brief Hash functor that sends every key to the same group, so the tests
+ * can exercise long probes and deleted slots
+ */
+struct FlatHashMapTestCollidingHash {
+    size_t operator () (int key) const {return 0;}
+};
+
+/**
+ * @brief Hash and equality functors that take both std::string and
+ * const char*, so string keys can be searched without a copy
+ */
+struct FlatHashMapTestStringHash {
+    size_t operator () (const std::string& key) const {
+        return (*this)(key.c_str());
+    }
+    size_t operator () (const char* key) const {
+        size_t hash = 14695981039346656037ULL;
+        for (; *key; key++) {
+            hash = (hash ^ static_cast<unsigned char>(*key)) * 1099511628211ULL;
+        }
+        return hash;
+    }
+};
+
+struct FlatHashMapTestStringEqual {
+    bool operator () (const std::string& lhs, const std::string& rhs) const {
+        return lhs == rhs;
+    }
+    bool operator () (const std::string& lhs, const char* rhs) const {
+        return std::strcmp(lhs.c_str(), rhs) == 0;
+    }
+};
+
+bool flatHashMapTestMatch() {
+    bool result = true;
+
+    // The SIMD and portable matches agree, from any starting byte
+    int8_t bytes[3 * FLAT_HASH_MAP_GROUP_WIDTH];
+    unsigned int state = 12345;
+    for (size_t i = 0; i < sizeof(bytes); i++) {
+        state = state * 1103515245 + 12345;
+        int choice = (state >> 16) % 4;
+        bytes[i] = choice == 0 ? FLAT_HASH_MAP_EMPTY
+            : choice == 1 ? FLAT_HASH_MAP_DELETED
+            : static_cast<int8_t>((state >> 8) % 4);
+    }
+    const int8_t values[4] = {FLAT_HASH_MAP_EMPTY, FLAT_HASH_MAP_DELETED, 0, 3};
+    for (size_t start = 0; start < 2 * FLAT_HASH_MAP_GROUP_WIDTH; start++) {
+        uint32_t free = 0;
+        for (int i = 0; i < 4; i++) {
+            result &= flatHashMapMatch(bytes + start, values[i])
+                == flatHashMapMatchPortable(bytes + start, values[i]);
+        }
+        free = flatHashMapMatchPortable(bytes + start, FLAT_HASH_MAP_EMPTY)
+            | flatHashMapMatchPortable(bytes + start, FLAT_HASH_MAP_DELETED);
+        result &= flatHashMapMatchFree(bytes + start) == free;
+    }
+
+    result &= flatHashMapLowestBit(0x8) == 3;
+    result &= flatHashMapLeadingZeros(0x8) == 12;
+    result &= flatHashMapLeadingZeros(0x8000) == 0;
+
+    return result;
+}
+
+bool flatHashMapTestCopy() {
+    bool result = true;
+
+    FlatHashMap<int, int> empty;
+    result &= !empty.ctrl && !empty.slots;
+    result &= empty.capacity == 0 && empty.size == 0;
+    FlatHashMap<int, int> empty_copy(empty);
+    result &= empty_copy.capacity == 0;
+
+    FlatHashMap<std::string, int> original;
+    flatHashMapInsert(original, std::string("one"), 1);
+    flatHashMapInsert(original, std::string("two"), 2);
+    FlatHashMap<std::string, int> copy(original);
+    result &= copy.size == 2;
+    result &= *flatHashMapGet(copy, std::string("two")) == 2;
+    result &= flatHashMapGet(copy, std::string("two"))
+        != flatHashMapGet(original, std::string("two"));
+
+    FlatHashMap<std::string, int> assigned;
+    assigned = original;
+    flatHashMapInsert(original, std::string("one"), 3);
+    result &= *flatHashMapGet(assigned, std::string("one")) == 1;
+
+    FlatHashMap<std::string, int> moved(std::move(original));
+    result &= moved.size == 2 && original.size == 0;
+    result &= *flatHashMapGet(moved, std::string("one")) == 3;
+    result &= !flatHashMapGet(original, std::string("one"));
+
+    return result;
+}
+
+bool flatHashMapTestInsertGet() {
+    bool result = true;
+
+    FlatHashMap<int, int> map;
+    result &= !flatHashMapGet(map, 4);
+    result &= !flatHashMapHas(map, 4);
+    flatHashMapInsert(map, 4, 16);
+    result &= *flatHashMapGet(map, 4) == 16;
+    result &= !flatHashMapHas(map, 5);
+    flatHashMapInsert(map, 4, 17);
+    result &= *flatHashMapGet(map, 4) == 17;
+    result &= map.size == 1;
+
+    // Grows through several doublings, staying at most 7/8 full
+    const int COUNT = 100000;
+    for (int i = 0; i < COUNT; i++) {flatHashMapInsert(map, i, 2 * i);}
+    result &= map.size == COUNT;
+    result &= map.size <= map.capacity / 8 * 7;
+    for (int i = 0; i < COUNT; i++) {
+        int* value = flatHashMapGet(map, i);
+        result &= value && *value == 2 * i;
+    }
+    result &= !flatHashMapHas(map, COUNT);
+    result &= !flatHashMapHas(map, -1);
+
+    FlatHashMap<int, int> reserved;
+    flatHashMapReserve(reserved, 1000);
+    size_t capacity = reserved.capacity;
+    for (int i = 0; i < 1000; i++) {flatHashMapInsert(reserved, i, i);}
+    result &= reserved.capacity == capacity;
+
+    return result;
+}
+
+bool flatHashMapTestDelete() {
+    bool result = true;
+
+    FlatHashMap<int, int> map;
+    flatHashMapDelete(map, 1);
+    for (int i = 0; i < 1000; i++) {flatHashMapInsert(map, i, i);}
+    for (int i = 0; i < 1000; i += 2) {flatHashMapDelete(map, i);}
+    flatHashMapDelete(map, 2);
+    result &= map.size == 500;
+    for (int i = 0; i < 1000; i++) {result &= flatHashMapHas(map, i) == i % 2;}
+
+    // A table that's never very full can mark almost every slot empty
+    result &= map.deleted < 50;
+    for (int i = 0; i < 1000; i += 2) {flatHashMapInsert(map, i, -i);}
+    result &= map.size == 1000;
+    result &= *flatHashMapGet(map, 10) == -10;
+
+    // Colliding keys form one long run, so deleting needs deleted slots to
+    // keep later keys reachable, and inserts reuse them
+    FlatHashMap<int, int, FlatHashMapTestCollidingHash> colliding;
+    for (int i = 0; i < 100; i++) {flatHashMapInsert(colliding, i, i);}
+    for (int i = 0; i < 50; i++) {flatHashMapDelete(colliding, i);}
+    result &= colliding.deleted > 0;
+    for (int i = 0; i < 100; i++) {
+        result &= flatHashMapHas(colliding, i) == (i >= 50);
+    }
+    size_t capacity = colliding.capacity;
+    for (int i = 0; i < 50; i++) {flatHashMapInsert(colliding, i, i);}
+    result &= colliding.capacity == capacity;
+    for (int i = 0; i < 100; i++) {result &= flatHashMapHas(colliding, i);}
+
+    // Churn through many more keys than fit, and deleted slots get cleared
+    FlatHashMap<int, int> churn;
+    for (int i = 0; i < 100000; i++) {
+        flatHashMapInsert(churn, i, i);
+        if (i >= 100) {flatHashMapDelete(churn, i - 100);}
+    }
+    result &= churn.size == 100;
+    result &= churn.capacity <= 256;
+    for (int i = 99900; i < 100000; i++) {result &= flatHashMapHas(churn, i);}
+
+    return result;
+}
+
+bool flatHashMapTestHeterogeneous() {
+    bool result = true;
+
+    FlatHashMap<
+        std::string,
+        int,
+        FlatHashMapTestStringHash,
+        FlatHashMapTestStringEqual> map;
+    flatHashMapInsert(map, std::string("alpha"), 1);
+    flatHashMapInsert(map, std::string("beta"), 2);
+    result &= *flatHashMapGet(map, "alpha") == 1;
+    result &= *flatHashMapGet(map, std::string("beta")) == 2;
+    result &= !flatHashMapHas(map, "gamma");
+    flatHashMapDelete(map, "alpha");
+    result &= !flatHashMapHas(map, std::string("alpha"));
+    result &= map.size == 1;
+
+    return result;
+}
+
+bool flatHashMapTestForEach() {
+    bool result = true;
+
+    FlatHashMap<int, int> map;
+    for (int i = 1; i <= 100; i++) {flatHashMapInsert(map, i, i);}
+    flatHashMapDelete(map, 100);
+    int count = 0, sum = 0;
+    flatHashMapForEach(map, [&](const int& key, int& value) {
+        count++;
+        sum += key;
+        value *= 2;
+    });
+    result &= count == 99;
+    result &= sum == 99 * 100 / 2;
+    result &= *flatHashMapGet(map, 7) == 14;
+
+    return result;
+}
+
+void flatHashMapTestRegisterTests(TestManager* test_manager) {
+    TestGroup test_group("flat hash map");
+
+    testGroupAddTest(&test_group, UnitTest("match", flatHashMapTestMatch));
+    testGroupAddTest(&test_group, UnitTest("copy", flatHashMapTestCopy));
+    testGroupAddTest(&test_group, UnitTest("insert and get",
+        flatHashMapTestInsertGet));
+    testGroupAddTest(&test_group, UnitTest("delete", flatHashMapTestDelete));
+    testGroupAddTest(&test_group, UnitTest("heterogeneous",
+        flatHashMapTestHeterogeneous));
+    testGroupAddTest(&test_group, UnitTest("for each",
+        flatHashMapTestForEach));
+
+    testManagerAddTestGroup(test_manager, test_group);
+}
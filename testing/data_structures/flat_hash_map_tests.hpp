@@ -0,0 +1,8 @@
+#ifndef FLAT_HASH_MAP_TESTS_HPP
+#define FLAT_HASH_MAP_TESTS_HPP
+
+#include "test_utils/test_manager.hpp"
+
+void flatHashMapTestRegisterTests(TestManager* test_manager);
+
+#endif
@@ -65,6 +65,38 @@ bool graphTestFilePathConstructor() {
     result &= graphTestFilePathConstructorHelper(undirected, 5, 2, 0, 3);
     result &= graphTestFilePathConstructorHelper(undirected, 5, 2, 1, 4);
 
+    // Every integer node type keeps the nodes that have no edges
+    Graph<long long> wide(TESTING + graph_file, GRAPH_DIRECTED);
+    result &= graphGetNumNodes(wide) == 10;
+    result &= graphHasNode(wide, 0LL);
+    result &= graphHasEdge(wide, Edge<long long>(3, 5));
+    Graph<short> narrow(TESTING + graph_file, GRAPH_UNDIRECTED);
+    result &= graphGetNumNodes(narrow) == 10;
+    result &= graphHasNode(narrow, static_cast<short>(0));
+    result &= graphHasEdge(narrow, Edge<short>(5, 3));
+
+    return result;
+}
+
+bool graphTestFilePathConstructorStrings() {
+    bool result = true;
+
+    // Nodes come in the order the edges first name them
+    Graph<std::string> directed(
+        TESTING + "string_vertices.txt", GRAPH_DIRECTED);
+    result &= graphGetNumNodes(directed) == 4;
+    result &= directed.adjacency_matrix->data.from == "paris";
+    result &= directed.tail->data.from == "rome";
+    result &= graphHasEdge(directed, Edge<std::string>("paris", "london", 2.5));
+    result &= graphHasEdge(directed, Edge<std::string>("rome", "paris", 4));
+    result &= !graphHasEdge(directed, Edge<std::string>("london", "paris"));
+
+    Graph<std::string> undirected(
+        TESTING + "string_vertices.txt", GRAPH_UNDIRECTED);
+    result &= graphHasEdge(undirected, Edge<std::string>("london", "paris"));
+    result &= linkedListGetLength(
+        graphGetNode(undirected, std::string("paris"))->data.edges) == 3;
+
     return result;
 }
 
@@ -149,9 +181,7 @@ bool graphTestAddNode() {
 
     Graph<int> already_found;
     result &= !already_found.adjacency_matrix;
-    linkedListInsertAtTail(
-        &already_found.adjacency_matrix, 
-        AdjacencyList<int>(5));
+    graphAddNode(already_found, 5);
     result &= linkedListGetLength(already_found.adjacency_matrix) == 1;
     graphAddNode(already_found, 5);
     result &= linkedListGetLength(already_found.adjacency_matrix) == 1;
@@ -168,6 +198,8 @@ bool graphTestUpdateNode() {
         GRAPH_UNDIRECTED);
     graphUpdateNode(node_not_found, 1, 4);
     result &= graphHasNode(node_not_found, 4);
+    result &= !graphHasNode(node_not_found, 1);
+    result &= graphGetNode(node_not_found, 4)->data.from == 4;
 
     Graph<int> node_found(directory + "node_found.txt", GRAPH_UNDIRECTED);
     try {
@@ -181,7 +213,6 @@ bool graphTestUpdateNode() {
     return result;
 }
 
-// TODO: fix graphDeleteNode bug - deleting wrong value and deleting two nodes!
 bool graphTestDeleteNode() {
     bool result = true;
     std::string directory = TESTING + "delete_node/";
@@ -192,7 +223,9 @@ bool graphTestDeleteNode() {
     result &= graphGetNumNodes(node_found) == 4;
 
 
-    Graph<int> node_not_found(directory + "node_found.txt", GRAPH_DIRECTED);
+    Graph<int> node_not_found(
+        directory + "node_not_found.txt", 
+        GRAPH_DIRECTED);
     result &= graphGetNumNodes(node_not_found) == 4;
     graphDeleteNode(node_not_found, 4);
     result &= graphGetNumNodes(node_not_found) == 4;
@@ -200,6 +233,35 @@ bool graphTestDeleteNode() {
     return result;
 }
 
+bool graphTestNodeIndex() {
+    bool result = true;
+
+    Graph<int> graph;
+    for (int i = 0; i < 100; i++) {graphAddNode(graph, i);}
+    result &= graph.node_index.size == 100;
+    result &= graphGetNode(graph, 57)->data.from == 57;
+    result &= graph.tail->data.from == 99;
+
+    graphDeleteNode(graph, 99);
+    result &= !graphHasNode(graph, 99);
+    result &= graph.tail->data.from == 98;
+    graphAddNode(graph, 100);
+    result &= linkedListGetTail(&graph.adjacency_matrix)->data.from == 100;
+    result &= graphGetNumNodes(graph) == 100;
+
+    Graph<int> copy(graph);
+    result &= graphGetNode(copy, 57) != graphGetNode(graph, 57);
+    result &= graphGetNode(copy, 57)->data.from == 57;
+    result &= copy.tail->data.from == 100;
+
+    Graph<int> assigned;
+    assigned = copy;
+    result &= graphGetNode(assigned, 3) != graphGetNode(copy, 3);
+    result &= graphGetNode(assigned, 3)->data.from == 3;
+
+    return result;
+}
+
 bool graphTestGetEdge() {
     bool result = true;
 
@@ -276,6 +338,98 @@ bool graphTestAddEdge() {
     return result;
 }
 
+bool graphTestUpdateEdge() {
+    bool result = true;
+
+    Graph<int> graph;
+    graphAddNode(graph, 1);
+    graphAddNode(graph, 2);
+    graphAddEdge(graph, Edge<int>(1, 2, 3));
+    graphUpdateEdge(graph, Edge<int>(1, 2, 5));
+    result &= graphGetEdge(graph, Edge<int>(1, 2))->data.weight == 5;
+
+    Edge<int> missing[2] = {Edge<int>(2, 1, 1), Edge<int>(3, 1, 1)};
+    for (int i = 0; i < 2; i++) {
+        try {
+            graphUpdateEdge(graph, missing[i]);
+            result &= false;
+        } catch (std::logic_error) {
+            result &= true;
+        } catch (...) {
+            result &= false;
+        }
+    }
+
+    return result;
+}
+
+bool graphTestDeleteEdge() {
+    bool result = true;
+
+    Graph<int> graph;
+    graphAddNode(graph, 1);
+    graphAddNode(graph, 2);
+    graphAddEdge(graph, Edge<int>(1, 2));
+    graphAddEdge(graph, Edge<int>(1, 1));
+    graphDeleteEdge(graph, Edge<int>(1, 2));
+    result &= !graphHasEdge(graph, Edge<int>(1, 2));
+    result &= graphHasEdge(graph, Edge<int>(1, 1));
+
+    // Missing edges and nodes are left alone
+    graphDeleteEdge(graph, Edge<int>(2, 1));
+    graphDeleteEdge(graph, Edge<int>(3, 1));
+    result &= graphHasEdge(graph, Edge<int>(1, 1));
+    graphAddEdge(graph, Edge<int>(1, 2));
+    result &= graphHasEdge(graph, Edge<int>(1, 2));
+
+    return result;
+}
+
+bool graphTestAddEdges() {
+    bool result = true;
+
+    Graph<char> graph;
+    graphAddNode(graph, 'a');
+    graphAddNode(graph, 'b');
+    graphAddEdge(graph, Edge<char>('a', 'b'));
+
+    DynamicArray<Edge<char>> missing_node;
+    dynamicArrayPushBack(missing_node, Edge<char>('b', 'a'));
+    dynamicArrayPushBack(missing_node, Edge<char>('c', 'a'));
+    DynamicArray<Edge<char>> existing_edge;
+    dynamicArrayPushBack(existing_edge, Edge<char>('a', 'b'));
+    DynamicArray<Edge<char>> repeated_edge;
+    dynamicArrayPushBack(repeated_edge, Edge<char>('b', 'a'));
+    dynamicArrayPushBack(repeated_edge, Edge<char>('b', 'a', 2));
+    DynamicArray<Edge<char>> invalid[3] = 
+        {missing_node, existing_edge, repeated_edge};
+    for (int i = 0; i < 3; i++) {
+        try {
+            graphAddEdges(graph, invalid[i]);
+            result &= false;
+        } catch (std::logic_error) {
+            result &= true;
+        } catch (...) {
+            result &= false;
+        }
+    }
+    result &= !graphGetNode(graph, 'b')->data.edges;
+
+    DynamicArray<Edge<char>> edges;
+    dynamicArrayPushBack(edges, Edge<char>('a', 'a', 3));
+    dynamicArrayPushBack(edges, Edge<char>('b', 'a', 2));
+    dynamicArrayPushBack(edges, Edge<char>('a', 'z'));
+    graphAddEdges(graph, edges);
+    LinkedList<Edge<char>>* a_edges = graphGetNode(graph, 'a')->data.edges;
+    result &= a_edges->data == Edge<char>('a', 'b');
+    result &= a_edges->next->data == Edge<char>('a', 'a', 3);
+    result &= a_edges->next->next->data == Edge<char>('a', 'z');
+    result &= graphGetNode(graph, 'b')->data.edges->data 
+        == Edge<char>('b', 'a', 2);
+
+    return result;
+}
+
 void graphTestRegisterTests(TestManager* test_manager) {
     TestGroup test_group("graph");
 
@@ -283,6 +437,8 @@ void graphTestRegisterTests(TestManager* test_manager) {
         graphTestDefaultConstructor));
     testGroupAddTest(&test_group, UnitTest("file path constructor", 
         graphTestFilePathConstructor));
+    testGroupAddTest(&test_group, UnitTest("file path constructor strings",
+        graphTestFilePathConstructorStrings));
     testGroupAddTest(&test_group, UnitTest("copy constructor", 
         graphTestCopyConstructor));
     testGroupAddTest(&test_group, UnitTest("assignment operator", 
@@ -296,9 +452,13 @@ void graphTestRegisterTests(TestManager* test_manager) {
     testGroupAddTest(&test_group, UnitTest("add node", graphTestAddNode));
     testGroupAddTest(&test_group, UnitTest("update node", graphTestUpdateNode));
     testGroupAddTest(&test_group, UnitTest("delete node", graphTestDeleteNode));
+    testGroupAddTest(&test_group, UnitTest("node index", graphTestNodeIndex));
     testGroupAddTest(&test_group, UnitTest("get edge", graphTestGetEdge));
     testGroupAddTest(&test_group, UnitTest("has edge", graphTestHasEdge));
     testGroupAddTest(&test_group, UnitTest("add edge", graphTestAddEdge));
+    testGroupAddTest(&test_group, UnitTest("add edges", graphTestAddEdges));
+    testGroupAddTest(&test_group, UnitTest("update edge", graphTestUpdateEdge));
+    testGroupAddTest(&test_group, UnitTest("delete edge", graphTestDeleteEdge));
 
     testManagerAddTestGroup(test_manager, test_group);
 }
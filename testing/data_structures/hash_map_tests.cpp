@@ -0,0 +1,139 @@
+#include "hash_map_tests.hpp"
+#include <string>
+#include <data_structures/hash_map.cpp>
+
+/**
+ * @brief Hash functor that sends every key to the same bucket,
+ * so the tests can exercise collisions.
+ */
+struct HashMapTestCollidingHash {
+    size_t operator () (int key) const {return 0;}
+};
+
+bool hashMapTestDefaultConstructor() {
+    bool result = true;
+
+    HashMap<int, int> empty;
+    result &= !empty.buckets;
+    result &= empty.num_buckets == 0;
+    result &= empty.size == 0;
+
+    return result;
+}
+
+bool hashMapTestCopyConstructor() {
+    bool result = true;
+
+    HashMap<std::string, int> original;
+    hashMapInsert(original, std::string("one"), 1);
+    hashMapInsert(original, std::string("two"), 2);
+    HashMap<std::string, int> copy(original);
+    result &= copy.size == 2;
+    result &= *hashMapGet(copy, std::string("two")) == 2;
+    result &= hashMapGet(copy, std::string("two"))
+        != hashMapGet(original, std::string("two"));
+
+    return result;
+}
+
+bool hashMapTestAssignmentOperator() {
+    bool result = true;
+
+    HashMap<int, char> original;
+    hashMapInsert(original, 4, 'a');
+    HashMap<int, char> assigned;
+    assigned = original;
+    result &= assigned.size == 1;
+    result &= *hashMapGet(assigned, 4) == 'a';
+    result &= hashMapGet(assigned, 4) != hashMapGet(original, 4);
+
+    return result;
+}
+
+bool hashMapTestGet() {
+    bool result = true;
+
+    HashMap<int, int> empty;
+    result &= !hashMapGet(empty, 4);
+
+    HashMap<int, int> map;
+    hashMapInsert(map, 4, 16);
+    result &= *hashMapGet(map, 4) == 16;
+    result &= !hashMapGet(map, 5);
+    *hashMapGet(map, 4) = 17;
+    result &= *hashMapGet(map, 4) == 17;
+
+    return result;
+}
+
+bool hashMapTestHas() {
+    bool result = true;
+
+    HashMap<char, int> map;
+    result &= !hashMapHas(map, 'a');
+    hashMapInsert(map, 'a', 1);
+    result &= hashMapHas(map, 'a');
+
+    return result;
+}
+
+bool hashMapTestInsert() {
+    bool result = true;
+
+    HashMap<int, int> replace;
+    hashMapInsert(replace, 1, 1);
+    hashMapInsert(replace, 1, 2);
+    result &= replace.size == 1;
+    result &= *hashMapGet(replace, 1) == 2;
+
+    HashMap<int, int> rehash;
+    for (int i = 0; i < 1000; i++) {hashMapInsert(rehash, i, i * i);}
+    result &= rehash.size == 1000;
+    result &= rehash.num_buckets >= 1000;
+    for (int i = 0; i < 1000; i++) {result &= *hashMapGet(rehash, i) == i * i;}
+
+    HashMap<int, int, HashMapTestCollidingHash> colliding;
+    for (int i = 0; i < 20; i++) {hashMapInsert(colliding, i, -i);}
+    for (int i = 0; i < 20; i++) {result &= *hashMapGet(colliding, i) == -i;}
+
+    return result;
+}
+
+bool hashMapTestDelete() {
+    bool result = true;
+
+    HashMap<int, int> empty;
+    hashMapDelete(empty, 3);
+    result &= empty.size == 0;
+
+    HashMap<int, int, HashMapTestCollidingHash> map;
+    hashMapInsert(map, 1, 10);
+    hashMapInsert(map, 2, 20);
+    hashMapInsert(map, 3, 30);
+    hashMapDelete(map, 2);
+    result &= map.size == 2;
+    result &= !hashMapHas(map, 2);
+    result &= *hashMapGet(map, 1) == 10;
+    result &= *hashMapGet(map, 3) == 30;
+    hashMapDelete(map, 2);
+    result &= map.size == 2;
+
+    return result;
+}
+
+void hashMapTestRegisterTests(TestManager* test_manager) {
+    TestGroup test_group("hash map");
+
+    testGroupAddTest(&test_group, UnitTest("default constructor",
+        hashMapTestDefaultConstructor));
+    testGroupAddTest(&test_group, UnitTest("copy constructor",
+        hashMapTestCopyConstructor));
+    testGroupAddTest(&test_group, UnitTest("assignment operator",
+        hashMapTestAssignmentOperator));
+    testGroupAddTest(&test_group, UnitTest("get", hashMapTestGet));
+    testGroupAddTest(&test_group, UnitTest("has", hashMapTestHas));
+    testGroupAddTest(&test_group, UnitTest("insert", hashMapTestInsert));
+    testGroupAddTest(&test_group, UnitTest("delete", hashMapTestDelete));
+
+    testManagerAddTestGroup(test_manager, test_group);
+}
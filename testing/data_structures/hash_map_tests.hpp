@@ -0,0 +1,8 @@
+#ifndef HASH_MAP_TESTS_HPP
+#define HASH_MAP_TESTS_HPP
+
+#include "test_utils/test_manager.hpp"
+
+void hashMapTestRegisterTests(TestManager* test_manager);
+
+#endif
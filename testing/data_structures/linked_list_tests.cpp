@@ -309,9 +309,19 @@ bool linkedListTestDeleteNthOccurrence() {
     linkedListInsertAtTail(&delete_after_head, 7);
     linkedListInsertAtTail(&delete_after_head, 8);
     linkedListDeleteNthOccurrence(&delete_after_head, 7, 1);
+    result &= (delete_after_head->data == 4);
     result &= (delete_after_head->next->data == 8);
+    result &= (linkedListGetLength(delete_after_head) == 2);
     delete delete_after_head;
 
+    LinkedList<int>* delete_tail = new LinkedList<int>(1);
+    linkedListInsertAtTail(&delete_tail, 2);
+    linkedListInsertAtTail(&delete_tail, 3);
+    linkedListDeleteNthOccurrence(&delete_tail, 3, 1);
+    result &= (delete_tail->data == 1);
+    result &= (linkedListGetTail(&delete_tail)->data == 2);
+    delete delete_tail;
+
     return result;
 }
 
@@ -365,6 +375,28 @@ bool linkedListTestGetSuccessorOfNthOccurrence() {
     return result;
 }
 
+bool linkedListTestLongList() {
+    bool result = true;
+
+    // Long enough that recursive copies or deletes would blow the stack
+    const int length = 1000000;
+    LinkedList<int>* list = nullptr;
+    for (int i = length - 1; i >= 0; i--) {
+        list = new LinkedList<int>(i, list);
+    }
+
+    LinkedList<int>* copy = new LinkedList<int>(*list);
+    result &= *copy == *list;
+    result &= linkedListGetLength(copy) == length;
+    linkedListGetTail(&copy)->data = -1;
+    result &= *copy != *list;
+
+    delete list;
+    delete copy;
+
+    return result;
+}
+
 void linkedListTestRegisterTests(TestManager* test_manager) {
     TestGroup test_group("linked list");
     testGroupAddTest(&test_group, UnitTest("default constructor",
@@ -401,5 +433,7 @@ void linkedListTestRegisterTests(TestManager* test_manager) {
         linkedListTestGetPredecessorOfNthOccurrence));
     testGroupAddTest(&test_group, UnitTest("get successor of nth occurrence",
         linkedListTestGetSuccessorOfNthOccurrence));
+    testGroupAddTest(&test_group, UnitTest("long list",
+        linkedListTestLongList));
     testManagerAddTestGroup(test_manager, test_group);
 }
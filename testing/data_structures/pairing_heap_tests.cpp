@@ -0,0 +1,61 @@
+#include "pairing_heap_tests.hpp"
+#include <data_structures/pairing_heap.cpp>
+
+bool pairingHeapTestPush() {
+    bool result = true;
+
+    PairingHeap<char> heap;
+    result &= priorityQueueEmpty(heap);
+    priorityQueuePush(heap, 3.5, 'c');
+    priorityQueuePush(heap, 1.5, 'a');
+    priorityQueuePush(heap, 2.5, 'b');
+    result &= priorityQueueGetSize(heap) == 3;
+    result &= priorityQueueTop(heap).value == 'a';
+    result &= heap.nodes[heap.root].child != -1;
+
+    return result;
+}
+
+bool pairingHeapTestPop() {
+    bool result = true;
+
+    PairingHeap<int> empty;
+    try {
+        priorityQueuePop(empty);
+        result &= false;
+    } catch (std::logic_error) {
+        result &= true;
+    } catch (...) {
+        result &= false;
+    }
+
+    PairingHeap<int> heap;
+    for (int i = 0; i < 1000; i++) {
+        int key = i * 389 % 1000;
+        priorityQueuePush(heap, key, key);
+    }
+    for (int i = 0; i < 500; i++) {
+        result &= priorityQueueTop(heap).value == i;
+        priorityQueuePop(heap);
+    }
+
+    // Popped nodes are reused rather than growing the pool
+    for (int i = 0; i < 500; i++) {priorityQueuePush(heap, i, i);}
+    result &= heap.nodes.size == 1000;
+    for (int i = 0; i < 1000; i++) {
+        result &= priorityQueueTop(heap).value == i;
+        priorityQueuePop(heap);
+    }
+    result &= priorityQueueEmpty(heap);
+
+    return result;
+}
+
+void pairingHeapTestRegisterTests(TestManager* test_manager) {
+    TestGroup test_group("pairing heap");
+
+    testGroupAddTest(&test_group, UnitTest("push", pairingHeapTestPush));
+    testGroupAddTest(&test_group, UnitTest("pop", pairingHeapTestPop));
+
+    testManagerAddTestGroup(test_manager, test_group);
+}
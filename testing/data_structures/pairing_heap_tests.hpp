@@ -0,0 +1,8 @@
+#ifndef PAIRING_HEAP_TESTS_HPP
+#define PAIRING_HEAP_TESTS_HPP
+
+#include "test_utils/test_manager.hpp"
+
+void pairingHeapTestRegisterTests(TestManager* test_manager);
+
+#endif
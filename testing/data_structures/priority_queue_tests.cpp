@@ -0,0 +1,64 @@
+#include "priority_queue_tests.hpp"
+#include <data_structures/priority_queue.cpp>
+
+bool priorityQueueTestPush() {
+    bool result = true;
+
+    BinaryHeap<char> heap;
+    result &= priorityQueueEmpty(heap);
+    priorityQueuePush(heap, 3.5, 'c');
+    priorityQueuePush(heap, 1.5, 'a');
+    priorityQueuePush(heap, 2.5, 'b');
+    result &= priorityQueueGetSize(heap) == 3;
+    result &= priorityQueueTop(heap).value == 'a';
+    result &= priorityQueueTop(heap).key == 1.5;
+
+    return result;
+}
+
+bool priorityQueueTestPop() {
+    bool result = true;
+
+    QuaternaryHeap<int> empty;
+    try {
+        priorityQueuePop(empty);
+        result &= false;
+    } catch (std::logic_error) {
+        result &= true;
+    } catch (...) {
+        result &= false;
+    }
+
+    // Keys are a permutation of 0 to 999, so they should come out in order
+    BinaryHeap<int> binary;
+    QuaternaryHeap<int> quaternary;
+    DaryHeap<int, 3> ternary;
+    for (int i = 0; i < 1000; i++) {
+        int key = i * 389 % 1000;
+        priorityQueuePush(binary, key, key);
+        priorityQueuePush(quaternary, key, key);
+        priorityQueuePush(ternary, key, key);
+    }
+    for (int i = 0; i < 1000; i++) {
+        result &= priorityQueueTop(binary).value == i;
+        result &= priorityQueueTop(quaternary).value == i;
+        result &= priorityQueueTop(ternary).value == i;
+        priorityQueuePop(binary);
+        priorityQueuePop(quaternary);
+        priorityQueuePop(ternary);
+    }
+    result &= priorityQueueEmpty(binary);
+    result &= priorityQueueEmpty(quaternary);
+    result &= priorityQueueEmpty(ternary);
+
+    return result;
+}
+
+void priorityQueueTestRegisterTests(TestManager* test_manager) {
+    TestGroup test_group("priority queue");
+
+    testGroupAddTest(&test_group, UnitTest("push", priorityQueueTestPush));
+    testGroupAddTest(&test_group, UnitTest("pop", priorityQueueTestPop));
+
+    testManagerAddTestGroup(test_manager, test_group);
+}
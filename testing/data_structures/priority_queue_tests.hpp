@@ -0,0 +1,8 @@
+#ifndef PRIORITY_QUEUE_TESTS_HPP
+#define PRIORITY_QUEUE_TESTS_HPP
+
+#include "test_utils/test_manager.hpp"
+
+void priorityQueueTestRegisterTests(TestManager* test_manager);
+
+#endif
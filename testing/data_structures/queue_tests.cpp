@@ -1,12 +1,13 @@
 #include "queue_tests.hpp"
+#include <memory>
 #include <data_structures/queue.cpp>
 
 bool queueTestDefaultConstructor() {
     bool result = true;
 
     Queue<int> queue;
-    result &= !queue.head;
-    result &= !queue.tail;
+    result &= !queue.data;
+    result &= queue.size == 0;
 
     return result;
 }
@@ -15,8 +16,8 @@ bool queueTestDataConstructor() {
     bool result = true;
 
     Queue<int> queue(4);
-    result &= queue.head->data == 4;
-    result &= queue.head == queue.tail;
+    result &= queueFront(queue) == 4;
+    result &= queueLength(queue) == 1;
 
     return result;
 }
@@ -24,15 +25,21 @@ bool queueTestDataConstructor() {
 bool queueTestCopyConstructor() {
     bool result = true;
 
+    // Wrap around the end of the buffer first
     Queue<int> queue(4);
-    linkedListInsertAtTail(&queue.head, 5);
-    linkedListInsertAtTail(&queue.head, 6);
-    queue.tail = queue.head->next->next;
+    queuePush(queue, 5);
+    queuePush(queue, 6);
+    queuePush(queue, 7);
+    queuePop(queue);
+    queuePop(queue);
+    queuePush(queue, 8);
+    queuePush(queue, 9);
+    result &= queue.head + queue.size > queue.capacity;
+
     Queue<int> copy(queue);
-    result &= copy.head->data == queue.head->data;
-    result &= copy.head != queue.head;
-    result &= copy.tail->data == queue.tail->data;
-    result &= copy.tail != queue.tail;
+    result &= copy == queue;
+    result &= copy.data != queue.data;
+    result &= queueFront(copy) == 6 && queueLength(copy) == 4;
 
     return result;
 }
@@ -41,13 +48,13 @@ bool queueTestAssignmentOperator() {
     bool result = true;
 
     Queue<int> original(4);
-    linkedListInsertAtTail(&original.head, 2);
-    original.tail = original.head->next;
-    Queue<int> assigned = original;
-    result &= assigned.head->data == original.head->data;
-    result &= assigned.head != original.head;
-    result &= assigned.tail->data == original.tail->data;
-    result &= assigned.tail != original.tail;
+    queuePush(original, 2);
+    Queue<int> assigned(7);
+    assigned = original;
+    result &= assigned == original;
+    result &= assigned.data != original.data;
+    queuePop(assigned);
+    result &= queueFront(original) == 4;
 
     return result;
 }
@@ -56,21 +63,29 @@ bool queueTestEqualityOperator() {
     bool result = true;
 
     Queue<int> different_head_lhs(4);
-    linkedListInsertAtTail(&different_head_lhs.head, 2);
+    queuePush(different_head_lhs, 2);
     Queue<int> different_head_rhs(2);
-    linkedListInsertAtTail(&different_head_rhs.head, 2);
+    queuePush(different_head_rhs, 2);
     result &= !(different_head_lhs == different_head_rhs);
 
     Queue<int> different_tail_lhs(4);
-    linkedListInsertAtTail(&different_tail_lhs.tail, 2);
+    queuePush(different_tail_lhs, 2);
     Queue<int> different_tail_rhs(4);
-    linkedListInsertAtTail(&different_tail_rhs.tail, 3);
+    queuePush(different_tail_rhs, 3);
     result &= !(different_tail_lhs == different_tail_rhs);
 
+    Queue<int> different_length_lhs(4);
+    Queue<int> different_length_rhs(4);
+    queuePush(different_length_rhs, 3);
+    result &= different_length_lhs != different_length_rhs;
+
+    // Equal contents at different places in the buffer
     Queue<int> equals_lhs(4);
-    linkedListInsertAtTail(&equals_lhs.tail, 2);
-    Queue<int> equals_rhs(4);
-    linkedListInsertAtTail(&equals_rhs.tail, 2);
+    queuePush(equals_lhs, 2);
+    Queue<int> equals_rhs(1);
+    queuePush(equals_rhs, 4);
+    queuePush(equals_rhs, 2);
+    queuePop(equals_rhs);
     result &= equals_lhs == equals_rhs;
 
     return result;
@@ -98,9 +113,8 @@ bool queueTestLength() {
     result &= queueLength(one_element) == 1;
 
     Queue<int> many_elements(4);
-    linkedListInsertAtTail(&many_elements.head, 2);
-    linkedListInsertAtTail(&many_elements.head, 3);
-    many_elements.tail = linkedListGetTail(&many_elements.head);
+    queuePush(many_elements, 2);
+    queuePush(many_elements, 3);
     result &= queueLength(many_elements) == 3;
 
     return result;
@@ -113,12 +127,69 @@ bool queueTestPush() {
     queuePush(empty, 'h');
     result &= queueFront(empty) == 'h';
     result &= queueLength(empty) == 1;
-    result &= empty.tail->data == 'h';
 
     Queue<int> not_empty(4);
     queuePush(not_empty, 1);
     result &= queueLength(not_empty) == 2;
-    result &= not_empty.tail->data == 1;
+    result &= queueGet(not_empty, 1) == 1;
+
+    // Growing keeps the order even when the buffer has wrapped
+    Queue<int> growing;
+    for (int i = 0; i < 3; i++) {queuePush(growing, i);}
+    queuePop(growing);
+    for (int i = 3; i < 100; i++) {queuePush(growing, i);}
+    for (int i = 1; i < 100; i++) {
+        result &= queueFront(growing) == i;
+        queuePop(growing);
+    }
+    result &= queueEmpty(growing);
+
+    // Move-only types are moved in
+    Queue<std::unique_ptr<int>> pointers;
+    queuePush(pointers, std::unique_ptr<int>(new int(3)));
+    result &= *queueFront(pointers) == 3;
+
+    return result;
+}
+
+bool queueTestPushN() {
+    bool result = true;
+
+    const int data[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    Queue<int> queue;
+    queuePushN(queue, data, 0);
+    result &= queueEmpty(queue);
+
+    // The second batch wraps around the end of the buffer
+    queuePushN(queue, data, 6);
+    int popped[10];
+    result &= queuePopN(queue, popped, 4) == 4;
+    queuePushN(queue, data + 6, 4);
+    result &= queue.capacity == 8 && queueLength(queue) == 6;
+    for (int i = 4; i < 10; i++) {
+        result &= queueFront(queue) == i;
+        queuePop(queue);
+    }
+
+    return result;
+}
+
+bool queueTestPopN() {
+    bool result = true;
+
+    const int data[5] = {3, 1, 4, 1, 5};
+    Queue<int> queue;
+    queuePushN(queue, data, 5);
+
+    int popped[5];
+    result &= queuePopN(queue, popped, 2) == 2;
+    result &= popped[0] == 3 && popped[1] == 1;
+
+    // Asking for more than are left pops the rest
+    result &= queuePopN(queue, popped, 5) == 3;
+    result &= popped[0] == 4 && popped[1] == 1 && popped[2] == 5;
+    result &= queueEmpty(queue);
+    result &= queuePopN(queue, popped, 5) == 0;
 
     return result;
 }
@@ -129,6 +200,7 @@ bool queueTestFront() {
     Queue<int> empty;
     try {
         queueFront(empty);
+        result &= false;
     } catch (std::logic_error) {
         result &= true;
     } catch (...) {
@@ -136,9 +208,8 @@ bool queueTestFront() {
     }
 
     Queue<char> many_characters('a');
-    linkedListInsertAtTail(&many_characters.head, '2');
-    linkedListInsertAtTail(&many_characters.head, 'f');
-    many_characters.tail = linkedListGetTail(&many_characters.head);
+    queuePush(many_characters, '2');
+    queuePush(many_characters, 'f');
     result &= queueFront(many_characters) == 'a';
 
     return result;
@@ -150,6 +221,7 @@ bool queueTestPop() {
     Queue<int> empty;
     try {
         queuePop(empty);
+        result &= false;
     } catch (std::logic_error) {
         result &= true;
     } catch (...) {
@@ -179,6 +251,8 @@ void queueTestRegisterTests(TestManager* test_manager) {
     testGroupAddTest(&test_group, UnitTest("empty", queueTestEmpty));
     testGroupAddTest(&test_group, UnitTest("length", queueTestLength));
     testGroupAddTest(&test_group, UnitTest("push", queueTestPush));
+    testGroupAddTest(&test_group, UnitTest("push n", queueTestPushN));
+    testGroupAddTest(&test_group, UnitTest("pop n", queueTestPopN));
     testGroupAddTest(&test_group, UnitTest("front", queueTestFront));
     testGroupAddTest(&test_group, UnitTest("pop", queueTestPop));
 
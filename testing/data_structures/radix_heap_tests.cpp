@@ -0,0 +1,89 @@
+#include "radix_heap_tests.hpp"
+#include <data_structures/radix_heap.cpp>
+
+bool radixHeapTestGetBucket() {
+    bool result = true;
+
+    result &= radixHeapGetBucket(5, 5) == 0;
+    result &= radixHeapGetBucket(1, 0) == 1;
+    result &= radixHeapGetBucket(6, 4) == 2;
+    result &= radixHeapGetBucket(uint64_t(1) << 63, 0) == 64;
+    result &= radixHeapGetBits(1.0) < radixHeapGetBits(1.5);
+    result &= radixHeapGetBits(0.25) < radixHeapGetBits(1e10);
+
+    return result;
+}
+
+bool radixHeapTestPush() {
+    bool result = true;
+
+    RadixHeap<char> heap;
+    result &= priorityQueueEmpty(heap);
+    priorityQueuePush(heap, 3.5, 'c');
+    priorityQueuePush(heap, 0.5, 'a');
+    priorityQueuePush(heap, 2.5, 'b');
+    result &= priorityQueueGetSize(heap) == 3;
+    result &= priorityQueueTop(heap).value == 'a';
+    priorityQueuePop(heap);
+
+    // Keys can't go below the last popped key
+    const double invalid[2] = {0.25, -1};
+    for (int i = 0; i < 2; i++) {
+        try {
+            priorityQueuePush(heap, invalid[i], 'z');
+            result &= false;
+        } catch (std::logic_error) {
+            result &= true;
+        } catch (...) {
+            result &= false;
+        }
+    }
+    priorityQueuePush(heap, 0.5, 'd');
+    result &= priorityQueueTop(heap).value == 'd';
+
+    return result;
+}
+
+bool radixHeapTestPop() {
+    bool result = true;
+
+    RadixHeap<int> empty;
+    try {
+        priorityQueuePop(empty);
+        result &= false;
+    } catch (std::logic_error) {
+        result &= true;
+    } catch (...) {
+        result &= false;
+    }
+
+    RadixHeap<int> heap;
+    for (int i = 0; i < 1000; i++) {
+        int key = i * 389 % 1000;
+        priorityQueuePush(heap, key / 8.0, key);
+    }
+    for (int i = 0; i < 1000; i++) {
+        result &= priorityQueueTop(heap).value == i;
+        priorityQueuePop(heap);
+        // Monotone pushes in between pops are allowed
+        if (i % 10 == 0) {priorityQueuePush(heap, 1000 + i, 1000 + i);}
+    }
+    for (int i = 0; i < 100; i++) {
+        result &= priorityQueueTop(heap).value == 1000 + 10 * i;
+        priorityQueuePop(heap);
+    }
+    result &= priorityQueueEmpty(heap);
+
+    return result;
+}
+
+void radixHeapTestRegisterTests(TestManager* test_manager) {
+    TestGroup test_group("radix heap");
+
+    testGroupAddTest(&test_group, UnitTest("get bucket",
+        radixHeapTestGetBucket));
+    testGroupAddTest(&test_group, UnitTest("push", radixHeapTestPush));
+    testGroupAddTest(&test_group, UnitTest("pop", radixHeapTestPop));
+
+    testManagerAddTestGroup(test_manager, test_group);
+}
@@ -0,0 +1,8 @@
+#ifndef RADIX_HEAP_TESTS_HPP
+#define RADIX_HEAP_TESTS_HPP
+
+#include "test_utils/test_manager.hpp"
+
+void radixHeapTestRegisterTests(TestManager* test_manager);
+
+#endif
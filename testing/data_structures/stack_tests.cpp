@@ -1,11 +1,14 @@
 #include "stack_tests.hpp"
+#include <memory>
+#include <string>
+#include <utility>
 #include <data_structures/stack.cpp>
 
 bool stackTestEmptyConstructor() {
     bool result = true;
     
     Stack<int> empty;
-    result &= !empty.top;
+    result &= empty.elements.size == 0;
 
     return result;
 }
@@ -14,7 +17,7 @@ bool stackTestDataConstructor() {
     bool result = true;
 
     Stack<int> data(4);
-    result &= data.top->data == 4;
+    result &= stackSize(data) == 1 && stackTop(data) == 4;
 
     return result;
 }
@@ -24,8 +27,8 @@ bool stackTestCopyConstructor() {
 
     Stack<int> original(4);
     Stack<int> copy(original);
-    result &= *copy.top == *original.top;
-    result &= copy.top != original.top;
+    result &= copy == original;
+    result &= copy.elements.data != original.elements.data;
 
     return result;
 }
@@ -34,8 +37,11 @@ bool stackTestAssignmentOperator() {
     bool result = true;
 
     Stack<int> original(4);
-    Stack<int> copy = original;
-    result &= *copy.top == *original.top;
+    Stack<int> copy;
+    copy = original;
+    result &= copy == original;
+    stackPush(copy, 5);
+    result &= copy != original;
 
     return result;
 }
@@ -83,11 +89,21 @@ bool stackTestPush() {
 
     Stack<int> empty;
     stackPush(empty, 4);
-    result &= empty.top->data == 4;
+    result &= stackTop(empty) == 4;
 
     Stack<int> not_empty(3);
     stackPush(not_empty, 5);
-    result &= not_empty.top->data == 5;
+    result &= stackTop(not_empty) == 5;
+
+    // Pushes stay cheap for big stacks
+    Stack<int> big;
+    for (int i = 0; i < 1000000; i++) {stackPush(big, i);}
+    result &= stackSize(big) == 1000000 && stackTop(big) == 999999;
+
+    // Move-only types are moved in
+    Stack<std::unique_ptr<int>> pointers;
+    stackPush(pointers, std::unique_ptr<int>(new int(7)));
+    result &= *stackTop(pointers) == 7;
 
     return result;
 }
@@ -140,6 +156,20 @@ bool stackTestPop() {
     return result;
 }
 
+bool stackTestEmplace() {
+    bool result = true;
+
+    Stack<std::pair<int, std::string>> pairs;
+    std::pair<int, std::string>& top = stackEmplace(pairs, 3, "three");
+    result &= top.first == 3 && top.second == "three";
+    stackEmplace(pairs, 4, "four");
+    result &= stackTop(pairs).second == "four";
+    stackPop(pairs);
+    result &= stackTop(pairs).first == 3;
+
+    return result;
+}
+
 void stackTestRegisterTests(TestManager* test_manager) {
     TestGroup test_group("stack");
 
@@ -158,6 +188,7 @@ void stackTestRegisterTests(TestManager* test_manager) {
     testGroupAddTest(&test_group, UnitTest("push", stackTestPush));
     testGroupAddTest(&test_group, UnitTest("top", stackTestTop));
     testGroupAddTest(&test_group, UnitTest("pop", stackTestPop));
+    testGroupAddTest(&test_group, UnitTest("emplace", stackTestEmplace));
     
 
     testManagerAddTestGroup(test_manager, test_group);
@@ -0,0 +1,79 @@
+#include "vertex_id_map_tests.hpp"
+#include <string>
+#include <data_structures/vertex_id_map.cpp>
+
+bool vertexIdMapTestAdd() {
+    bool result = true;
+
+    VertexIdMap<std::string> map;
+    result &= vertexIdMapGetSize(map) == 0;
+    result &= vertexIdMapAdd(map, std::string("b")) == 0;
+    result &= vertexIdMapAdd(map, std::string("a")) == 1;
+    result &= vertexIdMapAdd(map, std::string("b")) == 0;
+    result &= vertexIdMapGetSize(map) == 2;
+
+    uint32_t id = 7;
+    result &= vertexIdMapGetId(map, std::string("a"), &id) && id == 1;
+    result &= !vertexIdMapGetId(map, std::string("c"), &id);
+    result &= vertexIdMapGetValue(map, 0u) == "b";
+
+    try {
+        vertexIdMapGetValue(map, 2u);
+        result &= false;
+    } catch (std::logic_error) {
+        result &= true;
+    } catch (...) {
+        result &= false;
+    }
+
+    return result;
+}
+
+bool vertexIdMapTestRemapEdges() {
+    bool result = true;
+
+    // Enough edges that the ids are assigned in parallel
+    const int NUM_EDGES = 50000;
+    DynamicArray<Edge<long long>> edges(NUM_EDGES);
+    for (int i = 0; i < NUM_EDGES; i++) {
+        long long from = (i * 7919LL) % 3001 * 1000000007LL;
+        long long to = (i * 104729LL) % 2999 * 1000000007LL;
+        dynamicArrayPushBack(edges, Edge<long long>(from, to, i));
+    }
+
+    ThreadPool pool(4);
+    VertexIdMap<long long> map;
+    vertexIdMapAdd(map, 5LL);
+    DynamicArray<Edge<uint32_t>> remapped;
+    vertexIdMapRemapEdges(map, edges, remapped, pool);
+
+    // Same ids as adding the endpoints one by one
+    VertexIdMap<long long> expected;
+    vertexIdMapAdd(expected, 5LL);
+    result &= remapped.size == NUM_EDGES;
+    for (int i = 0; i < NUM_EDGES; i++) {
+        result &= remapped[i].from == vertexIdMapAdd(expected, edges[i].from);
+        result &= remapped[i].to == vertexIdMapAdd(expected, edges[i].to);
+        result &= remapped[i].weight == i;
+        result &= vertexIdMapGetValue(map, remapped[i].to) == edges[i].to;
+    }
+    result &= vertexIdMapGetSize(map) == vertexIdMapGetSize(expected);
+    for (size_t i = 0; i < vertexIdMapGetSize(map); i++) {
+        result &= map.values[i] == expected.values[i];
+    }
+
+    // Each edge is 16 bytes instead of 24
+    result &= sizeof(remapped[0]) < sizeof(edges[0]);
+
+    return result;
+}
+
+void vertexIdMapTestRegisterTests(TestManager* test_manager) {
+    TestGroup test_group("vertex id map");
+
+    testGroupAddTest(&test_group, UnitTest("add", vertexIdMapTestAdd));
+    testGroupAddTest(&test_group, UnitTest("remap edges",
+        vertexIdMapTestRemapEdges));
+
+    testManagerAddTestGroup(test_manager, test_group);
+}
@@ -0,0 +1,8 @@
+#ifndef VERTEX_ID_MAP_TESTS_HPP
+#define VERTEX_ID_MAP_TESTS_HPP
+
+#include "test_utils/test_manager.hpp"
+
+void vertexIdMapTestRegisterTests(TestManager* test_manager);
+
+#endif
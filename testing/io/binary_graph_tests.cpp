@@ -0,0 +1,175 @@
+#include "binary_graph_tests.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <io/binary_graph.cpp>
+
+const std::string TESTING = "../resources/testing/";
+
+bool binaryGraphTestLayout() {
+    bool result = true;
+
+    BinaryGraphHeader header = binaryGraphLayout<int>(10, 8);
+    result &= header.nodes_offset % BINARY_GRAPH_ALIGNMENT == 0;
+    result &= header.offsets_offset % BINARY_GRAPH_ALIGNMENT == 0;
+    result &= header.targets_offset % BINARY_GRAPH_ALIGNMENT == 0;
+    result &= header.weights_offset % BINARY_GRAPH_ALIGNMENT == 0;
+    result &= header.offsets_offset >= header.nodes_offset + 10 * sizeof(int);
+    result &= header.file_size == header.weights_offset + 8 * sizeof(double);
+
+    return result;
+}
+
+bool binaryGraphTestWriteAndOpen() {
+    bool result = true;
+
+    std::string path = TESTING + "binary_graph.bin";
+    CsrGraph<int> original(
+        TESTING + "file_path_constructor.txt",
+        GRAPH_UNDIRECTED);
+    binaryGraphWrite(original, path);
+    {
+        MappedCsrGraph<int> mapped(path);
+        result &= mapped.graph == original;
+        result &= !mapped.graph.owns_memory;
+        result &= csrGraphHasEdge(mapped.graph, 5, 3);
+        result &= csrGraphGetDegree(mapped.graph, 0) == 0;
+
+        CsrGraph<int> copy(mapped.graph);
+        result &= copy.owns_memory;
+        result &= copy == original;
+    }
+
+    Graph<char> letters;
+    graphAddNode(letters, 'a');
+    graphAddNode(letters, 'b');
+    graphAddEdge(letters, Edge<char>('b', 'a', 0.5));
+    CsrGraph<char> small(letters);
+    binaryGraphWrite(small, path);
+    {
+        MappedCsrGraph<char> mapped(path);
+        result &= mapped.graph == small;
+        result &= csrGraphGetIndex(mapped.graph, 'b') == 1;
+    }
+
+    CsrGraph<int> empty;
+    binaryGraphWrite(empty, path);
+    {
+        MappedCsrGraph<int> mapped(path);
+        result &= csrGraphGetNumNodes(mapped.graph) == 0;
+        result &= csrGraphGetNumEdges(mapped.graph) == 0;
+    }
+
+    std::remove(path.c_str());
+    return result;
+}
+
+bool binaryGraphTestOpenInvalid() {
+    bool result = true;
+
+    std::string path = TESTING + "binary_graph.bin";
+    binaryGraphWrite(CsrGraph<int>(
+        TESTING + "file_path_constructor.txt",
+        GRAPH_DIRECTED), path);
+    std::ifstream input(path, std::ios::binary);
+    std::string bytes(
+        (std::istreambuf_iterator<char>(input)),
+        std::istreambuf_iterator<char>());
+    input.close();
+
+    // A text graph, the wrong node type, a truncated file, a bad count and
+    // offsets that don't start at 0 or end at the number of edges
+    BinaryGraphHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    std::string truncated = bytes.substr(0, bytes.size() - 1);
+    std::string bad_count = bytes;
+    bad_count[offsetof(BinaryGraphHeader, num_edges)]++;
+    std::string bad_first = bytes;
+    bad_first[header.offsets_offset]++;
+    std::string bad_last = bytes;
+    bad_last[header.offsets_offset + header.num_nodes * sizeof(size_t)]++;
+    std::string corrupt[4] = {truncated, bad_count, bad_first, bad_last};
+
+    try {
+        MappedCsrGraph<int> text(TESTING + "file_path_constructor.txt");
+        result &= false;
+    } catch (std::logic_error) {
+        result &= true;
+    } catch (...) {
+        result &= false;
+    }
+    try {
+        MappedCsrGraph<double> wrong_type(path);
+        result &= false;
+    } catch (std::logic_error) {
+        result &= true;
+    } catch (...) {
+        result &= false;
+    }
+    for (int i = 0; i < 4; i++) {
+        std::ofstream(path, std::ios::binary) << corrupt[i];
+        try {
+            MappedCsrGraph<int> invalid(path);
+            result &= false;
+        } catch (std::logic_error) {
+            result &= true;
+        } catch (...) {
+            result &= false;
+        }
+    }
+
+    // Offsets out of order and targets past the last node are only found
+    // by the full check
+    const size_t offset = 7;
+    std::string unordered = bytes;
+    std::memcpy(
+        &unordered[header.offsets_offset + 5 * sizeof(size_t)],
+        &offset,
+        sizeof(offset));
+    const int target = 10;
+    std::string bad_target = bytes;
+    std::memcpy(
+        &bad_target[header.targets_offset + 7 * sizeof(int)],
+        &target,
+        sizeof(target));
+    std::string unchecked[2] = {unordered, bad_target};
+    for (int i = 0; i < 2; i++) {
+        std::ofstream(path, std::ios::binary) << unchecked[i];
+        {
+            MappedCsrGraph<int> opened(path);
+            result &= csrGraphGetNumEdges(opened.graph) == 8;
+        }
+        try {
+            MappedCsrGraph<int> invalid(path, BINARY_GRAPH_CHECK_ALL);
+            result &= false;
+        } catch (std::logic_error) {
+            result &= true;
+        } catch (...) {
+            result &= false;
+        }
+    }
+    binaryGraphWrite(CsrGraph<int>(
+        TESTING + "file_path_constructor.txt",
+        GRAPH_DIRECTED), path);
+    {
+        MappedCsrGraph<int> valid(path, BINARY_GRAPH_CHECK_ALL);
+        result &= csrGraphGetNumNodes(valid.graph) == 10;
+    }
+
+    std::remove(path.c_str());
+    return result;
+}
+
+void binaryGraphTestRegisterTests(TestManager* test_manager) {
+    TestGroup test_group("binary graph");
+
+    testGroupAddTest(&test_group, UnitTest("layout", binaryGraphTestLayout));
+    testGroupAddTest(&test_group, UnitTest("write and open",
+        binaryGraphTestWriteAndOpen));
+    testGroupAddTest(&test_group, UnitTest("open invalid",
+        binaryGraphTestOpenInvalid));
+
+    testManagerAddTestGroup(test_manager, test_group);
+}
@@ -0,0 +1,8 @@
+#ifndef BINARY_GRAPH_TESTS_HPP
+#define BINARY_GRAPH_TESTS_HPP
+
+#include "test_utils/test_manager.hpp"
+
+void binaryGraphTestRegisterTests(TestManager* test_manager);
+
+#endif
@@ -0,0 +1,208 @@
+#include "edge_list_loader_tests.hpp"
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <io/edge_list_loader.cpp>
+
+const std::string TESTING = "../resources/testing/";
+
+bool edgeListLoaderTestParseInt() {
+    bool result = true;
+
+    std::string text = "-42 7x +3 2147483648";
+    const char* cursor = text.c_str();
+    const char* end = cursor + text.size();
+    int value = 0;
+    result &= edgeListParseInt(cursor, end, &value) && value == -42;
+    cursor++;
+    result &= edgeListParseInt(cursor, end, &value) && value == 7;
+    result &= !edgeListParseInt(cursor, end, &value);
+    result &= *cursor == 'x';
+    cursor += 2;
+    result &= edgeListParseInt(cursor, end, &value) && value == 3;
+    cursor++;
+    result &= !edgeListParseInt(cursor, end, &value);
+
+    return result;
+}
+
+bool edgeListLoaderTestParseVertex() {
+    bool result = true;
+
+    // 64-bit ids parse at both ends of their range and reject overflow
+    std::string text = "-9223372036854775808 9223372036854775808 -1";
+    const char* cursor = text.c_str();
+    const char* end = cursor + text.size();
+    long long signed_value = 0;
+    result &= edgeListParseVertex(cursor, end, &signed_value);
+    result &= signed_value == std::numeric_limits<long long>::min();
+    cursor++;
+    result &= !edgeListParseVertex(cursor, end, &signed_value);
+    unsigned long long unsigned_value = 0;
+    result &= edgeListParseVertex(cursor, end, &unsigned_value);
+    result &= unsigned_value == 9223372036854775808ULL;
+    cursor++;
+    result &= !edgeListParseVertex(cursor, end, &unsigned_value);
+    result &= *cursor == '-';
+
+    // Strings run up to the next space or line break
+    std::string names = "new_york\tSao-Paulo\n";
+    cursor = names.c_str();
+    end = cursor + names.size();
+    std::string name;
+    result &= edgeListParseVertex(cursor, end, &name) && name == "new_york";
+    cursor++;
+    result &= edgeListParseVertex(cursor, end, &name) && name == "Sao-Paulo";
+    result &= !edgeListParseVertex(cursor, end, &name);
+
+    return result;
+}
+
+bool edgeListLoaderTestParseDouble() {
+    bool result = true;
+
+    const char* inputs[] = {"2.5", "-0.001", "1e3", "3.14159265358979",
+        "12345678901234567890", ".5", "7."};
+    double expected[] = {2.5, -0.001, 1000, 3.14159265358979,
+        12345678901234567890.0, 0.5, 7};
+    for (int i = 0; i < 7; i++) {
+        std::string text = inputs[i];
+        const char* cursor = text.c_str();
+        double value = 0;
+        result &= edgeListParseDouble(cursor, cursor + text.size(), &value);
+        result &= value == expected[i];
+        result &= cursor == text.c_str() + text.size();
+    }
+
+    std::string invalid = "e5";
+    const char* cursor = invalid.c_str();
+    double value = 0;
+    result &= !edgeListParseDouble(cursor, cursor + invalid.size(), &value);
+    result &= cursor == invalid.c_str();
+
+    return result;
+}
+
+bool edgeListLoaderTestLoad() {
+    bool result = true;
+
+    DynamicArray<Edge<int>> edges;
+    int size = edgeListLoad(TESTING + "edge_list_loader/weights.txt", edges);
+    result &= size == 5;
+    result &= edges.size == 5;
+    result &= edges[0] == Edge<int>(0, 1, 2.5);
+    result &= edges[1] == Edge<int>(1, 2, 1);
+    result &= edges[2] == Edge<int>(2, 3, -1.25e-3);
+    result &= edges[3].weight == 12345678901234567890.0;
+    result &= edges[4] == Edge<int>(4, 0, 7);
+
+    const std::string malformed[] = {"too_many_tokens.txt", "not_a_number.txt"};
+    for (const std::string& name : malformed) {
+        try {
+            DynamicArray<Edge<int>> invalid;
+            edgeListLoad(TESTING + "edge_list_loader/" + name, invalid);
+            result &= false;
+        } catch (std::logic_error) {
+            result &= true;
+        } catch (...) {
+            result &= false;
+        }
+    }
+
+    try {
+        DynamicArray<Edge<int>> missing;
+        edgeListLoad(TESTING + "edge_list_loader/missing.txt", missing);
+        result &= false;
+    } catch (std::logic_error) {
+        result &= true;
+    } catch (...) {
+        result &= false;
+    }
+
+    return result;
+}
+
+bool edgeListLoaderTestLoadVertices() {
+    bool result = true;
+
+    DynamicArray<Edge<std::string>> names;
+    int size = edgeListLoad(TESTING + "string_vertices.txt", names);
+    result &= size == 5;
+    result &= names.size == 4;
+    result &= names[0] == Edge<std::string>("paris", "london", 2.5);
+    result &= names[1] == Edge<std::string>("london", "berlin", 1);
+    result &= names[3] == Edge<std::string>("rome", "paris", 4);
+
+    DynamicArray<Edge<long long>> ids;
+    edgeListLoad(TESTING + "edge_list_loader/int64.txt", ids);
+    result &= ids.size == 2;
+    result &= ids[0].from == std::numeric_limits<long long>::max();
+    result &= ids[0].to == std::numeric_limits<long long>::min();
+    result &= ids[1].from == 4294967296LL;
+    result &= ids[1].weight == 1;
+
+    // The same ids don't fit an int
+    try {
+        DynamicArray<Edge<int>> small;
+        edgeListLoad(TESTING + "edge_list_loader/int64.txt", small);
+        result &= false;
+    } catch (std::logic_error) {
+        result &= true;
+    } catch (...) {
+        result &= false;
+    }
+
+    return result;
+}
+
+bool edgeListLoaderTestLoadParallel() {
+    bool result = true;
+
+    // Big enough that the loader splits it between threads
+    const int NUM_EDGES = 300000;
+    std::string path = TESTING + "edge_list_loader/generated.txt";
+    {
+        std::ofstream file(path);
+        file << NUM_EDGES << '\n';
+        for (int i = 0; i < NUM_EDGES; i++) {
+            file << i << ' ' << (i + 1) % NUM_EDGES << ' ' << i % 10 << ".5\n";
+        }
+    }
+
+    DynamicArray<Edge<int>> edges;
+    EdgeListLoadStats stats;
+    int size = edgeListLoad(path, edges, &stats, 4);
+    std::remove(path.c_str());
+
+    result &= size == NUM_EDGES + 1;
+    result &= edges.size == NUM_EDGES;
+    result &= stats.num_threads == 4;
+    result &= stats.edges == NUM_EDGES;
+    result &= stats.bytes > 0;
+    result &= stats.megabytes_per_second >= 0;
+    for (int i = 0; i < NUM_EDGES; i++) {
+        result &= edges[i].from == i;
+        result &= edges[i].to == (i + 1) % NUM_EDGES;
+        result &= edges[i].weight == i % 10 + 0.5;
+    }
+
+    return result;
+}
+
+void edgeListLoaderTestRegisterTests(TestManager* test_manager) {
+    TestGroup test_group("edge list loader");
+
+    testGroupAddTest(&test_group, UnitTest("parse int",
+        edgeListLoaderTestParseInt));
+    testGroupAddTest(&test_group, UnitTest("parse vertex",
+        edgeListLoaderTestParseVertex));
+    testGroupAddTest(&test_group, UnitTest("parse double",
+        edgeListLoaderTestParseDouble));
+    testGroupAddTest(&test_group, UnitTest("load", edgeListLoaderTestLoad));
+    testGroupAddTest(&test_group, UnitTest("load vertices",
+        edgeListLoaderTestLoadVertices));
+    testGroupAddTest(&test_group, UnitTest("load parallel",
+        edgeListLoaderTestLoadParallel));
+
+    testManagerAddTestGroup(test_manager, test_group);
+}
@@ -0,0 +1,8 @@
+#ifndef EDGE_LIST_LOADER_TESTS_HPP
+#define EDGE_LIST_LOADER_TESTS_HPP
+
+#include "test_utils/test_manager.hpp"
+
+void edgeListLoaderTestRegisterTests(TestManager* test_manager);
+
+#endif
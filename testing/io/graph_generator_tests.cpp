@@ -0,0 +1,256 @@
+#include "graph_generator_tests.hpp"
+#include <cstdio>
+#include <fstream>
+#include <io/graph_generator.cpp>
+
+const std::string TESTING = "../resources/testing/";
+
+/**
+ * @brief Checks that every edge is in range and has a whole weight from 1
+ * to max_weight, and counts each node's out-degree
+ */
+bool graphGeneratorTestCheckEdges(
+        const GraphGenerator& generator,
+        const DynamicArray<Edge<int>>& edges,
+        DynamicArray<int>& degrees) {
+    bool result = true;
+    dynamicArrayResize(degrees, generator.num_nodes);
+    for (size_t i = 0; i < edges.size; i++) {
+        result &= 0 <= edges[i].from && edges[i].from < generator.num_nodes;
+        result &= 0 <= edges[i].to && edges[i].to < generator.num_nodes;
+        result &= edges[i].weight >= 1;
+        result &= edges[i].weight <= generator.max_weight;
+        result &= edges[i].weight == static_cast<int>(edges[i].weight);
+        if (result) {degrees[edges[i].from]++;}
+    }
+    return result;
+}
+
+bool graphGeneratorTestModels() {
+    bool result = true;
+
+    DynamicArray<Edge<int>> edges;
+    DynamicArray<int> degrees;
+    GraphGenerator uniform = graphGeneratorUniform(100, 1000, 7, 5);
+    graphGeneratorGenerateEdges(uniform, edges);
+    result &= edges.size == 1000;
+    result &= graphGeneratorTestCheckEdges(uniform, edges, degrees);
+
+    // R-MAT degrees are skewed, so the busiest node is far above average
+    GraphGenerator rmat = graphGeneratorRmat(10, 16 << 10, 7);
+    result &= rmat.num_nodes == 1024;
+    dynamicArrayClear(edges);
+    graphGeneratorGenerateEdges(rmat, edges);
+    result &= edges.size == 16 << 10;
+    result &= graphGeneratorTestCheckEdges(rmat, edges, degrees);
+    int busiest = 0;
+    for (int i = 0; i < rmat.num_nodes; i++) {
+        if (degrees[i] > busiest) {busiest = degrees[i];}
+    }
+    result &= busiest > 8 * 16;
+
+    // Every lattice edge appears once, going up one step along an axis
+    GraphGenerator grid = graphGeneratorGrid(3, 2, 2, 7);
+    result &= grid.num_nodes == 12;
+    result &= grid.num_edges == 8 + 6 + 6;
+    dynamicArrayClear(edges);
+    graphGeneratorGenerateEdges(grid, edges);
+    result &= graphGeneratorTestCheckEdges(grid, edges, degrees);
+    DynamicArray<int> seen;
+    dynamicArrayResize(seen, 3 * grid.num_nodes);
+    for (size_t i = 0; i < edges.size; i++) {
+        int from = edges[i].from;
+        int step = edges[i].to - from;
+        if (step == 1) {
+            result &= from % 3 < 2;
+            seen[3 * from]++;
+        } else if (step == 3) {
+            result &= from % 6 < 3;
+            seen[3 * from + 1]++;
+        } else {
+            result &= step == 6 && from < 6;
+            seen[3 * from + 2]++;
+        }
+    }
+    for (int i = 0; i < 3 * grid.num_nodes; i++) {result &= seen[i] <= 1;}
+    result &= graphGeneratorGrid(4, 4, 1, 7).num_edges == 24;
+
+    // New nodes only attach to older ones, and the oldest become hubs
+    GraphGenerator preferential = graphGeneratorPreferential(1000, 4, 7);
+    result &= preferential.num_edges == 4000;
+    dynamicArrayClear(edges);
+    graphGeneratorGenerateEdges(preferential, edges);
+    result &= graphGeneratorTestCheckEdges(preferential, edges, degrees);
+    DynamicArray<int> in_degrees;
+    dynamicArrayResize(in_degrees, preferential.num_nodes);
+    for (size_t i = 0; i < edges.size; i++) {
+        result &= edges[i].from == static_cast<int>(i / 4);
+        result &= edges[i].to <= edges[i].from;
+        in_degrees[edges[i].to]++;
+    }
+    result &= in_degrees[0] + in_degrees[1] > 10 * 4;
+
+    return result;
+}
+
+bool graphGeneratorTestDeterministic() {
+    bool result = true;
+
+    // Big enough to take a few blocks, so workers interleave
+    GraphGenerator rmat = graphGeneratorRmat(16, 300000, 42);
+    ThreadPool serial(1), parallel(4);
+    DynamicArray<Edge<int>> first, second, other;
+    graphGeneratorGenerateEdges(rmat, first, GRAPH_DIRECTED, serial);
+    graphGeneratorGenerateEdges(rmat, second, GRAPH_DIRECTED, parallel);
+    result &= first.size == second.size;
+    for (size_t i = 0; i < first.size; i++) {
+        result &= first[i] == second[i];
+        result &= first[i] == graphGeneratorEdge(rmat, i);
+    }
+
+    int differences = 0;
+    graphGeneratorGenerateEdges(graphGeneratorRmat(16, 300000, 43), other);
+    for (size_t i = 0; i < first.size; i++) {
+        differences += first[i] != other[i];
+    }
+    result &= differences > 290000;
+
+    // Undirected graphs follow every edge with its reverse
+    DynamicArray<Edge<int>> both;
+    graphGeneratorGenerateEdges(rmat, both, GRAPH_UNDIRECTED, parallel);
+    result &= both.size == 2 * first.size;
+    for (size_t i = 0; i < first.size; i++) {
+        result &= both[2 * i] == first[i];
+        result &= both[2 * i + 1] == Edge<int>(
+            first[i].to, first[i].from, first[i].weight);
+    }
+
+    return result;
+}
+
+bool graphGeneratorTestInvalid() {
+    bool result = true;
+
+    const int NUM_INVALID = 8;
+    for (int i = 0; i < NUM_INVALID; i++) {
+        try {
+            if (i == 0) {graphGeneratorRmat(0, 10, 1);}
+            if (i == 1) {graphGeneratorRmat(31, 10, 1);}
+            if (i == 2) {graphGeneratorRmat(4, 10, 1, 100, 0.5, 0.3, 0.3);}
+            if (i == 3) {graphGeneratorUniform(0, 10, 1);}
+            if (i == 4) {graphGeneratorGrid(3, 0, 1, 1);}
+            if (i == 5) {graphGeneratorGrid(65536, 65536, 1, 1);}
+            if (i == 6) {graphGeneratorPreferential(10, 0, 1);}
+            if (i == 7) {graphGeneratorUniform(10, 10, 1, 0);}
+            result &= false;
+        } catch (std::logic_error) {
+            result &= true;
+        } catch (...) {
+            result &= false;
+        }
+    }
+
+    Graph<int> graph;
+    graphAddNode(graph, 0);
+    try {
+        graphGeneratorGenerateGraph(graphGeneratorUniform(5, 5, 1), graph);
+        result &= false;
+    } catch (std::logic_error) {
+        result &= true;
+    } catch (...) {
+        result &= false;
+    }
+
+    return result;
+}
+
+bool graphGeneratorTestGraph() {
+    bool result = true;
+
+    // A small, dense R-MAT graph repeats plenty of edges, which are dropped
+    GraphGenerator rmat = graphGeneratorRmat(5, 1000, 3);
+    DynamicArray<Edge<int>> edges;
+    graphGeneratorGenerateEdges(rmat, edges);
+    Graph<int> graph;
+    graphGeneratorGenerateGraph(rmat, graph);
+    result &= graphGetNumNodes(graph) == 32;
+
+    HashMap<long long, double> distinct;
+    for (size_t i = 0; i < edges.size; i++) {
+        long long key = static_cast<long long>(edges[i].from) << 32
+            | edges[i].to;
+        if (!hashMapGet(distinct, key)) {
+            hashMapInsert(distinct, key, edges[i].weight);
+        }
+    }
+    CsrGraph<int> csr(graph);
+    result &= csr.num_edges == distinct.size;
+    result &= csr.num_edges < edges.size;
+    for (size_t i = 0; i < edges.size; i++) {
+        long long key = static_cast<long long>(edges[i].from) << 32
+            | edges[i].to;
+        LinkedList<Edge<int>>* edge = graphGetEdge(graph, edges[i]);
+        result &= edge && edge->data.weight == *hashMapGet(distinct, key);
+    }
+
+    return result;
+}
+
+bool graphGeneratorTestWrite() {
+    bool result = true;
+
+    // Text files load back into the same graph
+    std::string text_path = TESTING + "graph_generator.txt";
+    GraphGenerator uniform = graphGeneratorUniform(500, 200000, 11);
+    graphGeneratorWriteEdgeList(uniform, text_path);
+    result &= CsrGraph<int>(text_path, GRAPH_UNDIRECTED)
+        == graphGeneratorGenerateCsr(uniform, GRAPH_UNDIRECTED);
+    std::remove(text_path.c_str());
+
+    // Binary files match whether they're written in one range or many
+    std::string binary_path = TESTING + "graph_generator.bin";
+    GraphGenerator rmat = graphGeneratorRmat(8, 4000, 11);
+    CsrGraph<int> expected = graphGeneratorGenerateCsr(rmat, GRAPH_UNDIRECTED);
+    const size_t budgets[2] = {GRAPH_GENERATOR_MAX_EDGES_IN_MEMORY, 100};
+    for (int i = 0; i < 2; i++) {
+        graphGeneratorWriteBinary(
+            rmat, binary_path, GRAPH_UNDIRECTED, budgets[i]);
+        MappedCsrGraph<int> mapped(binary_path);
+        result &= mapped.graph == expected;
+    }
+
+    // Graphs generated over several rounds fill their ranges in order too,
+    // and leave no spill file behind
+    CsrGraph<int> large = graphGeneratorGenerateCsr(uniform, GRAPH_UNDIRECTED);
+    graphGeneratorWriteBinary(uniform, binary_path, GRAPH_UNDIRECTED, 100000);
+    {
+        MappedCsrGraph<int> mapped(binary_path);
+        result &= mapped.graph == large;
+    }
+    result &= !std::ifstream(binary_path + ".spill");
+
+    GraphGenerator empty = graphGeneratorUniform(5, 0, 11);
+    graphGeneratorWriteBinary(empty, binary_path);
+    {
+        MappedCsrGraph<int> mapped(binary_path);
+        result &= csrGraphGetNumNodes(mapped.graph) == 5;
+        result &= csrGraphGetNumEdges(mapped.graph) == 0;
+    }
+    std::remove(binary_path.c_str());
+
+    return result;
+}
+
+void graphGeneratorTestRegisterTests(TestManager* test_manager) {
+    TestGroup test_group("graph generator");
+
+    testGroupAddTest(&test_group, UnitTest("models", graphGeneratorTestModels));
+    testGroupAddTest(&test_group, UnitTest("deterministic",
+        graphGeneratorTestDeterministic));
+    testGroupAddTest(&test_group, UnitTest("invalid",
+        graphGeneratorTestInvalid));
+    testGroupAddTest(&test_group, UnitTest("graph", graphGeneratorTestGraph));
+    testGroupAddTest(&test_group, UnitTest("write", graphGeneratorTestWrite));
+
+    testManagerAddTestGroup(test_manager, test_group);
+}
@@ -0,0 +1,8 @@
+#ifndef GRAPH_GENERATOR_TESTS_HPP
+#define GRAPH_GENERATOR_TESTS_HPP
+
+#include "test_utils/test_manager.hpp"
+
+void graphGeneratorTestRegisterTests(TestManager* test_manager);
+
+#endif
@@ -7,9 +7,42 @@
 #include "data_structures/edge_tests.hpp"
 #include "data_structures/adjacency_list_tests.hpp"
 #include "data_structures/graph_tests.hpp"
+#include "data_structures/dynamic_array_tests.hpp"
+#include "data_structures/csr_graph_tests.hpp"
+#include "data_structures/dynamic_graph_tests.hpp"
+#include "data_structures/hash_map_tests.hpp"
+#include "data_structures/flat_hash_map_tests.hpp"
+#include "data_structures/vertex_id_map_tests.hpp"
+#include "data_structures/priority_queue_tests.hpp"
+#include "data_structures/pairing_heap_tests.hpp"
+#include "data_structures/radix_heap_tests.hpp"
+#include "io/edge_list_loader_tests.hpp"
+#include "io/binary_graph_tests.hpp"
+#include "algorithms/breadth_first_search_tests.hpp"
+#include "algorithms/dijkstra_tests.hpp"
+#include "algorithms/delta_stepping_tests.hpp"
+#include "data_structures/eytzinger_tree_tests.hpp"
+#include "memory/node_pool_tests.hpp"
+#include "concurrency/mpmc_queue_tests.hpp"
+#include "concurrency/work_stealing_deque_tests.hpp"
+#include "concurrency/thread_pool_tests.hpp"
+#include "concurrency/concurrent_hash_map_tests.hpp"
+#include "io/graph_generator_tests.hpp"
 
-int main() {
+/**
+ * @brief Runs every test. Takes these arguments, in any order:
+ *
+ * --filter <text>: only runs the tests whose "group/test" contains text
+ * --threads <n>: how many groups to run at once, or 0 for one per hardware
+ * thread. 1 runs everything on the main thread, which is easier to debug
+ * --slow-ms <ms>: reports tests that take longer than this as slow
+ *
+ * @return int 0 if every test passed, 1 if any failed or the arguments
+ * were invalid
+ */
+int main(int argc, char** argv) {
     TestManager test_manager;
+    if (!testManagerParseArguments(&test_manager, argc, argv)) {return 1;}
     linkedListTestRegisterTests(&test_manager);
     doubleLinkedListTestRegisterTests(&test_manager);
     binaryTreeTestRegisterTests(&test_manager);
@@ -18,6 +51,26 @@ int main() {
     edgeTestRegisterTests(&test_manager);
     adjacencyListTestRegisterTests(&test_manager);
     graphTestRegisterTests(&test_manager);
-    testManagerRun(test_manager);
-    return 0;
+    dynamicArrayTestRegisterTests(&test_manager);
+    csrGraphTestRegisterTests(&test_manager);
+    dynamicGraphTestRegisterTests(&test_manager);
+    hashMapTestRegisterTests(&test_manager);
+    flatHashMapTestRegisterTests(&test_manager);
+    vertexIdMapTestRegisterTests(&test_manager);
+    priorityQueueTestRegisterTests(&test_manager);
+    pairingHeapTestRegisterTests(&test_manager);
+    radixHeapTestRegisterTests(&test_manager);
+    edgeListLoaderTestRegisterTests(&test_manager);
+    binaryGraphTestRegisterTests(&test_manager);
+    breadthFirstSearchTestRegisterTests(&test_manager);
+    dijkstraTestRegisterTests(&test_manager);
+    deltaSteppingTestRegisterTests(&test_manager);
+    eytzingerTreeTestRegisterTests(&test_manager);
+    nodePoolTestRegisterTests(&test_manager);
+    mpmcQueueTestRegisterTests(&test_manager);
+    workStealingDequeTestRegisterTests(&test_manager);
+    threadPoolTestRegisterTests(&test_manager);
+    concurrentHashMapTestRegisterTests(&test_manager);
+    graphGeneratorTestRegisterTests(&test_manager);
+    return testManagerRun(test_manager) ? 1 : 0;
 }
\ No newline at end of file
@@ -0,0 +1,167 @@
+#include "node_pool_tests.hpp"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <memory/node_pool.cpp>
+#include <data_structures/binary_tree.cpp>
+#include <data_structures/double_linked_list.cpp>
+#include <data_structures/linked_list.cpp>
+
+bool nodePoolTestAllocate() {
+    bool result = true;
+
+    // Tiny sizes are padded so a free block can hold the list link
+    void* small = nodePoolAllocate<1>(1);
+    result &= nodePoolGet<1>().block_size >= sizeof(NodePoolBlock);
+    result &= reinterpret_cast<uintptr_t>(small) % NODE_POOL_ALIGNMENT == 0;
+    nodePoolDeallocate<1>(small, 1);
+
+    // Freed blocks are handed out again, most recent first
+    void* first = nodePoolAllocate<24>(24);
+    void* second = nodePoolAllocate<24>(24);
+    result &= first != second;
+    nodePoolDeallocate<24>(second, 24);
+    result &= nodePoolAllocate<24>(24) == second;
+    nodePoolDeallocate<24>(first, 24);
+    nodePoolDeallocate<24>(second, 24);
+    nodePoolDeallocate<24>(nullptr, 24);
+
+    // Outgrowing a slab keeps every block distinct
+    const int count = 10000;
+    void* blocks[count];
+    for (int i = 0; i < count; i++) {blocks[i] = nodePoolAllocate<40>(40);}
+    for (int i = 0; i < count; i++) {
+        static_cast<char*>(blocks[i])[39] = char(i);
+    }
+    for (int i = 0; i < count; i++) {
+        result &= static_cast<char*>(blocks[i])[39] == char(i);
+    }
+    for (int i = 0; i < count; i++) {nodePoolDeallocate<40>(blocks[i], 40);}
+
+    // Other sizes go to the global allocator
+    void* other = nodePoolAllocate<40>(100);
+    nodePoolDeallocate<40>(other, 100);
+
+    return result;
+}
+
+/**
+ * @brief Counts every slab allocated so far, by any pool
+ */
+int nodePoolTestCountSlabs() {
+    int count = 0;
+    for (void* slab = nodePoolSlabs().load();
+            slab;
+            slab = *static_cast<void**>(slab)) {
+        count++;
+    }
+    return count;
+}
+
+bool nodePoolTestThreads() {
+    bool result = true;
+
+    // Each thread gets its own pool
+    NodePool* main_pool = &nodePoolGet<32>();
+    NodePool* thread_pool = nullptr;
+    std::thread thread([&thread_pool]() {thread_pool = &nodePoolGet<32>();});
+    thread.join();
+    result &= thread_pool != main_pool;
+
+    // Nodes can be freed by a different thread than allocated them
+    LinkedList<int>* list = nullptr;
+    std::thread builder([&list]() {
+        for (int i = 0; i < 1000; i++) {list = new LinkedList<int>(i, list);}
+    });
+    builder.join();
+    int length = 0;
+    for (LinkedList<int>* temp = list; temp; temp = temp->next) {length++;}
+    result &= length == 1000;
+    delete list;
+
+    // A thread that only allocates reuses what a thread that only frees
+    // gives back, rather than carving new slabs every round
+    const int rounds = 100;
+    const int batch = 1000;
+    void* blocks[batch];
+    std::atomic<int> allocated(0), freed(0);
+    int slabs_before = nodePoolTestCountSlabs();
+    std::thread producer([&]() {
+        for (int round = 1; round <= rounds; round++) {
+            while (freed.load() != round - 1) {std::this_thread::yield();}
+            for (int i = 0; i < batch; i++) {
+                blocks[i] = nodePoolAllocate<200>(200);
+            }
+            allocated.store(round);
+        }
+    });
+    for (int round = 1; round <= rounds; round++) {
+        while (allocated.load() != round) {std::this_thread::yield();}
+        for (int i = 0; i < batch; i++) {
+            nodePoolDeallocate<200>(blocks[i], 200);
+        }
+        freed.store(round);
+    }
+    producer.join();
+    result &= nodePoolTestCountSlabs() - slabs_before < 10;
+
+    // Blocks left on a thread's free list are reused after it exits
+    std::thread exiting([&]() {
+        for (int i = 0; i < batch; i++) {
+            blocks[i] = nodePoolAllocate<232>(232);
+        }
+        for (int i = 0; i < batch; i++) {
+            nodePoolDeallocate<232>(blocks[i], 232);
+        }
+    });
+    exiting.join();
+    slabs_before = nodePoolTestCountSlabs();
+    for (int i = 0; i < batch; i++) {blocks[i] = nodePoolAllocate<232>(232);}
+    result &= nodePoolTestCountSlabs() == slabs_before;
+    for (int i = 0; i < batch; i++) {nodePoolDeallocate<232>(blocks[i], 232);}
+
+    return result;
+}
+
+bool nodePoolTestNodes() {
+    bool result = true;
+
+    // Deleting a node puts it back for the next one of the same type
+    LinkedList<int>* list = new LinkedList<int>(1, new LinkedList<int>(2));
+    LinkedList<int>* next = list->next;
+    delete list;
+    LinkedList<int>* reused = new LinkedList<int>(3);
+    result &= reused == next || reused == list;
+    result &= reused->data == 3;
+    delete reused;
+
+    DoubleLinkedList<std::string>* double_list =
+        new DoubleLinkedList<std::string>("a");
+    double_list->next =
+        new DoubleLinkedList<std::string>("b", double_list, nullptr);
+    DoubleLinkedList<std::string>* copy =
+        new DoubleLinkedList<std::string>(*double_list);
+    result &= copy->next->data == "b" && copy->next->prev == copy;
+    delete double_list;
+    delete copy;
+
+    BinaryTree<int>* tree = new BinaryTree<int>(2,
+        new BinaryTree<int>(1), new BinaryTree<int>(3));
+    BinaryTree<int>* tree_copy = new BinaryTree<int>(*tree);
+    result &= tree_copy->left->data == 1 && tree_copy->right->data == 3;
+    delete tree;
+    delete tree_copy;
+
+    return result;
+}
+
+void nodePoolTestRegisterTests(TestManager* test_manager) {
+    TestGroup test_group("node pool");
+
+    testGroupAddTest(&test_group, UnitTest("allocate", nodePoolTestAllocate));
+    testGroupAddTest(&test_group, UnitTest("threads", nodePoolTestThreads));
+    testGroupAddTest(&test_group, UnitTest("nodes", nodePoolTestNodes));
+
+    testManagerAddTestGroup(test_manager, test_group);
+}
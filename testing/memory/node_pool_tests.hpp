@@ -0,0 +1,8 @@
+#ifndef NODE_POOL_TESTS_HPP
+#define NODE_POOL_TESTS_HPP
+
+#include "test_utils/test_manager.hpp"
+
+void nodePoolTestRegisterTests(TestManager* test_manager);
+
+#endif
@@ -1,29 +1,71 @@
 #include "test_group.hpp"
-#include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
 
-void testGroupRun(const TestGroup& test_group) {
-    std::cout << "===========================================" << std::endl;
-    std::cout << "Running tests for " << test_group.group_name
-        << std::endl << std::endl;
+bool testGroupSelected(
+        const TestGroup& test_group,
+        const UnitTest& unit_test,
+        const TestOptions& options) {
+    std::string name = test_group.group_name + "/" + unit_test.test_name;
+    return name.find(options.filter) != std::string::npos;
+}
+
+TestGroupResult testGroupRun(
+        const TestGroup& test_group,
+        const TestOptions& options) {
+    TestGroupResult group_result;
+    group_result.group_name = test_group.group_name;
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2);
+    out << "===========================================\n";
+    out << "Running tests for " << test_group.group_name << "\n\n";
 
     // TODO(dderasmo): Replace with linked list.
-    size_t total = test_group.unit_tests.size(), passed = 0, failed = 0;
-    for (size_t i = 0; i < total; i++) {
-        UnitTest unit_test = test_group.unit_tests[i];
-        std::cout << "Testing " << unit_test.test_name
-            << " [" << i + 1 << "/" << total << "]: ";
-        if (unit_test.test_function()) {
-            std::cout << "Passed!" << std::endl;
-            passed++;
-        } else {
-            std::cout << "Failed!" << std::endl;
-            failed++;
+    size_t total = 0;
+    for (size_t i = 0; i < test_group.unit_tests.size(); i++) {
+        total += testGroupSelected(
+            test_group, test_group.unit_tests[i], options);
+    }
+    size_t index = 0;
+    for (size_t i = 0; i < test_group.unit_tests.size(); i++) {
+        const UnitTest& unit_test = test_group.unit_tests[i];
+        if (!testGroupSelected(test_group, unit_test, options)) {continue;}
+
+        TestResult result;
+        result.test_name = unit_test.test_name;
+        std::chrono::steady_clock::time_point start =
+            std::chrono::steady_clock::now();
+        try {
+            result.passed = unit_test.test_function();
+        } catch (...) {
+            result.threw = true;
+        }
+        std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+        result.milliseconds = elapsed.count();
+        group_result.milliseconds += result.milliseconds;
+
+        out << "Testing " << unit_test.test_name
+            << " [" << ++index << "/" << total << "]: "
+            << (result.passed ? "Passed!" : "Failed!")
+            << " (" << result.milliseconds << " ms";
+        if (result.threw) {out << ", threw";}
+        if (result.milliseconds > options.slow_milliseconds) {
+            out << ", slow";
         }
+        out << ")\n";
+        group_result.passed += result.passed;
+        group_result.failed += !result.passed;
+        group_result.test_results.push_back(result);
     }
-    std::cout << std::endl;
-    std::cout << "Passed: " << passed << "/" << total << std::endl;
-    std::cout << "Failed: " << failed << "/" << total << std::endl;
-    std::cout << "===========================================" << std::endl;
+    out << "\n";
+    out << "Passed: " << group_result.passed << "/" << total << "\n";
+    out << "Failed: " << group_result.failed << "/" << total << "\n";
+    out << "Time: " << group_result.milliseconds << " ms\n";
+    out << "===========================================\n";
+    group_result.report = out.str();
+    return group_result;
 }
 
 void testGroupAddTest(TestGroup* test_group, const UnitTest& unit_test) {
@@ -15,8 +15,57 @@ struct TestGroup {
         group_name(group_name), unit_tests(std::vector<UnitTest>()) {}
 };
 
+struct TestOptions {
+ public:
+    // Fields
+    // Only tests whose "group/test" name contains this are run
+    std::string filter;
+    // Groups run in parallel on this many threads, or one per hardware
+    // thread if 0. Tests in a group always run in order, one at a time
+    int num_threads;
+    // Tests that take longer than this are reported as slow
+    double slow_milliseconds;
+
+    // Constructors
+    TestOptions(): filter(""), num_threads(0), slow_milliseconds(1000) {}
+};
+
+struct TestResult {
+ public:
+    // Fields
+    std::string test_name;
+    bool passed;
+    bool threw;
+    double milliseconds;
+
+    // Constructors
+    TestResult(): passed(false), threw(false), milliseconds(0) {}
+};
+
+struct TestGroupResult {
+ public:
+    // Fields
+    std::string group_name;
+    std::vector<TestResult> test_results;
+    size_t passed;
+    size_t failed;
+    double milliseconds;
+    // The group's output, kept until it's this group's turn to print
+    std::string report;
+
+    // Constructors
+    TestGroupResult(): passed(0), failed(0), milliseconds(0) {}
+};
+
 void testGroupAddTest(TestGroup* test_group, const UnitTest& unit_test);
 
-void testGroupRun(const TestGroup& test_group);
+bool testGroupSelected(
+    const TestGroup& test_group,
+    const UnitTest& unit_test,
+    const TestOptions& options);
+
+TestGroupResult testGroupRun(
+    const TestGroup& test_group,
+    const TestOptions& options);
 
 #endif  // TESTING_TEST_UTILS_TEST_GROUP_HPP_
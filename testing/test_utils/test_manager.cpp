@@ -1,22 +1,129 @@
 #include "test_manager.hpp"
 #include "test_group.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iomanip>
 #include <iostream>
+#include <mutex>
+#include <thread>
 
-void testManagerRun(const TestManager& test_manager) {
+bool testManagerParseArguments(
+        TestManager* test_manager,
+        int argc,
+        char** argv) {
+    TestOptions& options = test_manager->options;
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        if (argument != "--filter" && argument != "--threads"
+            && argument != "--slow-ms") {
+            std::cerr << "Unknown option " << argument << std::endl;
+            return false;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing a value for " << argument << std::endl;
+            return false;
+        }
+        if (argument == "--filter") {
+            options.filter = argv[++i];
+        } else if (argument == "--threads") {
+            options.num_threads = std::atoi(argv[++i]);
+        } else {
+            options.slow_milliseconds = std::atof(argv[++i]);
+        }
+    }
+    if (options.num_threads < 0) {
+        std::cerr << "--threads can't be negative" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+size_t testManagerRun(const TestManager& test_manager) {
+    const TestOptions& options = test_manager.options;
     std::cout << "Running tests." << std::endl;
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
 
     // TODO(dderasmo): replace with linked list
+    std::vector<const TestGroup*> selected;
     for (size_t i = 0; i < test_manager.test_groups.size(); i++) {
-        TestGroup test_group = test_manager.test_groups[i];
-        std::cout << "Running tests for group "
-            << test_group.group_name << std::endl;
-        testGroupRun(test_group);
+        const TestGroup& test_group = test_manager.test_groups[i];
+        for (size_t j = 0; j < test_group.unit_tests.size(); j++) {
+            if (testGroupSelected(
+                    test_group, test_group.unit_tests[j], options)) {
+                selected.push_back(&test_group);
+                break;
+            }
+        }
+    }
+
+    // Workers take the next group until there are none left, and the
+    // reports are printed in order as soon as each one is done
+    size_t num_threads = options.num_threads > 0
+        ? options.num_threads
+        : std::thread::hardware_concurrency();
+    if (num_threads > selected.size()) {num_threads = selected.size();}
+    if (num_threads < 1) {num_threads = 1;}
+    std::vector<TestGroupResult> results(selected.size());
+    std::vector<bool> finished(selected.size(), false);
+    std::atomic<size_t> next(0);
+    std::mutex mutex;
+    std::condition_variable done;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; num_threads > 1 && i < num_threads; i++) {
+        threads.push_back(std::thread([&]() {
+            for (size_t j = next.fetch_add(1); j < selected.size();
+                    j = next.fetch_add(1)) {
+                TestGroupResult result = testGroupRun(*selected[j], options);
+                std::lock_guard<std::mutex> lock(mutex);
+                results[j] = result;
+                finished[j] = true;
+                done.notify_all();
+            }
+        }));
     }
+
+    size_t passed = 0, failed = 0;
+    for (size_t i = 0; i < selected.size(); i++) {
+        if (threads.empty()) {
+            results[i] = testGroupRun(*selected[i], options);
+        } else {
+            std::unique_lock<std::mutex> lock(mutex);
+            done.wait(lock, [&]() {return finished[i];});
+        }
+        std::cout << "Running tests for group " << results[i].group_name
+            << "\n" << results[i].report << std::flush;
+        passed += results[i].passed;
+        failed += results[i].failed;
+    }
+    for (size_t i = 0; i < threads.size(); i++) {threads[i].join();}
+
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    std::cout << std::fixed << std::setprecision(2);
+    for (size_t i = 0; i < results.size(); i++) {
+        for (size_t j = 0; j < results[i].test_results.size(); j++) {
+            const TestResult& result = results[i].test_results[j];
+            if (result.milliseconds > options.slow_milliseconds) {
+                std::cout << "Slow: " << results[i].group_name << "/"
+                    << result.test_name << " took " << result.milliseconds
+                    << " ms (budget " << options.slow_milliseconds
+                    << " ms)\n";
+            }
+        }
+    }
+    std::cout << "Passed: " << passed << "/" << passed + failed << "\n";
+    std::cout << "Failed: " << failed << "/" << passed + failed << "\n";
+    std::cout << "Time: " << elapsed.count() << " ms on " << num_threads
+        << (num_threads == 1 ? " thread" : " threads") << "\n";
     std::cout << "Done!" << std::endl;
+    return failed;
 }
 
 void testManagerAddTestGroup(
-        TestManager* test_manager, 
+        TestManager* test_manager,
         const TestGroup& test_group) {
     test_manager->test_groups.push_back(test_group);
-}
\ No newline at end of file
+}
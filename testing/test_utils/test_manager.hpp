@@ -9,14 +9,19 @@ struct TestManager {
  public:
     // Fields
     std::vector<TestGroup> test_groups;
+    TestOptions options;
 
     // Constructors
     TestManager(): test_groups(std::vector<TestGroup>()) {}
 };
 
-void testManagerRun(const TestManager& test_manager);
+bool testManagerParseArguments(
+    TestManager* test_manager,
+    int argc,
+    char** argv);
+size_t testManagerRun(const TestManager& test_manager);
 void testManagerAddTestGroup(
-    TestManager* test_manager, 
+    TestManager* test_manager,
     const TestGroup& test_group);
 
 #endif  // TESTING_TEST_UTILS_TEST_MANAGER_HPP_